@@ -0,0 +1,180 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @defgroup zigbee_examples_ble_zigbee_color_light_bulb_thingy app_profiler.c
+ * @{
+ * @ingroup zigbee_examples
+ */
+#include <stdint.h>
+#include <string.h>
+
+#include "app_profiler.h"
+
+#if APP_PROFILER_ENABLED
+
+#include "app_util_platform.h"
+#include "nordic_common.h"
+#include "nrf_log.h"
+
+static app_profiler_stats_t m_stats[APP_PROFILER_STAGES_COUNT];
+
+static const char * const m_stage_names[APP_PROFILER_STAGES_COUNT] =
+{
+    [APP_PROFILER_STAGE_LED_REFRESH]    = "led_refresh",
+    [APP_PROFILER_STAGE_WS2812_ENCODE]  = "ws2812_encode",
+    [APP_PROFILER_STAGE_HSB_TO_RGB]     = "hsb_to_rgb",
+    [APP_PROFILER_STAGE_ZCL_DEVICE_CB]  = "zcl_device_cb",
+    [APP_PROFILER_STAGE_SCENE_RECALL]   = "scene_recall",
+    [APP_PROFILER_STAGE_WS2812_LATENCY] = "ws2812_latency",
+    [APP_PROFILER_STAGE_APA102_LATENCY] = "apa102_latency",
+};
+
+/**@brief Function for getting histogram bin of given duration.
+ *
+ * @param[in] duration  Execution time.
+ *
+ * @return Integer part of log2 of @p duration, 0 for @p duration equal to 0.
+ */
+static uint32_t histogram_bin_get(uint32_t duration)
+{
+    static const uint8_t shifts[] = {16U, 8U, 4U, 2U, 1U};
+    uint32_t             bin      = 0U;
+    uint32_t             i;
+
+    for (i = 0U; i < ARRAY_SIZE(shifts); i++)
+    {
+        if (duration >= (1UL << shifts[i]))
+        {
+            duration >>= shifts[i];
+            bin       += shifts[i];
+        }
+    }
+
+    return bin;
+}
+
+void app_profiler_record(app_profiler_stage_t stage, uint32_t duration)
+{
+    app_profiler_stats_t * p_stats = &m_stats[stage];
+
+    /* Stages may be executed from different interrupt priorities */
+    CRITICAL_REGION_ENTER();
+
+    if ((p_stats->count == 0U) || (duration < p_stats->min))
+    {
+        p_stats->min = duration;
+    }
+    if (duration > p_stats->max)
+    {
+        p_stats->max = duration;
+    }
+    p_stats->count++;
+    p_stats->sum += duration;
+    p_stats->histogram[histogram_bin_get(duration)]++;
+
+    CRITICAL_REGION_EXIT();
+}
+
+void app_profiler_report(void)
+{
+    app_profiler_stats_t stats;
+    uint32_t             stage;
+    uint32_t             bin;
+
+    for (stage = 0U; stage < APP_PROFILER_STAGES_COUNT; stage++)
+    {
+        CRITICAL_REGION_ENTER();
+        stats = m_stats[stage];
+        CRITICAL_REGION_EXIT();
+
+        if (stats.count == 0U)
+        {
+            continue;
+        }
+
+        NRF_LOG_INFO("%s: count %u min %u avg %u max %u",
+                     m_stage_names[stage],
+                     stats.count,
+                     stats.min,
+                     (uint32_t)(stats.sum / stats.count),
+                     stats.max);
+
+        for (bin = 0U; bin < APP_PROFILER_HISTOGRAM_BINS; bin++)
+        {
+            if (stats.histogram[bin] != 0U)
+            {
+                NRF_LOG_INFO("  >= %u: %u", (bin == 0U) ? 0U : (1UL << bin), stats.histogram[bin]);
+            }
+        }
+    }
+}
+
+void app_profiler_reset(void)
+{
+    CRITICAL_REGION_ENTER();
+    memset(m_stats, 0, sizeof(m_stats));
+    CRITICAL_REGION_EXIT();
+}
+
+void app_profiler_stats_get(app_profiler_stage_t stage, app_profiler_stats_t * p_stats)
+{
+    CRITICAL_REGION_ENTER();
+    *p_stats = m_stats[stage];
+    CRITICAL_REGION_EXIT();
+}
+
+void app_profiler_init(void)
+{
+#if APP_PROFILER_CLOCK_DWT
+    /* Enable the cycle counter */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT       = 0U;
+    DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+
+    app_profiler_reset();
+}
+
+#endif /* APP_PROFILER_ENABLED */
+
+/**
+ * @}
+ */
@@ -0,0 +1,162 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @defgroup zigbee_examples_ble_zigbee_color_light_bulb_thingy app_profiler.h
+ * @{
+ * @ingroup zigbee_examples
+ *
+ * @brief Lightweight profiler of hot paths of the application.
+ *
+ * Execution time of instrumented stages is measured with the DWT cycle counter, or any other clock provided through
+ * @ref APP_PROFILER_CLOCK_GET. Minimum, average and maximum time and a histogram of log2 of the time are collected
+ * for each stage. With @ref APP_PROFILER_ENABLED set to 0, all instrumentation compiles out.
+ */
+
+#ifndef APP_PROFILER_H__
+#define APP_PROFILER_H__
+
+#include <stdint.h>
+
+#include "sdk_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**@def APP_PROFILER_ENABLED
+ * @brief Enables measurement of execution time of instrumented stages */
+#ifndef APP_PROFILER_ENABLED
+#define APP_PROFILER_ENABLED    0
+#endif
+
+/* Instrumented stages */
+typedef enum
+{
+    APP_PROFILER_STAGE_LED_REFRESH,     /**< Refresh of the LED chain by rgb_led. */
+    APP_PROFILER_STAGE_WS2812_ENCODE,   /**< Encoding of WS2812 pixels into PWM sequence. */
+    APP_PROFILER_STAGE_HSB_TO_RGB,      /**< Conversion of HSB color to RGB. */
+    APP_PROFILER_STAGE_ZCL_DEVICE_CB,   /**< Handling of ZCL device callback. */
+    APP_PROFILER_STAGE_SCENE_RECALL,    /**< Recall of a scene from the scene table. */
+    APP_PROFILER_STAGE_WS2812_LATENCY,  /**< Time from commit of a WS2812 frame until it is latched by the LEDs. */
+    APP_PROFILER_STAGE_APA102_LATENCY,  /**< Time from commit of an APA102 frame until it is latched by the LEDs. */
+    APP_PROFILER_STAGES_COUNT
+} app_profiler_stage_t;
+
+/* Number of histogram bins. Bin n counts durations from range [2^n, 2^(n+1)), bin 0 counts also duration 0. */
+#define APP_PROFILER_HISTOGRAM_BINS     32U
+
+/* Statistics of single stage */
+typedef struct
+{
+    uint32_t count;                                     /**< Number of executions. */
+    uint32_t min;                                       /**< Shortest execution time. */
+    uint32_t max;                                       /**< Longest execution time. */
+    uint64_t sum;                                       /**< Total execution time. */
+    uint32_t histogram[APP_PROFILER_HISTOGRAM_BINS];    /**< Number of executions in each log2 bin. */
+} app_profiler_stats_t;
+
+#if APP_PROFILER_ENABLED
+
+/**@def APP_PROFILER_CLOCK_GET
+ * @brief Returns current value of free running 32-bit counter used as profiler clock.
+ *        Defaults to the DWT cycle counter, may be defined e.g. by a host build to use another clock. */
+#ifndef APP_PROFILER_CLOCK_GET
+#include "nrf.h"
+#define APP_PROFILER_CLOCK_GET()        (DWT->CYCCNT)
+#define APP_PROFILER_CLOCK_DWT          1
+#endif
+
+/**@brief Marks beginning of a stage. Must be followed by @ref APP_PROFILER_STAGE_END in the same block.
+ *
+ * @param[in] stage     One of @ref app_profiler_stage_t values.
+ */
+#define APP_PROFILER_STAGE_BEGIN(stage) \
+    uint32_t const app_profiler_begin_ ## stage = APP_PROFILER_CLOCK_GET()
+
+/**@brief Marks end of a stage and records time elapsed since @ref APP_PROFILER_STAGE_BEGIN.
+ *
+ * @param[in] stage     One of @ref app_profiler_stage_t values.
+ */
+#define APP_PROFILER_STAGE_END(stage) \
+    app_profiler_record((stage), APP_PROFILER_CLOCK_GET() - app_profiler_begin_ ## stage)
+
+/**@brief Function for initializing the profiler and starting its clock. */
+void app_profiler_init(void);
+
+/**@brief Function for recording execution time of a stage.
+ *
+ * @param[in] stage     Stage which has been executed.
+ * @param[in] duration  Execution time, in profiler clock ticks.
+ */
+void app_profiler_record(app_profiler_stage_t stage, uint32_t duration);
+
+/**@brief Function for logging statistics of all stages executed at least once. */
+void app_profiler_report(void);
+
+/**@brief Function for clearing statistics of all stages. */
+void app_profiler_reset(void);
+
+/**@brief Function for getting statistics of a stage.
+ *
+ * @param[in]  stage    Stage of interest.
+ * @param[out] p_stats  Statistics collected since the last reset.
+ */
+void app_profiler_stats_get(app_profiler_stage_t stage, app_profiler_stats_t * p_stats);
+
+#else
+
+#define APP_PROFILER_STAGE_BEGIN(stage)
+#define APP_PROFILER_STAGE_END(stage)
+#define app_profiler_init()
+#define app_profiler_report()
+#define app_profiler_reset()
+
+#endif /* APP_PROFILER_ENABLED */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_PROFILER_H__ */
+
+/**
+ * @}
+ */
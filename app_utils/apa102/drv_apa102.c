@@ -0,0 +1,265 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include <nrfx.h>
+#include <nrfx_spim.h>
+
+#include "app_profiler.h"
+#include "drv_apa102.h"
+
+/* Start frame is 32 zero bits */
+#define APA102_START_FRAME_WORDS    1U
+/* Every LED delays the data by half a clock period, so the last pixel is clocked out after another half a bit
+ * per LED. Zeros are sent for that, preceded by 32 zero bits, which SK9822 needs to latch the frame.
+ */
+#define APA102_END_FRAME_WORDS      (1U + ((DRV_APA102_LED_CHAIN_PIXELS_COUNT_MAX + 63U) / 64U))
+#define APA102_FRAME_WORDS          (APA102_START_FRAME_WORDS + DRV_APA102_LED_CHAIN_PIXELS_COUNT_MAX + \
+                                     APA102_END_FRAME_WORDS)
+
+/* Every pixel starts with three 1 bits followed by 5 bits of global brightness */
+#define APA102_PIXEL_HEADER         0xE0U
+
+/* TXD.MAXCNT register of nRF52840 is 16 bits wide */
+NRFX_STATIC_ASSERT((APA102_FRAME_WORDS * sizeof(uint32_t)) <= 0xFFFFU);
+
+/**@brief LED state buffer, sent by EasyDMA as it is: start frame, pixels and end frame.
+ *
+ * Every pixel is one word holding bytes in the order of transmission (header, blue, green, red),
+ * which is little-endian, so it is written with a single store.
+ */
+static uint32_t m_frame[APA102_FRAME_WORDS];
+
+/**@brief SPIM module used by the driver */
+static const nrfx_spim_t m_spim = NRFX_SPIM_INSTANCE(DRV_APA102_SPIM_INSTANCE_NO);
+
+/* Frame is owned by the thread context while false, and by whoever starts it while true */
+static volatile bool m_frame_pending;
+static drv_apa102_refresh_callback_t p_pending_callback;
+static void *        p_pending_callback_param;
+
+static volatile bool m_busy;
+static volatile drv_apa102_refresh_callback_t p_refresh_callback;
+static void * volatile p_refresh_callback_param;
+
+#if APP_PROFILER_ENABLED
+/* Profiler clock at commit of the pending frame, and of the frame being sent */
+static uint32_t m_pending_commit_time;
+static uint32_t m_refresh_commit_time;
+#endif
+
+/**@brief Driver statistics */
+static drv_apa102_stats_t m_stats;
+
+/**@brief Function for making a word of the LED state buffer.
+ *
+ * @param[in] color         Color in the format described for @ref drv_apa102_set_pixel.
+ * @param[in] brightness    Global brightness.
+ */
+static uint32_t make_pixel(uint32_t color, uint8_t brightness)
+{
+    return ((color & 0xFFU) << 8)          |
+           (((color >> 8) & 0xFFU) << 16)  |
+           (((color >> 16) & 0xFFU) << 24) |
+           APA102_PIXEL_HEADER | (brightness & DRV_APA102_BRIGHTNESS_MAX);
+}
+
+/**@brief Function for starting the transfer of the LED state buffer. Caller must have set m_busy.
+ *
+ * @param[in] p_callback        Function called when the transfer has finished, may be NULL.
+ * @param[in] p_callback_param  Parameter passed to p_callback.
+ */
+static void refresh_start(drv_apa102_refresh_callback_t p_callback, void * p_callback_param)
+{
+    nrfx_spim_xfer_desc_t const xfer = NRFX_SPIM_XFER_TX(m_frame, sizeof(m_frame));
+
+    p_refresh_callback       = p_callback;
+    p_refresh_callback_param = p_callback_param;
+
+    UNUSED_RETURN_VALUE(nrfx_spim_xfer(&m_spim, &xfer, 0));
+}
+
+/**@brief Function for starting the transfer of the pending frame, if there is one and the LED chain is idle.
+ *
+ * Called from thread context on commit, and from SPIM interrupt when the previous transfer has finished.
+ *
+ * @retval true     Transfer of the pending frame has been started.
+ * @retval false    No frame is pending or the LED chain is busy.
+ */
+static bool pending_frame_start(void)
+{
+    bool start;
+
+    NRFX_CRITICAL_SECTION_ENTER();
+    start = m_frame_pending && !m_busy;
+    if (start)
+    {
+        m_frame_pending = false;
+        m_busy          = true;
+    }
+    NRFX_CRITICAL_SECTION_EXIT();
+
+    if (start)
+    {
+#if APP_PROFILER_ENABLED
+        m_refresh_commit_time = m_pending_commit_time;
+#endif
+        refresh_start(p_pending_callback, p_pending_callback_param);
+    }
+
+    return start;
+}
+
+static void spim_handler(nrfx_spim_evt_t const * p_event, void * p_context)
+{
+    drv_apa102_refresh_callback_t p_callback;
+
+    UNUSED_PARAMETER(p_context);
+    m_stats.interrupts++;
+
+    if (p_event->type == NRFX_SPIM_EVENT_DONE)
+    {
+        /* Pixels are latched while being clocked out, so the frame is visible now */
+#if APP_PROFILER_ENABLED
+        app_profiler_record(APP_PROFILER_STAGE_APA102_LATENCY, APP_PROFILER_CLOCK_GET() - m_refresh_commit_time);
+#endif
+        m_busy = false;
+
+        p_callback = p_refresh_callback;
+        if (p_callback != NULL)
+        {
+            /* Note: Function pointed by p_callback may call drv_apa102_display */
+            p_callback(p_refresh_callback_param);
+        }
+
+        /* Frame committed while the LED chain was busy is sent right away */
+        UNUSED_RETURN_VALUE(pending_frame_start());
+    }
+}
+
+uint32_t drv_apa102_init(uint8_t clk_pin, uint8_t data_pin)
+{
+    nrfx_spim_config_t spim_config = NRFX_SPIM_DEFAULT_CONFIG;
+
+    memset(m_frame, 0x00, sizeof(m_frame));
+    drv_apa102_set_pixel_all(0x00000000U, 0U);
+    memset(&m_stats, 0x00, sizeof(m_stats));
+    m_frame_pending          = false;
+    m_busy                   = false;
+    p_refresh_callback       = NULL;
+    p_refresh_callback_param = NULL;
+
+    spim_config.sck_pin      = clk_pin;
+    spim_config.mosi_pin     = data_pin;
+    spim_config.miso_pin     = NRFX_SPIM_PIN_NOT_USED;
+    spim_config.ss_pin       = NRFX_SPIM_PIN_NOT_USED;
+    spim_config.irq_priority = DRV_APA102_SPIM_IRQ_PRIORITY;
+    spim_config.frequency    = DRV_APA102_SPIM_FREQUENCY;
+    // APA102 samples data on the rising edge of the clock
+    spim_config.mode         = NRF_SPIM_MODE_0;
+    spim_config.bit_order    = NRF_SPIM_BIT_ORDER_MSB_FIRST;
+
+    return nrfx_spim_init(&m_spim, &spim_config, spim_handler, NULL);
+}
+
+uint32_t drv_apa102_display(drv_apa102_refresh_callback_t p_callback, void * p_callback_param)
+{
+    bool replaced;
+
+    /* Take the pending frame back, so it is not started while its callback is replaced */
+    NRFX_CRITICAL_SECTION_ENTER();
+    replaced        = m_frame_pending;
+    m_frame_pending = false;
+    NRFX_CRITICAL_SECTION_EXIT();
+
+    if (replaced)
+    {
+        m_stats.dropped_frames++;
+    }
+
+    p_pending_callback       = p_callback;
+    p_pending_callback_param = p_callback_param;
+#if APP_PROFILER_ENABLED
+    m_pending_commit_time    = APP_PROFILER_CLOCK_GET();
+#endif
+    m_stats.frames++;
+    m_frame_pending = true;
+
+    if (!pending_frame_start())
+    {
+        /* Started from spim_handler when the current transfer finishes */
+        m_stats.queued_frames++;
+    }
+
+    return NRF_SUCCESS;
+}
+
+void drv_apa102_stats_get(drv_apa102_stats_t * p_stats)
+{
+    *p_stats = m_stats;
+}
+
+bool drv_apa102_is_refreshing(void)
+{
+    return m_busy;
+}
+
+void drv_apa102_set_pixel(uint32_t pixel_no, uint32_t color, uint8_t brightness)
+{
+    if (pixel_no < DRV_APA102_LED_CHAIN_PIXELS_COUNT_MAX)
+    {
+        m_frame[APA102_START_FRAME_WORDS + pixel_no] = make_pixel(color, brightness);
+    }
+}
+
+void drv_apa102_set_pixel_all(uint32_t color, uint8_t brightness)
+{
+    uint32_t pixel = make_pixel(color, brightness);
+
+    size_t pixel_no;
+    for (pixel_no = 0U; pixel_no < DRV_APA102_LED_CHAIN_PIXELS_COUNT_MAX; ++pixel_no)
+    {
+        m_frame[APA102_START_FRAME_WORDS + pixel_no] = pixel;
+    }
+}
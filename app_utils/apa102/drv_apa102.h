@@ -0,0 +1,195 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @{
+ * @ingroup zigbee_examples
+ * @brief   Simple APA102/SK9822-based LED chain driver.
+ * @note
+ * The physical geometry of LED chain (for example, matrix, ring) is out of scope of this driver.
+ * It should be handled by upper-layer module.
+ */
+
+#ifndef DRV_APA102_H__
+#define DRV_APA102_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "sdk_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**@def DRV_APA102_LED_CHAIN_PIXELS_COUNT_MAX
+ *
+ * @brief Maximum number of the APA102 LEDs in chain supported by the APA102 driver.
+ *
+ * @note The LED state buffer is sent to the LED chain as it is, so the driver needs only 4 bytes of RAM
+ * per pixel. Sending the LED chain takes 32 SPI clock periods per pixel, that is 4 us at 8 MHz.
+ */
+#ifndef DRV_APA102_LED_CHAIN_PIXELS_COUNT_MAX
+#define DRV_APA102_LED_CHAIN_PIXELS_COUNT_MAX   (40U)
+#endif
+
+/**@def DRV_APA102_SPIM_INSTANCE_NO
+ *
+ * @brief Number of the nrfx SPIM instance used by the APA102 driver.
+ *
+ * @note You must enable the corresponding instance for the driver to work correctly. For example, when using
+ * the instance number 3, set NRFX_SPIM3_ENABLED to 1. The SPIM module is used exclusively by the driver.
+ */
+#ifndef DRV_APA102_SPIM_INSTANCE_NO
+#define DRV_APA102_SPIM_INSTANCE_NO             0
+#endif
+
+/**@def DRV_APA102_SPIM_FREQUENCY
+ *
+ * @brief SPI clock frequency, one of nrf_spim_frequency_t values.
+ *
+ * @note Only SPIM3 of nRF52840 supports frequencies above 8 MHz. Long chains may need a lower frequency,
+ * because every LED regenerates the clock with some skew.
+ */
+#ifndef DRV_APA102_SPIM_FREQUENCY
+#define DRV_APA102_SPIM_FREQUENCY               NRF_SPIM_FREQ_8M
+#endif
+
+/**@def DRV_APA102_SPIM_IRQ_PRIORITY
+ *
+ * @brief Interrupt priority of the SPIM instance.
+ */
+#ifndef DRV_APA102_SPIM_IRQ_PRIORITY
+#define DRV_APA102_SPIM_IRQ_PRIORITY            6
+#endif
+
+/**@brief Maximum value of the global brightness of a pixel. */
+#define DRV_APA102_BRIGHTNESS_MAX               31U
+
+/**@brief Driver statistics, see @ref drv_apa102_stats_get. */
+typedef struct
+{
+    uint32_t frames;            /**< Number of frames passed to @ref drv_apa102_display. */
+    uint32_t queued_frames;     /**< Number of frames committed while the LED chain was busy. */
+    uint32_t dropped_frames;    /**< Number of frames replaced by a newer one before being sent. */
+    uint32_t interrupts;        /**< Number of SPIM interrupts handled by the driver. */
+} drv_apa102_stats_t;
+
+/**@brief Typedef of function pointer being called when APA102 LED chain has just been refreshed.
+ *
+ * @param p_param   Opaque pointer passed from the application.
+ */
+typedef void ( * drv_apa102_refresh_callback_t)(void * p_param);
+
+/**@brief Function for initializing the APA102 LED chain driver.
+ *
+ * @param[in] clk_pin   GPIO pin used as clock (to be connected to the CI pin of the first LED in the chain).
+ * @param[in] data_pin  GPIO pin used as data (to be connected to the DI pin of the first LED in the chain).
+ *                      Use @ref NRF_GPIO_PIN_MAP to specify values.
+ *
+ * @retval NRF_SUCCESS     Initialization successful
+ * @retval Other           Error during initialization.
+ */
+uint32_t drv_apa102_init(uint8_t clk_pin, uint8_t data_pin);
+
+/**@brief Function for sending the LED state buffer to the LED chain. Must be called to update the LED visible state.
+ *
+ * The LED state buffer is transferred by EasyDMA directly, without a copy. If the LED chain is busy, the buffer
+ * is sent again as soon as the current transfer finishes. Several calls made in the meantime result in one
+ * transfer (counted as dropped frames).
+ *
+ * @param[in] p_callback        Pointer to a function called, when the frame has been sent to the LED chain.
+ *                              This function is called within ISR context. It is not called if the frame is
+ *                              replaced before being sent. Pass NULL if no user function should be called.
+ * @param[in] p_callback_param  Opaque pointer passed as a parameter when calling p_callback.
+ *                              Meaning of the pointer is completely up to the application.
+ *
+ * @retval NRF_SUCCESS     Frame is being sent or waits for the current transfer to finish.
+ *
+ * @note Pixels set while the LED chain is busy may already appear in the frame being sent.
+ *       Every pixel is written with a single 32-bit store, so it is never sent half-updated.
+ */
+uint32_t drv_apa102_display(drv_apa102_refresh_callback_t p_callback, void * p_callback_param);
+
+/**@brief Function for reading the driver statistics.
+ *
+ * @param[out] p_stats  Pointer to the structure to be filled. Must not be NULL.
+ */
+void drv_apa102_stats_get(drv_apa102_stats_t * p_stats);
+
+/**@brief Function for checking if the driver is sending the LED state buffer to the LED chain.
+ *
+ * @retval true     Driver is busy with performing the refresh.
+ * @retval false    Driver is in the idle state.
+ */
+bool drv_apa102_is_refreshing(void);
+
+/**@brief Function for setting the specified pixel in the LED state buffer to the specified color.
+ *
+ * @param[in] pixel_no      Number of the pixel in the LED chain.
+ *                          Specify a value in the range from 0 to @ref DRV_APA102_LED_CHAIN_PIXELS_COUNT_MAX-1.
+ *                          Values out of the range are ignored.
+ * @param[in] color         Color to be set. Use the RGB format. Bits 23 to 16 are for the red component,
+ *                          bits 15 to 8 are for the green component, and bits 7 to 0 are for the blue component.
+ * @param[in] brightness    Global brightness of the pixel, from 0 to @ref DRV_APA102_BRIGHTNESS_MAX,
+ *                          scaling all color components. Higher bits are ignored.
+ *
+ * @note Call @ref drv_apa102_display to update the LED chain from the frame buffer.
+ */
+void drv_apa102_set_pixel(uint32_t pixel_no, uint32_t color, uint8_t brightness);
+
+/**@brief Function for setting all pixels in the LED state buffer to the specified color.
+ *
+ * @param[in] color         Color to be set. Use the RGB format, as described for @ref drv_apa102_set_pixel.
+ * @param[in] brightness    Global brightness, as described for @ref drv_apa102_set_pixel.
+ *
+ * @note Call @ref drv_apa102_display to update the LED chain from the frame buffer.
+ */
+void drv_apa102_set_pixel_all(uint32_t color, uint8_t brightness);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DRV_APA102_H__
+
+/**
+ * @}
+ */
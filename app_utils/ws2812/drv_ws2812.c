@@ -47,212 +47,682 @@
 #include <nrfx_pwm.h>
 #include <hal/nrf_gpio.h>
 
+#include "app_profiler.h"
 #include "drv_ws2812.h"
+#include "drv_ws2812_frame.h"
 
+/* With DRV_WS2812_I2S_ENABLED the driver is implemented in drv_ws2812_i2s.c */
+#if !DRV_WS2812_I2S_ENABLED
+
+#if DRV_WS2812_HW_KEEPALIVE_ENABLED
+#include <nrfx_ppi.h>
+#include <hal/nrf_rtc.h>
+#endif
+
+#if DRV_WS2812_RGBW_ENABLED
+/* SK6812 requires T1H of 0.6 us +- 0.15 us, while WS2812B tolerates 0.58 us to 1 us */
+#define WS2812_T1H                  (10U | 0x8000U)
+#define WS2812_T0H                  (5U | 0x8000U)
+#else
 #define WS2812_T1H                  (14U | 0x8000U)
 #define WS2812_T0H                  (6U | 0x8000U)
+#endif
+#define WS2812_LOW                  (0x8000U)
 
-#define LED_CHAIN_TOTAL_BYTE_WIDTH  (DRV_WS2812_LED_CHAIN_PIXELS_COUNT_MAX * 3U)
+/* WS2812 requires that RET code time (TReset) is above 50us. Exact value doesn't seem to work,
+ * thus bigger value was selected: 100 pwm periods gives 125us. Seems enough.
+ */
+#define WS2812_RET_CODE_PERIODS     100U
+
+/* Helpers for generating the encoding lookup table at compile time */
+#define WS2812_BIT(v, n)            ((((v) >> (n)) & 1U) ? WS2812_T1H : WS2812_T0H)
+#define WS2812_LUT_NIBBLE(v)        { WS2812_BIT(v, 3U), WS2812_BIT(v, 2U), WS2812_BIT(v, 1U), WS2812_BIT(v, 0U) }
+#define WS2812_LUT_BYTE(v)          { WS2812_BIT(v, 7U), WS2812_BIT(v, 6U), WS2812_BIT(v, 5U), WS2812_BIT(v, 4U), \
+                                      WS2812_BIT(v, 3U), WS2812_BIT(v, 2U), WS2812_BIT(v, 1U), WS2812_BIT(v, 0U) }
+#define WS2812_LUT_4(entry, v)      entry(v), entry((v) + 1U), entry((v) + 2U), entry((v) + 3U)
+#define WS2812_LUT_16(entry, v)     WS2812_LUT_4(entry, v),          WS2812_LUT_4(entry, (v) + 4U),  \
+                                    WS2812_LUT_4(entry, (v) + 8U),   WS2812_LUT_4(entry, (v) + 12U)
+#define WS2812_LUT_64(entry, v)     WS2812_LUT_16(entry, v),         WS2812_LUT_16(entry, (v) + 16U), \
+                                    WS2812_LUT_16(entry, (v) + 32U), WS2812_LUT_16(entry, (v) + 48U)
+#define WS2812_LUT_256(entry)       WS2812_LUT_64(entry, 0U),        WS2812_LUT_64(entry, 64U),       \
+                                    WS2812_LUT_64(entry, 128U),      WS2812_LUT_64(entry, 192U)
+
+/* With a single channel all PWM channels share one value (NRF_PWM_LOAD_COMMON). With more channels every
+ * WS2812 bit takes one nrf_pwm_values_individual_t, so strips of one instance are interleaved in the sequence.
+ */
+#if (DRV_WS2812_CHANNELS_PER_INSTANCE == 1)
+#define PWM_VALUES_PER_BIT          1U
+#define PWM_LOAD_MODE               NRF_PWM_LOAD_COMMON
+#else
+#define PWM_VALUES_PER_BIT          4U
+#define PWM_LOAD_MODE               NRF_PWM_LOAD_INDIVIDUAL
+#endif
+
+#define PWM_VALUES_PER_BYTE         (8U * PWM_VALUES_PER_BIT)
+#define PWM_VALUES_PER_PIXEL        (WS2812_BYTES_PER_PIXEL * PWM_VALUES_PER_BYTE)
+
+#define LED_CHAIN_TOTAL_BYTE_WIDTH  (DRV_WS2812_LED_CHAIN_PIXELS_COUNT_MAX * WS2812_BYTES_PER_PIXEL)
 #define LED_CHAIN_TOTAL_BIT_WIDTH   (LED_CHAIN_TOTAL_BYTE_WIDTH * 8U)
 
-typedef struct
-{
-    uint8_t g;
-    uint8_t r;
-    uint8_t b;
-} rgb_color_t;
-
-/**@brief Led state buffer */
-static rgb_color_t m_led_matrix_buffer[DRV_WS2812_LED_CHAIN_PIXELS_COUNT_MAX];
+NRFX_STATIC_ASSERT((DRV_WS2812_CHANNELS_PER_INSTANCE >= 1) && (DRV_WS2812_CHANNELS_PER_INSTANCE <= 4));
+NRFX_STATIC_ASSERT((DRV_WS2812_PWM_INSTANCES_COUNT >= 1) && (DRV_WS2812_PWM_INSTANCES_COUNT <= 4));
 
-/**@brief PWM module used by the driver */
-static nrfx_pwm_t m_pwm = NRFX_PWM_INSTANCE(DRV_WS2812_PWM_INSTANCE_NO);
+#if DRV_WS2812_STREAMING_ENABLED
+#define STREAM_CHUNK_BIT_WIDTH      (DRV_WS2812_STREAM_CHUNK_PIXELS * WS2812_BYTES_PER_PIXEL * 8U)
+#define STREAM_CHUNK_VALUES         (DRV_WS2812_STREAM_CHUNK_PIXELS * PWM_VALUES_PER_PIXEL)
+#define STREAM_DATA_CHUNKS_COUNT    ((DRV_WS2812_LED_CHAIN_PIXELS_COUNT_MAX + DRV_WS2812_STREAM_CHUNK_PIXELS - 1U) / \
+                                     DRV_WS2812_STREAM_CHUNK_PIXELS)
+/* At least one chunk of low level is appended after data to generate RET code, and the total number of chunks
+ * is rounded up to even, because every playback loop plays both sequences.
+ */
+#define STREAM_CHUNKS_COUNT         ((STREAM_DATA_CHUNKS_COUNT + 2U) & ~1U)
 
-/**@brief Buffer used directly by PWM module to generate DOUT waveform */
-static nrf_pwm_values_common_t pwm_duty_cycle_values[LED_CHAIN_TOTAL_BIT_WIDTH];
+/* Chunk of low level must be long enough to be used as RET code (TReset above 50us) */
+NRFX_STATIC_ASSERT(STREAM_CHUNK_BIT_WIDTH >= 100U);
+#else
+/* Data is followed by a single low value, which is held for the end delay of the sequence to generate RET code.
+ * This way data and RET code are played as one sequence, without CPU involvement in between.
+ */
+#define PWM_SEQUENCE_VALUES         ((DRV_WS2812_LED_CHAIN_PIXELS_COUNT_MAX * PWM_VALUES_PER_PIXEL) + PWM_VALUES_PER_BIT)
+
+/* SEQ[n].CNT register is 15 bits wide */
+NRFX_STATIC_ASSERT(PWM_SEQUENCE_VALUES <= 0x7FFFU);
+#endif
+
+#if DRV_WS2812_HW_KEEPALIVE_ENABLED
+#if DRV_WS2812_STREAMING_ENABLED
+#error "DRV_WS2812_HW_KEEPALIVE_ENABLED is not supported with DRV_WS2812_STREAMING_ENABLED"
+#endif
+#define KEEPALIVE_RTC               NRFX_CONCAT_2(NRF_RTC, DRV_WS2812_HW_KEEPALIVE_RTC_INSTANCE_NO)
+#define KEEPALIVE_RTC_FREQUENCY     32768U
+#define KEEPALIVE_PERIOD_MS_MAX     511999U
+/* Duration of a refresh in RTC ticks (PWM runs at 800 kHz), rounded up, plus one tick for the clear of RTC */
+#define KEEPALIVE_REFRESH_TICKS     (((((PWM_SEQUENCE_VALUES / PWM_VALUES_PER_BIT) + WS2812_RET_CODE_PERIODS) * \
+                                       KEEPALIVE_RTC_FREQUENCY) + 799999U) / 800000U + 1U)
+#endif
 
 typedef enum {
     pwm_sequence_state_idle = 0,
-    pwm_sequence_state_data,
-    pwm_sequence_state_ret_code
+    pwm_sequence_state_data
 } pwm_sequence_state_t;
 
-static volatile pwm_sequence_state_t pwm_sequence_state = pwm_sequence_state_idle;
-static volatile drv_ws2812_refresh_callback_t p_refresh_callback;
-static void * volatile p_refresh_callback_param;
+/**@brief State of a single PWM instance driving up to four strips. */
+typedef struct
+{
+#if DRV_WS2812_STREAMING_ENABLED
+    /**@brief Ping-pong buffers used directly by PWM module to generate DOUT waveform.
+     * While PWM module plays one of them, the other one is refilled with the next chunk of the LED chain.
+     */
+    nrf_pwm_values_common_t       pwm_duty_cycle_values[2][STREAM_CHUNK_VALUES];
+    nrf_pwm_sequence_t            pwm_sequence_stream[2];
+    /* Index of the chunk to be encoded into the buffer which has just been played */
+    size_t                        stream_next_chunk;
+#else
+    /**@brief Buffer used directly by PWM module to generate DOUT waveform */
+    nrf_pwm_values_common_t       pwm_duty_cycle_values[PWM_SEQUENCE_VALUES];
+    nrf_pwm_sequence_t            pwm_sequence_data;
+#endif
+    volatile pwm_sequence_state_t pwm_sequence_state;
+} ws2812_instance_t;
+
+/**@brief PWM modules used by the driver */
+static const nrfx_pwm_t m_pwm[DRV_WS2812_PWM_INSTANCES_COUNT] =
+{
+    NRFX_PWM_INSTANCE(DRV_WS2812_PWM_INSTANCE_NO),
+#if (DRV_WS2812_PWM_INSTANCES_COUNT > 1)
+    NRFX_PWM_INSTANCE(DRV_WS2812_PWM_INSTANCE_NO_1),
+#endif
+#if (DRV_WS2812_PWM_INSTANCES_COUNT > 2)
+    NRFX_PWM_INSTANCE(DRV_WS2812_PWM_INSTANCE_NO_2),
+#endif
+#if (DRV_WS2812_PWM_INSTANCES_COUNT > 3)
+    NRFX_PWM_INSTANCE(DRV_WS2812_PWM_INSTANCE_NO_3),
+#endif
+};
+
+static ws2812_instance_t m_instances[DRV_WS2812_PWM_INSTANCES_COUNT];
+
+/* Number of PWM instances which have not finished the refresh yet */
+static volatile uint8_t m_instances_busy;
 
-/* Structure describing main data sequence */
-static const nrf_pwm_sequence_t pwm_sequence_data =
+#if DRV_WS2812_HW_KEEPALIVE_ENABLED
+/* PPI channels starting the PWM instances on RTC compare event, the first one also clears the RTC */
+static nrf_ppi_channel_t m_keepalive_ppi_channels[DRV_WS2812_PWM_INSTANCES_COUNT];
+static volatile bool     m_keepalive_active;
+/* True while the PPI channels are enabled, so the RTC may start a refresh at any time */
+static volatile bool     m_keepalive_running;
+#endif
+
+#if DRV_WS2812_ENCODE_LUT_NIBBLE
+/**@brief PWM duty cycle values for every nibble value, MSB first. */
+static const nrf_pwm_values_common_t c_pwm_encode_lut[16][4] =
+{
+    WS2812_LUT_16(WS2812_LUT_NIBBLE, 0U)
+};
+#else
+/**@brief PWM duty cycle values for every byte value, MSB first. */
+static const nrf_pwm_values_common_t c_pwm_encode_lut[256][8] =
 {
-    .values.p_common = pwm_duty_cycle_values,
-    .length          = (sizeof(pwm_duty_cycle_values) / sizeof(uint16_t)),
-    .repeats         = 0,
-    .end_delay       = 0
+    WS2812_LUT_256(WS2812_LUT_BYTE)
 };
+#endif
+
+/**@brief Function for encoding a single byte into PWM duty cycle values.
+ *
+ * @param[out] p_dst    Destination, room for 8 bits of @ref PWM_VALUES_PER_BIT values each.
+ * @param[in]  b        Byte to encode.
+ */
+static inline void byte_encode(nrf_pwm_values_common_t * p_dst, uint_fast8_t b)
+{
+    /* Every byte expands to 8 values, MSB first */
+#if (PWM_VALUES_PER_BIT == 1)
+#if DRV_WS2812_ENCODE_LUT_NIBBLE
+    memcpy(p_dst,      c_pwm_encode_lut[b >> 4],   sizeof(c_pwm_encode_lut[0]));
+    memcpy(p_dst + 4U, c_pwm_encode_lut[b & 0x0FU], sizeof(c_pwm_encode_lut[0]));
+#else
+    memcpy(p_dst, c_pwm_encode_lut[b], sizeof(c_pwm_encode_lut[0]));
+#endif
+#else
+#if DRV_WS2812_ENCODE_LUT_NIBBLE
+    nrf_pwm_values_common_t const * p_hi = c_pwm_encode_lut[b >> 4];
+    nrf_pwm_values_common_t const * p_lo = c_pwm_encode_lut[b & 0x0FU];
+    p_dst[0U * PWM_VALUES_PER_BIT] = p_hi[0];
+    p_dst[1U * PWM_VALUES_PER_BIT] = p_hi[1];
+    p_dst[2U * PWM_VALUES_PER_BIT] = p_hi[2];
+    p_dst[3U * PWM_VALUES_PER_BIT] = p_hi[3];
+    p_dst[4U * PWM_VALUES_PER_BIT] = p_lo[0];
+    p_dst[5U * PWM_VALUES_PER_BIT] = p_lo[1];
+    p_dst[6U * PWM_VALUES_PER_BIT] = p_lo[2];
+    p_dst[7U * PWM_VALUES_PER_BIT] = p_lo[3];
+#else
+    nrf_pwm_values_common_t const * p_lut = c_pwm_encode_lut[b];
+    p_dst[0U * PWM_VALUES_PER_BIT] = p_lut[0];
+    p_dst[1U * PWM_VALUES_PER_BIT] = p_lut[1];
+    p_dst[2U * PWM_VALUES_PER_BIT] = p_lut[2];
+    p_dst[3U * PWM_VALUES_PER_BIT] = p_lut[3];
+    p_dst[4U * PWM_VALUES_PER_BIT] = p_lut[4];
+    p_dst[5U * PWM_VALUES_PER_BIT] = p_lut[5];
+    p_dst[6U * PWM_VALUES_PER_BIT] = p_lut[6];
+    p_dst[7U * PWM_VALUES_PER_BIT] = p_lut[7];
+#endif
+#endif
+}
 
-/**@brief Buffer used directly by PWM module to generate DOUT waveform for RET code.
- * @note  Despite content is constant, this buffer is placed in RAM to allow operation also when flash is being written.
+/**@brief Function for encoding pixels of a frame into PWM duty cycle values.
+ *
+ * Bytes of a pixel are stored in the order of transmission, which is selected at compile time by
+ * @ref DRV_WS2812_COLOR_ORDER, so every pixel is encoded by the same straight-line code.
+ *
+ * @param[out] p_dst        Destination buffer, must have room for @ref PWM_VALUES_PER_PIXEL values per pixel.
+ *                          In individual load mode it points to the value of the strip's channel.
+ * @param[in]  p_pixel      First pixel to encode.
+ * @param[in]  pixels_count Number of pixels to encode.
  */
-static nrf_pwm_values_common_t pwm_duty_cycle_ret_code_values[] =
+static void convert_rgb_to_pwm_sequence(nrf_pwm_values_common_t * p_dst,
+                                        rgb_color_t const *       p_pixel,
+                                        size_t                    pixels_count)
 {
-        0x8000
-};
+    rgb_color_t const * p_pixel_end = p_pixel + pixels_count;
+    APP_PROFILER_STAGE_BEGIN(APP_PROFILER_STAGE_WS2812_ENCODE);
+
+    while (p_pixel < p_pixel_end)
+    {
+        uint8_t const * p_bytes = (uint8_t const *)(p_pixel++);
+
+        byte_encode(&p_dst[0U * PWM_VALUES_PER_BYTE], p_bytes[0]);
+        byte_encode(&p_dst[1U * PWM_VALUES_PER_BYTE], p_bytes[1]);
+        byte_encode(&p_dst[2U * PWM_VALUES_PER_BYTE], p_bytes[2]);
+#if DRV_WS2812_RGBW_ENABLED
+        byte_encode(&p_dst[3U * PWM_VALUES_PER_BYTE], p_bytes[3]);
+#endif
+        p_dst += PWM_VALUES_PER_PIXEL;
+    }
 
-static const nrf_pwm_sequence_t pwm_sequence_ret_code =
+    APP_PROFILER_STAGE_END(APP_PROFILER_STAGE_WS2812_ENCODE);
+}
+
+/**@brief Function for getting the number of the first pixel of a strip in the LED state buffer. */
+static size_t strip_first_pixel(size_t instance_no, size_t channel)
 {
-    .values.p_common = pwm_duty_cycle_ret_code_values,
-    .length          = (sizeof(pwm_duty_cycle_ret_code_values) / sizeof(uint16_t)),
-    .repeats         = 0,
-    .end_delay       = 0
-};
+    return ((instance_no * DRV_WS2812_CHANNELS_PER_INSTANCE) + channel) * DRV_WS2812_LED_CHAIN_PIXELS_COUNT_MAX;
+}
 
+#if DRV_WS2812_STREAMING_ENABLED
 
-static void pwm_handler(nrfx_pwm_evt_type_t event_type)
+/**@brief Function for filling one of the ping-pong buffers with the given chunk of the LED chains.
+ *
+ * Chunks past the end of the LED chains are filled with low level, which acts as RET code.
+ *
+ * @param[in]  instance_no  Number of the PWM instance.
+ * @param[out] p_dst        Buffer to fill, @ref STREAM_CHUNK_VALUES values long.
+ * @param[in]  chunk_no     Number of the chunk to encode.
+ */
+static void stream_chunk_fill(size_t instance_no, nrf_pwm_values_common_t * p_dst, size_t chunk_no)
 {
-    if (event_type == NRFX_PWM_EVT_FINISHED)
+    size_t first_pixel  = chunk_no * DRV_WS2812_STREAM_CHUNK_PIXELS;
+    size_t pixels_count = 0U;
+
+    if (first_pixel < DRV_WS2812_LED_CHAIN_PIXELS_COUNT_MAX)
     {
-        if (pwm_sequence_state == pwm_sequence_state_data)
+        pixels_count = DRV_WS2812_LED_CHAIN_PIXELS_COUNT_MAX - first_pixel;
+        if (pixels_count > DRV_WS2812_STREAM_CHUNK_PIXELS)
         {
-            /* After data sequence has been sent, RET code is being sent to cause ws2812 leds apply sent value */
-            pwm_sequence_state = pwm_sequence_state_ret_code;
+            pixels_count = DRV_WS2812_STREAM_CHUNK_PIXELS;
+        }
 
-            /* WS2812 requires that RET code time (TReset) is above 50us. Exact value doesn't seem to work,
-             * thus bigger value was selected: 100 pwm periods gives 125us. Seems enough.
-             */
-            UNUSED_RETURN_VALUE(nrfx_pwm_simple_playback(&m_pwm, &pwm_sequence_ret_code, 100, NRFX_PWM_FLAG_STOP));
+        for (size_t channel = 0U; channel < DRV_WS2812_CHANNELS_PER_INSTANCE; ++channel)
+        {
+            /* Front frame does not change during the refresh */
+            convert_rgb_to_pwm_sequence(p_dst + channel,
+                                        &drv_ws2812_frame_front_get()[strip_first_pixel(instance_no, channel) + first_pixel],
+                                        pixels_count);
         }
-        else if (pwm_sequence_state == pwm_sequence_state_ret_code)
+    }
+
+    for (size_t idx = pixels_count * PWM_VALUES_PER_PIXEL; idx < STREAM_CHUNK_VALUES; ++idx)
+    {
+        p_dst[idx] = WS2812_LOW;
+    }
+}
+
+/**@brief Function for refilling the buffer, which has just been played, with the next chunk.
+ *
+ * @param[in] instance_no   Number of the PWM instance.
+ * @param[in] buffer_no     Number of the ping-pong buffer which has just been played.
+ */
+static void stream_refill(size_t instance_no, uint_fast8_t buffer_no)
+{
+    ws2812_instance_t * p_instance = &m_instances[instance_no];
+
+    if (p_instance->stream_next_chunk < STREAM_CHUNKS_COUNT)
+    {
+        stream_chunk_fill(instance_no, p_instance->pwm_duty_cycle_values[buffer_no], p_instance->stream_next_chunk);
+        p_instance->stream_next_chunk++;
+    }
+}
+
+#endif /* DRV_WS2812_STREAMING_ENABLED */
+
+#if DRV_WS2812_HW_KEEPALIVE_ENABLED
+/**@brief Function for checking if a refresh started by the hardware keepalive may still be in progress. */
+static bool keepalive_refresh_in_progress(void)
+{
+    /* RTC is cleared by the compare event starting the refresh */
+    return m_keepalive_running && (nrf_rtc_counter_get(KEEPALIVE_RTC) < KEEPALIVE_REFRESH_TICKS);
+}
+
+/**@brief Function for letting the RTC start refreshes, after a refresh started by software has finished. */
+static void keepalive_resume(void)
+{
+    /* Compare event may have been missed while PPI was disabled, RTC would not be cleared until it wraps around */
+    if (nrf_rtc_counter_get(KEEPALIVE_RTC) >= nrf_rtc_cc_get(KEEPALIVE_RTC, 0U))
+    {
+        nrf_rtc_task_trigger(KEEPALIVE_RTC, NRF_RTC_TASK_CLEAR);
+    }
+
+    for (size_t instance_no = 0U; instance_no < DRV_WS2812_PWM_INSTANCES_COUNT; ++instance_no)
+    {
+        /* PWM stops after every refresh, which must not wake up the CPU */
+        nrf_pwm_int_disable(m_pwm[instance_no].p_registers, NRF_PWM_INT_STOPPED_MASK);
+        UNUSED_RETURN_VALUE(nrfx_ppi_channel_enable(m_keepalive_ppi_channels[instance_no]));
+    }
+    m_keepalive_running = true;
+}
+
+/**@brief Function for preventing the RTC from starting refreshes, before the PWM sequences are modified.
+ *
+ * No interrupt signals the end of a refresh started by hardware, so the function busy-waits for it. The wait
+ * takes at most one refresh and happens only if the keepalive period elapses just before. The keepalive stays
+ * suspended during refreshes started by software, so nothing is waited for when called from the PWM interrupt.
+ */
+static void keepalive_suspend(void)
+{
+    if (m_keepalive_running)
+    {
+        for (size_t instance_no = 0U; instance_no < DRV_WS2812_PWM_INSTANCES_COUNT; ++instance_no)
         {
-            pwm_sequence_state = pwm_sequence_state_idle;
+            UNUSED_RETURN_VALUE(nrfx_ppi_channel_disable(m_keepalive_ppi_channels[instance_no]));
+        }
 
-            drv_ws2812_refresh_callback_t p_callback;
-            p_callback = p_refresh_callback;
-            if (p_callback != NULL)
-            {
-                /* Note: Function pointed by p_callback may call drv_ws2812_display or drv_ws2812_refresh */
-                p_callback(p_refresh_callback_param);
-            }
+        while (keepalive_refresh_in_progress())
+        {
         }
-        else
+        m_keepalive_running = false;
+    }
+}
+#endif /* DRV_WS2812_HW_KEEPALIVE_ENABLED */
+
+static void refresh_finished(size_t instance_no)
+{
+    m_instances[instance_no].pwm_sequence_state = pwm_sequence_state_idle;
+
+    /* All PWM interrupts have the same priority, so they do not preempt each other here */
+    if (--m_instances_busy == 0U)
+    {
+        /* Starts the frame committed while the LED chain was busy, if there is one */
+        drv_ws2812_frame_refresh_finished();
+
+#if DRV_WS2812_HW_KEEPALIVE_ENABLED
+        if (m_keepalive_active && !drv_ws2812_frame_is_busy())
         {
-            /* Defensive code, should never get here */
-            pwm_sequence_state = pwm_sequence_state_idle;
+            keepalive_resume();
         }
+#endif
     }
 }
 
-static uint32_t pwm_init(uint8_t dout_pin)
+static void pwm_handler(size_t instance_no, nrfx_pwm_evt_type_t event_type)
+{
+    drv_ws2812_frame_interrupt_count();
+
+#if DRV_WS2812_STREAMING_ENABLED
+    switch (event_type)
+    {
+        case NRFX_PWM_EVT_END_SEQ0:
+            /* Sequence 1 is being played now, buffer of sequence 0 can be refilled */
+            stream_refill(instance_no, 0U);
+            break;
+
+        case NRFX_PWM_EVT_END_SEQ1:
+            stream_refill(instance_no, 1U);
+            break;
+
+        case NRFX_PWM_EVT_STOPPED:
+            /* RET code has been sent together with the last chunks */
+            refresh_finished(instance_no);
+            break;
+
+        default:
+            break;
+    }
+#else
+    /* Data and RET code are played as a single sequence, which stops the PWM when done */
+    if ((event_type == NRFX_PWM_EVT_STOPPED) &&
+        (m_instances[instance_no].pwm_sequence_state == pwm_sequence_state_data))
+    {
+        refresh_finished(instance_no);
+    }
+#endif
+}
+
+/* nrfx PWM handlers do not carry a context, so every instance needs its own one */
+static void pwm_handler_0(nrfx_pwm_evt_type_t event_type)
+{
+    pwm_handler(0U, event_type);
+}
+
+#if (DRV_WS2812_PWM_INSTANCES_COUNT > 1)
+static void pwm_handler_1(nrfx_pwm_evt_type_t event_type)
+{
+    pwm_handler(1U, event_type);
+}
+#endif
+
+#if (DRV_WS2812_PWM_INSTANCES_COUNT > 2)
+static void pwm_handler_2(nrfx_pwm_evt_type_t event_type)
+{
+    pwm_handler(2U, event_type);
+}
+#endif
+
+#if (DRV_WS2812_PWM_INSTANCES_COUNT > 3)
+static void pwm_handler_3(nrfx_pwm_evt_type_t event_type)
+{
+    pwm_handler(3U, event_type);
+}
+#endif
+
+static const nrfx_pwm_handler_t m_pwm_handlers[DRV_WS2812_PWM_INSTANCES_COUNT] =
+{
+    pwm_handler_0,
+#if (DRV_WS2812_PWM_INSTANCES_COUNT > 1)
+    pwm_handler_1,
+#endif
+#if (DRV_WS2812_PWM_INSTANCES_COUNT > 2)
+    pwm_handler_2,
+#endif
+#if (DRV_WS2812_PWM_INSTANCES_COUNT > 3)
+    pwm_handler_3,
+#endif
+};
+
+static uint32_t pwm_init(size_t instance_no, uint8_t const * p_dout_pins)
 {
     nrfx_pwm_config_t pwm_config = NRFX_PWM_DEFAULT_CONFIG;
 
+#if (DRV_WS2812_CHANNELS_PER_INSTANCE == 1)
     pwm_config.output_pins[0] = NRFX_PWM_PIN_NOT_USED; 
-    pwm_config.output_pins[1] = dout_pin;
+    pwm_config.output_pins[1] = p_dout_pins[0];
     pwm_config.output_pins[2] = NRFX_PWM_PIN_NOT_USED;
     pwm_config.output_pins[3] = NRFX_PWM_PIN_NOT_USED;
-    pwm_config.load_mode      = NRF_PWM_LOAD_COMMON;
+#else
+    for (size_t channel = 0U; channel < 4U; ++channel)
+    {
+        pwm_config.output_pins[channel] = (channel < DRV_WS2812_CHANNELS_PER_INSTANCE) ?
+                                          p_dout_pins[channel] : NRFX_PWM_PIN_NOT_USED;
+    }
+#endif
+    pwm_config.load_mode      = PWM_LOAD_MODE;
     // WS2812 protocol requires a 800 kHz PWM frequency. PWM Top value = 20 and Base Clock = 16 MHz achieves this
     pwm_config.top_value      = 20;
     pwm_config.base_clock     = NRF_PWM_CLK_16MHz;
     
-    return nrfx_pwm_init(&m_pwm, &pwm_config, pwm_handler);
+    return nrfx_pwm_init(&m_pwm[instance_no], &pwm_config, m_pwm_handlers[instance_no]);
 }
 
-static void make_rgb_color(rgb_color_t *rgb_color, uint32_t color)
+static void instance_init(size_t instance_no)
 {
-    rgb_color->b = (uint8_t)color;
-    color >>= 8;
-    rgb_color->g = (uint8_t)color;
-    color >>= 8;
-    rgb_color->r = (uint8_t)color;
+    ws2812_instance_t * p_instance = &m_instances[instance_no];
+
+#if DRV_WS2812_STREAMING_ENABLED
+    for (size_t buffer_no = 0U; buffer_no < 2U; ++buffer_no)
+    {
+        p_instance->pwm_sequence_stream[buffer_no].values.p_common = p_instance->pwm_duty_cycle_values[buffer_no];
+        p_instance->pwm_sequence_stream[buffer_no].length          = STREAM_CHUNK_VALUES;
+        p_instance->pwm_sequence_stream[buffer_no].repeats         = 0;
+        p_instance->pwm_sequence_stream[buffer_no].end_delay       = 0;
+    }
+#else
+    /* Values of channels without a strip stay at low level */
+    for (size_t idx = 0U; idx < PWM_SEQUENCE_VALUES; ++idx)
+    {
+        p_instance->pwm_duty_cycle_values[idx] = WS2812_LOW;
+    }
+    for (size_t channel = 0U; channel < DRV_WS2812_CHANNELS_PER_INSTANCE; ++channel)
+    {
+        convert_rgb_to_pwm_sequence(&p_instance->pwm_duty_cycle_values[channel],
+                                    &drv_ws2812_frame_front_get()[strip_first_pixel(instance_no, channel)],
+                                    DRV_WS2812_LED_CHAIN_PIXELS_COUNT_MAX);
+    }
+
+    p_instance->pwm_sequence_data.values.p_common = p_instance->pwm_duty_cycle_values;
+    p_instance->pwm_sequence_data.length          = PWM_SEQUENCE_VALUES;
+    p_instance->pwm_sequence_data.repeats         = 0;
+    p_instance->pwm_sequence_data.end_delay       = WS2812_RET_CODE_PERIODS - 1U;
+#endif
+    p_instance->pwm_sequence_state = pwm_sequence_state_idle;
 }
 
-static void convert_rgb_to_pwm_sequence(void)
+uint32_t drv_ws2812_backend_encode(rgb_color_t const * p_frame, size_t const * p_first, size_t const * p_last)
 {
-    uint8_t * ptr = (uint8_t *)m_led_matrix_buffer;
-    size_t    pwm_duty_cycle_idx = 0;
-    size_t    pixel_no;
-
-    for (pixel_no = 0U; pixel_no < LED_CHAIN_TOTAL_BYTE_WIDTH; ++pixel_no)
+    uint32_t encoded_pixels = 0U;
+
+#if DRV_WS2812_HW_KEEPALIVE_ENABLED
+    /* Sequence is re-encoded below, it must not be played by a refresh started by hardware meanwhile */
+    keepalive_suspend();
+#endif
+
+#if DRV_WS2812_STREAMING_ENABLED
+    /* Whole chain is encoded during the refresh anyway */
+    UNUSED_PARAMETER(p_frame);
+    UNUSED_PARAMETER(p_first);
+    UNUSED_PARAMETER(p_last);
+    encoded_pixels = DRV_WS2812_PIXELS_COUNT_TOTAL;
+#else
+    for (size_t strip = 0U; strip < DRV_WS2812_STRIPS_COUNT; ++strip)
     {
-        uint_fast8_t bit;
-        uint_fast8_t b = *(ptr++);
-
-        /* Process bits in byte b, MSB first */
-        for (bit = 0U; bit < 8U; ++bit)
+        if (p_first[strip] <= p_last[strip])
         {
-            uint16_t pwm = WS2812_T0H;
-            if ( (b & 0x80U) != 0U)
-            {
-                pwm = WS2812_T1H;
-            }
-            pwm_duty_cycle_values[pwm_duty_cycle_idx++] = pwm;
-            b <<= 1;
+            size_t instance_no  = strip / DRV_WS2812_CHANNELS_PER_INSTANCE;
+            size_t channel      = strip % DRV_WS2812_CHANNELS_PER_INSTANCE;
+            size_t pixels_count = p_last[strip] - p_first[strip] + 1U;
+
+            convert_rgb_to_pwm_sequence(&m_instances[instance_no].pwm_duty_cycle_values[(p_first[strip] * PWM_VALUES_PER_PIXEL) + channel],
+                                        &p_frame[strip_first_pixel(instance_no, channel) + p_first[strip]],
+                                        pixels_count);
+            encoded_pixels += pixels_count;
         }
     }
-}
+#endif
 
-uint32_t drv_ws2812_init(uint8_t dout_pin)
-{   
-    memset(m_led_matrix_buffer, 0x00, sizeof(m_led_matrix_buffer));
-    convert_rgb_to_pwm_sequence();
-    p_refresh_callback       = NULL;
-    p_refresh_callback_param = NULL;
-    pwm_sequence_state       = pwm_sequence_state_idle;
-    return pwm_init(dout_pin);
+    return encoded_pixels;
 }
 
-uint32_t drv_ws2812_display(drv_ws2812_refresh_callback_t p_callback, void * p_callback_param)
+void drv_ws2812_backend_start(void)
 {
-    uint32_t result = NRF_ERROR_BUSY;
+#if DRV_WS2812_HW_KEEPALIVE_ENABLED
+    keepalive_suspend();
+#endif
+    m_instances_busy = DRV_WS2812_PWM_INSTANCES_COUNT;
 
-    if (pwm_sequence_state == pwm_sequence_state_idle)
+    for (size_t instance_no = 0U; instance_no < DRV_WS2812_PWM_INSTANCES_COUNT; ++instance_no)
     {
-        convert_rgb_to_pwm_sequence();
-        result = drv_ws2812_refresh(p_callback, p_callback_param);
+        ws2812_instance_t * p_instance = &m_instances[instance_no];
+
+        p_instance->pwm_sequence_state = pwm_sequence_state_data;
+#if DRV_WS2812_STREAMING_ENABLED
+        /* Prefill both buffers, following chunks are encoded from pwm_handler on END_SEQ0/END_SEQ1 events */
+        stream_chunk_fill(instance_no, p_instance->pwm_duty_cycle_values[0], 0U);
+        stream_chunk_fill(instance_no, p_instance->pwm_duty_cycle_values[1], 1U);
+        p_instance->stream_next_chunk = 2U;
+        UNUSED_RETURN_VALUE(nrfx_pwm_complex_playback(&m_pwm[instance_no],
+                                                      &p_instance->pwm_sequence_stream[0],
+                                                      &p_instance->pwm_sequence_stream[1],
+                                                      STREAM_CHUNKS_COUNT / 2U,
+                                                      NRFX_PWM_FLAG_SIGNAL_END_SEQ0 |
+                                                      NRFX_PWM_FLAG_SIGNAL_END_SEQ1 |
+                                                      NRFX_PWM_FLAG_NO_EVT_FINISHED |
+                                                      NRFX_PWM_FLAG_STOP));
+#else
+        /* Only the STOPPED interrupt is generated, at the end of RET code */
+        UNUSED_RETURN_VALUE(nrfx_pwm_simple_playback(&m_pwm[instance_no], &p_instance->pwm_sequence_data, 1,
+                                                     NRFX_PWM_FLAG_NO_EVT_FINISHED | NRFX_PWM_FLAG_STOP));
+#endif
     }
-
-    return result;
 }
 
-uint32_t drv_ws2812_refresh(drv_ws2812_refresh_callback_t p_callback, void * p_callback_param)
+uint32_t drv_ws2812_init_multi(uint8_t const * p_dout_pins)
 {
-    uint32_t result = NRF_ERROR_BUSY;
+    uint32_t result = NRF_SUCCESS;
+
+    drv_ws2812_frame_init();
+    m_instances_busy    = 0U;
+#if DRV_WS2812_HW_KEEPALIVE_ENABLED
+    m_keepalive_active  = false;
+    m_keepalive_running = false;
+#endif
 
-    if (pwm_sequence_state == pwm_sequence_state_idle)
+    for (size_t instance_no = 0U; (instance_no < DRV_WS2812_PWM_INSTANCES_COUNT) && (result == NRF_SUCCESS); ++instance_no)
     {
-        pwm_sequence_state = pwm_sequence_state_data;
-        p_refresh_callback = p_callback;
-        p_refresh_callback_param = p_callback_param;
-        UNUSED_RETURN_VALUE(nrfx_pwm_simple_playback(&m_pwm, &pwm_sequence_data, 1, NRFX_PWM_FLAG_STOP));
-        result = NRF_SUCCESS;
+        instance_init(instance_no);
+        result = pwm_init(instance_no, &p_dout_pins[instance_no * DRV_WS2812_CHANNELS_PER_INSTANCE]);
     }
 
     return result;
 }
 
+uint32_t drv_ws2812_init(uint8_t dout_pin)
+{   
+    uint8_t dout_pins[DRV_WS2812_STRIPS_COUNT];
+
+    memset(dout_pins, NRFX_PWM_PIN_NOT_USED, sizeof(dout_pins));
+    dout_pins[0] = dout_pin;
+
+    return drv_ws2812_init_multi(dout_pins);
+}
+
 bool drv_ws2812_is_refreshing(void)
 {
-    return pwm_sequence_state != pwm_sequence_state_idle;
+#if DRV_WS2812_HW_KEEPALIVE_ENABLED
+    return drv_ws2812_frame_is_busy() || keepalive_refresh_in_progress();
+#else
+    return drv_ws2812_frame_is_busy();
+#endif
 }
 
-void drv_ws2812_set_pixel(uint32_t pixel_no, uint32_t color)
+#if DRV_WS2812_HW_KEEPALIVE_ENABLED
+uint32_t drv_ws2812_keepalive_start(uint32_t period_ms)
 {
-    if (pixel_no < DRV_WS2812_LED_CHAIN_PIXELS_COUNT_MAX)
+    size_t             instance_no;
+    drv_ws2812_stats_t stats;
+    uint32_t           period_ticks = (uint32_t)(((uint64_t)period_ms * KEEPALIVE_RTC_FREQUENCY) / 1000U);
+
+    /* Period must be longer than a refresh, so a refresh started by hardware ends before the RTC starts the next one.
+     * The RTC counter tells then whether it is still in progress, see keepalive_suspend.
+     */
+    if ((period_ticks <= KEEPALIVE_REFRESH_TICKS) || (period_ms > KEEPALIVE_PERIOD_MS_MAX))
     {
-        make_rgb_color(&m_led_matrix_buffer[pixel_no], color);
+        return NRF_ERROR_INVALID_PARAM;
     }
+
+    drv_ws2812_keepalive_stop();
+
+    for (instance_no = 0U; instance_no < DRV_WS2812_PWM_INSTANCES_COUNT; ++instance_no)
+    {
+        if (nrfx_ppi_channel_alloc(&m_keepalive_ppi_channels[instance_no]) != NRFX_SUCCESS)
+        {
+            while (instance_no-- > 0U)
+            {
+                UNUSED_RETURN_VALUE(nrfx_ppi_channel_free(m_keepalive_ppi_channels[instance_no]));
+            }
+            return NRF_ERROR_NO_MEM;
+        }
+
+        /* Sequence 1 is started, as nrfx_pwm_simple_playback does for a single playback */
+        UNUSED_RETURN_VALUE(nrfx_ppi_channel_assign(m_keepalive_ppi_channels[instance_no],
+                                                    nrf_rtc_event_address_get(KEEPALIVE_RTC, NRF_RTC_EVENT_COMPARE_0),
+                                                    nrfx_pwm_task_address_get(&m_pwm[instance_no], NRF_PWM_TASK_SEQSTART1)));
+    }
+    UNUSED_RETURN_VALUE(nrfx_ppi_channel_fork_assign(m_keepalive_ppi_channels[0],
+                                                     nrf_rtc_task_address_get(KEEPALIVE_RTC, NRF_RTC_TASK_CLEAR)));
+
+    nrf_rtc_prescaler_set(KEEPALIVE_RTC, 0U);
+    nrf_rtc_cc_set(KEEPALIVE_RTC, 0U, period_ticks - 1U);
+    nrf_rtc_event_enable(KEEPALIVE_RTC, NRF_RTC_INT_COMPARE0_MASK);
+    nrf_rtc_task_trigger(KEEPALIVE_RTC, NRF_RTC_TASK_CLEAR);
+    nrf_rtc_task_trigger(KEEPALIVE_RTC, NRF_RTC_TASK_START);
+
+    m_keepalive_active = true;
+
+    /* PWM sequences are configured by the first refresh, otherwise keepalive starts when it finishes */
+    drv_ws2812_stats_get(&stats);
+    if (!drv_ws2812_frame_is_busy() && (stats.refreshes != 0U))
+    {
+        keepalive_resume();
+    }
+
+    return NRF_SUCCESS;
 }
 
-void drv_ws2812_set_pixel_all(uint32_t color)
+void drv_ws2812_keepalive_stop(void)
 {
-    rgb_color_t rgb_color;
-    make_rgb_color(&rgb_color, color);
-
-    rgb_color_t * p_iter_rgb_color;
-    for (p_iter_rgb_color = &m_led_matrix_buffer[0];
-            p_iter_rgb_color < &m_led_matrix_buffer[DRV_WS2812_LED_CHAIN_PIXELS_COUNT_MAX];
-            ++p_iter_rgb_color)
+    if (m_keepalive_active)
     {
-        *p_iter_rgb_color = rgb_color;
+        /* Cleared first, so the end of a refresh started by software does not resume the keepalive. PPI channels
+         * are disabled and a refresh started by hardware is waited for before they are freed.
+         */
+        m_keepalive_active = false;
+        keepalive_suspend();
+
+        nrf_rtc_task_trigger(KEEPALIVE_RTC, NRF_RTC_TASK_STOP);
+        nrf_rtc_event_disable(KEEPALIVE_RTC, NRF_RTC_INT_COMPARE0_MASK);
+
+        for (size_t instance_no = 0U; instance_no < DRV_WS2812_PWM_INSTANCES_COUNT; ++instance_no)
+        {
+            UNUSED_RETURN_VALUE(nrfx_ppi_channel_free(m_keepalive_ppi_channels[instance_no]));
+        }
     }
 }
+#endif /* DRV_WS2812_HW_KEEPALIVE_ENABLED */
+
+#endif /* !DRV_WS2812_I2S_ENABLED */
@@ -61,15 +61,43 @@ extern "C" {
 
 /**@def DRV_WS2812_LED_CHAIN_PIXELS_COUNT_MAX
  *
- * @brief Maximum number of the WS2812 LEDs in chain supported by the WS2812 driver.
+ * @brief Maximum number of the WS2812 LEDs in chain (in every strip) supported by the WS2812 driver.
  *
  * @note This value has a direct impact on the amount of RAM required by the driver and
  * on the execution time of @ref drv_ws2812_refresh. Use as little RAM as possible.
+ * Without @ref DRV_WS2812_STREAMING_ENABLED the driver needs 57 bytes of RAM per pixel,
+ * with streaming enabled only 9 bytes per pixel (LED state buffer and two committed frames).
+ * With @ref DRV_WS2812_RGBW_ENABLED it is 76 and 12 bytes. With @ref DRV_WS2812_I2S_ENABLED
+ * it is 21 bytes per pixel (28 with RGBW).
  */
 #ifndef DRV_WS2812_LED_CHAIN_PIXELS_COUNT_MAX
 #define DRV_WS2812_LED_CHAIN_PIXELS_COUNT_MAX    (40U)
 #endif
 
+/**@def DRV_WS2812_STREAMING_ENABLED
+ *
+ * @brief Enables streaming of the PWM sequence.
+ *
+ * When enabled, the PWM sequence is not kept for the whole LED chain. Instead, two small buffers
+ * of @ref DRV_WS2812_STREAM_CHUNK_PIXELS pixels each are played alternately and the one not being
+ * played is refilled from the PWM interrupt. RAM used for the PWM sequence does not depend on the
+ * length of the LED chain, at the cost of CPU time spent in the interrupt during the whole refresh.
+ */
+#ifndef DRV_WS2812_STREAMING_ENABLED
+#define DRV_WS2812_STREAMING_ENABLED            0
+#endif
+
+/**@def DRV_WS2812_STREAM_CHUNK_PIXELS
+ *
+ * @brief Number of pixels encoded in a single streaming buffer.
+ *
+ * @note Playing a chunk takes 30 us per pixel, so this value sets the deadline for refilling the buffer
+ * from the PWM interrupt. Must be at least 5, so that a chunk of low level is long enough to be used as RET code.
+ */
+#ifndef DRV_WS2812_STREAM_CHUNK_PIXELS
+#define DRV_WS2812_STREAM_CHUNK_PIXELS          (8U)
+#endif
+
 /**@def DRV_WS2812_PWM_INSTANCE_NO
  *
  * @brief Number of the nrfx PWM instance used by the WS2812 driver.
@@ -82,6 +110,166 @@ extern "C" {
 #define DRV_WS2812_PWM_INSTANCE_NO      0
 #endif
 
+/**@def DRV_WS2812_PWM_INSTANCES_COUNT
+ *
+ * @brief Number of nrfx PWM instances used by the WS2812 driver (1 to 4).
+ *
+ * The first instance is @ref DRV_WS2812_PWM_INSTANCE_NO, the following ones are
+ * @ref DRV_WS2812_PWM_INSTANCE_NO_1, @ref DRV_WS2812_PWM_INSTANCE_NO_2 and @ref DRV_WS2812_PWM_INSTANCE_NO_3.
+ * All instances are refreshed in parallel.
+ */
+#ifndef DRV_WS2812_PWM_INSTANCES_COUNT
+#define DRV_WS2812_PWM_INSTANCES_COUNT  1
+#endif
+
+#ifndef DRV_WS2812_PWM_INSTANCE_NO_1
+#define DRV_WS2812_PWM_INSTANCE_NO_1    1
+#endif
+
+#ifndef DRV_WS2812_PWM_INSTANCE_NO_2
+#define DRV_WS2812_PWM_INSTANCE_NO_2    2
+#endif
+
+#ifndef DRV_WS2812_PWM_INSTANCE_NO_3
+#define DRV_WS2812_PWM_INSTANCE_NO_3    3
+#endif
+
+/**@def DRV_WS2812_CHANNELS_PER_INSTANCE
+ *
+ * @brief Number of independent LED strips driven by every PWM instance (1 to 4).
+ *
+ * With more than one channel, PWM works in individual load mode and the waveforms of all strips are
+ * interleaved in one sequence, so they are refreshed in the time of one strip. This costs 4 times more
+ * RAM for the PWM sequence per pixel, regardless of the number of channels used.
+ */
+#ifndef DRV_WS2812_CHANNELS_PER_INSTANCE
+#define DRV_WS2812_CHANNELS_PER_INSTANCE 1
+#endif
+
+/**@def DRV_WS2812_I2S_ENABLED
+ *
+ * @brief Selects the I2S peripheral instead of PWM for generating the DOUT waveform (drv_ws2812_i2s.c).
+ *
+ * Every WS2812 bit is sent as 4 I2S bits, so the DMA buffer takes 12 bytes per pixel instead of 48.
+ * Only one strip is supported and streaming and hardware keepalive are not available. The I2S peripheral
+ * is used exclusively by the driver, so NRFX_I2S_ENABLED must be 0.
+ */
+#ifndef DRV_WS2812_I2S_ENABLED
+#define DRV_WS2812_I2S_ENABLED                  0
+#endif
+
+/**@def DRV_WS2812_I2S_SCK_PIN
+ *
+ * @brief GPIO pin used as I2S bit clock output. It is required by the peripheral, but must be left unconnected.
+ */
+#ifndef DRV_WS2812_I2S_SCK_PIN
+#define DRV_WS2812_I2S_SCK_PIN                  NRF_GPIO_PIN_MAP(1,10)
+#endif
+
+/**@def DRV_WS2812_I2S_LRCK_PIN
+ *
+ * @brief GPIO pin used as I2S word clock output. It is required by the peripheral, but must be left unconnected.
+ */
+#ifndef DRV_WS2812_I2S_LRCK_PIN
+#define DRV_WS2812_I2S_LRCK_PIN                 NRF_GPIO_PIN_MAP(1,11)
+#endif
+
+/**@def DRV_WS2812_I2S_IRQ_PRIORITY
+ *
+ * @brief Interrupt priority of the I2S peripheral.
+ */
+#ifndef DRV_WS2812_I2S_IRQ_PRIORITY
+#define DRV_WS2812_I2S_IRQ_PRIORITY             6
+#endif
+
+/**@brief Total number of LED strips driven by the WS2812 driver. */
+#if DRV_WS2812_I2S_ENABLED
+#define DRV_WS2812_STRIPS_COUNT         1
+#else
+#define DRV_WS2812_STRIPS_COUNT         (DRV_WS2812_PWM_INSTANCES_COUNT * DRV_WS2812_CHANNELS_PER_INSTANCE)
+#endif
+
+/**@brief Total number of pixels in the LED state buffer. Pixels of strip @c n start at
+ *        @c n * @ref DRV_WS2812_LED_CHAIN_PIXELS_COUNT_MAX.
+ */
+#define DRV_WS2812_PIXELS_COUNT_TOTAL   (DRV_WS2812_STRIPS_COUNT * DRV_WS2812_LED_CHAIN_PIXELS_COUNT_MAX)
+
+/**@def DRV_WS2812_RGBW_ENABLED
+ *
+ * @brief Selects SK6812 RGBW LEDs, which take 32 bits per pixel (green, red, blue, white) instead of 24.
+ *
+ * @note Bit timing is then shortened to fit both WS2812 and SK6812 tolerances.
+ */
+#ifndef DRV_WS2812_RGBW_ENABLED
+#define DRV_WS2812_RGBW_ENABLED                 0
+#endif
+
+/**@brief Byte orders of a pixel supported by @ref DRV_WS2812_COLOR_ORDER. */
+#define DRV_WS2812_COLOR_ORDER_GRB              0
+#define DRV_WS2812_COLOR_ORDER_RGB              1
+#define DRV_WS2812_COLOR_ORDER_BRG              2
+#define DRV_WS2812_COLOR_ORDER_RBG              3
+#define DRV_WS2812_COLOR_ORDER_GBR              4
+#define DRV_WS2812_COLOR_ORDER_BGR              5
+
+/**@def DRV_WS2812_COLOR_ORDER
+ *
+ * @brief Selects the order in which color components of a pixel are sent to the LED chain.
+ *
+ * WS2812B and SK6812 expect GRB, some clones and APA106 expect RGB. With @ref DRV_WS2812_RGBW_ENABLED
+ * the white component is always sent last. The order is fixed at compile time, so the encoder does
+ * not reorder bytes at run time.
+ */
+#ifndef DRV_WS2812_COLOR_ORDER
+#define DRV_WS2812_COLOR_ORDER                  DRV_WS2812_COLOR_ORDER_GRB
+#endif
+
+/**@def DRV_WS2812_ENCODE_LUT_NIBBLE
+ *
+ * @brief Selects the lookup table used for encoding pixels into the PWM sequence.
+ *
+ * When set to 0, a 4 kB table (in flash) expanding a whole byte into 8 PWM values is used.
+ * When set to 1, a 128 byte table expanding a nibble into 4 PWM values is used, at the cost of
+ * a second lookup per byte.
+ */
+#ifndef DRV_WS2812_ENCODE_LUT_NIBBLE
+#define DRV_WS2812_ENCODE_LUT_NIBBLE            0
+#endif
+
+/**@def DRV_WS2812_HW_KEEPALIVE_ENABLED
+ *
+ * @brief Enables refreshing of the LED chain by hardware, see @ref drv_ws2812_keepalive_start.
+ *
+ * An RTC compare event starts playback of the PWM sequence through PPI, so the LED chain is
+ * refreshed periodically without waking up the CPU. Not available with @ref DRV_WS2812_STREAMING_ENABLED,
+ * because streaming needs the CPU to encode chunks during the refresh.
+ */
+#ifndef DRV_WS2812_HW_KEEPALIVE_ENABLED
+#define DRV_WS2812_HW_KEEPALIVE_ENABLED         0
+#endif
+
+/**@def DRV_WS2812_HW_KEEPALIVE_RTC_INSTANCE_NO
+ *
+ * @brief Number of the RTC instance triggering the hardware keepalive refresh.
+ *
+ * The RTC is used exclusively by the driver. RTC1 is used by app_timer and RTC2 by the 802.15.4 radio driver.
+ */
+#ifndef DRV_WS2812_HW_KEEPALIVE_RTC_INSTANCE_NO
+#define DRV_WS2812_HW_KEEPALIVE_RTC_INSTANCE_NO 0
+#endif
+
+/**@brief Driver statistics, see @ref drv_ws2812_stats_get. */
+typedef struct
+{
+    uint32_t frames;                    /**< Number of frames passed to @ref drv_ws2812_display. */
+    uint32_t encoded_pixels;            /**< Total number of pixels encoded into the PWM sequence. */
+    uint32_t last_frame_encoded_pixels; /**< Number of pixels encoded for the last frame. */
+    uint32_t queued_frames;             /**< Number of frames committed while the LED chain was busy. */
+    uint32_t dropped_frames;            /**< Number of frames replaced by a newer one before being sent. */
+    uint32_t refreshes;                 /**< Number of refreshes started by software, see @ref drv_ws2812_refresh. */
+    uint32_t interrupts;                /**< Number of PWM interrupts handled by the driver. */
+} drv_ws2812_stats_t;
+
 /**@brief Typedef of function pointer being called when ws2812 LED chain has just been refreshed.
  *
  * @param p_param   Opaque pointer passed from the application.
@@ -98,18 +286,33 @@ typedef void ( * drv_ws2812_refresh_callback_t)(void * p_param);
  */
 uint32_t drv_ws2812_init(uint8_t dout_pin);
 
+/**@brief Function for initializing the WS2812 LED chain driver with multiple strips.
+ *
+ * @param[in] p_dout_pins   Array of @ref DRV_WS2812_STRIPS_COUNT GPIO pins used as DOUT of the strips.
+ *                          Strip @c n is driven by channel @c n % @ref DRV_WS2812_CHANNELS_PER_INSTANCE of PWM instance
+ *                          @c n / @ref DRV_WS2812_CHANNELS_PER_INSTANCE. Use NRFX_PWM_PIN_NOT_USED for unused strips.
+ *
+ * @retval NRF_SUCCESS     Initialization successful
+ * @retval Other           Error during initialization.
+ */
+uint32_t drv_ws2812_init_multi(uint8_t const * p_dout_pins);
+
 /**@brief Function for sending the LED state buffer to the LED chain. Must be called to update the LED visible state.
  *
- * @param[in] p_callback        Pointer to a function called, when LED chain has been refreshed. This function is
- *                              called within ISR context. Pass NULL if no user function should be called.
+ * The LED state buffer is copied (committed) as a whole, so the application may render the next frame
+ * right after the call. If the LED chain is busy, the frame is sent as soon as the current refresh finishes.
+ * A frame waiting this way is replaced by the next committed one (counted as dropped).
+ *
+ * @param[in] p_callback        Pointer to a function called, when the frame has been sent to the LED chain.
+ *                              This function is called within ISR context. It is not called if the frame is
+ *                              replaced before being sent. Pass NULL if no user function should be called.
  * @param[in] p_callback_param  Opaque pointer passed as a parameter when calling p_callback.
  *                              Meaning of the pointer is completely up to the application.
  *
- * @retval NRF_SUCCESS     Operation performed successfully. Callback (if supplied) will be called.
- * @retval NRF_ERROR_BUSY  Previous refresh has not finished yet.
- * @retval Other           Error when performing the operation.
+ * @retval NRF_SUCCESS     Frame is being sent or waits for the current refresh to finish.
  *
- * @note Calls @ref drv_ws2812_refresh
+ * @note Only pixels changed since the previous call are encoded into the PWM sequence,
+ *       see @ref drv_ws2812_stats_get.
  */
 uint32_t drv_ws2812_display(drv_ws2812_refresh_callback_t p_callback, void * p_callback_param);
 
@@ -133,7 +336,39 @@ uint32_t drv_ws2812_display(drv_ws2812_refresh_callback_t p_callback, void * p_c
  */
 uint32_t drv_ws2812_refresh(drv_ws2812_refresh_callback_t p_callback, void * p_callback_param);
 
+#if DRV_WS2812_HW_KEEPALIVE_ENABLED
+/**@brief Function for starting periodic refresh of the LED chain by hardware.
+ *
+ * The last frame sent by @ref drv_ws2812_display is sent again every period, without any interrupt.
+ * Refreshes started by software suspend the keepalive until they finish. If the keepalive has just started
+ * a refresh, @ref drv_ws2812_display and @ref drv_ws2812_refresh busy-wait until it ends before modifying
+ * the PWM sequence, which takes at most one refresh. Frames queued while the LED chain is busy are started
+ * from the PWM interrupt without waiting.
+ *
+ * @param[in] period_ms     Refresh period in milliseconds, up to 511999. Must be longer than a refresh.
+ *
+ * @retval NRF_SUCCESS              Keepalive started.
+ * @retval NRF_ERROR_INVALID_PARAM  Period out of range.
+ * @retval NRF_ERROR_NO_MEM         No free PPI channel.
+ */
+uint32_t drv_ws2812_keepalive_start(uint32_t period_ms);
+
+/**@brief Function for stopping periodic refresh of the LED chain by hardware.
+ *
+ * A refresh already started by hardware is completed.
+ */
+void drv_ws2812_keepalive_stop(void);
+#endif
+
+/**@brief Function for reading the driver statistics.
+ *
+ * @param[out] p_stats  Pointer to the structure to be filled. Must not be NULL.
+ */
+void drv_ws2812_stats_get(drv_ws2812_stats_t * p_stats);
+
 /**@brief Function for checking if the driver is performing the refresh of the LED chain.
+ *
+ * Refreshes started by the hardware keepalive are also reported.
  *
  * @retval true     Driver is busy with performing the refresh.
  * @retval false    Driver is in the idle state.
@@ -143,10 +378,11 @@ bool drv_ws2812_is_refreshing(void);
 /**@brief Function for setting the specified pixel in the LED state buffer to the specified color.
  *
  * @param[in] pixel_no  Number of the pixel in the LED chain.
- *                      Specify a value in the range from 0 to @ref WS2812_LED_CHAIN_PIXELS_COUNT_MAX-1.
+ *                      Specify a value in the range from 0 to @ref DRV_WS2812_PIXELS_COUNT_TOTAL-1.
  *                      Values out of the range are ignored.
  * @param[in] color     Color to be set. Use the RGB format. Bits 23 to 16 are for the red component,
  *                      bits 15 to 8 are for the green component, and bits 7 to 0 are for the blue component.
+ *                      With @ref DRV_WS2812_RGBW_ENABLED bits 31 to 24 are for the white component.
  *
  * @note Call @ref drv_ws2812_display to update the LED chain from the frame buffer.
  */
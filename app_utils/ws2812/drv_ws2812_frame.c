@@ -0,0 +1,364 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include <nrfx.h>
+
+#include "app_profiler.h"
+#include "drv_ws2812.h"
+#include "drv_ws2812_frame.h"
+
+NRFX_STATIC_ASSERT(sizeof(rgb_color_t) == WS2812_BYTES_PER_PIXEL);
+
+/**@brief Led state buffer written by the application (back buffer), strips one after another */
+static rgb_color_t m_led_matrix_buffer[DRV_WS2812_PIXELS_COUNT_TOTAL];
+
+/**@brief Frames committed by @ref drv_ws2812_display. The front frame is encoded by the backend,
+ *        the pending one waits until the LED chain is idle. Buffers are swapped when the pending frame is started.
+ */
+static rgb_color_t   m_frame_buffers[2][DRV_WS2812_PIXELS_COUNT_TOTAL];
+static rgb_color_t * p_front_frame;
+static rgb_color_t * p_pending_frame;
+/* Pending frame is owned by the thread context while false, and by whoever starts it while true */
+static volatile bool m_frame_pending;
+static drv_ws2812_refresh_callback_t p_pending_callback;
+static void *        p_pending_callback_param;
+
+/**@brief Range of pixels of every strip changed in the back buffer since the last commit,
+ *        empty when m_dirty_first > m_dirty_last */
+static size_t m_dirty_first[DRV_WS2812_STRIPS_COUNT];
+static size_t m_dirty_last[DRV_WS2812_STRIPS_COUNT];
+
+/**@brief Range of pixels of every strip changed by frames committed since the last frame was encoded */
+static size_t m_commit_dirty_first[DRV_WS2812_STRIPS_COUNT];
+static size_t m_commit_dirty_last[DRV_WS2812_STRIPS_COUNT];
+
+#if APP_PROFILER_ENABLED
+/* Profiler clock at commit of the pending frame, and of the frame being sent */
+static uint32_t m_pending_commit_time;
+static uint32_t m_refresh_commit_time;
+static bool     m_refresh_has_frame;
+#endif
+
+/**@brief Driver statistics */
+static drv_ws2812_stats_t m_stats;
+
+/* True from the start of a refresh by software until the backend reports its end */
+static volatile bool m_busy;
+static volatile drv_ws2812_refresh_callback_t p_refresh_callback;
+static void * volatile p_refresh_callback_param;
+
+static void make_rgb_color(rgb_color_t *rgb_color, uint32_t color)
+{
+    rgb_color->b = (uint8_t)color;
+    color >>= 8;
+    rgb_color->g = (uint8_t)color;
+    color >>= 8;
+    rgb_color->r = (uint8_t)color;
+#if DRV_WS2812_RGBW_ENABLED
+    color >>= 8;
+    rgb_color->w = (uint8_t)color;
+#endif
+}
+
+/**@brief Function for marking all pixels of a set of dirty ranges as unchanged.
+ *
+ * @param[out] p_first  First changed pixel of every strip.
+ * @param[out] p_last   Last changed pixel of every strip.
+ */
+static void dirty_range_clear(size_t * p_first, size_t * p_last)
+{
+    for (size_t strip = 0U; strip < DRV_WS2812_STRIPS_COUNT; ++strip)
+    {
+        p_first[strip] = DRV_WS2812_LED_CHAIN_PIXELS_COUNT_MAX;
+        p_last[strip]  = 0U;
+    }
+}
+
+/**@brief Function for writing a color to the LED state buffer, extending the dirty range if it changes the pixel.
+ *
+ * @param[in] pixel_no      Number of the pixel in the LED state buffer. Must be in range.
+ * @param[in] p_rgb_color   Color to be written.
+ */
+static void pixel_write(size_t pixel_no, rgb_color_t const * p_rgb_color)
+{
+    rgb_color_t * p_pixel = &m_led_matrix_buffer[pixel_no];
+
+    if (memcmp(p_pixel, p_rgb_color, sizeof(rgb_color_t)) != 0)
+    {
+        size_t strip          = pixel_no / DRV_WS2812_LED_CHAIN_PIXELS_COUNT_MAX;
+        size_t pixel_in_strip = pixel_no % DRV_WS2812_LED_CHAIN_PIXELS_COUNT_MAX;
+
+        *p_pixel = *p_rgb_color;
+
+        if (pixel_in_strip < m_dirty_first[strip])
+        {
+            m_dirty_first[strip] = pixel_in_strip;
+        }
+        if (pixel_in_strip > m_dirty_last[strip])
+        {
+            m_dirty_last[strip] = pixel_in_strip;
+        }
+    }
+}
+
+/**@brief Function for starting the refresh of the LED chain. Caller must have set m_busy.
+ *
+ * @param[in] p_callback        Function called when the refresh has finished, may be NULL.
+ * @param[in] p_callback_param  Parameter passed to p_callback.
+ */
+static void refresh_start(drv_ws2812_refresh_callback_t p_callback, void * p_callback_param)
+{
+    p_refresh_callback       = p_callback;
+    p_refresh_callback_param = p_callback_param;
+
+    drv_ws2812_backend_start();
+    m_stats.refreshes++;
+}
+
+/**@brief Function for copying the back buffer to the pending frame.
+ *
+ * If the previous pending frame has not been started yet, it is replaced (latest wins).
+ *
+ * @param[in] p_callback        Function called when the frame has been sent, may be NULL.
+ * @param[in] p_callback_param  Parameter passed to p_callback.
+ */
+static void frame_commit(drv_ws2812_refresh_callback_t p_callback, void * p_callback_param)
+{
+    bool replaced;
+
+    /* Take the pending frame back, so it is not started while being written */
+    NRFX_CRITICAL_SECTION_ENTER();
+    replaced        = m_frame_pending;
+    m_frame_pending = false;
+    NRFX_CRITICAL_SECTION_EXIT();
+
+    if (replaced)
+    {
+        m_stats.dropped_frames++;
+    }
+
+    memcpy(p_pending_frame, m_led_matrix_buffer, sizeof(m_led_matrix_buffer));
+    for (size_t strip = 0U; strip < DRV_WS2812_STRIPS_COUNT; ++strip)
+    {
+        if (m_dirty_first[strip] < m_commit_dirty_first[strip])
+        {
+            m_commit_dirty_first[strip] = m_dirty_first[strip];
+        }
+        if (m_dirty_last[strip] > m_commit_dirty_last[strip])
+        {
+            m_commit_dirty_last[strip] = m_dirty_last[strip];
+        }
+    }
+    dirty_range_clear(m_dirty_first, m_dirty_last);
+
+    p_pending_callback       = p_callback;
+    p_pending_callback_param = p_callback_param;
+#if APP_PROFILER_ENABLED
+    m_pending_commit_time    = APP_PROFILER_CLOCK_GET();
+#endif
+    m_stats.frames++;
+
+    m_frame_pending = true;
+}
+
+/**@brief Function for starting the refresh with the pending frame, if there is one and the LED chain is idle.
+ *
+ * Called from thread context on commit, and from the interrupt of the backend when the previous refresh has finished.
+ *
+ * @retval true     Refresh with the pending frame has been started.
+ * @retval false    No frame is pending or the LED chain is busy.
+ */
+static bool pending_frame_start(void)
+{
+    bool start;
+
+    NRFX_CRITICAL_SECTION_ENTER();
+    start = m_frame_pending && !m_busy;
+    if (start)
+    {
+        m_frame_pending = false;
+        m_busy          = true;
+    }
+    NRFX_CRITICAL_SECTION_EXIT();
+
+    if (start)
+    {
+        rgb_color_t * p_frame = p_front_frame;
+        uint32_t      encoded_pixels;
+
+        p_front_frame   = p_pending_frame;
+        p_pending_frame = p_frame;
+
+        /* Only pixels changed by frames committed since the previous encoding */
+        encoded_pixels = drv_ws2812_backend_encode(p_front_frame, m_commit_dirty_first, m_commit_dirty_last);
+        dirty_range_clear(m_commit_dirty_first, m_commit_dirty_last);
+        m_stats.encoded_pixels += encoded_pixels;
+        m_stats.last_frame_encoded_pixels = encoded_pixels;
+
+#if APP_PROFILER_ENABLED
+        m_refresh_commit_time = m_pending_commit_time;
+        m_refresh_has_frame   = true;
+#endif
+        refresh_start(p_pending_callback, p_pending_callback_param);
+    }
+
+    return start;
+}
+
+void drv_ws2812_frame_init(void)
+{
+    memset(m_led_matrix_buffer, 0x00, sizeof(m_led_matrix_buffer));
+    memset(m_frame_buffers, 0x00, sizeof(m_frame_buffers));
+    p_front_frame   = m_frame_buffers[0];
+    p_pending_frame = m_frame_buffers[1];
+    m_frame_pending = false;
+    dirty_range_clear(m_dirty_first, m_dirty_last);
+    dirty_range_clear(m_commit_dirty_first, m_commit_dirty_last);
+    memset(&m_stats, 0x00, sizeof(m_stats));
+    p_refresh_callback       = NULL;
+    p_refresh_callback_param = NULL;
+    m_busy                   = false;
+}
+
+rgb_color_t const * drv_ws2812_frame_front_get(void)
+{
+    return p_front_frame;
+}
+
+bool drv_ws2812_frame_is_busy(void)
+{
+    return m_busy;
+}
+
+void drv_ws2812_frame_refresh_finished(void)
+{
+    drv_ws2812_refresh_callback_t p_callback;
+
+    m_busy = false;
+
+#if APP_PROFILER_ENABLED
+    if (m_refresh_has_frame)
+    {
+        app_profiler_record(APP_PROFILER_STAGE_WS2812_LATENCY, APP_PROFILER_CLOCK_GET() - m_refresh_commit_time);
+    }
+#endif
+    p_callback = p_refresh_callback;
+    if (p_callback != NULL)
+    {
+        /* Note: Function pointed by p_callback may call drv_ws2812_display or drv_ws2812_refresh */
+        p_callback(p_refresh_callback_param);
+    }
+
+    /* Frame committed while the LED chain was busy is sent right away */
+    UNUSED_RETURN_VALUE(pending_frame_start());
+}
+
+void drv_ws2812_frame_interrupt_count(void)
+{
+    m_stats.interrupts++;
+}
+
+uint32_t drv_ws2812_display(drv_ws2812_refresh_callback_t p_callback, void * p_callback_param)
+{
+    frame_commit(p_callback, p_callback_param);
+
+    if (!pending_frame_start())
+    {
+        /* Started from the interrupt of the backend when the current refresh finishes */
+        m_stats.queued_frames++;
+    }
+
+    return NRF_SUCCESS;
+}
+
+uint32_t drv_ws2812_refresh(drv_ws2812_refresh_callback_t p_callback, void * p_callback_param)
+{
+    uint32_t result = NRF_ERROR_BUSY;
+
+    NRFX_CRITICAL_SECTION_ENTER();
+    if (!m_busy)
+    {
+        m_busy = true;
+        result = NRF_SUCCESS;
+    }
+    NRFX_CRITICAL_SECTION_EXIT();
+
+    if (result == NRF_SUCCESS)
+    {
+#if APP_PROFILER_ENABLED
+        m_refresh_has_frame = false;
+#endif
+        refresh_start(p_callback, p_callback_param);
+    }
+
+    return result;
+}
+
+void drv_ws2812_set_pixel(uint32_t pixel_no, uint32_t color)
+{
+    if (pixel_no < DRV_WS2812_PIXELS_COUNT_TOTAL)
+    {
+        rgb_color_t rgb_color;
+        make_rgb_color(&rgb_color, color);
+        pixel_write(pixel_no, &rgb_color);
+    }
+}
+
+void drv_ws2812_set_pixel_all(uint32_t color)
+{
+    rgb_color_t rgb_color;
+    make_rgb_color(&rgb_color, color);
+
+    size_t pixel_no;
+    for (pixel_no = 0U; pixel_no < DRV_WS2812_PIXELS_COUNT_TOTAL; ++pixel_no)
+    {
+        pixel_write(pixel_no, &rgb_color);
+    }
+}
+
+void drv_ws2812_stats_get(drv_ws2812_stats_t * p_stats)
+{
+    *p_stats = m_stats;
+}
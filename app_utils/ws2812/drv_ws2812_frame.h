@@ -0,0 +1,164 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @{
+ * @ingroup zigbee_examples
+ * @brief   Frame layer of the WS2812 LED chain driver, shared by the PWM (drv_ws2812.c) and I2S (drv_ws2812_i2s.c)
+ *          backends.
+ *
+ * The frame layer keeps the LED state buffer written by the application, commits it to the frame waiting for the
+ * LED chain, tracks which pixels have changed, and starts a refresh as soon as the LED chain is idle. It implements
+ * @ref drv_ws2812_display, @ref drv_ws2812_refresh, @ref drv_ws2812_set_pixel, @ref drv_ws2812_set_pixel_all and
+ * @ref drv_ws2812_stats_get. The backend generates the waveform: it implements @ref drv_ws2812_backend_encode and
+ * @ref drv_ws2812_backend_start, and reports the end of every refresh with @ref drv_ws2812_frame_refresh_finished.
+ *
+ * @note This header is internal to the driver.
+ */
+
+#ifndef DRV_WS2812_FRAME_H__
+#define DRV_WS2812_FRAME_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "drv_ws2812.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if DRV_WS2812_RGBW_ENABLED
+#define WS2812_BYTES_PER_PIXEL      4U
+#else
+#define WS2812_BYTES_PER_PIXEL      3U
+#endif
+
+/**@brief Pixel in the order of bytes sent to the LED, white (if present) always goes last. */
+typedef struct
+{
+#if (DRV_WS2812_COLOR_ORDER == DRV_WS2812_COLOR_ORDER_GRB)
+    uint8_t g;
+    uint8_t r;
+    uint8_t b;
+#elif (DRV_WS2812_COLOR_ORDER == DRV_WS2812_COLOR_ORDER_RGB)
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+#elif (DRV_WS2812_COLOR_ORDER == DRV_WS2812_COLOR_ORDER_BRG)
+    uint8_t b;
+    uint8_t r;
+    uint8_t g;
+#elif (DRV_WS2812_COLOR_ORDER == DRV_WS2812_COLOR_ORDER_RBG)
+    uint8_t r;
+    uint8_t b;
+    uint8_t g;
+#elif (DRV_WS2812_COLOR_ORDER == DRV_WS2812_COLOR_ORDER_GBR)
+    uint8_t g;
+    uint8_t b;
+    uint8_t r;
+#elif (DRV_WS2812_COLOR_ORDER == DRV_WS2812_COLOR_ORDER_BGR)
+    uint8_t b;
+    uint8_t g;
+    uint8_t r;
+#else
+#error "Unsupported DRV_WS2812_COLOR_ORDER"
+#endif
+#if DRV_WS2812_RGBW_ENABLED
+    uint8_t w;
+#endif
+} rgb_color_t;
+
+/**@brief Function for bringing the waveform buffer of the backend in line with a frame about to be sent.
+ *
+ * Implemented by the backend. Called with the LED chain idle, from thread context on commit or from the interrupt
+ * of the backend when the previous refresh has finished.
+ *
+ * @param[in] p_frame   Frame to be sent, @ref DRV_WS2812_PIXELS_COUNT_TOTAL pixels, strips one after another.
+ *                      It does not change until the next call.
+ * @param[in] p_first   First pixel of every strip changed since the previous call.
+ * @param[in] p_last    Last pixel of every strip changed since the previous call. A strip is unchanged when its
+ *                      first pixel is above the last one.
+ *
+ * @return Number of pixels encoded.
+ */
+uint32_t drv_ws2812_backend_encode(rgb_color_t const * p_frame, size_t const * p_first, size_t const * p_last);
+
+/**@brief Function for starting the refresh of the LED chain with the waveform buffer.
+ *
+ * Implemented by the backend. The frame layer has marked the LED chain busy before the call. The backend must call
+ * @ref drv_ws2812_frame_refresh_finished when the refresh, including RET code, has finished.
+ */
+void drv_ws2812_backend_start(void);
+
+/**@brief Function for initializing the frame layer. All pixels are black, no frame is pending.
+ *
+ * Must be called by the initialization of the backend, before the front frame is encoded.
+ */
+void drv_ws2812_frame_init(void);
+
+/**@brief Function for getting the frame sent by the last refresh, or being sent.
+ *
+ * @return Frame of @ref DRV_WS2812_PIXELS_COUNT_TOTAL pixels, which does not change while the LED chain is busy.
+ */
+rgb_color_t const * drv_ws2812_frame_front_get(void);
+
+/**@brief Function for checking if a refresh started by software has not finished yet. */
+bool drv_ws2812_frame_is_busy(void);
+
+/**@brief Function for marking the LED chain idle, calling the refresh callback and starting the pending frame.
+ *
+ * Called by the backend from its interrupt. The pending frame is encoded and started from within the call.
+ */
+void drv_ws2812_frame_refresh_finished(void);
+
+/**@brief Function for counting an interrupt of the backend in the driver statistics. */
+void drv_ws2812_frame_interrupt_count(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DRV_WS2812_FRAME_H__
+
+/**
+ * @}
+ */
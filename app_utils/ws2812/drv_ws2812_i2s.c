@@ -0,0 +1,248 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include <nrfx.h>
+#include <hal/nrf_gpio.h>
+
+#include "app_profiler.h"
+#include "drv_ws2812.h"
+#include "drv_ws2812_frame.h"
+
+#if DRV_WS2812_I2S_ENABLED
+#include <hal/nrf_i2s.h>
+
+#if DRV_WS2812_STREAMING_ENABLED
+#error "DRV_WS2812_I2S_ENABLED is not supported with DRV_WS2812_STREAMING_ENABLED"
+#endif
+#if DRV_WS2812_HW_KEEPALIVE_ENABLED
+#error "DRV_WS2812_I2S_ENABLED is not supported with DRV_WS2812_HW_KEEPALIVE_ENABLED"
+#endif
+/* The driver restarts transfers from I2S_IRQHandler, which nrfx_i2s does not allow from its data handler */
+#if NRFX_I2S_ENABLED
+#error "NRFX_I2S_ENABLED must be 0, the I2S peripheral is used exclusively by the WS2812 driver"
+#endif
+
+/* With MCK of 3.2 MHz and ratio 32X, SCK is 3.2 MHz, so every WS2812 bit (1.25 us) takes 4 I2S bits.
+ * High level lasts 312 ns for 0 and 937 ns for 1. SK6812 requires T1H of 0.6 us +- 0.15 us, so 625 ns is used.
+ */
+#if DRV_WS2812_RGBW_ENABLED
+#define WS2812_I2S_T1               0xCU
+#else
+#define WS2812_I2S_T1               0xEU
+#endif
+#define WS2812_I2S_T0               0x8U
+
+/* Every 16-bit sample carries one nibble, so every 32-bit word (left and right sample) carries one byte
+ * and lasts 10 us. RET code (TReset above 50us) of 13 words gives 130 us.
+ */
+#define I2S_RET_CODE_WORDS          13U
+#define I2S_BUFFER_WORDS            (I2S_RET_CODE_WORDS + (DRV_WS2812_LED_CHAIN_PIXELS_COUNT_MAX * WS2812_BYTES_PER_PIXEL))
+
+/* RXTXD.MAXCNT register is 14 bits wide */
+NRFX_STATIC_ASSERT(I2S_BUFFER_WORDS <= 0x3FFFU);
+
+/* Helpers for generating the encoding lookup table at compile time */
+#define WS2812_I2S_BIT(v, n)        ((((v) >> (n)) & 1U) ? WS2812_I2S_T1 : WS2812_I2S_T0)
+#define WS2812_I2S_NIBBLE(v)        (uint16_t)((WS2812_I2S_BIT(v, 3U) << 12) | (WS2812_I2S_BIT(v, 2U) << 8) | \
+                                               (WS2812_I2S_BIT(v, 1U) << 4)  | WS2812_I2S_BIT(v, 0U))
+#define WS2812_I2S_LUT_4(v)         WS2812_I2S_NIBBLE(v),        WS2812_I2S_NIBBLE((v) + 1U), \
+                                    WS2812_I2S_NIBBLE((v) + 2U), WS2812_I2S_NIBBLE((v) + 3U)
+
+/**@brief Buffer used directly by I2S module to generate DOUT waveform: RET code followed by the LED chain */
+static uint32_t m_i2s_buffer[I2S_BUFFER_WORDS];
+
+/* Number of TXPTRUPD events since the start of the transfer */
+static uint8_t m_tx_ptr_updates;
+
+/**@brief I2S samples for every nibble value, MSB first. */
+static const uint16_t c_i2s_encode_lut[16] =
+{
+    WS2812_I2S_LUT_4(0U), WS2812_I2S_LUT_4(4U), WS2812_I2S_LUT_4(8U), WS2812_I2S_LUT_4(12U)
+};
+
+/**@brief Function for encoding a single byte into an I2S word.
+ *
+ * Left sample is stored in the lower half-word and sent first, so it carries the upper nibble.
+ */
+static inline uint32_t byte_encode(uint_fast8_t b)
+{
+    return (uint32_t)c_i2s_encode_lut[b >> 4] | ((uint32_t)c_i2s_encode_lut[b & 0x0FU] << 16);
+}
+
+/**@brief Function for encoding pixels of a frame into the I2S buffer.
+ *
+ * @param[in]  p_frame      Frame to encode.
+ * @param[in]  first_pixel  Number of the first pixel to encode.
+ * @param[in]  pixels_count Number of pixels to encode.
+ */
+static void convert_rgb_to_i2s_words(rgb_color_t const * p_frame, size_t first_pixel, size_t pixels_count)
+{
+    rgb_color_t const * p_pixel     = &p_frame[first_pixel];
+    rgb_color_t const * p_pixel_end = p_pixel + pixels_count;
+    uint32_t          * p_dst       = &m_i2s_buffer[I2S_RET_CODE_WORDS + (first_pixel * WS2812_BYTES_PER_PIXEL)];
+    APP_PROFILER_STAGE_BEGIN(APP_PROFILER_STAGE_WS2812_ENCODE);
+
+    while (p_pixel < p_pixel_end)
+    {
+        uint8_t const * p_bytes = (uint8_t const *)(p_pixel++);
+
+        p_dst[0] = byte_encode(p_bytes[0]);
+        p_dst[1] = byte_encode(p_bytes[1]);
+        p_dst[2] = byte_encode(p_bytes[2]);
+#if DRV_WS2812_RGBW_ENABLED
+        p_dst[3] = byte_encode(p_bytes[3]);
+#endif
+        p_dst += WS2812_BYTES_PER_PIXEL;
+    }
+
+    APP_PROFILER_STAGE_END(APP_PROFILER_STAGE_WS2812_ENCODE);
+}
+
+uint32_t drv_ws2812_backend_encode(rgb_color_t const * p_frame, size_t const * p_first, size_t const * p_last)
+{
+    uint32_t encoded_pixels = 0U;
+
+    /* I2S buffer is not read while the LED chain is idle */
+    if (p_first[0] <= p_last[0])
+    {
+        encoded_pixels = p_last[0] - p_first[0] + 1U;
+        convert_rgb_to_i2s_words(p_frame, p_first[0], encoded_pixels);
+    }
+
+    return encoded_pixels;
+}
+
+void drv_ws2812_backend_start(void)
+{
+    m_tx_ptr_updates = 0U;
+
+    nrf_i2s_event_clear(NRF_I2S, NRF_I2S_EVENT_TXPTRUPD);
+    nrf_i2s_event_clear(NRF_I2S, NRF_I2S_EVENT_STOPPED);
+    nrf_i2s_enable(NRF_I2S);
+    /* TXD.PTR is not changed during the transfer, so the buffer is played again after it ends */
+    nrf_i2s_transfer_set(NRF_I2S, I2S_BUFFER_WORDS, NULL, m_i2s_buffer);
+    nrf_i2s_int_enable(NRF_I2S, NRF_I2S_INT_TXPTRUPD_MASK | NRF_I2S_INT_STOPPED_MASK);
+    nrf_i2s_task_trigger(NRF_I2S, NRF_I2S_TASK_START);
+}
+
+void I2S_IRQHandler(void)
+{
+    drv_ws2812_frame_interrupt_count();
+
+    if (nrf_i2s_event_check(NRF_I2S, NRF_I2S_EVENT_TXPTRUPD))
+    {
+        nrf_i2s_event_clear(NRF_I2S, NRF_I2S_EVENT_TXPTRUPD);
+
+        /* The first event comes when the buffer is taken at start, the second one when it is taken again
+         * after the LED chain has been sent. I2S is stopped then, during the RET code leading the buffer.
+         * If the interrupt is delayed past the RET code, the beginning of the same frame is sent again.
+         */
+        if (++m_tx_ptr_updates >= 2U)
+        {
+            nrf_i2s_int_disable(NRF_I2S, NRF_I2S_INT_TXPTRUPD_MASK);
+            nrf_i2s_task_trigger(NRF_I2S, NRF_I2S_TASK_STOP);
+        }
+    }
+
+    if (nrf_i2s_event_check(NRF_I2S, NRF_I2S_EVENT_STOPPED))
+    {
+        nrf_i2s_event_clear(NRF_I2S, NRF_I2S_EVENT_STOPPED);
+        nrf_i2s_int_disable(NRF_I2S, NRF_I2S_INT_STOPPED_MASK);
+        /* DOUT is driven low by GPIO while I2S is disabled */
+        nrf_i2s_disable(NRF_I2S);
+        /* Starts the frame committed while the LED chain was busy, if there is one */
+        drv_ws2812_frame_refresh_finished();
+    }
+}
+
+uint32_t drv_ws2812_init_multi(uint8_t const * p_dout_pins)
+{
+    drv_ws2812_frame_init();
+
+    /* RET code is never overwritten, pixels start black */
+    memset(m_i2s_buffer, 0x00, sizeof(m_i2s_buffer));
+    convert_rgb_to_i2s_words(drv_ws2812_frame_front_get(), 0U, DRV_WS2812_PIXELS_COUNT_TOTAL);
+
+    nrf_gpio_pin_clear(p_dout_pins[0]);
+    nrf_gpio_cfg_output(p_dout_pins[0]);
+    nrf_gpio_cfg_output(DRV_WS2812_I2S_SCK_PIN);
+    nrf_gpio_cfg_output(DRV_WS2812_I2S_LRCK_PIN);
+
+    // WS2812 protocol requires 800 kHz bit rate. 4 I2S bits per WS2812 bit give SCK = MCK = 3.2 MHz
+    if (!nrf_i2s_configure(NRF_I2S,
+                           NRF_I2S_MODE_MASTER,
+                           NRF_I2S_FORMAT_ALIGNED,
+                           NRF_I2S_ALIGN_LEFT,
+                           NRF_I2S_SWIDTH_16BIT,
+                           NRF_I2S_CHANNELS_STEREO,
+                           NRF_I2S_MCK_32MDIV10,
+                           NRF_I2S_RATIO_32X))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+    nrf_i2s_pins_set(NRF_I2S,
+                     DRV_WS2812_I2S_SCK_PIN,
+                     DRV_WS2812_I2S_LRCK_PIN,
+                     NRF_I2S_PIN_NOT_CONNECTED,
+                     p_dout_pins[0],
+                     NRF_I2S_PIN_NOT_CONNECTED);
+
+    NRFX_IRQ_PRIORITY_SET(I2S_IRQn, DRV_WS2812_I2S_IRQ_PRIORITY);
+    NRFX_IRQ_ENABLE(I2S_IRQn);
+
+    return NRF_SUCCESS;
+}
+
+uint32_t drv_ws2812_init(uint8_t dout_pin)
+{
+    return drv_ws2812_init_multi(&dout_pin);
+}
+
+bool drv_ws2812_is_refreshing(void)
+{
+    return drv_ws2812_frame_is_busy();
+}
+
+#endif /* DRV_WS2812_I2S_ENABLED */
@@ -0,0 +1,406 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @defgroup zigbee_examples_ble_zigbee_color_light_bulb_thingy color_conv.c
+ * @{
+ * @ingroup zigbee_examples
+ */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "app_profiler.h"
+#include "color_conv.h"
+
+#define HSB_SATURATION_MAX      254U    /**< Saturation value meaning fully saturated color. */
+#define HSB_HUE_SECTOR_WIDTH    127U    /**< Width of a 120 degree part of the color wheel, in hue units divided by 3. */
+#define HSB_HUE_CIRCLE          254U    /**< Hue value equal to hue 0 after going around the color wheel. */
+
+#define XY_COORD_ONE            65536   /**< Chromaticity coordinate equal to 1. */
+#define CIE_Y_LINEAR_MAX_Q16    580U    /**< Relative luminance 0.008856, below which CIE 1976 lightness is linear. */
+
+#define CT_TABLE_MIREDS_FIRST   152U    /**< Color temperature of the first entry of c_ct_rgb_table, in mireds. */
+#define CT_TABLE_MIREDS_STEP    8U      /**< Difference of color temperature between consecutive entries, in mireds. */
+
+/* White along the Planckian locus, every CT_TABLE_MIREDS_STEP mireds starting from CT_TABLE_MIREDS_FIRST.
+ * Generated offline: chromaticity from the cubic approximation of Kim et al., converted as color_conv_xy_to_rgb
+ * does with the default WS2812B primaries and D65 white point (see LIGHT_PRIMARY_* in zigbee_color_light.c).
+ */
+static const uint8_t c_ct_rgb_table[][3] =
+{
+    {253, 249, 255}, {255, 250, 251}, {255, 249, 245}, {255, 248, 239},  /* 152 - 176 */
+    {255, 246, 233}, {255, 245, 227}, {255, 243, 221}, {255, 242, 216},  /* 184 - 208 */
+    {255, 240, 210}, {255, 239, 204}, {255, 237, 199}, {255, 236, 194},  /* 216 - 240 */
+    {255, 234, 188}, {255, 232, 183}, {255, 231, 178}, {255, 229, 173},  /* 248 - 272 */
+    {255, 228, 168}, {255, 226, 163}, {255, 224, 158}, {255, 223, 153},  /* 280 - 304 */
+    {255, 221, 149}, {255, 219, 144}, {255, 218, 140}, {255, 216, 136},  /* 312 - 336 */
+    {255, 215, 131}, {255, 213, 127}, {255, 211, 123}, {255, 210, 119},  /* 344 - 368 */
+    {255, 208, 115}, {255, 206, 111}, {255, 205, 107}, {255, 203, 103},  /* 376 - 400 */
+    {255, 202,  99}, {255, 200,  95}, {255, 198,  91}, {255, 197,  87},  /* 408 - 432 */
+    {255, 195,  83}, {255, 194,  80}, {255, 192,  76}, {255, 190,  72},  /* 440 - 464 */
+    {255, 189,  68}, {255, 187,  64}, {255, 186,  61}, {255, 184,  57},  /* 472 - 496 */
+    {255, 183,  53},                                                      /* 504 */
+};
+
+uint32_t color_conv_hsb_to_rgb(uint8_t hue, uint8_t saturation, uint8_t brightness)
+{
+    uint32_t sector_pos;
+    int32_t  x_weight;
+    int32_t  x;
+    int32_t  m;
+    uint32_t c;
+    uint32_t r;
+    uint32_t g;
+    uint32_t b;
+    APP_PROFILER_STAGE_BEGIN(APP_PROFILER_STAGE_HSB_TO_RGB);
+
+    /* Position within the current 120 degree part of the color wheel, folded to a triangle of height
+     * HSB_HUE_SECTOR_WIDTH: x_weight / HSB_HUE_SECTOR_WIDTH is 1 - |(hue * 6 / 254) mod 2 - 1|.
+     */
+    sector_pos = (3U * hue) % (2U * HSB_HUE_SECTOR_WIDTH);
+    x_weight   = (int32_t)HSB_HUE_SECTOR_WIDTH -
+                 ((sector_pos > HSB_HUE_SECTOR_WIDTH) ? (int32_t)(sector_pos - HSB_HUE_SECTOR_WIDTH)
+                                                      : (int32_t)(HSB_HUE_SECTOR_WIDTH - sector_pos));
+
+    /* With chroma C = brightness * saturation / 254 and m = brightness - C, the components are:
+     * C + m = brightness,
+     * X + m = brightness * (saturation * x_weight + 127 * (254 - saturation)) / (254 * 127),
+     * m     = brightness * (254 - saturation) / 254.
+     * Saturation above 254 makes m slightly negative, such results are clamped to 0.
+     */
+    c = brightness;
+    x = (int32_t)brightness * ((int32_t)saturation * x_weight +
+                               (int32_t)HSB_HUE_SECTOR_WIDTH * ((int32_t)HSB_SATURATION_MAX - saturation));
+    x = (x > 0) ? (x / (int32_t)(HSB_SATURATION_MAX * HSB_HUE_SECTOR_WIDTH)) : 0;
+    m = (int32_t)brightness * ((int32_t)HSB_SATURATION_MAX - saturation);
+    m = (m > 0) ? (m / (int32_t)HSB_SATURATION_MAX) : 0;
+
+    /* Hue value is stored in range (0 - 255) instead of (0 - 360) degree */
+    if (hue <= 42U)         /* hue < 60 degree */
+    {
+        r = c;
+        g = x;
+        b = m;
+    }
+    else if (hue <= 84U)    /* hue < 120 degree */
+    {
+        r = x;
+        g = c;
+        b = m;
+    }
+    else if (hue <= 127U)   /* hue < 180 degree */
+    {
+        r = m;
+        g = c;
+        b = x;
+    }
+    else if (hue < 170U)    /* hue < 240 degree */
+    {
+        r = m;
+        g = x;
+        b = c;
+    }
+    else if (hue <= 212U)   /* hue < 300 degree */
+    {
+        r = x;
+        g = m;
+        b = c;
+    }
+    else                    /* hue < 360 degree */
+    {
+        r = c;
+        g = m;
+        b = x;
+    }
+
+    APP_PROFILER_STAGE_END(APP_PROFILER_STAGE_HSB_TO_RGB);
+
+    return (r << 16) | (g << 8) | b;
+}
+
+void color_conv_rgb_to_hs(uint32_t rgb, uint8_t * p_hue, uint8_t * p_saturation)
+{
+    int32_t r = (int32_t)((rgb >> 16) & 0xFFU);
+    int32_t g = (int32_t)((rgb >> 8) & 0xFFU);
+    int32_t b = (int32_t)(rgb & 0xFFU);
+    int32_t max;
+    int32_t delta;
+    int32_t wheel_pos;
+
+    max   = (r > g) ? r : g;
+    max   = (max > b) ? max : b;
+    delta = max - ((r < g) ? ((r < b) ? r : b) : ((g < b) ? g : b));
+
+    if (delta == 0)
+    {
+        /* Shade of gray */
+        *p_hue        = 0U;
+        *p_saturation = 0U;
+    }
+    else
+    {
+        /* Position on the color wheel, the whole wheel being 6 * delta long */
+        if (max == r)
+        {
+            wheel_pos = g - b;
+        }
+        else if (max == g)
+        {
+            wheel_pos = (2 * delta) + (b - r);
+        }
+        else
+        {
+            wheel_pos = (4 * delta) + (r - g);
+        }
+        if (wheel_pos < 0)
+        {
+            wheel_pos += 6 * delta;
+        }
+
+        /* Values are rounded to the nearest integer */
+        wheel_pos     = ((wheel_pos * (int32_t)HSB_HUE_CIRCLE) + (3 * delta)) / (6 * delta);
+        *p_hue        = (uint8_t)((wheel_pos >= (int32_t)HSB_HUE_CIRCLE) ? 0 : wheel_pos);
+        *p_saturation = (uint8_t)((((int32_t)HSB_SATURATION_MAX * delta) + (max / 2)) / max);
+    }
+}
+
+bool color_conv_xy_matrix_init(color_conv_xy_matrix_t * p_matrix,
+                               const color_conv_xy_t    p_primaries[3],
+                               const color_conv_xy_t  * p_white)
+{
+    float  p[3][3];     /* XYZ of primaries with Y = 1, in columns */
+    float  inv[3][3];
+    float  white[3];
+    float  det;
+    float  intensity;
+    size_t i;
+    size_t j;
+
+    for (i = 0; i < 3U; i++)
+    {
+        float x = (float)p_primaries[i].x / XY_COORD_ONE;
+        float y = (float)p_primaries[i].y / XY_COORD_ONE;
+
+        if (p_primaries[i].y == 0U)
+        {
+            return false;
+        }
+        p[0][i] = x / y;
+        p[1][i] = 1.0f;
+        p[2][i] = (1.0f - x - y) / y;
+    }
+
+    inv[0][0] = (p[1][1] * p[2][2]) - (p[1][2] * p[2][1]);
+    inv[0][1] = (p[0][2] * p[2][1]) - (p[0][1] * p[2][2]);
+    inv[0][2] = (p[0][1] * p[1][2]) - (p[0][2] * p[1][1]);
+    inv[1][0] = (p[1][2] * p[2][0]) - (p[1][0] * p[2][2]);
+    inv[1][1] = (p[0][0] * p[2][2]) - (p[0][2] * p[2][0]);
+    inv[1][2] = (p[0][2] * p[1][0]) - (p[0][0] * p[1][2]);
+    inv[2][0] = (p[1][0] * p[2][1]) - (p[1][1] * p[2][0]);
+    inv[2][1] = (p[0][1] * p[2][0]) - (p[0][0] * p[2][1]);
+    inv[2][2] = (p[0][0] * p[1][1]) - (p[0][1] * p[1][0]);
+
+    det = (p[0][0] * inv[0][0]) + (p[0][1] * inv[1][0]) + (p[0][2] * inv[2][0]);
+    if ((det < 1e-6f) && (det > -1e-6f))
+    {
+        return false;
+    }
+
+    /* White point, scaled like chromaticity coordinates passed to color_conv_xy_to_rgb */
+    white[0] = (float)p_white->x / XY_COORD_ONE;
+    white[1] = (float)p_white->y / XY_COORD_ONE;
+    white[2] = 1.0f - white[0] - white[1];
+
+    for (i = 0; i < 3U; i++)
+    {
+        /* Intensity of the primary needed for the white point, which has to be inside of the gamut */
+        intensity = ((inv[i][0] * white[0]) + (inv[i][1] * white[1]) + (inv[i][2] * white[2])) / det;
+        if (intensity <= 0.0f)
+        {
+            return false;
+        }
+
+        /* Rows are scaled, so that the white point gives full intensity of every primary */
+        for (j = 0; j < 3U; j++)
+        {
+            float element = (inv[i][j] / det / intensity) * (float)(1UL << COLOR_CONV_XY_MATRIX_FRAC_BITS);
+
+            p_matrix->m[i][j] = (int32_t)((element >= 0.0f) ? (element + 0.5f) : (element - 0.5f));
+        }
+    }
+
+    return true;
+}
+
+/**@brief Function for computing integer cube root.
+ *
+ * @param[in] value     Radicand.
+ *
+ * @return Floor of cube root of @p value.
+ */
+static uint32_t cube_root(uint64_t value)
+{
+    uint64_t root = 0U;
+    int32_t  shift;
+
+    /* Digit by digit calculation, one bit of the root per iteration */
+    for (shift = 63; shift >= 0; shift -= 3)
+    {
+        uint64_t subtrahend;
+
+        root     <<= 1;
+        subtrahend = (3U * root * (root + 1U)) + 1U;
+        if ((value >> shift) >= subtrahend)
+        {
+            value -= subtrahend << shift;
+            root++;
+        }
+    }
+
+    return (uint32_t)root;
+}
+
+/**@brief Function for encoding relative luminance as 8-bit CIE 1976 lightness.
+ *
+ * @param[in] luminance     Relative luminance in Q16 format, from range [0, 1].
+ *
+ * @return Lightness scaled to range [0, 255], rounded to the nearest integer.
+ */
+static uint8_t lightness_encode(uint32_t luminance)
+{
+    uint32_t lightness;
+
+    if (luminance <= CIE_Y_LINEAR_MAX_Q16)
+    {
+        /* 255 / 100 * 903.3 * Y */
+        lightness = ((luminance * 2303U) + 0x8000U) >> 16;
+    }
+    else
+    {
+        /* 255 / 100 * (116 * cbrt(Y) - 16), with cube root in Q16 format */
+        lightness = (uint32_t)((((29580ULL * cube_root((uint64_t)luminance << 32)) >> 16) - 4080U + 50U) / 100U);
+    }
+
+    return (uint8_t)lightness;
+}
+
+uint32_t color_conv_xy_to_rgb(const color_conv_xy_matrix_t * p_matrix, const color_conv_xy_t * p_xy)
+{
+    int32_t  xyz[3];
+    int64_t  intensity[3];
+    int64_t  intensity_max = 0;
+    uint32_t rgb           = 0U;
+    size_t   i;
+
+    xyz[0] = p_xy->x;
+    xyz[1] = p_xy->y;
+    xyz[2] = XY_COORD_ONE - xyz[0] - xyz[1];
+    if (xyz[2] < 0)
+    {
+        /* Not a valid color, x + y must not exceed 1 */
+        xyz[2] = 0;
+    }
+
+    for (i = 0; i < 3U; i++)
+    {
+        intensity[i] = ((int64_t)p_matrix->m[i][0] * xyz[0]) +
+                       ((int64_t)p_matrix->m[i][1] * xyz[1]) +
+                       ((int64_t)p_matrix->m[i][2] * xyz[2]);
+        if (intensity[i] < 0)
+        {
+            intensity[i] = 0;
+        }
+        if (intensity[i] > intensity_max)
+        {
+            intensity_max = intensity[i];
+        }
+    }
+
+    /* Chromaticity does not define brightness, the brightest primary gets full intensity */
+    for (i = 0; i < 3U; i++)
+    {
+        rgb <<= 8;
+        if (intensity_max > 0)
+        {
+            rgb |= lightness_encode((uint32_t)((intensity[i] << 16) / intensity_max));
+        }
+    }
+
+    return rgb;
+}
+
+uint32_t color_conv_ct_to_rgb(uint16_t mireds, uint8_t brightness)
+{
+    uint32_t offset;
+    uint32_t idx;
+    uint32_t frac;
+    uint32_t channel;
+    uint32_t rgb = 0U;
+    size_t   i;
+
+    if (mireds < COLOR_CONV_CT_MIREDS_MIN)
+    {
+        mireds = COLOR_CONV_CT_MIREDS_MIN;
+    }
+    else if (mireds > COLOR_CONV_CT_MIREDS_MAX)
+    {
+        mireds = COLOR_CONV_CT_MIREDS_MAX;
+    }
+
+    /* The supported range lies within the table, the entry after idx always exists */
+    offset = mireds - CT_TABLE_MIREDS_FIRST;
+    idx    = offset / CT_TABLE_MIREDS_STEP;
+    frac   = offset % CT_TABLE_MIREDS_STEP;
+
+    for (i = 0; i < 3U; i++)
+    {
+        channel = ((c_ct_rgb_table[idx][i] * (CT_TABLE_MIREDS_STEP - frac)) +
+                   (c_ct_rgb_table[idx + 1U][i] * frac) +
+                   (CT_TABLE_MIREDS_STEP / 2U)) / CT_TABLE_MIREDS_STEP;
+        rgb     = (rgb << 8) | (((channel * brightness) + 127U) / 255U);
+    }
+
+    return rgb;
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,142 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @defgroup zigbee_examples_ble_zigbee_color_light_bulb_thingy color_conv.h
+ * @{
+ * @ingroup zigbee_examples
+ */
+
+#ifndef COLOR_CONV_H__
+#define COLOR_CONV_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Range of color temperatures supported by @ref color_conv_ct_to_rgb, in mireds */
+#define COLOR_CONV_CT_MIREDS_MIN        153U    /**< 6536 K. */
+#define COLOR_CONV_CT_MIREDS_MAX        500U    /**< 2000 K. */
+
+/* Number of fractional bits of @ref color_conv_xy_matrix_t elements */
+#define COLOR_CONV_XY_MATRIX_FRAC_BITS  14U
+
+/* CIE 1931 chromaticity coordinates, in the format of Color Control cluster attributes (coordinate * 65536) */
+typedef struct
+{
+    uint16_t x;
+    uint16_t y;
+} color_conv_xy_t;
+
+/* Matrix converting chromaticity coordinates into linear intensities of LED primaries, in fixed point format */
+typedef struct
+{
+    int32_t m[3][3];
+} color_conv_xy_matrix_t;
+
+/**@brief Function for converting Zigbee hue, saturation and brightness into RGB color.
+ *
+ * Hue and saturation are expected in the format of Color Control cluster attributes (hue 0 - 254 covering the whole
+ * color wheel, saturation 0 - 254), brightness in the format of Level Control cluster attribute. The conversion uses
+ * integer arithmetic only and returns floor of the exact result.
+ *
+ * @param[in] hue           Hue value of color.
+ * @param[in] saturation    Saturation value of color.
+ * @param[in] brightness    Brightness value of color.
+ *
+ * @return RGB color. Bits 23 to 16 are for the red component, bits 15 to 8 are for the green component,
+ *         and bits 7 to 0 are for the blue component.
+ */
+uint32_t color_conv_hsb_to_rgb(uint8_t hue, uint8_t saturation, uint8_t brightness);
+
+/**@brief Function for converting RGB color into Zigbee hue and saturation.
+ *
+ * Inverse of @ref color_conv_hsb_to_rgb, brightness of the color is ignored.
+ *
+ * @param[in]  rgb              RGB color, in the format returned by @ref color_conv_hsb_to_rgb.
+ * @param[out] p_hue            Hue of the color.
+ * @param[out] p_saturation     Saturation of the color.
+ */
+void color_conv_rgb_to_hs(uint32_t rgb, uint8_t * p_hue, uint8_t * p_saturation);
+
+/**@brief Function for computing the matrix converting chromaticity coordinates into RGB color.
+ *
+ * The matrix is computed once for the LED, in floating point arithmetic. Red, green and blue primaries of
+ * full intensity together give the white point.
+ *
+ * @param[out] p_matrix     Matrix to be computed.
+ * @param[in]  p_primaries  Chromaticity coordinates of red, green and blue primary.
+ * @param[in]  p_white      Chromaticity coordinates of the white point.
+ *
+ * @return true if the matrix has been computed, false if the primaries do not span a color gamut.
+ */
+bool color_conv_xy_matrix_init(color_conv_xy_matrix_t * p_matrix,
+                               const color_conv_xy_t    p_primaries[3],
+                               const color_conv_xy_t  * p_white);
+
+/**@brief Function for converting chromaticity coordinates into RGB color of full brightness.
+ *
+ * Uses integer arithmetic only. Negative intensities of colors outside of the gamut of the LED are clipped to 0.
+ * Channels are encoded with CIE 1976 lightness, as the results of @ref color_conv_hsb_to_rgb are.
+ *
+ * @param[in] p_matrix  Matrix computed by @ref color_conv_xy_matrix_init.
+ * @param[in] p_xy      Chromaticity coordinates of the color.
+ *
+ * @return RGB color in the format returned by @ref color_conv_hsb_to_rgb, with the brightest channel equal to 255.
+ */
+uint32_t color_conv_xy_to_rgb(const color_conv_xy_matrix_t * p_matrix, const color_conv_xy_t * p_xy);
+
+/**@brief Function for converting color temperature into RGB color.
+ *
+ * White of the given temperature is interpolated linearly in a table of the Planckian locus, precomputed for
+ * the default LED primaries. No floating point arithmetic is used.
+ *
+ * @param[in] mireds        Color temperature in mireds, clamped to range
+ *                          [@ref COLOR_CONV_CT_MIREDS_MIN, @ref COLOR_CONV_CT_MIREDS_MAX].
+ * @param[in] brightness    Brightness value of color.
+ *
+ * @return RGB color in the format returned by @ref color_conv_hsb_to_rgb.
+ */
+uint32_t color_conv_ct_to_rgb(uint16_t mireds, uint8_t brightness);
+
+#endif /* COLOR_CONV_H__ */
+
+/**
+ * @}
+ */
@@ -0,0 +1,87 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @brief Stand-in of the error handler of the nRF5 SDK for the host build. Any error aborts the test.
+ */
+
+#ifndef APP_ERROR_H__
+#define APP_ERROR_H__
+
+#include <stdint.h>
+#include "sdk_errors.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**@brief Function called on an error, reports it and aborts. */
+void app_error_handler(ret_code_t error_code, uint32_t line_num, const uint8_t * p_file_name);
+
+#define APP_ERROR_HANDLER(ERR_CODE)                                     \
+    do                                                                  \
+    {                                                                   \
+        app_error_handler((ERR_CODE), __LINE__, (uint8_t *)__FILE__);   \
+    } while (0)
+
+#define APP_ERROR_CHECK(ERR_CODE)                                       \
+    do                                                                  \
+    {                                                                   \
+        const uint32_t LOCAL_ERR_CODE = (ERR_CODE);                     \
+        if (LOCAL_ERR_CODE != NRF_SUCCESS)                              \
+        {                                                               \
+            APP_ERROR_HANDLER(LOCAL_ERR_CODE);                          \
+        }                                                               \
+    } while (0)
+
+#define APP_ERROR_CHECK_BOOL(BOOLEAN_VALUE)                             \
+    do                                                                  \
+    {                                                                   \
+        if (!(BOOLEAN_VALUE))                                           \
+        {                                                               \
+            APP_ERROR_HANDLER(NRF_ERROR_INTERNAL);                      \
+        }                                                               \
+    } while (0)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // APP_ERROR_H__
@@ -0,0 +1,112 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @brief Stand-in of the app_timer library for the host build.
+ *
+ * Timers run on the virtual clock, with the resolution of the RTC given by APP_TIMER_CONFIG_RTC_FREQUENCY.
+ * Handlers are called from the simulated RTC interrupt. As in app_timer2, starting a running timer does nothing.
+ */
+
+#ifndef APP_TIMER_H__
+#define APP_TIMER_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "sdk_config.h"
+#include "sdk_errors.h"
+#include "app_util.h"
+#include "sim_clock.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define APP_TIMER_CLOCK_FREQ            32768
+#define APP_TIMER_MIN_TIMEOUT_TICKS     5
+#define APP_TIMER_MAX_CNT_VAL           0x00FFFFFF
+
+/**@brief Convert milliseconds to timer ticks. */
+#define APP_TIMER_TICKS(MS)                                \
+            ((uint32_t)ROUNDED_DIV(                        \
+            (MS) * (uint64_t)APP_TIMER_CLOCK_FREQ,         \
+            1000 * (APP_TIMER_CONFIG_RTC_FREQUENCY + 1)))
+
+typedef void (* app_timer_timeout_handler_t)(void * p_context);
+
+typedef enum
+{
+    APP_TIMER_MODE_SINGLE_SHOT,
+    APP_TIMER_MODE_REPEATED
+} app_timer_mode_t;
+
+typedef struct
+{
+    sim_clock_event_t           event;          /**< Event of the virtual clock. */
+    app_timer_timeout_handler_t handler;        /**< Timeout handler. */
+    app_timer_mode_t            mode;           /**< Mode given on creation. */
+    void                      * p_context;      /**< Parameter of the handler. */
+    uint64_t                    end_tick;       /**< RTC tick of the next expiration, not wrapped. */
+    uint32_t                    repeat_period;  /**< Period of repeated timer, in ticks. */
+    bool                        active;         /**< true while the timer is running. */
+} app_timer_t;
+
+typedef app_timer_t * app_timer_id_t;
+
+#define APP_TIMER_DEF(timer_id)                         \
+    static app_timer_t CONCAT_2(timer_id, _data);       \
+    static const app_timer_id_t timer_id = &CONCAT_2(timer_id, _data)
+
+ret_code_t app_timer_init(void);
+ret_code_t app_timer_create(app_timer_id_t const * p_timer_id,
+                            app_timer_mode_t        mode,
+                            app_timer_timeout_handler_t timeout_handler);
+ret_code_t app_timer_start(app_timer_id_t timer_id, uint32_t timeout_ticks, void * p_context);
+ret_code_t app_timer_stop(app_timer_id_t timer_id);
+ret_code_t app_timer_stop_all(void);
+uint32_t app_timer_cnt_get(void);
+uint32_t app_timer_cnt_diff_compute(uint32_t ticks_to, uint32_t ticks_from);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // APP_TIMER_H__
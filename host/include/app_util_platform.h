@@ -0,0 +1,90 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @brief Stand-in of the platform utilities of the nRF5 SDK for the host build.
+ *
+ * Critical regions mask simulated interrupts, see @ref sim_irq_lock.
+ */
+
+#ifndef APP_UTIL_PLATFORM_H__
+#define APP_UTIL_PLATFORM_H__
+
+#include <stdint.h>
+#include "compiler_abstraction.h"
+#include "nordic_common.h"
+#include "app_util.h"
+#include "app_error.h"
+#include "sim_clock.h"
+
+#define APP_IRQ_PRIORITY_HIGHEST    0
+#define APP_IRQ_PRIORITY_HIGH       2
+#define APP_IRQ_PRIORITY_MID        4
+#define APP_IRQ_PRIORITY_LOW_MID    5
+#define APP_IRQ_PRIORITY_LOW        6
+#define APP_IRQ_PRIORITY_LOWEST     7
+#define APP_IRQ_PRIORITY_THREAD     15
+
+#define __DMB()                     __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define __DSB()                     __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define __ISB()                     __atomic_thread_fence(__ATOMIC_SEQ_CST)
+
+static inline void app_util_critical_region_enter(uint8_t * p_nested)
+{
+    (void)p_nested;
+    sim_irq_lock();
+}
+
+static inline void app_util_critical_region_exit(uint8_t nested)
+{
+    (void)nested;
+    sim_irq_unlock();
+}
+
+#define CRITICAL_REGION_ENTER()                                             \
+    {                                                                       \
+        uint8_t __CR_NESTED = 0;                                            \
+        app_util_critical_region_enter(&__CR_NESTED);
+
+#define CRITICAL_REGION_EXIT()                                              \
+        app_util_critical_region_exit(__CR_NESTED);                         \
+    }
+
+#endif // APP_UTIL_PLATFORM_H__
@@ -0,0 +1,84 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @brief Stand-in of the GPIO HAL for the host build. Output levels are forwarded to @ref sim_gpio_write.
+ */
+
+#ifndef NRF_GPIO_H__
+#define NRF_GPIO_H__
+
+#include <stdint.h>
+#include "nrfx.h"
+#include "sim_gpio.h"
+
+#define NRF_GPIO_PIN_MAP(port, pin)     (((port) << 5) | ((pin) & 0x1F))
+
+static inline void nrf_gpio_cfg_output(uint32_t pin_number)
+{
+    (void)pin_number;
+}
+
+static inline void nrf_gpio_cfg_default(uint32_t pin_number)
+{
+    (void)pin_number;
+}
+
+static inline void nrf_gpio_pin_write(uint32_t pin_number, uint32_t value)
+{
+    sim_gpio_write(pin_number, value != 0U, sim_clock_now() * 1000U);
+}
+
+static inline void nrf_gpio_pin_set(uint32_t pin_number)
+{
+    nrf_gpio_pin_write(pin_number, 1U);
+}
+
+static inline void nrf_gpio_pin_clear(uint32_t pin_number)
+{
+    nrf_gpio_pin_write(pin_number, 0U);
+}
+
+static inline uint32_t nrf_gpio_pin_out_read(uint32_t pin_number)
+{
+    return sim_gpio_read(pin_number) ? 1U : 0U;
+}
+
+#endif // NRF_GPIO_H__
@@ -0,0 +1,217 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @brief Stand-in of the I2S HAL for the host build.
+ *
+ * Registers are plain memory, offsets of tasks, events and INTEN match the device. Tasks are triggered and
+ * interrupts are re-evaluated by functions of the I2S simulation, see sim_i2s.h.
+ */
+
+#ifndef NRF_I2S_H__
+#define NRF_I2S_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "nrfx.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct
+{
+    volatile uint32_t  MODE;
+    volatile uint32_t  RXEN;
+    volatile uint32_t  TXEN;
+    volatile uint32_t  MCKEN;
+    volatile uint32_t  MCKFREQ;
+    volatile uint32_t  RATIO;
+    volatile uint32_t  SWIDTH;
+    volatile uint32_t  ALIGN;
+    volatile uint32_t  FORMAT;
+    volatile uint32_t  CHANNELS;
+} NRF_I2S_CONFIG_Type;
+
+typedef struct
+{
+    volatile uint32_t  MCK;
+    volatile uint32_t  SCK;
+    volatile uint32_t  LRCK;
+    volatile uint32_t  SDIN;
+    volatile uint32_t  SDOUT;
+} NRF_I2S_PSEL_Type;
+
+typedef struct
+{
+    volatile uint32_t    TASKS_START;           /* 0x000 */
+    volatile uint32_t    TASKS_STOP;            /* 0x004 */
+    volatile uint32_t    RESERVED0[63];
+    volatile uint32_t    EVENTS_RXPTRUPD;       /* 0x104 */
+    volatile uint32_t    EVENTS_STOPPED;        /* 0x108 */
+    volatile uint32_t    RESERVED1[2];
+    volatile uint32_t    EVENTS_TXPTRUPD;       /* 0x114 */
+    volatile uint32_t    RESERVED2[122];
+    volatile uint32_t    INTEN;                 /* 0x300 */
+    volatile uint32_t    RESERVED3[127];
+    volatile uint32_t    ENABLE;                /* 0x500 */
+    NRF_I2S_CONFIG_Type  CONFIG;
+    volatile uintptr_t   RXD_PTR;               /**< Address of the RX buffer, a full host pointer. */
+    volatile uintptr_t   TXD_PTR;               /**< Address of the TX buffer, a full host pointer. */
+    volatile uint32_t    RXTXD_MAXCNT;
+    NRF_I2S_PSEL_Type    PSEL;
+} NRF_I2S_Type;
+
+/**@brief Registers of the simulated I2S peripheral. */
+extern NRF_I2S_Type sim_i2s_registers;
+
+#define NRF_I2S     (&sim_i2s_registers)
+
+#define NRF_I2S_PIN_NOT_CONNECTED   0xFFFFFFFF
+
+typedef enum
+{
+    NRF_I2S_TASK_START = offsetof(NRF_I2S_Type, TASKS_START),
+    NRF_I2S_TASK_STOP  = offsetof(NRF_I2S_Type, TASKS_STOP),
+} nrf_i2s_task_t;
+
+typedef enum
+{
+    NRF_I2S_EVENT_RXPTRUPD = offsetof(NRF_I2S_Type, EVENTS_RXPTRUPD),
+    NRF_I2S_EVENT_TXPTRUPD = offsetof(NRF_I2S_Type, EVENTS_TXPTRUPD),
+    NRF_I2S_EVENT_STOPPED  = offsetof(NRF_I2S_Type, EVENTS_STOPPED),
+} nrf_i2s_event_t;
+
+typedef enum
+{
+    NRF_I2S_INT_RXPTRUPD_MASK = (1UL << 1),
+    NRF_I2S_INT_STOPPED_MASK  = (1UL << 2),
+    NRF_I2S_INT_TXPTRUPD_MASK = (1UL << 5),
+} nrf_i2s_int_mask_t;
+
+typedef enum
+{
+    NRF_I2S_MODE_MASTER = 0,
+    NRF_I2S_MODE_SLAVE  = 1,
+} nrf_i2s_mode_t;
+
+typedef enum
+{
+    NRF_I2S_FORMAT_I2S     = 0,
+    NRF_I2S_FORMAT_ALIGNED = 1,
+} nrf_i2s_format_t;
+
+typedef enum
+{
+    NRF_I2S_ALIGN_LEFT  = 0,
+    NRF_I2S_ALIGN_RIGHT = 1,
+} nrf_i2s_align_t;
+
+typedef enum
+{
+    NRF_I2S_SWIDTH_8BIT  = 0,
+    NRF_I2S_SWIDTH_16BIT = 1,
+    NRF_I2S_SWIDTH_24BIT = 2,
+} nrf_i2s_swidth_t;
+
+typedef enum
+{
+    NRF_I2S_CHANNELS_STEREO = 0,
+    NRF_I2S_CHANNELS_LEFT   = 1,
+    NRF_I2S_CHANNELS_RIGHT  = 2,
+} nrf_i2s_channels_t;
+
+/* Values of MCKFREQ, as on the device */
+typedef enum
+{
+    NRF_I2S_MCK_DISABLED  = 0,
+    NRF_I2S_MCK_32MDIV8   = 0x20000000,
+    NRF_I2S_MCK_32MDIV10  = 0x18000000,
+    NRF_I2S_MCK_32MDIV16  = 0x10000000,
+    NRF_I2S_MCK_32MDIV32  = 0x08400000,
+} nrf_i2s_mck_t;
+
+typedef enum
+{
+    NRF_I2S_RATIO_32X  = 0,
+    NRF_I2S_RATIO_48X  = 1,
+    NRF_I2S_RATIO_64X  = 2,
+    NRF_I2S_RATIO_96X  = 3,
+    NRF_I2S_RATIO_128X = 4,
+    NRF_I2S_RATIO_192X = 5,
+    NRF_I2S_RATIO_256X = 6,
+    NRF_I2S_RATIO_384X = 7,
+    NRF_I2S_RATIO_512X = 8,
+} nrf_i2s_ratio_t;
+
+void nrf_i2s_task_trigger(NRF_I2S_Type * p_reg, nrf_i2s_task_t task);
+void nrf_i2s_event_clear(NRF_I2S_Type * p_reg, nrf_i2s_event_t event);
+bool nrf_i2s_event_check(NRF_I2S_Type const * p_reg, nrf_i2s_event_t event);
+void nrf_i2s_int_enable(NRF_I2S_Type * p_reg, uint32_t mask);
+void nrf_i2s_int_disable(NRF_I2S_Type * p_reg, uint32_t mask);
+bool nrf_i2s_int_enable_check(NRF_I2S_Type const * p_reg, nrf_i2s_int_mask_t mask);
+void nrf_i2s_enable(NRF_I2S_Type * p_reg);
+void nrf_i2s_disable(NRF_I2S_Type * p_reg);
+void nrf_i2s_pins_set(NRF_I2S_Type * p_reg,
+                      uint32_t       sck_pin,
+                      uint32_t       lrck_pin,
+                      uint32_t       mck_pin,
+                      uint32_t       sdout_pin,
+                      uint32_t       sdin_pin);
+bool nrf_i2s_configure(NRF_I2S_Type *     p_reg,
+                       nrf_i2s_mode_t     mode,
+                       nrf_i2s_format_t   format,
+                       nrf_i2s_align_t    alignment,
+                       nrf_i2s_swidth_t   sample_width,
+                       nrf_i2s_channels_t channels,
+                       nrf_i2s_mck_t      mck_setup,
+                       nrf_i2s_ratio_t    ratio);
+void nrf_i2s_transfer_set(NRF_I2S_Type *   p_reg,
+                          uint16_t         size,
+                          uint32_t *       p_rx_buffer,
+                          uint32_t const * p_tx_buffer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // NRF_I2S_H__
@@ -0,0 +1,245 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @brief Stand-in of the PWM HAL for the host build.
+ *
+ * Registers are plain memory, offsets of tasks, events, SHORTS and INTEN match the device. Tasks are triggered and
+ * interrupts are re-evaluated by functions of the PWM simulation, see sim_pwm.h.
+ */
+
+#ifndef NRF_PWM_H__
+#define NRF_PWM_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "nrfx.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct
+{
+    volatile uintptr_t PTR;         /**< Address of the sequence, a full host pointer. */
+    volatile uint32_t  CNT;
+    volatile uint32_t  REFRESH;
+    volatile uint32_t  ENDDELAY;
+} NRF_PWM_SEQ_Type;
+
+typedef struct
+{
+    volatile uint32_t  RESERVED0;
+    volatile uint32_t  TASKS_STOP;              /* 0x004 */
+    volatile uint32_t  TASKS_SEQSTART[2];       /* 0x008 */
+    volatile uint32_t  TASKS_NEXTSTEP;          /* 0x010 */
+    volatile uint32_t  RESERVED1[60];
+    volatile uint32_t  EVENTS_STOPPED;          /* 0x104 */
+    volatile uint32_t  EVENTS_SEQSTARTED[2];    /* 0x108 */
+    volatile uint32_t  EVENTS_SEQEND[2];        /* 0x110 */
+    volatile uint32_t  EVENTS_PWMPERIODEND;     /* 0x118 */
+    volatile uint32_t  EVENTS_LOOPSDONE;        /* 0x11C */
+    volatile uint32_t  RESERVED2[56];
+    volatile uint32_t  SHORTS;                  /* 0x200 */
+    volatile uint32_t  RESERVED3[63];
+    volatile uint32_t  INTEN;                   /* 0x300 */
+    volatile uint32_t  RESERVED4[125];
+    volatile uint32_t  ENABLE;                  /* 0x500 */
+    volatile uint32_t  MODE;
+    volatile uint32_t  COUNTERTOP;
+    volatile uint32_t  PRESCALER;
+    volatile uint32_t  DECODER;
+    volatile uint32_t  LOOP;
+    volatile uint32_t  RESERVED5[2];
+    NRF_PWM_SEQ_Type   SEQ[2];
+    volatile uint32_t  PSEL_OUT[4];
+} NRF_PWM_Type;
+
+/**@brief Registers of the simulated PWM instances. */
+extern NRF_PWM_Type sim_pwm_registers[4];
+
+#define NRF_PWM0    (&sim_pwm_registers[0])
+#define NRF_PWM1    (&sim_pwm_registers[1])
+#define NRF_PWM2    (&sim_pwm_registers[2])
+#define NRF_PWM3    (&sim_pwm_registers[3])
+
+#define NRF_PWM_CHANNEL_COUNT   4
+#define NRF_PWM_PIN_NOT_CONNECTED   0xFFFFFFFF
+
+typedef enum
+{
+    NRF_PWM_TASK_STOP      = offsetof(NRF_PWM_Type, TASKS_STOP),
+    NRF_PWM_TASK_SEQSTART0 = offsetof(NRF_PWM_Type, TASKS_SEQSTART[0]),
+    NRF_PWM_TASK_SEQSTART1 = offsetof(NRF_PWM_Type, TASKS_SEQSTART[1]),
+    NRF_PWM_TASK_NEXTSTEP  = offsetof(NRF_PWM_Type, TASKS_NEXTSTEP),
+} nrf_pwm_task_t;
+
+typedef enum
+{
+    NRF_PWM_EVENT_STOPPED      = offsetof(NRF_PWM_Type, EVENTS_STOPPED),
+    NRF_PWM_EVENT_SEQSTARTED0  = offsetof(NRF_PWM_Type, EVENTS_SEQSTARTED[0]),
+    NRF_PWM_EVENT_SEQSTARTED1  = offsetof(NRF_PWM_Type, EVENTS_SEQSTARTED[1]),
+    NRF_PWM_EVENT_SEQEND0      = offsetof(NRF_PWM_Type, EVENTS_SEQEND[0]),
+    NRF_PWM_EVENT_SEQEND1      = offsetof(NRF_PWM_Type, EVENTS_SEQEND[1]),
+    NRF_PWM_EVENT_PWMPERIODEND = offsetof(NRF_PWM_Type, EVENTS_PWMPERIODEND),
+    NRF_PWM_EVENT_LOOPSDONE    = offsetof(NRF_PWM_Type, EVENTS_LOOPSDONE),
+} nrf_pwm_event_t;
+
+/* Bit of an event in INTEN is its offset from EVENTS_ base divided by 4 */
+typedef enum
+{
+    NRF_PWM_INT_STOPPED_MASK      = (1UL << 1),
+    NRF_PWM_INT_SEQSTARTED0_MASK  = (1UL << 2),
+    NRF_PWM_INT_SEQSTARTED1_MASK  = (1UL << 3),
+    NRF_PWM_INT_SEQEND0_MASK      = (1UL << 4),
+    NRF_PWM_INT_SEQEND1_MASK      = (1UL << 5),
+    NRF_PWM_INT_PWMPERIODEND_MASK = (1UL << 6),
+    NRF_PWM_INT_LOOPSDONE_MASK    = (1UL << 7),
+} nrf_pwm_int_mask_t;
+
+typedef enum
+{
+    NRF_PWM_SHORT_SEQEND0_STOP_MASK        = (1UL << 0),
+    NRF_PWM_SHORT_SEQEND1_STOP_MASK        = (1UL << 1),
+    NRF_PWM_SHORT_LOOPSDONE_SEQSTART0_MASK = (1UL << 2),
+    NRF_PWM_SHORT_LOOPSDONE_SEQSTART1_MASK = (1UL << 3),
+    NRF_PWM_SHORT_LOOPSDONE_STOP_MASK      = (1UL << 4),
+} nrf_pwm_short_mask_t;
+
+typedef enum
+{
+    NRF_PWM_CLK_16MHz  = 0,
+    NRF_PWM_CLK_8MHz   = 1,
+    NRF_PWM_CLK_4MHz   = 2,
+    NRF_PWM_CLK_2MHz   = 3,
+    NRF_PWM_CLK_1MHz   = 4,
+    NRF_PWM_CLK_500kHz = 5,
+    NRF_PWM_CLK_250kHz = 6,
+    NRF_PWM_CLK_125kHz = 7,
+} nrf_pwm_clk_t;
+
+typedef enum
+{
+    NRF_PWM_MODE_UP          = 0,
+    NRF_PWM_MODE_UP_AND_DOWN = 1,
+} nrf_pwm_mode_t;
+
+typedef enum
+{
+    NRF_PWM_LOAD_COMMON     = 0,
+    NRF_PWM_LOAD_GROUPED    = 1,
+    NRF_PWM_LOAD_INDIVIDUAL = 2,
+    NRF_PWM_LOAD_WAVE_FORM  = 3,
+} nrf_pwm_dec_load_t;
+
+typedef enum
+{
+    NRF_PWM_STEP_AUTO      = 0,
+    NRF_PWM_STEP_TRIGGERED = 1,
+} nrf_pwm_dec_step_t;
+
+typedef uint16_t nrf_pwm_values_common_t;
+
+typedef struct
+{
+    uint16_t group_0;
+    uint16_t group_1;
+} nrf_pwm_values_grouped_t;
+
+typedef struct
+{
+    uint16_t channel_0;
+    uint16_t channel_1;
+    uint16_t channel_2;
+    uint16_t channel_3;
+} nrf_pwm_values_individual_t;
+
+typedef struct
+{
+    uint16_t channel_0;
+    uint16_t channel_1;
+    uint16_t channel_2;
+    uint16_t counter_top;
+} nrf_pwm_values_wave_form_t;
+
+typedef union
+{
+    nrf_pwm_values_common_t     const * p_common;
+    nrf_pwm_values_grouped_t    const * p_grouped;
+    nrf_pwm_values_individual_t const * p_individual;
+    nrf_pwm_values_wave_form_t  const * p_wave_form;
+    uint16_t                    const * p_raw;
+} nrf_pwm_values_t;
+
+#define NRF_PWM_VALUES_LENGTH(array)    (sizeof(array) / sizeof(uint16_t))
+
+typedef struct
+{
+    nrf_pwm_values_t values;
+    uint16_t         length;
+    uint32_t         repeats;
+    uint32_t         end_delay;
+} nrf_pwm_sequence_t;
+
+void nrf_pwm_task_trigger(NRF_PWM_Type * p_reg, nrf_pwm_task_t task);
+uint32_t nrf_pwm_task_address_get(NRF_PWM_Type const * p_reg, nrf_pwm_task_t task);
+void nrf_pwm_event_clear(NRF_PWM_Type * p_reg, nrf_pwm_event_t event);
+bool nrf_pwm_event_check(NRF_PWM_Type const * p_reg, nrf_pwm_event_t event);
+uint32_t nrf_pwm_event_address_get(NRF_PWM_Type const * p_reg, nrf_pwm_event_t event);
+void nrf_pwm_shorts_set(NRF_PWM_Type * p_reg, uint32_t mask);
+void nrf_pwm_int_enable(NRF_PWM_Type * p_reg, uint32_t mask);
+void nrf_pwm_int_disable(NRF_PWM_Type * p_reg, uint32_t mask);
+void nrf_pwm_int_set(NRF_PWM_Type * p_reg, uint32_t mask);
+bool nrf_pwm_int_enable_check(NRF_PWM_Type const * p_reg, nrf_pwm_int_mask_t mask);
+void nrf_pwm_enable(NRF_PWM_Type * p_reg);
+void nrf_pwm_disable(NRF_PWM_Type * p_reg);
+void nrf_pwm_pins_set(NRF_PWM_Type * p_reg, uint32_t out_pins[NRF_PWM_CHANNEL_COUNT]);
+void nrf_pwm_configure(NRF_PWM_Type * p_reg, nrf_pwm_clk_t base_clock, nrf_pwm_mode_t mode, uint16_t top_value);
+void nrf_pwm_sequence_set(NRF_PWM_Type * p_reg, uint8_t seq_id, nrf_pwm_sequence_t const * p_seq);
+void nrf_pwm_decoder_set(NRF_PWM_Type * p_reg, nrf_pwm_dec_load_t dec_load, nrf_pwm_dec_step_t dec_step);
+void nrf_pwm_loop_set(NRF_PWM_Type * p_reg, uint16_t loop_count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // NRF_PWM_H__
@@ -0,0 +1,79 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @brief Stand-in of the legacy PWM driver API for the host build, mapped to nrfx as in the nRF5 SDK.
+ */
+
+#ifndef NRF_DRV_PWM_H__
+#define NRF_DRV_PWM_H__
+
+#include "nrfx_pwm.h"
+
+#define nrf_drv_pwm_t                       nrfx_pwm_t
+#define nrf_drv_pwm_config_t                nrfx_pwm_config_t
+#define nrf_drv_pwm_handler_t               nrfx_pwm_handler_t
+#define nrf_drv_pwm_evt_type_t              nrfx_pwm_evt_type_t
+
+#define NRF_DRV_PWM_INSTANCE                NRFX_PWM_INSTANCE
+#define NRF_DRV_PWM_DEFAULT_CONFIG          NRFX_PWM_DEFAULT_CONFIG
+#define NRF_DRV_PWM_PIN_NOT_USED            NRFX_PWM_PIN_NOT_USED
+#define NRF_DRV_PWM_PIN_INVERTED            NRFX_PWM_PIN_INVERTED
+
+#define NRF_DRV_PWM_FLAG_STOP               NRFX_PWM_FLAG_STOP
+#define NRF_DRV_PWM_FLAG_LOOP               NRFX_PWM_FLAG_LOOP
+#define NRF_DRV_PWM_FLAG_SIGNAL_END_SEQ0    NRFX_PWM_FLAG_SIGNAL_END_SEQ0
+#define NRF_DRV_PWM_FLAG_SIGNAL_END_SEQ1    NRFX_PWM_FLAG_SIGNAL_END_SEQ1
+#define NRF_DRV_PWM_FLAG_NO_EVT_FINISHED    NRFX_PWM_FLAG_NO_EVT_FINISHED
+#define NRF_DRV_PWM_FLAG_START_VIA_TASK     NRFX_PWM_FLAG_START_VIA_TASK
+
+#define NRF_DRV_PWM_EVT_FINISHED            NRFX_PWM_EVT_FINISHED
+#define NRF_DRV_PWM_EVT_END_SEQ0            NRFX_PWM_EVT_END_SEQ0
+#define NRF_DRV_PWM_EVT_END_SEQ1            NRFX_PWM_EVT_END_SEQ1
+#define NRF_DRV_PWM_EVT_STOPPED             NRFX_PWM_EVT_STOPPED
+
+#define nrf_drv_pwm_init                    nrfx_pwm_init
+#define nrf_drv_pwm_uninit                  nrfx_pwm_uninit
+#define nrf_drv_pwm_simple_playback         nrfx_pwm_simple_playback
+#define nrf_drv_pwm_complex_playback        nrfx_pwm_complex_playback
+#define nrf_drv_pwm_stop                    nrfx_pwm_stop
+#define nrf_drv_pwm_is_stopped              nrfx_pwm_is_stopped
+
+#endif // NRF_DRV_PWM_H__
@@ -0,0 +1,118 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @brief Stand-in of the flash storage library for the host build. Flash is simulated by sim_fstorage.c.
+ */
+
+#ifndef NRF_FSTORAGE_H__
+#define NRF_FSTORAGE_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "sdk_errors.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define NRF_FSTORAGE_DEF(inst)  inst
+
+typedef enum
+{
+    NRF_FSTORAGE_EVT_READ_RESULT,
+    NRF_FSTORAGE_EVT_WRITE_RESULT,
+    NRF_FSTORAGE_EVT_ERASE_RESULT
+} nrf_fstorage_evt_id_t;
+
+typedef struct
+{
+    nrf_fstorage_evt_id_t   id;
+    ret_code_t              result;
+    uint32_t                addr;
+    void const            * p_src;
+    uint32_t                len;
+    void                  * p_param;
+} nrf_fstorage_evt_t;
+
+typedef void (* nrf_fstorage_evt_handler_t)(nrf_fstorage_evt_t * p_evt);
+
+typedef struct
+{
+    uint32_t erase_unit;
+    uint32_t program_unit;
+    bool     rmap;
+    bool     wmap;
+} nrf_fstorage_info_t;
+
+typedef struct nrf_fstorage_api_s nrf_fstorage_api_t;
+
+typedef struct
+{
+    nrf_fstorage_api_t  const * p_api;
+    void                      * p_flash_info;
+    nrf_fstorage_evt_handler_t  evt_handler;
+    uint32_t                    start_addr;
+    uint32_t                    end_addr;
+} nrf_fstorage_t;
+
+struct nrf_fstorage_api_s
+{
+    ret_code_t (* init)(nrf_fstorage_t * p_fs, void * p_param);
+};
+
+ret_code_t nrf_fstorage_init(nrf_fstorage_t * p_fs, nrf_fstorage_api_t const * p_api, void * p_param);
+ret_code_t nrf_fstorage_uninit(nrf_fstorage_t * p_fs, void * p_param);
+ret_code_t nrf_fstorage_read(nrf_fstorage_t const * p_fs, uint32_t addr, void * p_dest, uint32_t len);
+ret_code_t nrf_fstorage_write(nrf_fstorage_t const * p_fs,
+                              uint32_t               dest,
+                              void           const * p_src,
+                              uint32_t               len,
+                              void                 * p_param);
+ret_code_t nrf_fstorage_erase(nrf_fstorage_t const * p_fs, uint32_t page_addr, uint32_t len, void * p_param);
+bool nrf_fstorage_is_busy(nrf_fstorage_t const * p_fs);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // NRF_FSTORAGE_H__
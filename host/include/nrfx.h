@@ -0,0 +1,100 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @brief Stand-in of the nrfx glue layer for the host build.
+ *
+ * Critical sections mask simulated interrupts, see @ref sim_irq_lock. Interrupts of peripherals are always
+ * enabled in NVIC, simulated peripherals decide when to call their handlers.
+ */
+
+#ifndef NRFX_H__
+#define NRFX_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "sdk_config.h"
+#include "nrf.h"
+#include "nrf_error.h"
+#include "nordic_common.h"
+#include "app_util_platform.h"
+
+typedef enum
+{
+    NRFX_SUCCESS                    = NRF_SUCCESS,
+    NRFX_ERROR_INTERNAL             = NRF_ERROR_INTERNAL,
+    NRFX_ERROR_NO_MEM               = NRF_ERROR_NO_MEM,
+    NRFX_ERROR_NOT_SUPPORTED        = NRF_ERROR_NOT_SUPPORTED,
+    NRFX_ERROR_INVALID_PARAM        = NRF_ERROR_INVALID_PARAM,
+    NRFX_ERROR_INVALID_STATE        = NRF_ERROR_INVALID_STATE,
+    NRFX_ERROR_INVALID_LENGTH       = NRF_ERROR_INVALID_LENGTH,
+    NRFX_ERROR_TIMEOUT              = NRF_ERROR_TIMEOUT,
+    NRFX_ERROR_FORBIDDEN            = NRF_ERROR_FORBIDDEN,
+    NRFX_ERROR_NULL                 = NRF_ERROR_NULL,
+    NRFX_ERROR_INVALID_ADDR         = NRF_ERROR_INVALID_ADDR,
+    NRFX_ERROR_BUSY                 = NRF_ERROR_BUSY,
+} nrfx_err_t;
+
+typedef enum
+{
+    NRFX_DRV_STATE_UNINITIALIZED,
+    NRFX_DRV_STATE_INITIALIZED,
+    NRFX_DRV_STATE_POWERED_ON,
+} nrfx_drv_state_t;
+
+#define NRFX_CONCAT_2(p1, p2)           NRFX_CONCAT_2_(p1, p2)
+#define NRFX_CONCAT_2_(p1, p2)          p1 ## p2
+#define NRFX_CONCAT_3(p1, p2, p3)       NRFX_CONCAT_3_(p1, p2, p3)
+#define NRFX_CONCAT_3_(p1, p2, p3)      p1 ## p2 ## p3
+
+#define NRFX_STATIC_ASSERT(expression)  _Static_assert(expression, "static assertion failed: " #expression)
+#define NRFX_ASSERT(expression)         APP_ERROR_CHECK_BOOL(expression)
+#define NRFX_ARRAY_SIZE(array)          (sizeof(array) / sizeof((array)[0]))
+
+#define NRFX_CRITICAL_SECTION_ENTER()   CRITICAL_REGION_ENTER()
+#define NRFX_CRITICAL_SECTION_EXIT()    CRITICAL_REGION_EXIT()
+
+#define NRFX_IRQ_PRIORITY_SET(irq_number, priority) ((void)(irq_number), (void)(priority))
+#define NRFX_IRQ_ENABLE(irq_number)                 ((void)(irq_number))
+#define NRFX_IRQ_DISABLE(irq_number)                ((void)(irq_number))
+
+#endif // NRFX_H__
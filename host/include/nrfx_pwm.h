@@ -0,0 +1,146 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @brief Stand-in of the nrfx PWM driver for the host build. Implemented in host/sim/nrfx_pwm.c after the nrfx
+ *        driver, on top of the simulated PWM peripheral.
+ */
+
+#ifndef NRFX_PWM_H__
+#define NRFX_PWM_H__
+
+#include "nrfx.h"
+#include "hal/nrf_pwm.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct
+{
+    NRF_PWM_Type * p_registers;
+    uint8_t        drv_inst_idx;
+} nrfx_pwm_t;
+
+#define NRFX_PWM_INSTANCE(id)                               \
+{                                                           \
+    .p_registers  = NRFX_CONCAT_2(NRF_PWM, id),             \
+    .drv_inst_idx = (id),                                   \
+}
+
+#define NRFX_PWM_PIN_NOT_USED   0xFF
+#define NRFX_PWM_PIN_INVERTED   0x80
+
+typedef struct
+{
+    uint8_t             output_pins[NRF_PWM_CHANNEL_COUNT];
+    uint8_t             irq_priority;
+    nrf_pwm_clk_t       base_clock;
+    nrf_pwm_mode_t      count_mode;
+    uint16_t            top_value;
+    nrf_pwm_dec_load_t  load_mode;
+    nrf_pwm_dec_step_t  step_mode;
+} nrfx_pwm_config_t;
+
+#define NRFX_PWM_DEFAULT_CONFIG                                 \
+{                                                               \
+    .output_pins  = { NRFX_PWM_PIN_NOT_USED,                    \
+                      NRFX_PWM_PIN_NOT_USED,                    \
+                      NRFX_PWM_PIN_NOT_USED,                    \
+                      NRFX_PWM_PIN_NOT_USED },                  \
+    .irq_priority = APP_IRQ_PRIORITY_LOWEST,                    \
+    .base_clock   = NRF_PWM_CLK_1MHz,                           \
+    .count_mode   = NRF_PWM_MODE_UP,                            \
+    .top_value    = 1000,                                       \
+    .load_mode    = NRF_PWM_LOAD_COMMON,                        \
+    .step_mode    = NRF_PWM_STEP_AUTO,                          \
+}
+
+typedef enum
+{
+    NRFX_PWM_FLAG_STOP                  = 0x01,
+    NRFX_PWM_FLAG_LOOP                  = 0x02,
+    NRFX_PWM_FLAG_SIGNAL_END_SEQ0       = 0x04,
+    NRFX_PWM_FLAG_SIGNAL_END_SEQ1       = 0x08,
+    NRFX_PWM_FLAG_NO_EVT_FINISHED       = 0x10,
+    NRFX_PWM_FLAG_START_VIA_TASK        = 0x80,
+} nrfx_pwm_flag_t;
+
+typedef enum
+{
+    NRFX_PWM_EVT_FINISHED,
+    NRFX_PWM_EVT_END_SEQ0,
+    NRFX_PWM_EVT_END_SEQ1,
+    NRFX_PWM_EVT_STOPPED,
+} nrfx_pwm_evt_type_t;
+
+typedef void (* nrfx_pwm_handler_t)(nrfx_pwm_evt_type_t event_type);
+
+nrfx_err_t nrfx_pwm_init(nrfx_pwm_t const *        p_instance,
+                         nrfx_pwm_config_t const * p_config,
+                         nrfx_pwm_handler_t        handler);
+void nrfx_pwm_uninit(nrfx_pwm_t const * p_instance);
+uint32_t nrfx_pwm_simple_playback(nrfx_pwm_t const *         p_instance,
+                                  nrf_pwm_sequence_t const * p_sequence,
+                                  uint16_t                   playback_count,
+                                  uint32_t                   flags);
+uint32_t nrfx_pwm_complex_playback(nrfx_pwm_t const *         p_instance,
+                                   nrf_pwm_sequence_t const * p_sequence_0,
+                                   nrf_pwm_sequence_t const * p_sequence_1,
+                                   uint16_t                   playback_count,
+                                   uint32_t                   flags);
+bool nrfx_pwm_stop(nrfx_pwm_t const * p_instance, bool wait_until_stopped);
+bool nrfx_pwm_is_stopped(nrfx_pwm_t const * p_instance);
+
+__STATIC_INLINE uint32_t nrfx_pwm_task_address_get(nrfx_pwm_t const * p_instance, nrf_pwm_task_t task)
+{
+    return nrf_pwm_task_address_get(p_instance->p_registers, task);
+}
+
+__STATIC_INLINE uint32_t nrfx_pwm_event_address_get(nrfx_pwm_t const * p_instance, nrf_pwm_event_t event)
+{
+    return nrf_pwm_event_address_get(p_instance->p_registers, event);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // NRFX_PWM_H__
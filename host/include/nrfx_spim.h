@@ -0,0 +1,170 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @brief Stand-in of the nrfx SPIM driver for the host build. Implemented in host/sim/sim_spim.c, which simulates
+ *        the peripheral at the level of the driver: transfers take virtual time and transmitted bytes are passed
+ *        to a listener. Types of the SPIM HAL used in the driver configuration are declared here as well.
+ */
+
+#ifndef NRFX_SPIM_H__
+#define NRFX_SPIM_H__
+
+#include "nrfx.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Values of the FREQUENCY register, as on the device */
+typedef enum
+{
+    NRF_SPIM_FREQ_125K = 0x02000000,
+    NRF_SPIM_FREQ_250K = 0x04000000,
+    NRF_SPIM_FREQ_500K = 0x08000000,
+    NRF_SPIM_FREQ_1M   = 0x10000000,
+    NRF_SPIM_FREQ_2M   = 0x20000000,
+    NRF_SPIM_FREQ_4M   = 0x40000000,
+    NRF_SPIM_FREQ_8M   = 0x80000000UL,
+    NRF_SPIM_FREQ_16M  = 0x0A000000,
+    NRF_SPIM_FREQ_32M  = 0x14000000,
+} nrf_spim_frequency_t;
+
+typedef enum
+{
+    NRF_SPIM_MODE_0,
+    NRF_SPIM_MODE_1,
+    NRF_SPIM_MODE_2,
+    NRF_SPIM_MODE_3,
+} nrf_spim_mode_t;
+
+typedef enum
+{
+    NRF_SPIM_BIT_ORDER_MSB_FIRST,
+    NRF_SPIM_BIT_ORDER_LSB_FIRST,
+} nrf_spim_bit_order_t;
+
+typedef struct
+{
+    uint8_t drv_inst_idx;
+} nrfx_spim_t;
+
+#define NRFX_SPIM_INSTANCE(id)                              \
+{                                                           \
+    .drv_inst_idx = (id),                                   \
+}
+
+#define NRFX_SPIM_PIN_NOT_USED  0xFF
+
+typedef struct
+{
+    uint8_t              sck_pin;
+    uint8_t              mosi_pin;
+    uint8_t              miso_pin;
+    uint8_t              ss_pin;
+    bool                 ss_active_high;
+    uint8_t              irq_priority;
+    uint8_t              orc;
+    nrf_spim_frequency_t frequency;
+    nrf_spim_mode_t      mode;
+    nrf_spim_bit_order_t bit_order;
+} nrfx_spim_config_t;
+
+#define NRFX_SPIM_DEFAULT_CONFIG                                \
+{                                                               \
+    .sck_pin        = NRFX_SPIM_PIN_NOT_USED,                   \
+    .mosi_pin       = NRFX_SPIM_PIN_NOT_USED,                   \
+    .miso_pin       = NRFX_SPIM_PIN_NOT_USED,                   \
+    .ss_pin         = NRFX_SPIM_PIN_NOT_USED,                   \
+    .ss_active_high = false,                                    \
+    .irq_priority   = APP_IRQ_PRIORITY_LOWEST,                  \
+    .orc            = 0xFF,                                     \
+    .frequency      = NRF_SPIM_FREQ_4M,                         \
+    .mode           = NRF_SPIM_MODE_0,                          \
+    .bit_order      = NRF_SPIM_BIT_ORDER_MSB_FIRST,             \
+}
+
+typedef struct
+{
+    uint8_t const * p_tx_buffer;
+    size_t          tx_length;
+    uint8_t       * p_rx_buffer;
+    size_t          rx_length;
+} nrfx_spim_xfer_desc_t;
+
+#define NRFX_SPIM_XFER_TRX(p_tx_buf, tx_len, p_rx_buf, rx_len)          \
+{                                                                       \
+    .p_tx_buffer = (uint8_t const *)(p_tx_buf),                         \
+    .tx_length   = (tx_len),                                            \
+    .p_rx_buffer = (p_rx_buf),                                          \
+    .rx_length   = (rx_len),                                            \
+}
+
+#define NRFX_SPIM_XFER_TX(p_buf, length)    NRFX_SPIM_XFER_TRX(p_buf, length, NULL, 0)
+
+typedef enum
+{
+    NRFX_SPIM_EVENT_DONE,
+} nrfx_spim_evt_type_t;
+
+typedef struct
+{
+    nrfx_spim_evt_type_t  type;
+    nrfx_spim_xfer_desc_t xfer_desc;
+} nrfx_spim_evt_t;
+
+typedef void (* nrfx_spim_evt_handler_t)(nrfx_spim_evt_t const * p_event, void * p_context);
+
+nrfx_err_t nrfx_spim_init(nrfx_spim_t const *        p_instance,
+                          nrfx_spim_config_t const * p_config,
+                          nrfx_spim_evt_handler_t    handler,
+                          void *                     p_context);
+
+void nrfx_spim_uninit(nrfx_spim_t const * p_instance);
+
+nrfx_err_t nrfx_spim_xfer(nrfx_spim_t const *           p_instance,
+                          nrfx_spim_xfer_desc_t const * p_xfer_desc,
+                          uint32_t                      flags);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // NRFX_SPIM_H__
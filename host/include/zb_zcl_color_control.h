@@ -0,0 +1,96 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @brief Stand-in of the Color Control cluster definitions of ZBOSS for the host build.
+ */
+
+#ifndef ZB_ZCL_COLOR_CONTROL_H
+#define ZB_ZCL_COLOR_CONTROL_H 1
+
+#include "zboss_api.h"
+
+#define ZB_ZCL_ATTR_COLOR_CONTROL_CURRENT_HUE_ID            0x0000U
+#define ZB_ZCL_ATTR_COLOR_CONTROL_CURRENT_SATURATION_ID     0x0001U
+#define ZB_ZCL_ATTR_COLOR_CONTROL_REMAINING_TIME_ID         0x0002U
+#define ZB_ZCL_ATTR_COLOR_CONTROL_CURRENT_X_ID              0x0003U
+#define ZB_ZCL_ATTR_COLOR_CONTROL_CURRENT_Y_ID              0x0004U
+#define ZB_ZCL_ATTR_COLOR_CONTROL_COLOR_TEMPERATURE_ID      0x0007U
+#define ZB_ZCL_ATTR_COLOR_CONTROL_COLOR_MODE_ID             0x0008U
+#define ZB_ZCL_ATTR_COLOR_CONTROL_OPTIONS_ID                0x000fU
+#define ZB_ZCL_ATTR_COLOR_CONTROL_ENHANCED_CURRENT_HUE_ID   0x4000U
+#define ZB_ZCL_ATTR_COLOR_CONTROL_ENHANCED_COLOR_MODE_ID    0x4001U
+#define ZB_ZCL_ATTR_COLOR_CONTROL_COLOR_LOOP_ACTIVE_ID      0x4002U
+#define ZB_ZCL_ATTR_COLOR_CONTROL_COLOR_LOOP_DIRECTION_ID   0x4003U
+#define ZB_ZCL_ATTR_COLOR_CONTROL_COLOR_LOOP_TIME_ID        0x4004U
+#define ZB_ZCL_ATTR_COLOR_CONTROL_COLOR_CAPABILITIES_ID     0x400aU
+
+#define ZB_ZCL_CMD_COLOR_CONTROL_MOVE_TO_HUE                0x00U
+#define ZB_ZCL_CMD_COLOR_CONTROL_MOVE_HUE                   0x01U
+#define ZB_ZCL_CMD_COLOR_CONTROL_STEP_HUE                   0x02U
+#define ZB_ZCL_CMD_COLOR_CONTROL_MOVE_TO_SATURATION         0x03U
+#define ZB_ZCL_CMD_COLOR_CONTROL_MOVE_SATURATION            0x04U
+#define ZB_ZCL_CMD_COLOR_CONTROL_STEP_SATURATION            0x05U
+#define ZB_ZCL_CMD_COLOR_CONTROL_MOVE_TO_HUE_SATURATION     0x06U
+#define ZB_ZCL_CMD_COLOR_CONTROL_MOVE_TO_COLOR              0x07U
+#define ZB_ZCL_CMD_COLOR_CONTROL_MOVE_COLOR                 0x08U
+#define ZB_ZCL_CMD_COLOR_CONTROL_STEP_COLOR                 0x09U
+#define ZB_ZCL_CMD_COLOR_CONTROL_MOVE_TO_COLOR_TEMPERATURE  0x0aU
+#define ZB_ZCL_CMD_COLOR_CONTROL_COLOR_LOOP_SET             0x44U
+#define ZB_ZCL_CMD_COLOR_CONTROL_STOP_MOVE_STEP             0x47U
+
+#define ZB_ZCL_COLOR_CONTROL_HUE_RED                        0x00U
+#define ZB_ZCL_COLOR_CONTROL_CURRENT_SATURATION_MAX_VALUE   0xfeU
+#define ZB_ZCL_COLOR_CONTROL_COLOR_TEMPERATURE_DEF_VALUE    0x00faU
+#define ZB_ZCL_COLOR_CONTROL_REMAINING_TIME_MIN_VALUE       0x0000U
+
+#define ZB_ZCL_COLOR_CONTROL_COLOR_MODE_HUE_SATURATION      0x00U
+#define ZB_ZCL_COLOR_CONTROL_COLOR_MODE_CURRENT_X_Y         0x01U
+#define ZB_ZCL_COLOR_CONTROL_COLOR_MODE_TEMPERATURE         0x02U
+
+#define ZB_ZCL_COLOR_CONTROL_OPTIONS_EXECUTE_IF_OFF         0x01U
+
+#define ZB_ZCL_COLOR_CONTROL_CAPABILITIES_HUE_SATURATION    (1U << 0)
+#define ZB_ZCL_COLOR_CONTROL_CAPABILITIES_EX_HUE            (1U << 1)
+#define ZB_ZCL_COLOR_CONTROL_CAPABILITIES_COLOR_LOOP        (1U << 2)
+#define ZB_ZCL_COLOR_CONTROL_CAPABILITIES_X_Y               (1U << 3)
+#define ZB_ZCL_COLOR_CONTROL_CAPABILITIES_COLOR_TEMP        (1U << 4)
+
+#endif // ZB_ZCL_COLOR_CONTROL_H
@@ -0,0 +1,257 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @brief Stand-in of the ZBOSS API for the host build.
+ *
+ * Covers the scheduler, buffers and ZCL attribute access used by the light. Alarms run on the virtual clock in
+ * thread context, with the resolution of a beacon interval as in ZBOSS. Attributes are written through a registry
+ * filled by the test, see sim_zboss.h.
+ */
+
+#ifndef ZBOSS_API_H
+#define ZBOSS_API_H 1
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef uint8_t     zb_uint8_t;
+typedef int8_t      zb_int8_t;
+typedef uint16_t    zb_uint16_t;
+typedef int16_t     zb_int16_t;
+typedef uint32_t    zb_uint32_t;
+typedef int32_t     zb_int32_t;
+typedef uint64_t    zb_uint64_t;
+typedef unsigned    zb_uint_t;
+typedef int         zb_int_t;
+typedef uint8_t     zb_bool_t;
+typedef char        zb_char_t;
+typedef void        zb_void_t;
+typedef zb_int32_t  zb_ret_t;
+typedef zb_uint8_t  zb_bufid_t;
+typedef zb_uint32_t zb_time_t;
+typedef zb_uint8_t  zb_ieee_addr_t[8];
+
+#define ZB_TRUE     1
+#define ZB_FALSE    0
+
+#define RET_OK                  0
+#define RET_ERROR               (-1)
+#define RET_BLOCKED             (-2)
+#define RET_EXIT                (-3)
+#define RET_BUSY                (-4)
+#define RET_INVALID_PARAMETER   (-7)
+#define RET_NOT_FOUND           (-9)
+#define RET_OVERFLOW            (-20)
+#define RET_NOT_IMPLEMENTED     (-27)
+
+typedef void       (* zb_callback_t)(zb_uint8_t param);
+typedef zb_uint8_t (* zb_device_handler_t)(zb_bufid_t bufid);
+
+/* Scheduler */
+#define ZB_BEACON_INTERVAL_USEC                 15360U
+#define ZB_MILLISECONDS_TO_BEACON_INTERVAL(ms)  (((zb_time_t)(ms) * 1000U + (ZB_BEACON_INTERVAL_USEC - 1U)) / ZB_BEACON_INTERVAL_USEC)
+#define ZB_TIME_ONE_SECOND                      ZB_MILLISECONDS_TO_BEACON_INTERVAL(1000)
+#define ZB_ALARM_ANY_PARAM                      ((zb_uint8_t)(-1))
+
+zb_ret_t zb_schedule_app_callback(zb_callback_t func, zb_uint8_t param);
+zb_ret_t zb_schedule_app_alarm(zb_callback_t func, zb_uint8_t param, zb_time_t timeout_bi);
+zb_ret_t zb_schedule_alarm_cancel(zb_callback_t func, zb_uint8_t param, zb_uint8_t * p_param);
+
+#define ZB_SCHEDULE_APP_CALLBACK(func, param)           zb_schedule_app_callback((func), (param))
+#define ZB_SCHEDULE_APP_ALARM(func, param, timeout_bi)  zb_schedule_app_alarm((func), (param), (timeout_bi))
+#define ZB_SCHEDULE_APP_ALARM_CANCEL(func, param)       zb_schedule_alarm_cancel((func), (param), NULL)
+
+/* Buffers */
+void *     zb_buf_begin(zb_bufid_t buf);
+zb_uint_t  zb_buf_len(zb_bufid_t buf);
+void *     zb_buf_get_tail_func(zb_bufid_t buf, zb_uint_t size);
+void       zb_buf_free(zb_bufid_t buf);
+
+#define ZB_BUF_GET_PARAM(buf, type)     ((type *)zb_buf_get_tail_func((buf), sizeof(type)))
+
+/* ZCL */
+#define ZB_ZCL_VERSION                      2
+
+#define ZB_ZCL_CLUSTER_ID_BASIC             0x0000U
+#define ZB_ZCL_CLUSTER_ID_IDENTIFY          0x0003U
+#define ZB_ZCL_CLUSTER_ID_GROUPS            0x0004U
+#define ZB_ZCL_CLUSTER_ID_SCENES            0x0005U
+#define ZB_ZCL_CLUSTER_ID_ON_OFF            0x0006U
+#define ZB_ZCL_CLUSTER_ID_LEVEL_CONTROL     0x0008U
+#define ZB_ZCL_CLUSTER_ID_COLOR_CONTROL     0x0300U
+
+#define ZB_ZCL_CLUSTER_SERVER_ROLE          0x01U
+#define ZB_ZCL_CLUSTER_CLIENT_ROLE          0x02U
+
+#define ZB_ZCL_FRAME_DIRECTION_TO_SRV       0x00U
+#define ZB_ZCL_FRAME_DIRECTION_TO_CLI       0x01U
+
+typedef enum
+{
+    ZB_ZCL_STATUS_SUCCESS       = 0x00,
+    ZB_ZCL_STATUS_FAIL          = 0x01,
+    ZB_ZCL_STATUS_UNSUP_ATTRIB  = 0x86,
+    ZB_ZCL_STATUS_INVALID_VALUE = 0x87,
+} zb_zcl_status_t;
+
+typedef struct
+{
+    zb_uint16_t source_addr;
+    zb_uint8_t  src_endpoint;
+    zb_uint8_t  dst_endpoint;
+} zb_zcl_addr_common_data_t;
+
+typedef struct
+{
+    struct
+    {
+        zb_zcl_addr_common_data_t source;
+        zb_uint8_t                src_endpoint;
+        zb_uint8_t                dst_endpoint;
+    } common_data;
+} zb_zcl_addr_t;
+
+typedef struct
+{
+    zb_zcl_addr_t addr_data;
+    zb_uint16_t   cluster_id;
+    zb_uint16_t   profile_id;
+    zb_uint8_t    cmd_id;
+    zb_uint8_t    cmd_direction;
+    zb_uint8_t    seq_number;
+    zb_bool_t     is_common_command;
+    zb_bool_t     disable_default_response;
+    zb_bool_t     is_manuf_specific;
+    zb_uint16_t   manuf_specific;
+} zb_zcl_parsed_hdr_t;
+
+/* Value of an attribute passed to ZB_ZCL_DEVICE_CB_ID_SET_ATTR_VALUE_CB_ID callback */
+typedef struct
+{
+    zb_uint16_t cluster_id;
+    zb_uint16_t attr_id;
+    union
+    {
+        zb_uint8_t  data8;
+        zb_uint16_t data16;
+        zb_uint32_t data32;
+        zb_uint8_t  data_buf[8];
+    } values;
+} zb_zcl_set_attr_value_param_t;
+
+/**@brief Function for writing an attribute of an endpoint, as ZBOSS does for ZB_ZCL_SET_ATTRIBUTE. */
+zb_zcl_status_t zb_zcl_set_attr_val(zb_uint8_t   ep,
+                                    zb_uint16_t  cluster_id,
+                                    zb_uint8_t   cluster_role,
+                                    zb_uint16_t  attr_id,
+                                    zb_uint8_t * value,
+                                    zb_bool_t    check_access);
+
+#define ZB_ZCL_SET_ATTRIBUTE(ep, cluster_id, cluster_role, attr_id, value_ptr, check_access) \
+    zb_zcl_set_attr_val((ep), (cluster_id), (cluster_role), (attr_id), (zb_uint8_t *)(value_ptr), (check_access))
+
+#define ZB_ZCL_STRING_CONST_SIZE(str)           (zb_uint8_t)(sizeof(str) - 1)
+#define ZB_ZCL_SET_STRING_VAL(str, val, len)    (memcpy((zb_uint8_t *)(str) + 1, (val), (len)), ((zb_uint8_t *)(str))[0] = (zb_uint8_t)(len))
+
+/* Endpoint handlers are registered by the device declaration, which is not built for host */
+#define ZB_AF_SET_IDENTIFY_NOTIFICATION_HANDLER(ep, func)   ((void)(ep), (void)(func))
+#define ZB_AF_SET_ENDPOINT_HANDLER(ep, handler)             ((void)(ep), (void)(handler))
+
+/* Basic cluster */
+#define ZB_ZCL_BASIC_POWER_SOURCE_DC_SOURCE             0x04U
+#define ZB_ZCL_BASIC_ENV_UNSPECIFIED                    0x00U
+
+/* Identify cluster */
+#define ZB_ZCL_IDENTIFY_IDENTIFY_TIME_DEFAULT_VALUE     0x0000U
+
+enum zb_zcl_identify_trigger_effect_e
+{
+    ZB_ZCL_IDENTIFY_EFFECT_ID_BLINK          = 0x00,
+    ZB_ZCL_IDENTIFY_EFFECT_ID_BREATHE        = 0x01,
+    ZB_ZCL_IDENTIFY_EFFECT_ID_OKAY           = 0x02,
+    ZB_ZCL_IDENTIFY_EFFECT_ID_CHANNEL_CHANGE = 0x0b,
+    ZB_ZCL_IDENTIFY_EFFECT_ID_FINISH_EFFECT  = 0xfe,
+    ZB_ZCL_IDENTIFY_EFFECT_ID_STOP           = 0xff,
+};
+
+/* Scenes cluster */
+#define ZB_ZCL_CMD_SCENES_ADD_SCENE                     0x00U
+#define ZB_ZCL_CMD_SCENES_VIEW_SCENE                    0x01U
+#define ZB_ZCL_CMD_SCENES_REMOVE_SCENE                  0x02U
+#define ZB_ZCL_CMD_SCENES_REMOVE_ALL_SCENES             0x03U
+#define ZB_ZCL_CMD_SCENES_STORE_SCENE                   0x04U
+#define ZB_ZCL_CMD_SCENES_RECALL_SCENE                  0x05U
+
+/* On/Off cluster */
+#define ZB_ZCL_ATTR_ON_OFF_ON_OFF_ID                    0x0000U
+#define ZB_ZCL_ON_OFF_IS_OFF                            0U
+#define ZB_ZCL_ON_OFF_IS_ON                             1U
+
+#define ZB_ZCL_CMD_ON_OFF_OFF_ID                        0x00U
+#define ZB_ZCL_CMD_ON_OFF_ON_ID                         0x01U
+#define ZB_ZCL_CMD_ON_OFF_TOGGLE_ID                     0x02U
+
+/* Level control cluster */
+#define ZB_ZCL_ATTR_LEVEL_CONTROL_CURRENT_LEVEL_ID      0x0000U
+#define ZB_ZCL_ATTR_LEVEL_CONTROL_REMAINING_TIME_ID     0x0001U
+#define ZB_ZCL_ATTR_LEVEL_CONTROL_MOVE_STATUS_ID        0xefffU
+#define ZB_ZCL_LEVEL_CONTROL_LEVEL_MAX_VALUE            0xffU
+#define ZB_ZCL_LEVEL_CONTROL_REMAINING_TIME_DEFAULT_VALUE 0x0000U
+
+#define ZB_ZCL_CMD_LEVEL_CONTROL_MOVE_TO_LEVEL              0x00U
+#define ZB_ZCL_CMD_LEVEL_CONTROL_MOVE                       0x01U
+#define ZB_ZCL_CMD_LEVEL_CONTROL_STEP                       0x02U
+#define ZB_ZCL_CMD_LEVEL_CONTROL_STOP                       0x03U
+#define ZB_ZCL_CMD_LEVEL_CONTROL_MOVE_TO_LEVEL_WITH_ON_OFF  0x04U
+#define ZB_ZCL_CMD_LEVEL_CONTROL_MOVE_WITH_ON_OFF           0x05U
+#define ZB_ZCL_CMD_LEVEL_CONTROL_STEP_WITH_ON_OFF           0x06U
+#define ZB_ZCL_CMD_LEVEL_CONTROL_STOP_WITH_ON_OFF           0x07U
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ZBOSS_API_H
@@ -0,0 +1,194 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @defgroup zigbee_examples_host_app_timer app_timer.c
+ * @{
+ * @ingroup zigbee_examples
+ *
+ * @brief app_timer running on the virtual clock.
+ */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "app_timer.h"
+#include "nrf_error.h"
+#include "app_util_platform.h"
+
+#define RTC_FREQUENCY   (APP_TIMER_CLOCK_FREQ / (APP_TIMER_CONFIG_RTC_FREQUENCY + 1))
+
+#define TIMERS_COUNT_MAX    16U
+
+/* Timers which have been created, so app_timer_stop_all can find them */
+static app_timer_t * m_timers[TIMERS_COUNT_MAX];
+static size_t        m_timers_count;
+
+/**@brief Function for getting current RTC tick, not wrapped. */
+static uint64_t tick_now(void)
+{
+    return (sim_clock_now() * RTC_FREQUENCY) / 1000000000ULL;
+}
+
+/**@brief Function for getting time of the beginning of an RTC tick. */
+static uint64_t tick_to_ns(uint64_t tick)
+{
+    return ((tick * 1000000000ULL) + RTC_FREQUENCY - 1U) / RTC_FREQUENCY;
+}
+
+static void timer_expired(void * p_context)
+{
+    app_timer_t * p_timer = (app_timer_t *)p_context;
+
+    if (p_timer->mode == APP_TIMER_MODE_REPEATED)
+    {
+        p_timer->end_tick += p_timer->repeat_period;
+        sim_clock_schedule(&p_timer->event, tick_to_ns(p_timer->end_tick));
+    }
+    else
+    {
+        p_timer->active = false;
+    }
+
+    p_timer->handler(p_timer->p_context);
+}
+
+ret_code_t app_timer_init(void)
+{
+    m_timers_count = 0U;
+
+    return NRF_SUCCESS;
+}
+
+ret_code_t app_timer_create(app_timer_id_t const *      p_timer_id,
+                            app_timer_mode_t            mode,
+                            app_timer_timeout_handler_t timeout_handler)
+{
+    app_timer_t * p_timer;
+
+    if ((p_timer_id == NULL) || (*p_timer_id == NULL) || (timeout_handler == NULL))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    p_timer = *p_timer_id;
+    if (p_timer->active)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    p_timer->handler = timeout_handler;
+    p_timer->mode    = mode;
+    p_timer->active  = false;
+    sim_clock_event_init(&p_timer->event, timer_expired, p_timer, true);
+
+    if (m_timers_count < TIMERS_COUNT_MAX)
+    {
+        m_timers[m_timers_count++] = p_timer;
+    }
+
+    return NRF_SUCCESS;
+}
+
+ret_code_t app_timer_start(app_timer_id_t timer_id, uint32_t timeout_ticks, void * p_context)
+{
+    if ((timeout_ticks < APP_TIMER_MIN_TIMEOUT_TICKS) || (timeout_ticks > APP_TIMER_MAX_CNT_VAL))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+    if ((timer_id == NULL) || (timer_id->handler == NULL))
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    CRITICAL_REGION_ENTER();
+    if (!timer_id->active)
+    {
+        timer_id->active        = true;
+        timer_id->p_context     = p_context;
+        timer_id->repeat_period = timeout_ticks;
+        timer_id->end_tick      = tick_now() + timeout_ticks;
+        sim_clock_schedule(&timer_id->event, tick_to_ns(timer_id->end_tick));
+    }
+    CRITICAL_REGION_EXIT();
+
+    return NRF_SUCCESS;
+}
+
+ret_code_t app_timer_stop(app_timer_id_t timer_id)
+{
+    if (timer_id == NULL)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    CRITICAL_REGION_ENTER();
+    sim_clock_cancel(&timer_id->event);
+    timer_id->active = false;
+    CRITICAL_REGION_EXIT();
+
+    return NRF_SUCCESS;
+}
+
+ret_code_t app_timer_stop_all(void)
+{
+    size_t i;
+
+    for (i = 0; i < m_timers_count; i++)
+    {
+        UNUSED_RETURN_VALUE(app_timer_stop(m_timers[i]));
+    }
+
+    return NRF_SUCCESS;
+}
+
+uint32_t app_timer_cnt_get(void)
+{
+    return (uint32_t)(tick_now() & APP_TIMER_MAX_CNT_VAL);
+}
+
+uint32_t app_timer_cnt_diff_compute(uint32_t ticks_to, uint32_t ticks_from)
+{
+    return (ticks_to - ticks_from) & APP_TIMER_MAX_CNT_VAL;
+}
+
+/**
+ * @}
+ */
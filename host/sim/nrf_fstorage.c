@@ -0,0 +1,299 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @defgroup zigbee_examples_host_nrf_fstorage nrf_fstorage.c
+ * @{
+ * @ingroup zigbee_examples
+ */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "nordic_common.h"
+#include "nrf_error.h"
+#include "nrf_fstorage.h"
+#include "nrf_fstorage_nvmc.h"
+#include "sim_clock.h"
+#include "sim_fstorage.h"
+
+typedef struct
+{
+    uint32_t addr;
+    uint8_t  data[SIM_FSTORAGE_PAGE_SIZE];
+} page_t;
+
+static page_t   m_pages[SIM_FSTORAGE_PAGES_COUNT_MAX];
+static size_t   m_pages_count;
+static uint32_t m_words_written;
+static uint32_t m_pages_erased;
+
+static nrf_fstorage_info_t m_flash_info =
+{
+    .erase_unit   = SIM_FSTORAGE_PAGE_SIZE,
+    .program_unit = sizeof(uint32_t),
+    .rmap         = true,
+    .wmap         = false,
+};
+
+static ret_code_t nvmc_init(nrf_fstorage_t * p_fs, void * p_param)
+{
+    (void)p_param;
+
+    p_fs->p_flash_info = &m_flash_info;
+
+    return NRF_SUCCESS;
+}
+
+nrf_fstorage_api_t nrf_fstorage_nvmc =
+{
+    .init = nvmc_init,
+};
+
+/**@brief Function for getting the simulated page containing an address, allocating it if needed. */
+static page_t * page_get(uint32_t addr)
+{
+    uint32_t page_addr = addr & ~(SIM_FSTORAGE_PAGE_SIZE - 1U);
+    size_t   idx;
+
+    for (idx = 0; idx < m_pages_count; idx++)
+    {
+        if (m_pages[idx].addr == page_addr)
+        {
+            return &m_pages[idx];
+        }
+    }
+
+    if (m_pages_count == SIM_FSTORAGE_PAGES_COUNT_MAX)
+    {
+        return NULL;
+    }
+
+    m_pages[m_pages_count].addr = page_addr;
+    memset(m_pages[m_pages_count].data, 0xFF, SIM_FSTORAGE_PAGE_SIZE);
+
+    return &m_pages[m_pages_count++];
+}
+
+static bool range_check(nrf_fstorage_t const * p_fs, uint32_t addr, uint32_t len)
+{
+    return (addr >= p_fs->start_addr) && (len <= p_fs->end_addr - p_fs->start_addr) &&
+           (addr - p_fs->start_addr <= p_fs->end_addr - p_fs->start_addr - len);
+}
+
+static void evt_send(nrf_fstorage_t const * p_fs, nrf_fstorage_evt_id_t id, uint32_t addr,
+                     void const * p_src, uint32_t len, void * p_param)
+{
+    nrf_fstorage_evt_t evt =
+    {
+        .id      = id,
+        .result  = NRF_SUCCESS,
+        .addr    = addr,
+        .p_src   = p_src,
+        .len     = len,
+        .p_param = p_param,
+    };
+
+    if (p_fs->evt_handler != NULL)
+    {
+        p_fs->evt_handler(&evt);
+    }
+}
+
+void sim_fstorage_reset(void)
+{
+    m_pages_count   = 0U;
+    m_words_written = 0U;
+    m_pages_erased  = 0U;
+}
+
+uint32_t sim_fstorage_words_written_get(void)
+{
+    return m_words_written;
+}
+
+uint32_t sim_fstorage_pages_erased_get(void)
+{
+    return m_pages_erased;
+}
+
+ret_code_t nrf_fstorage_init(nrf_fstorage_t * p_fs, nrf_fstorage_api_t const * p_api, void * p_param)
+{
+    if ((p_fs == NULL) || (p_api == NULL))
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    p_fs->p_api = p_api;
+
+    return p_api->init(p_fs, p_param);
+}
+
+ret_code_t nrf_fstorage_uninit(nrf_fstorage_t * p_fs, void * p_param)
+{
+    (void)p_param;
+
+    p_fs->p_api = NULL;
+
+    return NRF_SUCCESS;
+}
+
+ret_code_t nrf_fstorage_read(nrf_fstorage_t const * p_fs, uint32_t addr, void * p_dest, uint32_t len)
+{
+    uint8_t * p_dst = (uint8_t *)p_dest;
+
+    if (p_fs->p_api == NULL)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+    if (!range_check(p_fs, addr, len))
+    {
+        return NRF_ERROR_INVALID_ADDR;
+    }
+
+    while (len > 0U)
+    {
+        page_t * p_page = page_get(addr);
+        uint32_t offset = addr % SIM_FSTORAGE_PAGE_SIZE;
+        uint32_t chunk  = MIN(len, SIM_FSTORAGE_PAGE_SIZE - offset);
+
+        if (p_page == NULL)
+        {
+            return NRF_ERROR_NO_MEM;
+        }
+        memcpy(p_dst, &p_page->data[offset], chunk);
+        p_dst += chunk;
+        addr  += chunk;
+        len   -= chunk;
+    }
+
+    return NRF_SUCCESS;
+}
+
+ret_code_t nrf_fstorage_write(nrf_fstorage_t const * p_fs,
+                              uint32_t               dest,
+                              void           const * p_src,
+                              uint32_t               len,
+                              void                 * p_param)
+{
+    uint8_t const * p_data = (uint8_t const *)p_src;
+    uint32_t        addr   = dest;
+    uint32_t        idx;
+
+    if (p_fs->p_api == NULL)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+    if (((dest % sizeof(uint32_t)) != 0U) || ((len % sizeof(uint32_t)) != 0U) || (len == 0U))
+    {
+        return NRF_ERROR_INVALID_LENGTH;
+    }
+    if (!range_check(p_fs, dest, len))
+    {
+        return NRF_ERROR_INVALID_ADDR;
+    }
+
+    for (idx = 0; idx < len; idx++, addr++)
+    {
+        page_t * p_page = page_get(addr);
+
+        if (p_page == NULL)
+        {
+            return NRF_ERROR_NO_MEM;
+        }
+        /* NOR flash: programming clears bits only */
+        p_page->data[addr % SIM_FSTORAGE_PAGE_SIZE] &= p_data[idx];
+    }
+
+    m_words_written += len / sizeof(uint32_t);
+    sim_clock_stall((len / sizeof(uint32_t)) * SIM_FSTORAGE_WORD_WRITE_NS);
+
+    evt_send(p_fs, NRF_FSTORAGE_EVT_WRITE_RESULT, dest, p_src, len, p_param);
+
+    return NRF_SUCCESS;
+}
+
+ret_code_t nrf_fstorage_erase(nrf_fstorage_t const * p_fs, uint32_t page_addr, uint32_t len, void * p_param)
+{
+    uint32_t page;
+
+    if (p_fs->p_api == NULL)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+    if (((page_addr % SIM_FSTORAGE_PAGE_SIZE) != 0U) || (len == 0U))
+    {
+        return NRF_ERROR_INVALID_ADDR;
+    }
+    if (!range_check(p_fs, page_addr, len * SIM_FSTORAGE_PAGE_SIZE))
+    {
+        return NRF_ERROR_INVALID_ADDR;
+    }
+
+    for (page = 0U; page < len; page++)
+    {
+        page_t * p_page = page_get(page_addr + (page * SIM_FSTORAGE_PAGE_SIZE));
+
+        if (p_page == NULL)
+        {
+            return NRF_ERROR_NO_MEM;
+        }
+        memset(p_page->data, 0xFF, SIM_FSTORAGE_PAGE_SIZE);
+    }
+
+    m_pages_erased += len;
+    sim_clock_stall(len * SIM_FSTORAGE_PAGE_ERASE_NS);
+
+    evt_send(p_fs, NRF_FSTORAGE_EVT_ERASE_RESULT, page_addr, NULL, len, p_param);
+
+    return NRF_SUCCESS;
+}
+
+bool nrf_fstorage_is_busy(nrf_fstorage_t const * p_fs)
+{
+    (void)p_fs;
+
+    return false;
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,367 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @defgroup zigbee_examples_host_nrfx_pwm nrfx_pwm.c
+ * @{
+ * @ingroup zigbee_examples
+ *
+ * @brief nrfx PWM driver on top of the simulated peripheral. Follows the nrfx implementation, so playback,
+ *        shorts and interrupt enabling behave as on the device.
+ */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "nrfx_pwm.h"
+#include "hal/nrf_gpio.h"
+#include "sim_pwm.h"
+
+typedef struct
+{
+    nrfx_pwm_handler_t        handler;
+    nrfx_drv_state_t volatile state;
+    uint8_t                   flags;
+} pwm_control_block_t;
+
+static pwm_control_block_t m_cb[SIM_PWM_INSTANCES_COUNT];
+
+static void configure_pins(nrfx_pwm_t const * p_instance, nrfx_pwm_config_t const * p_config)
+{
+    uint32_t out_pins[NRF_PWM_CHANNEL_COUNT];
+    uint8_t  i;
+
+    for (i = 0; i < NRF_PWM_CHANNEL_COUNT; ++i)
+    {
+        uint8_t output_pin = p_config->output_pins[i];
+        if (output_pin != NRFX_PWM_PIN_NOT_USED)
+        {
+            bool inverted = output_pin &  NRFX_PWM_PIN_INVERTED;
+            out_pins[i]   = output_pin & ~NRFX_PWM_PIN_INVERTED;
+
+            nrf_gpio_pin_write(out_pins[i], inverted ? 1U : 0U);
+            nrf_gpio_cfg_output(out_pins[i]);
+        }
+        else
+        {
+            out_pins[i] = NRF_PWM_PIN_NOT_CONNECTED;
+        }
+    }
+
+    nrf_pwm_pins_set(p_instance->p_registers, out_pins);
+}
+
+nrfx_err_t nrfx_pwm_init(nrfx_pwm_t const *        p_instance,
+                         nrfx_pwm_config_t const * p_config,
+                         nrfx_pwm_handler_t        handler)
+{
+    pwm_control_block_t * p_cb = &m_cb[p_instance->drv_inst_idx];
+
+    if (p_cb->state != NRFX_DRV_STATE_UNINITIALIZED)
+    {
+        return NRFX_ERROR_INVALID_STATE;
+    }
+
+    p_cb->handler = handler;
+
+    configure_pins(p_instance, p_config);
+
+    nrf_pwm_enable(p_instance->p_registers);
+    nrf_pwm_configure(p_instance->p_registers,
+        p_config->base_clock, p_config->count_mode, p_config->top_value);
+    nrf_pwm_decoder_set(p_instance->p_registers,
+        p_config->load_mode, p_config->step_mode);
+
+    nrf_pwm_shorts_set(p_instance->p_registers, 0);
+    nrf_pwm_int_set(p_instance->p_registers, 0);
+    nrf_pwm_event_clear(p_instance->p_registers, NRF_PWM_EVENT_LOOPSDONE);
+    nrf_pwm_event_clear(p_instance->p_registers, NRF_PWM_EVENT_SEQEND0);
+    nrf_pwm_event_clear(p_instance->p_registers, NRF_PWM_EVENT_SEQEND1);
+    nrf_pwm_event_clear(p_instance->p_registers, NRF_PWM_EVENT_STOPPED);
+
+    p_cb->state = NRFX_DRV_STATE_INITIALIZED;
+
+    return NRFX_SUCCESS;
+}
+
+void nrfx_pwm_uninit(nrfx_pwm_t const * p_instance)
+{
+    pwm_control_block_t * p_cb = &m_cb[p_instance->drv_inst_idx];
+
+    nrf_pwm_int_set(p_instance->p_registers, 0);
+    UNUSED_RETURN_VALUE(nrfx_pwm_stop(p_instance, true));
+    nrf_pwm_disable(p_instance->p_registers);
+
+    p_cb->state = NRFX_DRV_STATE_UNINITIALIZED;
+}
+
+static uint32_t start_playback(nrfx_pwm_t const *    p_instance,
+                               pwm_control_block_t * p_cb,
+                               uint8_t               flags,
+                               nrf_pwm_task_t        starting_task)
+{
+    p_cb->state = NRFX_DRV_STATE_POWERED_ON;
+    p_cb->flags = flags;
+
+    if (p_cb->handler)
+    {
+        // The notification about finished playback is by default enabled,
+        // but this can be suppressed.
+        // The notification that the peripheral has stopped is always enabled.
+        uint32_t int_mask = NRF_PWM_INT_LOOPSDONE_MASK |
+                            NRF_PWM_INT_STOPPED_MASK;
+
+        if (flags & NRFX_PWM_FLAG_SIGNAL_END_SEQ0)
+        {
+            int_mask |= NRF_PWM_INT_SEQEND0_MASK;
+        }
+        if (flags & NRFX_PWM_FLAG_SIGNAL_END_SEQ1)
+        {
+            int_mask |= NRF_PWM_INT_SEQEND1_MASK;
+        }
+        if (flags & NRFX_PWM_FLAG_NO_EVT_FINISHED)
+        {
+            int_mask &= ~NRF_PWM_INT_LOOPSDONE_MASK;
+        }
+
+        nrf_pwm_int_set(p_instance->p_registers, int_mask);
+    }
+
+    nrf_pwm_event_clear(p_instance->p_registers, NRF_PWM_EVENT_STOPPED);
+
+    if (flags & NRFX_PWM_FLAG_START_VIA_TASK)
+    {
+        return nrf_pwm_task_address_get(p_instance->p_registers, starting_task);
+    }
+
+    nrf_pwm_task_trigger(p_instance->p_registers, starting_task);
+    return 0;
+}
+
+uint32_t nrfx_pwm_simple_playback(nrfx_pwm_t const *         p_instance,
+                                  nrf_pwm_sequence_t const * p_sequence,
+                                  uint16_t                   playback_count,
+                                  uint32_t                   flags)
+{
+    pwm_control_block_t * p_cb = &m_cb[p_instance->drv_inst_idx];
+    uint16_t              odd;
+    uint32_t              shorts_mask;
+
+    NRFX_ASSERT(p_cb->state != NRFX_DRV_STATE_UNINITIALIZED);
+    NRFX_ASSERT(playback_count > 0);
+
+    // To take advantage of the looping mechanism, we need to use both sequences
+    // (single sequence can be played back only once).
+    nrf_pwm_sequence_set(p_instance->p_registers, 0, p_sequence);
+    nrf_pwm_sequence_set(p_instance->p_registers, 1, p_sequence);
+    odd = (playback_count & 1);
+    nrf_pwm_loop_set(p_instance->p_registers,
+        (playback_count / 2) + (odd ? 1 : 0));
+
+    if (flags & NRFX_PWM_FLAG_STOP)
+    {
+        shorts_mask = NRF_PWM_SHORT_LOOPSDONE_STOP_MASK;
+    }
+    else if (flags & NRFX_PWM_FLAG_LOOP)
+    {
+        shorts_mask = odd ? NRF_PWM_SHORT_LOOPSDONE_SEQSTART1_MASK
+                          : NRF_PWM_SHORT_LOOPSDONE_SEQSTART0_MASK;
+    }
+    else
+    {
+        shorts_mask = 0;
+    }
+    nrf_pwm_shorts_set(p_instance->p_registers, shorts_mask);
+
+    return start_playback(p_instance, p_cb, (uint8_t)flags, odd ? NRF_PWM_TASK_SEQSTART1 : NRF_PWM_TASK_SEQSTART0);
+}
+
+uint32_t nrfx_pwm_complex_playback(nrfx_pwm_t const *         p_instance,
+                                   nrf_pwm_sequence_t const * p_sequence_0,
+                                   nrf_pwm_sequence_t const * p_sequence_1,
+                                   uint16_t                   playback_count,
+                                   uint32_t                   flags)
+{
+    pwm_control_block_t * p_cb = &m_cb[p_instance->drv_inst_idx];
+    uint32_t              shorts_mask;
+
+    NRFX_ASSERT(p_cb->state != NRFX_DRV_STATE_UNINITIALIZED);
+    NRFX_ASSERT(playback_count > 0);
+
+    nrf_pwm_sequence_set(p_instance->p_registers, 0, p_sequence_0);
+    nrf_pwm_sequence_set(p_instance->p_registers, 1, p_sequence_1);
+    nrf_pwm_loop_set(p_instance->p_registers, playback_count);
+
+    if (flags & NRFX_PWM_FLAG_STOP)
+    {
+        shorts_mask = NRF_PWM_SHORT_LOOPSDONE_STOP_MASK;
+    }
+    else if (flags & NRFX_PWM_FLAG_LOOP)
+    {
+        shorts_mask = NRF_PWM_SHORT_LOOPSDONE_SEQSTART0_MASK;
+    }
+    else
+    {
+        shorts_mask = 0;
+    }
+    nrf_pwm_shorts_set(p_instance->p_registers, shorts_mask);
+
+    return start_playback(p_instance, p_cb, (uint8_t)flags, NRF_PWM_TASK_SEQSTART0);
+}
+
+bool nrfx_pwm_is_stopped(nrfx_pwm_t const * p_instance)
+{
+    pwm_control_block_t * p_cb = &m_cb[p_instance->drv_inst_idx];
+    bool ret_val = false;
+
+    // If the event handler is used (interrupts are enabled), the state will
+    // be changed in interrupt handler when the STOPPED event occurs.
+    if (nrf_pwm_event_check(p_instance->p_registers, NRF_PWM_EVENT_STOPPED))
+    {
+        p_cb->state = NRFX_DRV_STATE_INITIALIZED;
+    }
+
+    if (p_cb->state != NRFX_DRV_STATE_POWERED_ON)
+    {
+        ret_val = true;
+    }
+
+    return ret_val;
+}
+
+bool nrfx_pwm_stop(nrfx_pwm_t const * p_instance, bool wait_until_stopped)
+{
+    bool ret_val = false;
+
+    nrf_pwm_shorts_set(p_instance->p_registers, 0);
+
+    if (nrfx_pwm_is_stopped(p_instance))
+    {
+        ret_val = true;
+    }
+    else
+    {
+        nrf_pwm_task_trigger(p_instance->p_registers, NRF_PWM_TASK_STOP);
+
+        do {
+            if (nrfx_pwm_is_stopped(p_instance))
+            {
+                ret_val = true;
+                break;
+            }
+        } while (wait_until_stopped);
+    }
+
+    return ret_val;
+}
+
+void sim_pwm_driver_reset(void)
+{
+    memset(m_cb, 0, sizeof(m_cb));
+}
+
+static void irq_handler(NRF_PWM_Type * p_pwm, pwm_control_block_t * p_cb)
+{
+    // The user handler is called for SEQEND0 and SEQEND1 events only when the
+    // user asks for it (by setting proper flags when starting the playback).
+    if (nrf_pwm_event_check(p_pwm, NRF_PWM_EVENT_SEQEND0))
+    {
+        nrf_pwm_event_clear(p_pwm, NRF_PWM_EVENT_SEQEND0);
+        if ((p_cb->flags & NRFX_PWM_FLAG_SIGNAL_END_SEQ0) && p_cb->handler)
+        {
+            p_cb->handler(NRFX_PWM_EVT_END_SEQ0);
+        }
+    }
+    if (nrf_pwm_event_check(p_pwm, NRF_PWM_EVENT_SEQEND1))
+    {
+        nrf_pwm_event_clear(p_pwm, NRF_PWM_EVENT_SEQEND1);
+        if ((p_cb->flags & NRFX_PWM_FLAG_SIGNAL_END_SEQ1) && p_cb->handler)
+        {
+            p_cb->handler(NRFX_PWM_EVT_END_SEQ1);
+        }
+    }
+    // For LOOPSDONE the handler is called by default, but the user can disable
+    // this (via flags).
+    if (nrf_pwm_event_check(p_pwm, NRF_PWM_EVENT_LOOPSDONE))
+    {
+        nrf_pwm_event_clear(p_pwm, NRF_PWM_EVENT_LOOPSDONE);
+        if (!(p_cb->flags & NRFX_PWM_FLAG_NO_EVT_FINISHED) && p_cb->handler)
+        {
+            p_cb->handler(NRFX_PWM_EVT_FINISHED);
+        }
+    }
+
+    // The STOPPED event is always propagated to the user handler.
+    if (nrf_pwm_event_check(p_pwm, NRF_PWM_EVENT_STOPPED))
+    {
+        nrf_pwm_event_clear(p_pwm, NRF_PWM_EVENT_STOPPED);
+
+        p_cb->state = NRFX_DRV_STATE_INITIALIZED;
+        if (p_cb->handler)
+        {
+            p_cb->handler(NRFX_PWM_EVT_STOPPED);
+        }
+    }
+}
+
+void PWM0_IRQHandler(void)
+{
+    irq_handler(NRF_PWM0, &m_cb[0]);
+}
+
+void PWM1_IRQHandler(void)
+{
+    irq_handler(NRF_PWM1, &m_cb[1]);
+}
+
+void PWM2_IRQHandler(void)
+{
+    irq_handler(NRF_PWM2, &m_cb[2]);
+}
+
+void PWM3_IRQHandler(void)
+{
+    irq_handler(NRF_PWM3, &m_cb[3]);
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,146 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @defgroup zigbee_examples_host_sim_apa102 sim_apa102.c
+ * @{
+ * @ingroup zigbee_examples
+ */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "sim_spim.h"
+#include "sim_apa102.h"
+
+#define APA102_START_FRAME_BYTES    4U
+#define APA102_HEADER_MASK          0xE0U
+
+/**@brief Function for getting the number of zero bytes, which latch a frame of given length. */
+static uint32_t latch_bytes_get(size_t pixels_count)
+{
+    /* Half a bit per LED, then 32 bits */
+    return (uint32_t)(((pixels_count + 15U) / 16U) + APA102_START_FRAME_BYTES);
+}
+
+static void frame_latch(sim_apa102_decoder_t * p_decoder, uint64_t time_ps)
+{
+    p_decoder->pixels_count   = p_decoder->bytes_count / SIM_APA102_PIXEL_BYTES;
+    p_decoder->frame_start_ps = p_decoder->start_ps;
+    p_decoder->frame_end_ps   = time_ps;
+    memcpy(p_decoder->frame, p_decoder->bytes, p_decoder->bytes_count);
+    p_decoder->frames_count++;
+
+    p_decoder->in_frame    = false;
+    p_decoder->bytes_count = 0U;
+    p_decoder->zeros_count = 0U;
+}
+
+static void byte_handler(uint8_t byte, uint64_t time_ps, void * p_context)
+{
+    sim_apa102_decoder_t * p_decoder = (sim_apa102_decoder_t *)p_context;
+
+    if (!p_decoder->in_frame)
+    {
+        /* Waiting for the start frame */
+        if (byte == 0U)
+        {
+            p_decoder->zeros_count++;
+            if (p_decoder->zeros_count >= APA102_START_FRAME_BYTES)
+            {
+                p_decoder->in_frame    = true;
+                p_decoder->zeros_count = 0U;
+            }
+        }
+        else
+        {
+            p_decoder->errors_count++;
+            p_decoder->zeros_count = 0U;
+        }
+        return;
+    }
+
+    if ((p_decoder->bytes_count % SIM_APA102_PIXEL_BYTES) != 0U)
+    {
+        /* Blue, green or red */
+        p_decoder->bytes[p_decoder->bytes_count++] = byte;
+        if (p_decoder->bytes_count == SIM_APA102_PIXEL_BYTES)
+        {
+            p_decoder->start_ps = time_ps;
+        }
+    }
+    else if (byte == 0U)
+    {
+        /* End frame, or more zeros of the start frame */
+        p_decoder->zeros_count++;
+        if ((p_decoder->bytes_count > 0U) &&
+            (p_decoder->zeros_count >= latch_bytes_get(p_decoder->bytes_count / SIM_APA102_PIXEL_BYTES)))
+        {
+            frame_latch(p_decoder, time_ps);
+        }
+    }
+    else if (((byte & APA102_HEADER_MASK) == APA102_HEADER_MASK) &&
+             ((p_decoder->zeros_count == 0U) || (p_decoder->bytes_count == 0U)) &&
+             (p_decoder->bytes_count < sizeof(p_decoder->bytes)))
+    {
+        p_decoder->bytes[p_decoder->bytes_count++] = byte;
+        p_decoder->zeros_count = 0U;
+    }
+    else
+    {
+        /* Not a pixel, or pixels of a new frame before the previous one has been latched */
+        p_decoder->errors_count++;
+        p_decoder->in_frame    = false;
+        p_decoder->bytes_count = 0U;
+        p_decoder->zeros_count = 0U;
+    }
+}
+
+void sim_apa102_decoder_init(sim_apa102_decoder_t * p_decoder, uint8_t spim_instance_no)
+{
+    memset(p_decoder, 0, sizeof(*p_decoder));
+
+    sim_spim_listen(spim_instance_no, byte_handler, p_decoder);
+}
+
+/**
+ * @}
+ */
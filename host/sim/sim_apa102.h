@@ -0,0 +1,95 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @defgroup zigbee_examples_host_sim_apa102 sim_apa102.h
+ * @{
+ * @ingroup zigbee_examples
+ *
+ * @brief Decoder of the APA102/SK9822 data stream of a SPIM instance, acting as the LED chain.
+ *
+ * A frame starts with at least 32 zero bits, followed by pixels, 32 bits each, which start with three 1 bits.
+ * Every LED delays the clock by half a period, so the last pixel is displayed only after another half a bit per LED
+ * has been clocked out, and SK9822 latches the frame after 32 more zero bits. The frame is latched when the zero
+ * bits following the pixels cover both. Other bytes in place of a pixel, and a new frame started before the
+ * previous one is latched, are errors.
+ */
+
+#ifndef SIM_APA102_H__
+#define SIM_APA102_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SIM_APA102_PIXELS_MAX           1024U
+#define SIM_APA102_PIXEL_BYTES          4U
+
+typedef struct
+{
+    uint8_t  bytes[SIM_APA102_PIXELS_MAX * SIM_APA102_PIXEL_BYTES]; /**< Frame being received. */
+    size_t   bytes_count;                                           /**< Bytes of pixels of the frame being received. */
+    uint32_t zeros_count;                                           /**< Zero bytes received in a row. */
+    bool     in_frame;                                              /**< true after the start frame. */
+    uint64_t start_ps;                                              /**< Time of the first pixel being received. */
+    uint8_t  frame[SIM_APA102_PIXELS_MAX * SIM_APA102_PIXEL_BYTES]; /**< Last latched frame, as sent: header, B, G, R. */
+    size_t   pixels_count;                                          /**< Pixels of the last latched frame. */
+    uint64_t frame_start_ps;                                        /**< End of the first pixel of the last frame. */
+    uint64_t frame_end_ps;                                          /**< Time of latching the last frame. */
+    uint32_t frames_count;                                          /**< Number of latched frames. */
+    uint32_t errors_count;                                          /**< Number of errors. */
+} sim_apa102_decoder_t;
+
+/**@brief Function for attaching a decoder to a SPIM instance. Must be called after sim_spim_reset. */
+void sim_apa102_decoder_init(sim_apa102_decoder_t * p_decoder, uint8_t spim_instance_no);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIM_APA102_H__ */
+
+/**
+ * @}
+ */
@@ -0,0 +1,273 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @defgroup zigbee_examples_host_sim_clock sim_clock.c
+ * @{
+ * @ingroup zigbee_examples
+ */
+/* PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP */
+#define _GNU_SOURCE
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <pthread.h>
+#include <time.h>
+
+#include "sim_clock.h"
+
+#define SIM_CLOCK_SYNC_HOOKS_MAX    8U
+
+volatile uint64_t sim_irq_latency_ns;
+
+static sim_clock_event_t * mp_queue;
+static volatile uint64_t   m_now_ns;
+static sim_clock_sync_t    m_sync_hooks[SIM_CLOCK_SYNC_HOOKS_MAX];
+static size_t              m_sync_hooks_count;
+
+/* Queue may be modified from other threads of a test, interrupts are dispatched from the thread running the clock */
+static pthread_mutex_t     m_queue_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t     m_irq_mutex   = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+
+/**@brief Function for removing an event from the queue, queue mutex must be held. */
+static void queue_remove(sim_clock_event_t * p_event)
+{
+    sim_clock_event_t ** pp_prev = &mp_queue;
+
+    while (*pp_prev != NULL)
+    {
+        if (*pp_prev == p_event)
+        {
+            *pp_prev           = p_event->p_next;
+            p_event->scheduled = false;
+            p_event->p_next    = NULL;
+            return;
+        }
+        pp_prev = &(*pp_prev)->p_next;
+    }
+}
+
+/**@brief Function for calling sync hooks with given time. */
+static void sync_all(uint64_t time_ns)
+{
+    size_t i;
+
+    for (i = 0; i < m_sync_hooks_count; i++)
+    {
+        m_sync_hooks[i](time_ns);
+    }
+}
+
+void sim_clock_reset(void)
+{
+    pthread_mutex_lock(&m_queue_mutex);
+    while (mp_queue != NULL)
+    {
+        queue_remove(mp_queue);
+    }
+    m_now_ns           = 0U;
+    m_sync_hooks_count = 0U;
+    pthread_mutex_unlock(&m_queue_mutex);
+}
+
+uint64_t sim_clock_now(void)
+{
+    return m_now_ns;
+}
+
+void sim_clock_event_init(sim_clock_event_t * p_event, sim_clock_handler_t handler, void * p_context, bool irq)
+{
+    p_event->time_ns   = 0U;
+    p_event->handler   = handler;
+    p_event->p_context = p_context;
+    p_event->irq       = irq;
+    p_event->scheduled = false;
+    p_event->p_next    = NULL;
+}
+
+void sim_clock_schedule(sim_clock_event_t * p_event, uint64_t time_ns)
+{
+    sim_clock_event_t ** pp_prev;
+
+    pthread_mutex_lock(&m_queue_mutex);
+    if (p_event->scheduled)
+    {
+        queue_remove(p_event);
+    }
+    if (time_ns < m_now_ns)
+    {
+        time_ns = m_now_ns;
+    }
+
+    /* Sorted by time, FIFO among events of the same time */
+    pp_prev = &mp_queue;
+    while ((*pp_prev != NULL) && ((*pp_prev)->time_ns <= time_ns))
+    {
+        pp_prev = &(*pp_prev)->p_next;
+    }
+    p_event->time_ns   = time_ns;
+    p_event->p_next    = *pp_prev;
+    p_event->scheduled = true;
+    *pp_prev           = p_event;
+    pthread_mutex_unlock(&m_queue_mutex);
+}
+
+void sim_clock_cancel(sim_clock_event_t * p_event)
+{
+    pthread_mutex_lock(&m_queue_mutex);
+    if (p_event->scheduled)
+    {
+        queue_remove(p_event);
+    }
+    pthread_mutex_unlock(&m_queue_mutex);
+}
+
+void sim_clock_sync_register(sim_clock_sync_t sync)
+{
+    if (m_sync_hooks_count < SIM_CLOCK_SYNC_HOOKS_MAX)
+    {
+        m_sync_hooks[m_sync_hooks_count++] = sync;
+    }
+}
+
+bool sim_clock_run_next(uint64_t limit_ns)
+{
+    sim_clock_event_t * p_event;
+
+    pthread_mutex_lock(&m_queue_mutex);
+    p_event = mp_queue;
+    if ((p_event == NULL) || (p_event->time_ns > limit_ns))
+    {
+        pthread_mutex_unlock(&m_queue_mutex);
+        return false;
+    }
+    queue_remove(p_event);
+    if (p_event->time_ns > m_now_ns)
+    {
+        /* Events overdue after a stall are dispatched late */
+        m_now_ns = p_event->time_ns;
+    }
+    pthread_mutex_unlock(&m_queue_mutex);
+
+    /* Peripherals sample DMA buffers up to now, before the handler may modify them */
+    sync_all(m_now_ns);
+
+    if (p_event->irq)
+    {
+        sim_irq_lock();
+        p_event->handler(p_event->p_context);
+        sim_irq_unlock();
+    }
+    else
+    {
+        p_event->handler(p_event->p_context);
+    }
+
+    return true;
+}
+
+void sim_clock_run_until(uint64_t time_ns)
+{
+    while (sim_clock_run_next(time_ns))
+    {
+    }
+
+    pthread_mutex_lock(&m_queue_mutex);
+    if (time_ns > m_now_ns)
+    {
+        m_now_ns = time_ns;
+    }
+    pthread_mutex_unlock(&m_queue_mutex);
+
+    sync_all(m_now_ns);
+}
+
+void sim_clock_advance(uint64_t delta_ns)
+{
+    sim_clock_run_until(m_now_ns + delta_ns);
+}
+
+void sim_clock_stall(uint64_t delta_ns)
+{
+    pthread_mutex_lock(&m_queue_mutex);
+    m_now_ns += delta_ns;
+    pthread_mutex_unlock(&m_queue_mutex);
+
+    sync_all(m_now_ns);
+}
+
+bool sim_clock_run_until_idle(uint64_t limit_ns)
+{
+    bool idle;
+
+    while (sim_clock_run_next(limit_ns))
+    {
+    }
+
+    pthread_mutex_lock(&m_queue_mutex);
+    idle = (mp_queue == NULL);
+    pthread_mutex_unlock(&m_queue_mutex);
+
+    return idle;
+}
+
+void sim_irq_lock(void)
+{
+    pthread_mutex_lock(&m_irq_mutex);
+}
+
+void sim_irq_unlock(void)
+{
+    pthread_mutex_unlock(&m_irq_mutex);
+}
+
+uint32_t sim_cpu_clock_get_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint32_t)(((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec);
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,164 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @defgroup zigbee_examples_host_sim_clock sim_clock.h
+ * @{
+ * @ingroup zigbee_examples
+ *
+ * @brief Virtual clock of the host simulation.
+ *
+ * Time only advances while events are dispatched, so simulated peripherals, app_timer and the ZBOSS scheduler
+ * run in a deterministic order, independent of the speed of the host. Code called by a test (thread context)
+ * takes no virtual time. Events marked as interrupts are dispatched with the simulated interrupt lock held,
+ * which is also taken by critical sections of the code under test.
+ */
+
+#ifndef SIM_CLOCK_H__
+#define SIM_CLOCK_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SIM_CLOCK_NS_PER_US     1000ULL
+#define SIM_CLOCK_NS_PER_MS     1000000ULL
+
+/**@brief Function called when an event expires. */
+typedef void (* sim_clock_handler_t)(void * p_context);
+
+/**@brief Function called before every event, so peripherals can catch up with time up to @p time_ns. */
+typedef void (* sim_clock_sync_t)(uint64_t time_ns);
+
+/**@brief Event of the virtual clock. Owned by the caller, must stay valid while scheduled. */
+typedef struct sim_clock_event_s
+{
+    uint64_t                   time_ns;     /**< Expiration time. */
+    sim_clock_handler_t        handler;     /**< Function called on expiration. */
+    void                     * p_context;   /**< Parameter passed to @c handler. */
+    bool                       irq;         /**< true if the handler runs in interrupt context. */
+    bool                       scheduled;   /**< true while the event is in the queue. */
+    struct sim_clock_event_s * p_next;      /**< Next event in the queue. */
+} sim_clock_event_t;
+
+/**@brief Delay between a peripheral event and the call of its interrupt handler, in nanoseconds.
+ *        Used by simulated peripherals to model interrupt latency, 0 by default. */
+extern volatile uint64_t sim_irq_latency_ns;
+
+/**@brief Function for resetting the clock to 0 and dropping all events and sync hooks. */
+void sim_clock_reset(void);
+
+/**@brief Function for getting current virtual time. */
+uint64_t sim_clock_now(void);
+
+/**@brief Function for initializing an event.
+ *
+ * @param[out] p_event      Event to be initialized.
+ * @param[in]  handler      Function called on expiration.
+ * @param[in]  p_context    Parameter passed to @p handler.
+ * @param[in]  irq          true if @p handler runs in interrupt context.
+ */
+void sim_clock_event_init(sim_clock_event_t * p_event, sim_clock_handler_t handler, void * p_context, bool irq);
+
+/**@brief Function for scheduling an event at an absolute time. A scheduled event is moved.
+ *
+ * Events of the same time are dispatched in the order of scheduling. Times in the past expire right away.
+ */
+void sim_clock_schedule(sim_clock_event_t * p_event, uint64_t time_ns);
+
+/**@brief Function for removing an event from the queue. Does nothing if it is not scheduled. */
+void sim_clock_cancel(sim_clock_event_t * p_event);
+
+/**@brief Function for registering a hook called before every event with the time of the event. */
+void sim_clock_sync_register(sim_clock_sync_t sync);
+
+/**@brief Function for dispatching the first event, if it expires not later than @p limit_ns.
+ *
+ * @return true if an event has been dispatched.
+ */
+bool sim_clock_run_next(uint64_t limit_ns);
+
+/**@brief Function for dispatching all events up to @p time_ns and setting the clock to it. */
+void sim_clock_run_until(uint64_t time_ns);
+
+/**@brief Function for dispatching all events in the next @p delta_ns. */
+void sim_clock_advance(uint64_t delta_ns);
+
+/**@brief Function for advancing time without dispatching events, as when the CPU is halted.
+ *
+ * Events which expire meanwhile are dispatched late, by the next call which runs the clock.
+ */
+void sim_clock_stall(uint64_t delta_ns);
+
+/**@brief Function for dispatching events until the queue is empty or @p limit_ns is reached.
+ *
+ * @return true if the queue is empty.
+ */
+bool sim_clock_run_until_idle(uint64_t limit_ns);
+
+/**@brief Function for masking simulated interrupts, may be nested. */
+void sim_irq_lock(void);
+
+/**@brief Function for unmasking simulated interrupts. */
+void sim_irq_unlock(void);
+
+/**@brief Function for reading the cycle counter of the host CPU, used as profiler clock. */
+static inline uint32_t sim_cpu_clock_get(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return (uint32_t)__builtin_ia32_rdtsc();
+#else
+    extern uint32_t sim_cpu_clock_get_ns(void);
+    return sim_cpu_clock_get_ns();
+#endif
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIM_CLOCK_H__ */
+
+/**
+ * @}
+ */
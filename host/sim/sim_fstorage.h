@@ -0,0 +1,84 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @defgroup zigbee_examples_host_sim_fstorage sim_fstorage.h
+ * @{
+ * @ingroup zigbee_examples
+ *
+ * @brief Simulated flash behind nrf_fstorage.
+ *
+ * Pages are allocated when first accessed and start erased. Writes can only clear bits, as on NOR flash.
+ * Operations complete synchronously, as with the NVMC backend, and stall the virtual clock for the typical
+ * programming and erase times of nRF52840, as the CPU is halted meanwhile.
+ */
+
+#ifndef SIM_FSTORAGE_H__
+#define SIM_FSTORAGE_H__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SIM_FSTORAGE_PAGE_SIZE          4096U
+#define SIM_FSTORAGE_PAGES_COUNT_MAX    8U
+#define SIM_FSTORAGE_WORD_WRITE_NS      41000ULL    /**< Time of programming a word, tWRITE. */
+#define SIM_FSTORAGE_PAGE_ERASE_NS      85000000ULL /**< Time of erasing a page, tERASEPAGE. */
+
+/**@brief Function for erasing all simulated flash and clearing the counters. */
+void sim_fstorage_reset(void);
+
+/**@brief Function for getting the number of written words since reset. */
+uint32_t sim_fstorage_words_written_get(void);
+
+/**@brief Function for getting the number of erased pages since reset. */
+uint32_t sim_fstorage_pages_erased_get(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIM_FSTORAGE_H__ */
+
+/**
+ * @}
+ */
@@ -0,0 +1,110 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @defgroup zigbee_examples_host_sim_gpio sim_gpio.c
+ * @{
+ * @ingroup zigbee_examples
+ */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "sim_gpio.h"
+
+typedef struct
+{
+    bool                level;
+    uint32_t            edges;
+    sim_gpio_listener_t listener;
+    void              * p_context;
+} sim_gpio_pin_t;
+
+static sim_gpio_pin_t m_pins[SIM_GPIO_PINS_COUNT];
+
+void sim_gpio_reset(void)
+{
+    memset(m_pins, 0, sizeof(m_pins));
+}
+
+void sim_gpio_listen(uint32_t pin, sim_gpio_listener_t listener, void * p_context)
+{
+    if (pin < SIM_GPIO_PINS_COUNT)
+    {
+        m_pins[pin].listener  = listener;
+        m_pins[pin].p_context = p_context;
+    }
+}
+
+void sim_gpio_write(uint32_t pin, bool level, uint64_t time_ps)
+{
+    sim_gpio_pin_t * p_pin;
+
+    if (pin >= SIM_GPIO_PINS_COUNT)
+    {
+        return;
+    }
+
+    p_pin = &m_pins[pin];
+    if (p_pin->level != level)
+    {
+        p_pin->level = level;
+        p_pin->edges++;
+        if (p_pin->listener != NULL)
+        {
+            p_pin->listener(pin, level, time_ps, p_pin->p_context);
+        }
+    }
+}
+
+bool sim_gpio_read(uint32_t pin)
+{
+    return (pin < SIM_GPIO_PINS_COUNT) ? m_pins[pin].level : false;
+}
+
+uint32_t sim_gpio_edges_get(uint32_t pin)
+{
+    return (pin < SIM_GPIO_PINS_COUNT) ? m_pins[pin].edges : 0U;
+}
+
+/**
+ * @}
+ */
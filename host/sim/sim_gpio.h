@@ -0,0 +1,96 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @defgroup zigbee_examples_host_sim_gpio sim_gpio.h
+ * @{
+ * @ingroup zigbee_examples
+ *
+ * @brief Output pins of the host simulation.
+ *
+ * Peripherals driving a pin report every level with a timestamp in picoseconds, which keeps fractions of
+ * the 16 MHz PWM clock exact. Listeners are called only when the level changes, so they see edges.
+ */
+
+#ifndef SIM_GPIO_H__
+#define SIM_GPIO_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SIM_GPIO_PINS_COUNT     64U
+
+/**@brief Function called on a change of the level of a pin.
+ *
+ * @param[in] pin       Pin number.
+ * @param[in] level     New level.
+ * @param[in] time_ps   Time of the edge, in picoseconds.
+ * @param[in] p_context Parameter given on registration.
+ */
+typedef void (* sim_gpio_listener_t)(uint32_t pin, bool level, uint64_t time_ps, void * p_context);
+
+/**@brief Function for setting all pins low and removing all listeners. */
+void sim_gpio_reset(void);
+
+/**@brief Function for registering the listener of a pin, replacing the previous one. */
+void sim_gpio_listen(uint32_t pin, sim_gpio_listener_t listener, void * p_context);
+
+/**@brief Function for driving a pin. Edges of a pin must be reported in order of time. */
+void sim_gpio_write(uint32_t pin, bool level, uint64_t time_ps);
+
+/**@brief Function for reading the level of a pin. */
+bool sim_gpio_read(uint32_t pin);
+
+/**@brief Function for getting the number of edges of a pin since reset. */
+uint32_t sim_gpio_edges_get(uint32_t pin);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIM_GPIO_H__ */
+
+/**
+ * @}
+ */
@@ -0,0 +1,434 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @defgroup zigbee_examples_host_sim_i2s sim_i2s.c
+ * @{
+ * @ingroup zigbee_examples
+ */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "nordic_common.h"
+#include "sim_clock.h"
+#include "sim_gpio.h"
+#include "sim_i2s.h"
+
+#define I2S_MCK_BASE_PS     31250ULL        /**< Period of the 32 MHz source of MCK, in picoseconds. */
+#define I2S_PSEL_DISCONNECT (1UL << 31)
+#define I2S_EVENTS_BASE     0x100U
+#define I2S_WORD_BITS       32U
+
+/**@brief State of the transmission, copied from registers when a buffer is taken. */
+typedef struct
+{
+    sim_clock_event_t   buffer_event;       /**< End of the buffer being sent. */
+    sim_clock_event_t   stop_event;         /**< End of the word being sent when STOP was triggered. */
+    sim_clock_event_t   irq_event;          /**< Call of the interrupt handler. */
+    bool                running;
+    uint32_t    const * p_words;
+    uint32_t            words_count;
+    uint32_t            next_word;          /**< First word, which has not been sent yet. */
+    uint64_t            start_ps;           /**< Start of the buffer being sent. */
+    uint64_t            word_ps;
+    uint32_t            sdout_pin;
+    bool                idle_level;
+    uint64_t            last_edge_ps;
+    uint32_t            words_sent;
+} i2s_state_t;
+
+NRF_I2S_Type sim_i2s_registers;
+
+static i2s_state_t m_i2s;
+
+/* Interrupt handler, defined by the driver */
+extern void I2S_IRQHandler(void);
+
+static volatile uint32_t * reg_get(NRF_I2S_Type const * p_reg, uint32_t offset)
+{
+    return (volatile uint32_t *)((uintptr_t)p_reg + offset);
+}
+
+static uint64_t ps_to_ns(uint64_t time_ps)
+{
+    return (time_ps + 999U) / 1000U;
+}
+
+/**@brief Function for getting the mask of generated events, in the format of INTEN. */
+static uint32_t events_mask_get(NRF_I2S_Type const * p_reg)
+{
+    uint32_t mask = 0U;
+    uint32_t bit;
+
+    for (bit = 1U; bit <= 5U; bit++)
+    {
+        if (*reg_get(p_reg, I2S_EVENTS_BASE + (bit * sizeof(uint32_t))) != 0U)
+        {
+            mask |= (1UL << bit);
+        }
+    }
+
+    return mask;
+}
+
+/**@brief Function for requesting the interrupt, if an enabled event is generated. */
+static void irq_update(void)
+{
+    if (((sim_i2s_registers.INTEN & events_mask_get(&sim_i2s_registers)) != 0U) && !m_i2s.irq_event.scheduled)
+    {
+        sim_clock_schedule(&m_i2s.irq_event, sim_clock_now() + sim_irq_latency_ns);
+    }
+}
+
+static void event_generate(nrf_i2s_event_t event)
+{
+    *reg_get(&sim_i2s_registers, event) = 1U;
+    irq_update();
+}
+
+static void irq_event_handler(void * p_context)
+{
+    UNUSED_PARAMETER(p_context);
+
+    I2S_IRQHandler();
+
+    /* Events left uncleared request the interrupt again */
+    irq_update();
+}
+
+static void pin_write(bool level, uint64_t time_ps)
+{
+    sim_gpio_write(m_i2s.sdout_pin, level, time_ps);
+    if (time_ps > m_i2s.last_edge_ps)
+    {
+        m_i2s.last_edge_ps = time_ps;
+    }
+}
+
+/**@brief Function for writing the waveform of one word to SDOUT, left sample first. */
+static void word_send(uint32_t word_no)
+{
+    uint64_t time_ps = m_i2s.start_ps + (word_no * m_i2s.word_ps);
+    uint64_t bit_ps  = m_i2s.word_ps / I2S_WORD_BITS;
+    uint32_t word    = m_i2s.p_words[word_no];
+    uint32_t samples = (word << 16) | (word >> 16);
+    uint32_t bit;
+
+    if ((m_i2s.sdout_pin & I2S_PSEL_DISCONNECT) == 0U)
+    {
+        for (bit = 0U; bit < I2S_WORD_BITS; bit++)
+        {
+            pin_write((samples & (1UL << 31)) != 0U, time_ps + (bit * bit_ps));
+            samples <<= 1;
+        }
+    }
+
+    m_i2s.words_sent++;
+}
+
+/**@brief Function for sending all words, which start not later than @p time_ps. */
+static void words_sample(uint64_t time_ps)
+{
+    while (m_i2s.running &&
+           (m_i2s.next_word < m_i2s.words_count) &&
+           ((m_i2s.start_ps + (m_i2s.next_word * m_i2s.word_ps)) <= time_ps))
+    {
+        word_send(m_i2s.next_word);
+        m_i2s.next_word++;
+    }
+}
+
+static void sync_handler(uint64_t time_ns)
+{
+    words_sample(time_ns * 1000U);
+}
+
+/**@brief Function for taking the buffer from TXD.PTR and sending it from @p start_ps. */
+static void buffer_take(uint64_t start_ps)
+{
+    m_i2s.p_words     = (uint32_t const *)sim_i2s_registers.TXD_PTR;
+    m_i2s.words_count = sim_i2s_registers.RXTXD_MAXCNT;
+    m_i2s.start_ps    = start_ps;
+    m_i2s.next_word   = 0U;
+
+    event_generate(NRF_I2S_EVENT_TXPTRUPD);
+
+    /* First word is loaded right away */
+    words_sample(MAX(start_ps, sim_clock_now() * 1000U));
+
+    sim_clock_schedule(&m_i2s.buffer_event, ps_to_ns(start_ps + (m_i2s.words_count * m_i2s.word_ps)));
+}
+
+static void buffer_event_handler(void * p_context)
+{
+    uint64_t end_ps = m_i2s.start_ps + (m_i2s.words_count * m_i2s.word_ps);
+
+    UNUSED_PARAMETER(p_context);
+
+    words_sample(end_ps);
+    buffer_take(end_ps);
+}
+
+static void stop_event_handler(void * p_context)
+{
+    UNUSED_PARAMETER(p_context);
+
+    event_generate(NRF_I2S_EVENT_STOPPED);
+}
+
+/**@brief Function for getting the period of a word, from the configuration of the clocks. */
+static uint64_t word_ps_get(void)
+{
+    static const uint32_t ratios[] = {32U, 48U, 64U, 96U, 128U, 192U, 256U, 384U, 512U};
+    uint64_t              mck_divider;
+
+    switch (sim_i2s_registers.CONFIG.MCKFREQ)
+    {
+        case NRF_I2S_MCK_32MDIV8:
+            mck_divider = 8U;
+            break;
+
+        case NRF_I2S_MCK_32MDIV10:
+            mck_divider = 10U;
+            break;
+
+        case NRF_I2S_MCK_32MDIV16:
+            mck_divider = 16U;
+            break;
+
+        default:
+            mck_divider = 32U;
+            break;
+    }
+
+    /* Every word is one LRCK period of 16-bit stereo samples */
+    return I2S_MCK_BASE_PS * mck_divider * ratios[MIN(sim_i2s_registers.CONFIG.RATIO, ARRAY_SIZE(ratios) - 1U)];
+}
+
+static void start_task(void)
+{
+    if (m_i2s.running)
+    {
+        return;
+    }
+
+    m_i2s.running    = true;
+    m_i2s.sdout_pin  = sim_i2s_registers.PSEL.SDOUT;
+    m_i2s.word_ps    = word_ps_get();
+    /* Level driven by GPIO is restored when the transmission stops */
+    m_i2s.idle_level = ((m_i2s.sdout_pin & I2S_PSEL_DISCONNECT) == 0U) && sim_gpio_read(m_i2s.sdout_pin);
+
+    buffer_take(MAX(sim_clock_now() * 1000U, m_i2s.last_edge_ps));
+}
+
+static void stop_task(void)
+{
+    uint64_t stop_ps = sim_clock_now() * 1000U;
+
+    if (m_i2s.running)
+    {
+        words_sample(stop_ps);
+
+        /* Word being sent is finished first */
+        stop_ps = MAX(stop_ps, m_i2s.start_ps + (m_i2s.next_word * m_i2s.word_ps));
+        sim_clock_cancel(&m_i2s.buffer_event);
+        m_i2s.running = false;
+
+        if ((m_i2s.sdout_pin & I2S_PSEL_DISCONNECT) == 0U)
+        {
+            pin_write(m_i2s.idle_level, stop_ps);
+        }
+    }
+
+    sim_clock_schedule(&m_i2s.stop_event, ps_to_ns(stop_ps));
+}
+
+void sim_i2s_reset(void)
+{
+    memset(&sim_i2s_registers, 0, sizeof(sim_i2s_registers));
+    memset(&m_i2s, 0, sizeof(m_i2s));
+
+    sim_clock_event_init(&m_i2s.buffer_event, buffer_event_handler, NULL, true);
+    sim_clock_event_init(&m_i2s.stop_event, stop_event_handler, NULL, true);
+    sim_clock_event_init(&m_i2s.irq_event, irq_event_handler, NULL, true);
+
+    sim_i2s_registers.PSEL.MCK   = NRF_I2S_PIN_NOT_CONNECTED;
+    sim_i2s_registers.PSEL.SCK   = NRF_I2S_PIN_NOT_CONNECTED;
+    sim_i2s_registers.PSEL.LRCK  = NRF_I2S_PIN_NOT_CONNECTED;
+    sim_i2s_registers.PSEL.SDIN  = NRF_I2S_PIN_NOT_CONNECTED;
+    sim_i2s_registers.PSEL.SDOUT = NRF_I2S_PIN_NOT_CONNECTED;
+
+    sim_clock_sync_register(sync_handler);
+}
+
+bool sim_i2s_is_running(void)
+{
+    return m_i2s.running;
+}
+
+uint32_t sim_i2s_words_get(void)
+{
+    return m_i2s.words_sent;
+}
+
+void nrf_i2s_task_trigger(NRF_I2S_Type * p_reg, nrf_i2s_task_t task)
+{
+    if (p_reg->ENABLE == 0U)
+    {
+        return;
+    }
+
+    sim_irq_lock();
+    switch (task)
+    {
+        case NRF_I2S_TASK_START:
+            start_task();
+            break;
+
+        case NRF_I2S_TASK_STOP:
+            stop_task();
+            break;
+
+        default:
+            break;
+    }
+    sim_irq_unlock();
+}
+
+void nrf_i2s_event_clear(NRF_I2S_Type * p_reg, nrf_i2s_event_t event)
+{
+    *reg_get(p_reg, event) = 0U;
+}
+
+bool nrf_i2s_event_check(NRF_I2S_Type const * p_reg, nrf_i2s_event_t event)
+{
+    return *reg_get(p_reg, event) != 0U;
+}
+
+void nrf_i2s_int_enable(NRF_I2S_Type * p_reg, uint32_t mask)
+{
+    p_reg->INTEN |= mask;
+    irq_update();
+}
+
+void nrf_i2s_int_disable(NRF_I2S_Type * p_reg, uint32_t mask)
+{
+    p_reg->INTEN &= ~mask;
+}
+
+bool nrf_i2s_int_enable_check(NRF_I2S_Type const * p_reg, nrf_i2s_int_mask_t mask)
+{
+    return (p_reg->INTEN & mask) != 0U;
+}
+
+void nrf_i2s_enable(NRF_I2S_Type * p_reg)
+{
+    p_reg->ENABLE = 1U;
+}
+
+void nrf_i2s_disable(NRF_I2S_Type * p_reg)
+{
+    p_reg->ENABLE = 0U;
+}
+
+void nrf_i2s_pins_set(NRF_I2S_Type * p_reg,
+                      uint32_t       sck_pin,
+                      uint32_t       lrck_pin,
+                      uint32_t       mck_pin,
+                      uint32_t       sdout_pin,
+                      uint32_t       sdin_pin)
+{
+    p_reg->PSEL.SCK   = sck_pin;
+    p_reg->PSEL.LRCK  = lrck_pin;
+    p_reg->PSEL.MCK   = mck_pin;
+    p_reg->PSEL.SDOUT = sdout_pin;
+    p_reg->PSEL.SDIN  = sdin_pin;
+}
+
+bool nrf_i2s_configure(NRF_I2S_Type *     p_reg,
+                       nrf_i2s_mode_t     mode,
+                       nrf_i2s_format_t   format,
+                       nrf_i2s_align_t    alignment,
+                       nrf_i2s_swidth_t   sample_width,
+                       nrf_i2s_channels_t channels,
+                       nrf_i2s_mck_t      mck_setup,
+                       nrf_i2s_ratio_t    ratio)
+{
+    /* As the HAL: in master mode the ratio must be a multiple of 2 * sample width */
+    if ((mode == NRF_I2S_MODE_MASTER) &&
+        (((sample_width == NRF_I2S_SWIDTH_16BIT) && (ratio == NRF_I2S_RATIO_48X)) ||
+         ((sample_width == NRF_I2S_SWIDTH_24BIT) && ((ratio == NRF_I2S_RATIO_32X)  ||
+                                                     (ratio == NRF_I2S_RATIO_64X)  ||
+                                                     (ratio == NRF_I2S_RATIO_128X) ||
+                                                     (ratio == NRF_I2S_RATIO_256X) ||
+                                                     (ratio == NRF_I2S_RATIO_512X)))))
+    {
+        return false;
+    }
+
+    p_reg->CONFIG.MODE     = mode;
+    p_reg->CONFIG.FORMAT   = format;
+    p_reg->CONFIG.ALIGN    = alignment;
+    p_reg->CONFIG.SWIDTH   = sample_width;
+    p_reg->CONFIG.CHANNELS = channels;
+    p_reg->CONFIG.RATIO    = ratio;
+    p_reg->CONFIG.MCKEN    = (mck_setup != NRF_I2S_MCK_DISABLED) ? 1U : 0U;
+    p_reg->CONFIG.MCKFREQ  = mck_setup;
+
+    return true;
+}
+
+void nrf_i2s_transfer_set(NRF_I2S_Type *   p_reg,
+                          uint16_t         size,
+                          uint32_t *       p_rx_buffer,
+                          uint32_t const * p_tx_buffer)
+{
+    p_reg->RXTXD_MAXCNT    = size;
+    p_reg->CONFIG.RXEN     = (p_rx_buffer != NULL) ? 1U : 0U;
+    p_reg->CONFIG.TXEN     = (p_tx_buffer != NULL) ? 1U : 0U;
+    p_reg->RXD_PTR         = (uintptr_t)p_rx_buffer;
+    p_reg->TXD_PTR         = (uintptr_t)p_tx_buffer;
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,86 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @defgroup zigbee_examples_host_sim_i2s sim_i2s.h
+ * @{
+ * @ingroup zigbee_examples
+ *
+ * @brief Simulation of the I2S peripheral, transmitting in master mode.
+ *
+ * Words are read from RAM when they start to be sent and SDOUT is written to sim_gpio bit by bit, MSB first,
+ * left sample (lower half-word) first. TXPTRUPD is generated when TXD.PTR is taken: at START and then every
+ * RXTXD.MAXCNT words, when the next buffer is taken from TXD.PTR. STOP takes effect at the end of the word being
+ * sent, then SDOUT returns to the level it had before START and STOPPED is generated. Interrupts are level
+ * triggered and are delayed by @ref sim_irq_latency_ns.
+ *
+ * Not simulated: reception, slave mode, samples other than 16-bit stereo, SCK, LRCK and MCK pins.
+ */
+
+#ifndef SIM_I2S_H__
+#define SIM_I2S_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "hal/nrf_i2s.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**@brief Function for clearing registers. Must be called after @ref sim_clock_reset. */
+void sim_i2s_reset(void);
+
+/**@brief Function for checking if the peripheral is transmitting. */
+bool sim_i2s_is_running(void);
+
+/**@brief Function for getting the number of words sent since reset. */
+uint32_t sim_i2s_words_get(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIM_I2S_H__ */
+
+/**
+ * @}
+ */
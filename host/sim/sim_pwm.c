@@ -0,0 +1,598 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @defgroup zigbee_examples_host_sim_pwm sim_pwm.c
+ * @{
+ * @ingroup zigbee_examples
+ */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "nordic_common.h"
+#include "sim_clock.h"
+#include "sim_gpio.h"
+#include "sim_pwm.h"
+
+#define PWM_TICK_PS         62500ULL        /**< Period of the 16 MHz base clock, in picoseconds. */
+#define PWM_PSEL_DISCONNECT (1UL << 31)
+#define PWM_EVENTS_BASE     (offsetof(NRF_PWM_Type, EVENTS_STOPPED) - sizeof(uint32_t))
+
+/**@brief State of a sequence being played, copied from registers when it starts. */
+typedef struct
+{
+    sim_clock_event_t   seq_event;          /**< SEQEND or the end of the sequence. */
+    sim_clock_event_t   irq_event;          /**< Call of the interrupt handler. */
+    bool                playing;
+    bool                seqend_pending;     /**< true until SEQEND of the current sequence is generated. */
+    uint8_t             seq;
+    uint16_t    const * p_values;
+    uint32_t            values_per_period;
+    uint32_t            values_count;       /**< Number of periods with distinct values. */
+    uint32_t            refresh;
+    uint32_t            periods_count;      /**< Number of periods, with repeats and end delay. */
+    uint32_t            next_period;        /**< First period, which has not been sampled yet. */
+    uint64_t            start_ps;
+    uint64_t            period_ps;
+    uint64_t            tick_ps;
+    uint16_t            top;
+    uint32_t            loops_left;
+    bool                idle_levels[NRF_PWM_CHANNEL_COUNT];
+    uint64_t            last_edge_ps;
+    uint32_t            periods_played;
+} pwm_state_t;
+
+NRF_PWM_Type sim_pwm_registers[SIM_PWM_INSTANCES_COUNT];
+
+static pwm_state_t m_pwm[SIM_PWM_INSTANCES_COUNT];
+
+/* Interrupt handlers, defined by the driver */
+extern void PWM0_IRQHandler(void);
+extern void PWM1_IRQHandler(void);
+extern void PWM2_IRQHandler(void);
+extern void PWM3_IRQHandler(void);
+
+static void (* const m_irq_handlers[SIM_PWM_INSTANCES_COUNT])(void) =
+{
+    PWM0_IRQHandler,
+    PWM1_IRQHandler,
+    PWM2_IRQHandler,
+    PWM3_IRQHandler,
+};
+
+static void seq_start(uint8_t instance_no, uint8_t seq, uint64_t start_ps);
+
+static uint8_t instance_no_get(NRF_PWM_Type const * p_reg)
+{
+    return (uint8_t)(p_reg - sim_pwm_registers);
+}
+
+static volatile uint32_t * reg_get(NRF_PWM_Type const * p_reg, uint32_t offset)
+{
+    return (volatile uint32_t *)((uintptr_t)p_reg + offset);
+}
+
+static uint64_t ps_to_ns(uint64_t time_ps)
+{
+    return (time_ps + 999U) / 1000U;
+}
+
+/**@brief Function for getting the mask of generated events, in the format of INTEN. */
+static uint32_t events_mask_get(NRF_PWM_Type const * p_reg)
+{
+    uint32_t mask = 0U;
+    uint32_t bit;
+
+    for (bit = 1U; bit <= 7U; bit++)
+    {
+        if (*reg_get(p_reg, PWM_EVENTS_BASE + (bit * sizeof(uint32_t))) != 0U)
+        {
+            mask |= (1UL << bit);
+        }
+    }
+
+    return mask;
+}
+
+/**@brief Function for requesting the interrupt, if an enabled event is generated. */
+static void irq_update(uint8_t instance_no)
+{
+    NRF_PWM_Type * p_reg   = &sim_pwm_registers[instance_no];
+    pwm_state_t  * p_state = &m_pwm[instance_no];
+
+    if (((p_reg->INTEN & events_mask_get(p_reg)) != 0U) && !p_state->irq_event.scheduled)
+    {
+        sim_clock_schedule(&p_state->irq_event, sim_clock_now() + sim_irq_latency_ns);
+    }
+}
+
+static void event_generate(uint8_t instance_no, nrf_pwm_event_t event)
+{
+    *reg_get(&sim_pwm_registers[instance_no], event) = 1U;
+    irq_update(instance_no);
+}
+
+static void irq_event_handler(void * p_context)
+{
+    uint8_t instance_no = (uint8_t)(uintptr_t)p_context;
+
+    m_irq_handlers[instance_no]();
+
+    /* Events left uncleared request the interrupt again */
+    irq_update(instance_no);
+}
+
+static void pin_write(pwm_state_t * p_state, uint32_t pin, bool level, uint64_t time_ps)
+{
+    sim_gpio_write(pin, level, time_ps);
+    if (time_ps > p_state->last_edge_ps)
+    {
+        p_state->last_edge_ps = time_ps;
+    }
+}
+
+/**@brief Function for writing the waveform of one period to pins. */
+static void period_play(uint8_t instance_no, uint32_t period)
+{
+    NRF_PWM_Type * p_reg   = &sim_pwm_registers[instance_no];
+    pwm_state_t  * p_state = &m_pwm[instance_no];
+    uint64_t       time_ps = p_state->start_ps + (period * p_state->period_ps);
+    uint32_t       value_no;
+    uint32_t       channel;
+
+    value_no = period / (p_state->refresh + 1U);
+    if (value_no >= p_state->values_count)
+    {
+        /* End delay repeats the last value */
+        value_no = p_state->values_count - 1U;
+    }
+
+    for (channel = 0U; channel < NRF_PWM_CHANNEL_COUNT; channel++)
+    {
+        uint32_t pin = p_reg->PSEL_OUT[channel];
+        uint16_t value;
+        uint32_t compare;
+
+        if ((pin & PWM_PSEL_DISCONNECT) != 0U)
+        {
+            continue;
+        }
+
+        switch (p_reg->DECODER & 0x03U)
+        {
+            case NRF_PWM_LOAD_COMMON:
+                value = p_state->p_values[value_no];
+                break;
+
+            case NRF_PWM_LOAD_GROUPED:
+                value = p_state->p_values[(value_no * 2U) + (channel / 2U)];
+                break;
+
+            default:
+                value = p_state->p_values[(value_no * 4U) + channel];
+                break;
+        }
+
+        compare = MIN((uint32_t)(value & 0x7FFFU), (uint32_t)p_state->top);
+        if ((value & 0x8000U) != 0U)
+        {
+            /* High from the start of the period until the compare value */
+            pin_write(p_state, pin, compare != 0U, time_ps);
+            if ((compare != 0U) && (compare < p_state->top))
+            {
+                pin_write(p_state, pin, false, time_ps + (compare * p_state->tick_ps));
+            }
+        }
+        else
+        {
+            /* Low from the start of the period until the compare value */
+            pin_write(p_state, pin, compare == 0U, time_ps);
+            if ((compare != 0U) && (compare < p_state->top))
+            {
+                pin_write(p_state, pin, true, time_ps + (compare * p_state->tick_ps));
+            }
+        }
+    }
+
+    p_state->periods_played++;
+}
+
+/**@brief Function for playing all periods, which start not later than @p time_ps. */
+static void periods_sample(uint8_t instance_no, uint64_t time_ps)
+{
+    pwm_state_t * p_state = &m_pwm[instance_no];
+
+    while (p_state->playing &&
+           (p_state->next_period < p_state->periods_count) &&
+           ((p_state->start_ps + (p_state->next_period * p_state->period_ps)) <= time_ps))
+    {
+        period_play(instance_no, p_state->next_period);
+        p_state->next_period++;
+    }
+}
+
+static void sync_handler(uint64_t time_ns)
+{
+    uint8_t instance_no;
+
+    for (instance_no = 0U; instance_no < SIM_PWM_INSTANCES_COUNT; instance_no++)
+    {
+        periods_sample(instance_no, time_ns * 1000U);
+    }
+}
+
+/**@brief Function for getting the time, from which pins may be driven without reordering their edges. */
+static uint64_t free_time_get(uint8_t instance_no)
+{
+    pwm_state_t * p_state = &m_pwm[instance_no];
+    uint64_t      time_ps = sim_clock_now() * 1000U;
+
+    if (p_state->playing)
+    {
+        /* Current period is finished first */
+        uint64_t period_end_ps = p_state->start_ps + (p_state->next_period * p_state->period_ps);
+        time_ps = MAX(time_ps, period_end_ps);
+    }
+
+    return MAX(time_ps, p_state->last_edge_ps);
+}
+
+static void pwm_stop(uint8_t instance_no, uint64_t time_ps)
+{
+    NRF_PWM_Type * p_reg   = &sim_pwm_registers[instance_no];
+    pwm_state_t  * p_state = &m_pwm[instance_no];
+    uint32_t       channel;
+
+    sim_clock_cancel(&p_state->seq_event);
+    if (p_state->playing)
+    {
+        p_state->playing = false;
+
+        /* Pins are driven by GPIO again */
+        for (channel = 0U; channel < NRF_PWM_CHANNEL_COUNT; channel++)
+        {
+            if ((p_reg->PSEL_OUT[channel] & PWM_PSEL_DISCONNECT) == 0U)
+            {
+                pin_write(p_state, p_reg->PSEL_OUT[channel], p_state->idle_levels[channel], time_ps);
+            }
+        }
+    }
+
+    event_generate(instance_no, NRF_PWM_EVENT_STOPPED);
+}
+
+static void seq_event_handler(void * p_context)
+{
+    uint8_t        instance_no = (uint8_t)(uintptr_t)p_context;
+    NRF_PWM_Type * p_reg       = &sim_pwm_registers[instance_no];
+    pwm_state_t  * p_state     = &m_pwm[instance_no];
+    uint64_t       end_ps      = p_state->start_ps + (p_state->periods_count * p_state->period_ps);
+
+    if (p_state->seqend_pending)
+    {
+        p_state->seqend_pending = false;
+        sim_clock_schedule(&p_state->seq_event, ps_to_ns(end_ps));
+        event_generate(instance_no, (p_state->seq == 0U) ? NRF_PWM_EVENT_SEQEND0 : NRF_PWM_EVENT_SEQEND1);
+        if ((p_reg->SHORTS & ((p_state->seq == 0U) ? NRF_PWM_SHORT_SEQEND0_STOP_MASK :
+                                                     NRF_PWM_SHORT_SEQEND1_STOP_MASK)) != 0U)
+        {
+            pwm_stop(instance_no, free_time_get(instance_no));
+        }
+        return;
+    }
+
+    periods_sample(instance_no, end_ps);
+
+    if (p_state->seq == 0U)
+    {
+        if (p_reg->LOOP != 0U)
+        {
+            seq_start(instance_no, 1U, end_ps);
+        }
+        else
+        {
+            p_state->playing = false;
+        }
+    }
+    else if (p_state->loops_left > 0U)
+    {
+        p_state->loops_left--;
+        seq_start(instance_no, 0U, end_ps);
+    }
+    else
+    {
+        event_generate(instance_no, NRF_PWM_EVENT_LOOPSDONE);
+
+        if ((p_reg->SHORTS & NRF_PWM_SHORT_LOOPSDONE_STOP_MASK) != 0U)
+        {
+            pwm_stop(instance_no, end_ps);
+        }
+        else if ((p_reg->SHORTS & NRF_PWM_SHORT_LOOPSDONE_SEQSTART0_MASK) != 0U)
+        {
+            p_state->loops_left = p_reg->LOOP - 1U;
+            event_generate(instance_no, NRF_PWM_EVENT_SEQSTARTED0);
+            seq_start(instance_no, 0U, end_ps);
+        }
+        else if ((p_reg->SHORTS & NRF_PWM_SHORT_LOOPSDONE_SEQSTART1_MASK) != 0U)
+        {
+            p_state->loops_left = p_reg->LOOP - 1U;
+            event_generate(instance_no, NRF_PWM_EVENT_SEQSTARTED1);
+            seq_start(instance_no, 1U, end_ps);
+        }
+        else
+        {
+            p_state->playing = false;
+        }
+    }
+}
+
+/**@brief Function for starting to play a sequence at @p start_ps, with configuration of registers. */
+static void seq_start(uint8_t instance_no, uint8_t seq, uint64_t start_ps)
+{
+    NRF_PWM_Type * p_reg   = &sim_pwm_registers[instance_no];
+    pwm_state_t  * p_state = &m_pwm[instance_no];
+    uint32_t       seqend_period;
+
+    switch (p_reg->DECODER & 0x03U)
+    {
+        case NRF_PWM_LOAD_COMMON:
+            p_state->values_per_period = 1U;
+            break;
+
+        case NRF_PWM_LOAD_GROUPED:
+            p_state->values_per_period = 2U;
+            break;
+
+        default:
+            p_state->values_per_period = 4U;
+            break;
+    }
+
+    p_state->seq            = seq;
+    p_state->p_values       = (uint16_t const *)p_reg->SEQ[seq].PTR;
+    p_state->values_count   = p_reg->SEQ[seq].CNT / p_state->values_per_period;
+    p_state->refresh        = p_reg->SEQ[seq].REFRESH;
+    p_state->top            = (uint16_t)p_reg->COUNTERTOP;
+    p_state->tick_ps        = PWM_TICK_PS << p_reg->PRESCALER;
+    p_state->period_ps      = p_state->top * p_state->tick_ps;
+    p_state->start_ps       = start_ps;
+    p_state->next_period    = 0U;
+    p_state->playing        = true;
+    p_state->seqend_pending = true;
+
+    if (p_state->values_count == 0U)
+    {
+        /* Nothing to play, only the end delay elapses */
+        p_state->periods_count = 0U;
+        seqend_period          = 0U;
+        p_state->start_ps     += p_reg->SEQ[seq].ENDDELAY * p_state->period_ps;
+    }
+    else
+    {
+        p_state->periods_count = (p_state->values_count * (p_state->refresh + 1U)) + p_reg->SEQ[seq].ENDDELAY;
+        seqend_period          = (p_state->values_count - 1U) * (p_state->refresh + 1U);
+    }
+
+    /* First values are loaded right away */
+    periods_sample(instance_no, MAX(start_ps, sim_clock_now() * 1000U));
+
+    sim_clock_schedule(&p_state->seq_event, ps_to_ns(start_ps + (seqend_period * p_state->period_ps)));
+}
+
+static void seqstart_task(uint8_t instance_no, uint8_t seq)
+{
+    NRF_PWM_Type * p_reg   = &sim_pwm_registers[instance_no];
+    pwm_state_t  * p_state = &m_pwm[instance_no];
+    uint64_t       time_ps = free_time_get(instance_no);
+    uint32_t       channel;
+
+    if (!p_state->playing)
+    {
+        /* Levels driven by GPIO are restored when the PWM stops */
+        for (channel = 0U; channel < NRF_PWM_CHANNEL_COUNT; channel++)
+        {
+            p_state->idle_levels[channel] = ((p_reg->PSEL_OUT[channel] & PWM_PSEL_DISCONNECT) == 0U) &&
+                                            sim_gpio_read(p_reg->PSEL_OUT[channel]);
+        }
+    }
+
+    p_state->loops_left = (p_reg->LOOP > 0U) ? (p_reg->LOOP - 1U) : 0U;
+    event_generate(instance_no, (seq == 0U) ? NRF_PWM_EVENT_SEQSTARTED0 : NRF_PWM_EVENT_SEQSTARTED1);
+    seq_start(instance_no, seq, time_ps);
+}
+
+void sim_pwm_reset(void)
+{
+    uint8_t instance_no;
+
+    memset(sim_pwm_registers, 0, sizeof(sim_pwm_registers));
+    memset(m_pwm, 0, sizeof(m_pwm));
+
+    for (instance_no = 0U; instance_no < SIM_PWM_INSTANCES_COUNT; instance_no++)
+    {
+        sim_clock_event_init(&m_pwm[instance_no].seq_event, seq_event_handler, (void *)(uintptr_t)instance_no, true);
+        sim_clock_event_init(&m_pwm[instance_no].irq_event, irq_event_handler, (void *)(uintptr_t)instance_no, true);
+        for (uint32_t channel = 0U; channel < NRF_PWM_CHANNEL_COUNT; channel++)
+        {
+            sim_pwm_registers[instance_no].PSEL_OUT[channel] = NRF_PWM_PIN_NOT_CONNECTED;
+        }
+    }
+
+    sim_clock_sync_register(sync_handler);
+    sim_pwm_driver_reset();
+}
+
+bool sim_pwm_is_playing(uint8_t instance_no)
+{
+    return m_pwm[instance_no].playing;
+}
+
+uint32_t sim_pwm_periods_get(uint8_t instance_no)
+{
+    return m_pwm[instance_no].periods_played;
+}
+
+void nrf_pwm_task_trigger(NRF_PWM_Type * p_reg, nrf_pwm_task_t task)
+{
+    uint8_t instance_no = instance_no_get(p_reg);
+
+    if (p_reg->ENABLE == 0U)
+    {
+        return;
+    }
+
+    sim_irq_lock();
+    switch (task)
+    {
+        case NRF_PWM_TASK_STOP:
+            pwm_stop(instance_no, free_time_get(instance_no));
+            break;
+
+        case NRF_PWM_TASK_SEQSTART0:
+            seqstart_task(instance_no, 0U);
+            break;
+
+        case NRF_PWM_TASK_SEQSTART1:
+            seqstart_task(instance_no, 1U);
+            break;
+
+        default:
+            break;
+    }
+    sim_irq_unlock();
+}
+
+uint32_t nrf_pwm_task_address_get(NRF_PWM_Type const * p_reg, nrf_pwm_task_t task)
+{
+    return (uint32_t)((uintptr_t)p_reg + (uint32_t)task);
+}
+
+void nrf_pwm_event_clear(NRF_PWM_Type * p_reg, nrf_pwm_event_t event)
+{
+    *reg_get(p_reg, event) = 0U;
+}
+
+bool nrf_pwm_event_check(NRF_PWM_Type const * p_reg, nrf_pwm_event_t event)
+{
+    return *reg_get(p_reg, event) != 0U;
+}
+
+uint32_t nrf_pwm_event_address_get(NRF_PWM_Type const * p_reg, nrf_pwm_event_t event)
+{
+    return (uint32_t)((uintptr_t)p_reg + (uint32_t)event);
+}
+
+void nrf_pwm_shorts_set(NRF_PWM_Type * p_reg, uint32_t mask)
+{
+    p_reg->SHORTS = mask;
+}
+
+void nrf_pwm_int_enable(NRF_PWM_Type * p_reg, uint32_t mask)
+{
+    p_reg->INTEN |= mask;
+    irq_update(instance_no_get(p_reg));
+}
+
+void nrf_pwm_int_disable(NRF_PWM_Type * p_reg, uint32_t mask)
+{
+    p_reg->INTEN &= ~mask;
+}
+
+void nrf_pwm_int_set(NRF_PWM_Type * p_reg, uint32_t mask)
+{
+    p_reg->INTEN = mask;
+    irq_update(instance_no_get(p_reg));
+}
+
+bool nrf_pwm_int_enable_check(NRF_PWM_Type const * p_reg, nrf_pwm_int_mask_t mask)
+{
+    return (p_reg->INTEN & mask) != 0U;
+}
+
+void nrf_pwm_enable(NRF_PWM_Type * p_reg)
+{
+    p_reg->ENABLE = 1U;
+}
+
+void nrf_pwm_disable(NRF_PWM_Type * p_reg)
+{
+    p_reg->ENABLE = 0U;
+}
+
+void nrf_pwm_pins_set(NRF_PWM_Type * p_reg, uint32_t out_pins[NRF_PWM_CHANNEL_COUNT])
+{
+    uint32_t channel;
+
+    for (channel = 0U; channel < NRF_PWM_CHANNEL_COUNT; channel++)
+    {
+        p_reg->PSEL_OUT[channel] = out_pins[channel];
+    }
+}
+
+void nrf_pwm_configure(NRF_PWM_Type * p_reg, nrf_pwm_clk_t base_clock, nrf_pwm_mode_t mode, uint16_t top_value)
+{
+    p_reg->PRESCALER  = base_clock;
+    p_reg->MODE       = mode;
+    p_reg->COUNTERTOP = top_value;
+}
+
+void nrf_pwm_sequence_set(NRF_PWM_Type * p_reg, uint8_t seq_id, nrf_pwm_sequence_t const * p_seq)
+{
+    p_reg->SEQ[seq_id].PTR      = (uintptr_t)p_seq->values.p_raw;
+    p_reg->SEQ[seq_id].CNT      = p_seq->length;
+    p_reg->SEQ[seq_id].REFRESH  = p_seq->repeats;
+    p_reg->SEQ[seq_id].ENDDELAY = p_seq->end_delay;
+}
+
+void nrf_pwm_decoder_set(NRF_PWM_Type * p_reg, nrf_pwm_dec_load_t dec_load, nrf_pwm_dec_step_t dec_step)
+{
+    p_reg->DECODER = ((uint32_t)dec_load) | ((uint32_t)dec_step << 8);
+}
+
+void nrf_pwm_loop_set(NRF_PWM_Type * p_reg, uint16_t loop_count)
+{
+    p_reg->LOOP = loop_count;
+}
+
+/**
+ * @}
+ */
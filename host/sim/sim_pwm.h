@@ -0,0 +1,93 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @defgroup zigbee_examples_host_sim_pwm sim_pwm.h
+ * @{
+ * @ingroup zigbee_examples
+ *
+ * @brief Simulation of the PWM peripheral.
+ *
+ * Sequences are played as by the device: values are read from RAM when their period starts, so a buffer
+ * modified too late is played with its old content. Waveforms of the connected pins are written to sim_gpio
+ * with picosecond resolution. SEQEND is generated when the last value of a sequence is loaded, LOOPSDONE and
+ * the shorts when sequence 1 ends with no loops left. Interrupts are level triggered and are delayed by
+ * @ref sim_irq_latency_ns.
+ *
+ * Not simulated: NEXTSTEP task, up and down counter, wave form load mode (played as individual). A sequence which
+ * ends with no continuation holds the last levels of the pins, instead of repeating its last value.
+ */
+
+#ifndef SIM_PWM_H__
+#define SIM_PWM_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "hal/nrf_pwm.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SIM_PWM_INSTANCES_COUNT     4U
+
+/**@brief Function for clearing registers of all instances. Must be called after @ref sim_clock_reset. */
+void sim_pwm_reset(void);
+
+/**@brief Function for uninitializing the driver of all instances, called by @ref sim_pwm_reset.
+ *        Implemented by nrfx_pwm.c. */
+void sim_pwm_driver_reset(void);
+
+/**@brief Function for checking if an instance is playing a sequence. */
+bool sim_pwm_is_playing(uint8_t instance_no);
+
+/**@brief Function for getting the number of PWM periods played by an instance since reset. */
+uint32_t sim_pwm_periods_get(uint8_t instance_no);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIM_PWM_H__ */
+
+/**
+ * @}
+ */
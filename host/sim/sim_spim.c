@@ -0,0 +1,278 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @defgroup zigbee_examples_host_sim_spim sim_spim.c
+ * @{
+ * @ingroup zigbee_examples
+ */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "nordic_common.h"
+#include "sim_clock.h"
+#include "sim_spim.h"
+
+#define SPIM_PS_PER_S       1000000000000ULL
+
+/**@brief State of an instance, with the transfer being sent. */
+typedef struct
+{
+    sim_clock_event_t         end_event;        /**< END of the transfer. */
+    sim_clock_event_t         irq_event;        /**< Call of the driver handler. */
+    nrfx_drv_state_t          state;
+    nrfx_spim_evt_handler_t   handler;
+    void                    * p_context;
+    uint64_t                  byte_ps;
+    bool                      busy;
+    nrfx_spim_xfer_desc_t     xfer;
+    size_t                    next_byte;        /**< First byte, which has not been sent yet. */
+    uint64_t                  start_ps;
+    uint64_t                  last_end_ps;      /**< End of the last transfer, the next one cannot start earlier. */
+    sim_spim_listener_t       listener;
+    void                    * p_listener_context;
+    uint32_t                  bytes_sent;
+} spim_state_t;
+
+static spim_state_t m_spim[SIM_SPIM_INSTANCES_COUNT];
+
+static uint64_t ps_to_ns(uint64_t time_ps)
+{
+    return (time_ps + 999U) / 1000U;
+}
+
+/**@brief Function for getting the period of a byte, for a value of the FREQUENCY register. */
+static uint64_t byte_ps_get(nrf_spim_frequency_t frequency)
+{
+    uint64_t hz;
+
+    switch (frequency)
+    {
+        case NRF_SPIM_FREQ_125K:
+            hz = 125000U;
+            break;
+
+        case NRF_SPIM_FREQ_250K:
+            hz = 250000U;
+            break;
+
+        case NRF_SPIM_FREQ_500K:
+            hz = 500000U;
+            break;
+
+        case NRF_SPIM_FREQ_1M:
+            hz = 1000000U;
+            break;
+
+        case NRF_SPIM_FREQ_2M:
+            hz = 2000000U;
+            break;
+
+        case NRF_SPIM_FREQ_8M:
+            hz = 8000000U;
+            break;
+
+        case NRF_SPIM_FREQ_16M:
+            hz = 16000000U;
+            break;
+
+        case NRF_SPIM_FREQ_32M:
+            hz = 32000000U;
+            break;
+
+        default:
+            hz = 4000000U;
+            break;
+    }
+
+    return (8U * SPIM_PS_PER_S) / hz;
+}
+
+/**@brief Function for sending all bytes of an instance, which start not later than @p time_ps. */
+static void bytes_sample(uint8_t instance_no, uint64_t time_ps)
+{
+    spim_state_t * p_spim = &m_spim[instance_no];
+
+    while (p_spim->busy &&
+           (p_spim->next_byte < p_spim->xfer.tx_length) &&
+           ((p_spim->start_ps + (p_spim->next_byte * p_spim->byte_ps)) <= time_ps))
+    {
+        uint8_t byte = p_spim->xfer.p_tx_buffer[p_spim->next_byte];
+
+        p_spim->next_byte++;
+        p_spim->bytes_sent++;
+        if (p_spim->listener != NULL)
+        {
+            p_spim->listener(byte, p_spim->start_ps + (p_spim->next_byte * p_spim->byte_ps),
+                             p_spim->p_listener_context);
+        }
+    }
+}
+
+static void sync_handler(uint64_t time_ns)
+{
+    uint8_t instance_no;
+
+    for (instance_no = 0U; instance_no < SIM_SPIM_INSTANCES_COUNT; instance_no++)
+    {
+        bytes_sample(instance_no, time_ns * 1000U);
+    }
+}
+
+static void end_event_handler(void * p_context)
+{
+    uint8_t        instance_no = (uint8_t)(uintptr_t)p_context;
+    spim_state_t * p_spim      = &m_spim[instance_no];
+
+    bytes_sample(instance_no, p_spim->last_end_ps);
+    sim_clock_schedule(&p_spim->irq_event, sim_clock_now() + sim_irq_latency_ns);
+}
+
+/**@brief Function for handling END in the interrupt, as the nrfx driver does. */
+static void irq_event_handler(void * p_context)
+{
+    uint8_t         instance_no = (uint8_t)(uintptr_t)p_context;
+    spim_state_t  * p_spim      = &m_spim[instance_no];
+    nrfx_spim_evt_t event;
+
+    event.type      = NRFX_SPIM_EVENT_DONE;
+    event.xfer_desc = p_spim->xfer;
+    p_spim->busy    = false;
+
+    if (p_spim->handler != NULL)
+    {
+        p_spim->handler(&event, p_spim->p_context);
+    }
+}
+
+void sim_spim_reset(void)
+{
+    uint8_t instance_no;
+
+    memset(m_spim, 0, sizeof(m_spim));
+
+    for (instance_no = 0U; instance_no < SIM_SPIM_INSTANCES_COUNT; instance_no++)
+    {
+        sim_clock_event_init(&m_spim[instance_no].end_event, end_event_handler, (void *)(uintptr_t)instance_no, true);
+        sim_clock_event_init(&m_spim[instance_no].irq_event, irq_event_handler, (void *)(uintptr_t)instance_no, true);
+    }
+
+    sim_clock_sync_register(sync_handler);
+}
+
+void sim_spim_listen(uint8_t instance_no, sim_spim_listener_t listener, void * p_context)
+{
+    m_spim[instance_no].listener           = listener;
+    m_spim[instance_no].p_listener_context = p_context;
+}
+
+uint32_t sim_spim_bytes_get(uint8_t instance_no)
+{
+    return m_spim[instance_no].bytes_sent;
+}
+
+nrfx_err_t nrfx_spim_init(nrfx_spim_t const *        p_instance,
+                          nrfx_spim_config_t const * p_config,
+                          nrfx_spim_evt_handler_t    handler,
+                          void *                     p_context)
+{
+    spim_state_t * p_spim = &m_spim[p_instance->drv_inst_idx];
+
+    if (p_spim->state != NRFX_DRV_STATE_UNINITIALIZED)
+    {
+        return NRFX_ERROR_INVALID_STATE;
+    }
+
+    p_spim->handler   = handler;
+    p_spim->p_context = p_context;
+    p_spim->byte_ps   = byte_ps_get(p_config->frequency);
+    p_spim->busy      = false;
+    p_spim->state     = NRFX_DRV_STATE_INITIALIZED;
+
+    return NRFX_SUCCESS;
+}
+
+void nrfx_spim_uninit(nrfx_spim_t const * p_instance)
+{
+    spim_state_t * p_spim = &m_spim[p_instance->drv_inst_idx];
+
+    sim_clock_cancel(&p_spim->end_event);
+    sim_clock_cancel(&p_spim->irq_event);
+    p_spim->busy  = false;
+    p_spim->state = NRFX_DRV_STATE_UNINITIALIZED;
+}
+
+nrfx_err_t nrfx_spim_xfer(nrfx_spim_t const *           p_instance,
+                          nrfx_spim_xfer_desc_t const * p_xfer_desc,
+                          uint32_t                      flags)
+{
+    uint8_t        instance_no = p_instance->drv_inst_idx;
+    spim_state_t * p_spim      = &m_spim[instance_no];
+    nrfx_err_t     result      = NRFX_SUCCESS;
+
+    UNUSED_PARAMETER(flags);
+
+    sim_irq_lock();
+    if (p_spim->busy)
+    {
+        result = NRFX_ERROR_BUSY;
+    }
+    else
+    {
+        p_spim->busy        = true;
+        p_spim->xfer        = *p_xfer_desc;
+        p_spim->next_byte   = 0U;
+        p_spim->start_ps    = MAX(sim_clock_now() * 1000U, p_spim->last_end_ps);
+        p_spim->last_end_ps = p_spim->start_ps + (p_xfer_desc->tx_length * p_spim->byte_ps);
+
+        /* First byte is loaded right away */
+        bytes_sample(instance_no, p_spim->start_ps);
+        sim_clock_schedule(&p_spim->end_event, ps_to_ns(p_spim->last_end_ps));
+    }
+    sim_irq_unlock();
+
+    return result;
+}
+
+/**
+ * @}
+ */
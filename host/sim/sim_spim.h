@@ -0,0 +1,96 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @defgroup zigbee_examples_host_sim_spim sim_spim.h
+ * @{
+ * @ingroup zigbee_examples
+ *
+ * @brief Simulation of the SPIM peripheral with the nrfx SPIM driver on top of it.
+ *
+ * A transfer sends 8 clock periods per byte. Bytes are read from RAM by EasyDMA when they start to be sent,
+ * so a buffer modified during the transfer is sent with the bytes not sent yet updated. Every byte is passed
+ * to the listener of the instance with the time of its end. The driver handler is called with
+ * NRFX_SPIM_EVENT_DONE after the last byte, delayed by @ref sim_irq_latency_ns.
+ *
+ * Not simulated: reception, SCK and MOSI waveforms, slave select, flags of nrfx_spim_xfer.
+ */
+
+#ifndef SIM_SPIM_H__
+#define SIM_SPIM_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "nrfx_spim.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SIM_SPIM_INSTANCES_COUNT    4U
+
+/**@brief Function called for every byte sent.
+ *
+ * @param[in] byte      Byte sent.
+ * @param[in] time_ps   Time of the end of the byte, in picoseconds.
+ * @param[in] p_context Parameter given on registration.
+ */
+typedef void (* sim_spim_listener_t)(uint8_t byte, uint64_t time_ps, void * p_context);
+
+/**@brief Function for uninitializing all instances and removing listeners. Must be called after
+ *        @ref sim_clock_reset. */
+void sim_spim_reset(void);
+
+/**@brief Function for registering the listener of an instance, replacing the previous one. */
+void sim_spim_listen(uint8_t instance_no, sim_spim_listener_t listener, void * p_context);
+
+/**@brief Function for getting the number of bytes sent by an instance since reset. */
+uint32_t sim_spim_bytes_get(uint8_t instance_no);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIM_SPIM_H__ */
+
+/**
+ * @}
+ */
@@ -0,0 +1,98 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @defgroup zigbee_examples_host_sim_test sim_test.h
+ * @{
+ * @ingroup zigbee_examples
+ *
+ * @brief Checks of host tests. A failed check is reported and the test continues, the exit status of the test
+ *        is the number of failed checks.
+ */
+
+#ifndef SIM_TEST_H__
+#define SIM_TEST_H__
+
+#include <stdio.h>
+#include <stdint.h>
+#include <inttypes.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**@brief Number of failed checks. */
+extern uint32_t sim_test_failures;
+
+#define SIM_TEST_CHECK(condition)                                                       \
+    do                                                                                  \
+    {                                                                                   \
+        if (!(condition))                                                               \
+        {                                                                               \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            sim_test_failures++;                                                        \
+        }                                                                               \
+    } while (0)
+
+#define SIM_TEST_CHECK_EQUAL(actual, expected)                                          \
+    do                                                                                  \
+    {                                                                                   \
+        int64_t sim_test_actual_   = (int64_t)(actual);                                 \
+        int64_t sim_test_expected_ = (int64_t)(expected);                               \
+        if (sim_test_actual_ != sim_test_expected_)                                     \
+        {                                                                               \
+            fprintf(stderr, "%s:%d: check failed: %s == %" PRId64 ", expected %" PRId64 "\n", \
+                    __FILE__, __LINE__, #actual, sim_test_actual_, sim_test_expected_); \
+            sim_test_failures++;                                                        \
+        }                                                                               \
+    } while (0)
+
+/**@brief Function for printing the result of a test and getting its exit status. */
+int sim_test_result(const char * p_name);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIM_TEST_H__ */
+
+/**
+ * @}
+ */
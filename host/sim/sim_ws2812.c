@@ -0,0 +1,150 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @defgroup zigbee_examples_host_sim_ws2812 sim_ws2812.c
+ * @{
+ * @ingroup zigbee_examples
+ */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "sim_gpio.h"
+#include "sim_ws2812.h"
+
+#define T_GLITCH_PS     200000ULL
+#define T_0H_MAX_PS     550000ULL
+#define T_1H_MAX_PS     1000000ULL
+
+static void frame_latch(sim_ws2812_decoder_t * p_decoder)
+{
+    if ((p_decoder->bits_count % 8U) != 0U)
+    {
+        p_decoder->errors_count++;
+    }
+
+    p_decoder->frame_len      = p_decoder->bits_count / 8U;
+    p_decoder->frame_start_ps = p_decoder->start_ps;
+    p_decoder->frame_end_ps   = p_decoder->fall_ps;
+    memcpy(p_decoder->frame, p_decoder->bytes, p_decoder->frame_len);
+    p_decoder->frames_count++;
+
+    p_decoder->bits_count = 0U;
+    memset(p_decoder->bytes, 0, sizeof(p_decoder->bytes));
+}
+
+static void bit_add(sim_ws2812_decoder_t * p_decoder, bool bit)
+{
+    if (p_decoder->bits_count >= (8U * SIM_WS2812_FRAME_BYTES_MAX))
+    {
+        p_decoder->errors_count++;
+        return;
+    }
+
+    if (bit)
+    {
+        p_decoder->bytes[p_decoder->bits_count / 8U] |= (uint8_t)(0x80U >> (p_decoder->bits_count % 8U));
+    }
+    p_decoder->bits_count++;
+}
+
+static void edge_handler(uint32_t pin, bool level, uint64_t time_ps, void * p_context)
+{
+    sim_ws2812_decoder_t * p_decoder = (sim_ws2812_decoder_t *)p_context;
+
+    (void)pin;
+
+    if (level)
+    {
+        sim_ws2812_decoder_poll(p_decoder, time_ps);
+
+        if (p_decoder->bits_count == 0U)
+        {
+            p_decoder->start_ps = time_ps;
+        }
+        else if ((time_ps - p_decoder->fall_ps) > SIM_WS2812_GAP_MAX_PS)
+        {
+            /* LEDs may latch here or not, either way the frame is broken */
+            p_decoder->errors_count++;
+        }
+        p_decoder->rise_ps = time_ps;
+    }
+    else
+    {
+        uint64_t high_ps = time_ps - p_decoder->rise_ps;
+
+        if ((high_ps < T_GLITCH_PS) || (high_ps > T_1H_MAX_PS))
+        {
+            p_decoder->errors_count++;
+        }
+        else
+        {
+            bit_add(p_decoder, high_ps > T_0H_MAX_PS);
+        }
+        p_decoder->fall_ps = time_ps;
+    }
+
+    p_decoder->level = level;
+}
+
+void sim_ws2812_decoder_init(sim_ws2812_decoder_t * p_decoder, uint32_t pin)
+{
+    memset(p_decoder, 0, sizeof(*p_decoder));
+    p_decoder->pin   = pin;
+    p_decoder->level = sim_gpio_read(pin);
+
+    sim_gpio_listen(pin, edge_handler, p_decoder);
+}
+
+void sim_ws2812_decoder_poll(sim_ws2812_decoder_t * p_decoder, uint64_t time_ps)
+{
+    /* Edges of the current PWM period may already be written ahead of time */
+    if (!p_decoder->level && (p_decoder->bits_count > 0U) &&
+        (time_ps >= (p_decoder->fall_ps + SIM_WS2812_LATCH_PS)))
+    {
+        frame_latch(p_decoder);
+    }
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,99 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @defgroup zigbee_examples_host_sim_ws2812 sim_ws2812.h
+ * @{
+ * @ingroup zigbee_examples
+ *
+ * @brief Decoder of the WS2812 waveform of a pin, acting as the LED chain.
+ *
+ * Bits are classified by the high time: 200 ns to 550 ns is 0, 550 ns to 1000 ns is 1, anything else is an error.
+ * Low level of at least 50 us latches the frame. Low level between 5 us and 50 us inside a frame is an error,
+ * as LEDs would latch a partial frame or lose bits.
+ */
+
+#ifndef SIM_WS2812_H__
+#define SIM_WS2812_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SIM_WS2812_FRAME_BYTES_MAX      4096U
+#define SIM_WS2812_LATCH_PS             50000000ULL
+#define SIM_WS2812_GAP_MAX_PS           5000000ULL
+
+typedef struct
+{
+    uint32_t pin;
+    uint8_t  bytes[SIM_WS2812_FRAME_BYTES_MAX];     /**< Frame being received. */
+    size_t   bits_count;                            /**< Bits of the frame being received. */
+    uint64_t rise_ps;                               /**< Time of the last rising edge. */
+    uint64_t fall_ps;                               /**< Time of the last falling edge. */
+    uint64_t start_ps;                              /**< Time of the first bit of the frame being received. */
+    bool     level;
+    uint8_t  frame[SIM_WS2812_FRAME_BYTES_MAX];     /**< Last latched frame. */
+    size_t   frame_len;                             /**< Length of the last latched frame, in bytes. */
+    uint64_t frame_start_ps;                        /**< Time of the first bit of the last latched frame. */
+    uint64_t frame_end_ps;                          /**< Time of the end of the last bit of the last latched frame. */
+    uint32_t frames_count;                          /**< Number of latched frames. */
+    uint32_t errors_count;                          /**< Number of timing errors. */
+} sim_ws2812_decoder_t;
+
+/**@brief Function for attaching a decoder to a pin. Must be called after sim_gpio_reset. */
+void sim_ws2812_decoder_init(sim_ws2812_decoder_t * p_decoder, uint32_t pin);
+
+/**@brief Function for latching the frame being received, if the pin has been low long enough by @p time_ps. */
+void sim_ws2812_decoder_poll(sim_ws2812_decoder_t * p_decoder, uint64_t time_ps);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIM_WS2812_H__ */
+
+/**
+ * @}
+ */
@@ -0,0 +1,107 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @defgroup zigbee_examples_host_sim_zboss sim_zboss.h
+ * @{
+ * @ingroup zigbee_examples
+ *
+ * @brief Stand-ins of the ZBOSS scheduler, buffers and attribute storage.
+ *
+ * Alarms expire on beacon interval boundaries of the virtual clock and run in thread context. An attribute is
+ * written by ZB_ZCL_SET_ATTRIBUTE only if it has been registered, with the size of its type. The stack does not
+ * call the set attribute callback, tests do it as ZBOSS would after processing a command.
+ */
+
+#ifndef SIM_ZBOSS_H__
+#define SIM_ZBOSS_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "zboss_api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SIM_ZBOSS_ALARMS_COUNT_MAX      32U
+#define SIM_ZBOSS_ATTRS_COUNT_MAX       64U
+#define SIM_ZBOSS_BUFS_COUNT            8U
+#define SIM_ZBOSS_BUF_SIZE              128U
+
+/**@brief Function for dropping all alarms, attributes and buffers. Must be called after @ref sim_clock_reset. */
+void sim_zboss_reset(void);
+
+/**@brief Function for registering storage of an attribute.
+ *
+ * @param[in] ep            Endpoint.
+ * @param[in] cluster_id    Cluster.
+ * @param[in] attr_id       Attribute.
+ * @param[in] p_value       Storage of the value, little-endian as on the device.
+ * @param[in] size          Size of the value in bytes.
+ */
+void sim_zboss_attr_register(zb_uint8_t ep, zb_uint16_t cluster_id, zb_uint16_t attr_id, void * p_value, size_t size);
+
+/**@brief Function for getting the number of writes of registered attributes since reset. */
+uint32_t sim_zboss_attr_writes_get(void);
+
+/**@brief Function for allocating a buffer holding a received ZCL command.
+ *
+ * @param[in] p_hdr         Parsed header, stored as the buffer parameter.
+ * @param[in] p_payload     Payload of the command.
+ * @param[in] length        Length of the payload, at most @ref SIM_ZBOSS_BUF_SIZE.
+ *
+ * @return Buffer ID, freed with zb_buf_free.
+ */
+zb_bufid_t sim_zboss_buf_alloc(zb_zcl_parsed_hdr_t const * p_hdr, void const * p_payload, size_t length);
+
+/**@brief Function for getting the number of pending alarms. */
+uint32_t sim_zboss_alarms_count_get(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIM_ZBOSS_H__ */
+
+/**
+ * @}
+ */
@@ -0,0 +1,271 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @defgroup zigbee_examples_host_zboss zboss.c
+ * @{
+ * @ingroup zigbee_examples
+ */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "app_util_platform.h"
+#include "sim_clock.h"
+#include "sim_zboss.h"
+
+typedef struct
+{
+    sim_clock_event_t event;
+    zb_callback_t     func;
+    zb_uint8_t        param;
+} alarm_t;
+
+typedef struct
+{
+    zb_uint8_t  ep;
+    zb_uint16_t cluster_id;
+    zb_uint16_t attr_id;
+    void      * p_value;
+    size_t      size;
+} attr_t;
+
+typedef struct
+{
+    bool       used;
+    zb_uint8_t data[SIM_ZBOSS_BUF_SIZE];
+    zb_uint_t  len;
+    zb_uint8_t param[sizeof(zb_zcl_parsed_hdr_t)];
+} buf_t;
+
+static alarm_t  m_alarms[SIM_ZBOSS_ALARMS_COUNT_MAX];
+static attr_t   m_attrs[SIM_ZBOSS_ATTRS_COUNT_MAX];
+static size_t   m_attrs_count;
+static uint32_t m_attr_writes;
+static buf_t    m_bufs[SIM_ZBOSS_BUFS_COUNT];
+
+static void alarm_handler(void * p_context)
+{
+    alarm_t     * p_alarm = (alarm_t *)p_context;
+    zb_callback_t func    = p_alarm->func;
+
+    /* Slot is free before the callback, which may schedule again */
+    p_alarm->func = NULL;
+    func(p_alarm->param);
+}
+
+void sim_zboss_reset(void)
+{
+    size_t idx;
+
+    memset(m_alarms, 0, sizeof(m_alarms));
+    for (idx = 0; idx < SIM_ZBOSS_ALARMS_COUNT_MAX; idx++)
+    {
+        sim_clock_event_init(&m_alarms[idx].event, alarm_handler, &m_alarms[idx], false);
+    }
+    memset(m_attrs, 0, sizeof(m_attrs));
+    m_attrs_count = 0U;
+    m_attr_writes = 0U;
+    memset(m_bufs, 0, sizeof(m_bufs));
+}
+
+zb_ret_t zb_schedule_app_alarm(zb_callback_t func, zb_uint8_t param, zb_time_t timeout_bi)
+{
+    zb_ret_t ret = RET_OVERFLOW;
+    size_t   idx;
+
+    CRITICAL_REGION_ENTER();
+    for (idx = 0; idx < SIM_ZBOSS_ALARMS_COUNT_MAX; idx++)
+    {
+        if (m_alarms[idx].func == NULL)
+        {
+            uint64_t now_bi = sim_clock_now() / (ZB_BEACON_INTERVAL_USEC * SIM_CLOCK_NS_PER_US);
+
+            m_alarms[idx].func  = func;
+            m_alarms[idx].param = param;
+            sim_clock_schedule(&m_alarms[idx].event,
+                               (now_bi + timeout_bi) * ZB_BEACON_INTERVAL_USEC * SIM_CLOCK_NS_PER_US);
+            ret = RET_OK;
+            break;
+        }
+    }
+    CRITICAL_REGION_EXIT();
+
+    return ret;
+}
+
+zb_ret_t zb_schedule_app_callback(zb_callback_t func, zb_uint8_t param)
+{
+    return zb_schedule_app_alarm(func, param, 0U);
+}
+
+zb_ret_t zb_schedule_alarm_cancel(zb_callback_t func, zb_uint8_t param, zb_uint8_t * p_param)
+{
+    zb_ret_t ret = RET_NOT_FOUND;
+    size_t   idx;
+
+    CRITICAL_REGION_ENTER();
+    for (idx = 0; idx < SIM_ZBOSS_ALARMS_COUNT_MAX; idx++)
+    {
+        if ((m_alarms[idx].func == func) && ((param == ZB_ALARM_ANY_PARAM) || (m_alarms[idx].param == param)))
+        {
+            sim_clock_cancel(&m_alarms[idx].event);
+            m_alarms[idx].func = NULL;
+            if (p_param != NULL)
+            {
+                *p_param = m_alarms[idx].param;
+            }
+            ret = RET_OK;
+        }
+    }
+    CRITICAL_REGION_EXIT();
+
+    return ret;
+}
+
+uint32_t sim_zboss_alarms_count_get(void)
+{
+    uint32_t count = 0U;
+    size_t   idx;
+
+    for (idx = 0; idx < SIM_ZBOSS_ALARMS_COUNT_MAX; idx++)
+    {
+        if (m_alarms[idx].func != NULL)
+        {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+void sim_zboss_attr_register(zb_uint8_t ep, zb_uint16_t cluster_id, zb_uint16_t attr_id, void * p_value, size_t size)
+{
+    APP_ERROR_CHECK_BOOL(m_attrs_count < SIM_ZBOSS_ATTRS_COUNT_MAX);
+
+    m_attrs[m_attrs_count].ep         = ep;
+    m_attrs[m_attrs_count].cluster_id = cluster_id;
+    m_attrs[m_attrs_count].attr_id    = attr_id;
+    m_attrs[m_attrs_count].p_value    = p_value;
+    m_attrs[m_attrs_count].size       = size;
+    m_attrs_count++;
+}
+
+uint32_t sim_zboss_attr_writes_get(void)
+{
+    return m_attr_writes;
+}
+
+zb_zcl_status_t zb_zcl_set_attr_val(zb_uint8_t   ep,
+                                    zb_uint16_t  cluster_id,
+                                    zb_uint8_t   cluster_role,
+                                    zb_uint16_t  attr_id,
+                                    zb_uint8_t * value,
+                                    zb_bool_t    check_access)
+{
+    size_t idx;
+
+    UNUSED_PARAMETER(cluster_role);
+    UNUSED_PARAMETER(check_access);
+
+    for (idx = 0; idx < m_attrs_count; idx++)
+    {
+        if ((m_attrs[idx].ep == ep) && (m_attrs[idx].cluster_id == cluster_id) && (m_attrs[idx].attr_id == attr_id))
+        {
+            memcpy(m_attrs[idx].p_value, value, m_attrs[idx].size);
+            m_attr_writes++;
+            return ZB_ZCL_STATUS_SUCCESS;
+        }
+    }
+
+    return ZB_ZCL_STATUS_UNSUP_ATTRIB;
+}
+
+zb_bufid_t sim_zboss_buf_alloc(zb_zcl_parsed_hdr_t const * p_hdr, void const * p_payload, size_t length)
+{
+    size_t idx;
+
+    APP_ERROR_CHECK_BOOL(length <= SIM_ZBOSS_BUF_SIZE);
+
+    for (idx = 0; idx < SIM_ZBOSS_BUFS_COUNT; idx++)
+    {
+        if (!m_bufs[idx].used)
+        {
+            m_bufs[idx].used = true;
+            m_bufs[idx].len  = (zb_uint_t)length;
+            if (length > 0U)
+            {
+                memcpy(m_bufs[idx].data, p_payload, length);
+            }
+            memcpy(m_bufs[idx].param, p_hdr, sizeof(*p_hdr));
+            return (zb_bufid_t)(idx + 1U);
+        }
+    }
+
+    APP_ERROR_HANDLER(NRF_ERROR_NO_MEM);
+    return 0U;
+}
+
+void * zb_buf_begin(zb_bufid_t buf)
+{
+    return m_bufs[buf - 1U].data;
+}
+
+zb_uint_t zb_buf_len(zb_bufid_t buf)
+{
+    return m_bufs[buf - 1U].len;
+}
+
+void * zb_buf_get_tail_func(zb_bufid_t buf, zb_uint_t size)
+{
+    APP_ERROR_CHECK_BOOL(size <= sizeof(m_bufs[0].param));
+
+    return m_bufs[buf - 1U].param;
+}
+
+void zb_buf_free(zb_bufid_t buf)
+{
+    m_bufs[buf - 1U].used = false;
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,109 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @defgroup zigbee_examples_host_bench_color_conv_hsb bench_color_conv_hsb.c
+ * @{
+ * @ingroup zigbee_examples
+ *
+ * @brief Benchmark of color_conv_hsb_to_rgb against the float conversion it replaced.
+ *
+ * Reports host CPU cycles per conversion over all hue and saturation values at a few brightness levels. The host has
+ * a floating point unit, the Cortex-M4F of the device converts between floats and integers at a higher relative cost.
+ */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "color_conv.h"
+#include "color_conv_ref.h"
+#include "sim_clock.h"
+#include "sim_test.h"
+
+#define ITERATIONS              20U
+#define CONVERSIONS_COUNT       (256U * 256U)
+
+typedef uint32_t (* hsb_to_rgb_t)(uint8_t hue, uint8_t saturation, uint8_t brightness);
+
+/* Not static, so that the compiler keeps the conversions */
+uint32_t bench_rgb[CONVERSIONS_COUNT];
+
+/**@brief Function for measuring a conversion, in cycles per conversion. */
+static double measure(hsb_to_rgb_t conv, uint8_t brightness)
+{
+    uint64_t sum = 0U;
+    uint32_t iteration;
+
+    for (iteration = 0; iteration < ITERATIONS; iteration++)
+    {
+        uint32_t start = sim_cpu_clock_get();
+        uint32_t i;
+
+        for (i = 0; i < CONVERSIONS_COUNT; i++)
+        {
+            bench_rgb[i] = conv((uint8_t)(i >> 8), (uint8_t)i, brightness);
+        }
+        sum += (uint32_t)(sim_cpu_clock_get() - start);
+    }
+
+    return (double)sum / (ITERATIONS * CONVERSIONS_COUNT);
+}
+
+int main(void)
+{
+    static const uint8_t brightness[] = {1U, 128U, 255U};
+    size_t               i;
+
+    printf("host cycles per HSB to RGB conversion\n");
+    printf("%10s %10s %10s\n", "brightness", "float", "integer");
+    for (i = 0; i < (sizeof(brightness) / sizeof(brightness[0])); i++)
+    {
+        double before = measure(color_conv_ref_hsb_to_rgb, brightness[i]);
+        double after  = measure(color_conv_hsb_to_rgb, brightness[i]);
+
+        printf("%10u %10.1f %10.1f\n", (unsigned)brightness[i], before, after);
+    }
+
+    return sim_test_result("color_conv_hsb");
+}
+
+/**
+ * @}
+ */
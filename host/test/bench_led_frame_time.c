@@ -0,0 +1,253 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @defgroup zigbee_examples_host_bench_led_frame_time bench_led_frame_time.c
+ * @{
+ * @ingroup zigbee_examples
+ *
+ * @brief Benchmark of the frame time of the APA102 driver against the WS2812 driver.
+ *
+ * Both drivers send frames of the same chain length, set at build time. The virtual clock gives the time from
+ * commit until the driver accepts the next frame, which bounds the frame rate, and until the LEDs show the frame.
+ * Host CPU cycles are counted for setting the pixels and committing the frame in thread context. Every frame is
+ * decoded and checked.
+ */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "nrf_error.h"
+#include "nrf_gpio.h"
+#include "drv_apa102.h"
+#include "drv_ws2812.h"
+#include "sim_apa102.h"
+#include "sim_clock.h"
+#include "sim_gpio.h"
+#include "sim_pwm.h"
+#include "sim_spim.h"
+#include "sim_test.h"
+#include "sim_ws2812.h"
+
+#define WS2812_DOUT_PIN         NRF_GPIO_PIN_MAP(1,7)
+#define APA102_CLK_PIN          NRF_GPIO_PIN_MAP(1,8)
+#define APA102_DATA_PIN         NRF_GPIO_PIN_MAP(1,6)
+#define PIXELS_COUNT            DRV_APA102_LED_CHAIN_PIXELS_COUNT_MAX
+#define FRAMES_COUNT            50U
+#define FRAME_TIMEOUT_NS        (1000ULL * SIM_CLOCK_NS_PER_MS)
+
+NRFX_STATIC_ASSERT(DRV_WS2812_LED_CHAIN_PIXELS_COUNT_MAX == PIXELS_COUNT);
+
+/**@brief Measurements of one driver, summed over frames. */
+typedef struct
+{
+    uint64_t busy_ns;       /**< From commit until the driver accepts the next frame. */
+    uint64_t latched_ns;    /**< From commit until the LEDs show the frame. */
+    uint64_t cycles;        /**< Host cycles of setting the pixels and committing the frame. */
+} frame_time_t;
+
+static sim_ws2812_decoder_t m_ws2812_decoder;
+static sim_apa102_decoder_t m_apa102_decoder;
+
+static uint32_t pixel_color(uint32_t frame_no, uint32_t pixel_no)
+{
+    return ((pixel_no + 1U) * 2654435761U + (frame_no * 40503U)) & 0x00FFFFFFU;
+}
+
+/**@brief Function for running the clock until a driver is idle. */
+static void refresh_wait(bool (* is_refreshing)(void), uint64_t start_ns)
+{
+    while (is_refreshing() && sim_clock_run_next(start_ns + FRAME_TIMEOUT_NS))
+    {
+    }
+    SIM_TEST_CHECK(!is_refreshing());
+}
+
+static bool ws2812_frame_is(uint32_t frame_no)
+{
+    uint32_t pixel_no;
+
+    if (m_ws2812_decoder.frame_len != (PIXELS_COUNT * 3U))
+    {
+        return false;
+    }
+
+    /* GRB order */
+    for (pixel_no = 0; pixel_no < PIXELS_COUNT; pixel_no++)
+    {
+        uint32_t        color = pixel_color(frame_no, pixel_no);
+        uint8_t const * p_grb = &m_ws2812_decoder.frame[pixel_no * 3U];
+
+        if ((p_grb[0] != (uint8_t)(color >> 8)) || (p_grb[1] != (uint8_t)(color >> 16)) || (p_grb[2] != (uint8_t)color))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool apa102_frame_is(uint32_t frame_no)
+{
+    uint32_t pixel_no;
+
+    if (m_apa102_decoder.pixels_count != PIXELS_COUNT)
+    {
+        return false;
+    }
+
+    /* Header with global brightness, then BGR order */
+    for (pixel_no = 0; pixel_no < PIXELS_COUNT; pixel_no++)
+    {
+        uint32_t        color  = pixel_color(frame_no, pixel_no);
+        uint8_t const * p_pixel = &m_apa102_decoder.frame[pixel_no * SIM_APA102_PIXEL_BYTES];
+
+        if ((p_pixel[0] != (0xE0U | DRV_APA102_BRIGHTNESS_MAX)) || (p_pixel[1] != (uint8_t)color) ||
+            (p_pixel[2] != (uint8_t)(color >> 8)) || (p_pixel[3] != (uint8_t)(color >> 16)))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void ws2812_measure(frame_time_t * p_time)
+{
+    uint32_t frame_no;
+
+    for (frame_no = 0; frame_no < FRAMES_COUNT; frame_no++)
+    {
+        uint64_t start_ns     = sim_clock_now();
+        uint32_t frames_count = m_ws2812_decoder.frames_count;
+        uint32_t start_cycles = sim_cpu_clock_get();
+        uint32_t pixel_no;
+
+        for (pixel_no = 0; pixel_no < PIXELS_COUNT; pixel_no++)
+        {
+            drv_ws2812_set_pixel(pixel_no, pixel_color(frame_no, pixel_no));
+        }
+        SIM_TEST_CHECK_EQUAL(drv_ws2812_display(NULL, NULL), NRF_SUCCESS);
+        p_time->cycles += (uint32_t)(sim_cpu_clock_get() - start_cycles);
+
+        refresh_wait(drv_ws2812_is_refreshing, start_ns);
+        p_time->busy_ns += sim_clock_now() - start_ns;
+
+        /* LEDs show the frame after the reset time */
+        sim_clock_advance(SIM_WS2812_LATCH_PS / 1000U);
+        sim_ws2812_decoder_poll(&m_ws2812_decoder, sim_clock_now() * 1000ULL);
+        SIM_TEST_CHECK_EQUAL(m_ws2812_decoder.frames_count, frames_count + 1U);
+        SIM_TEST_CHECK(ws2812_frame_is(frame_no));
+        p_time->latched_ns += ((m_ws2812_decoder.frame_end_ps + SIM_WS2812_LATCH_PS) / 1000U) - start_ns;
+    }
+}
+
+static void apa102_measure(frame_time_t * p_time)
+{
+    uint32_t frame_no;
+
+    for (frame_no = 0; frame_no < FRAMES_COUNT; frame_no++)
+    {
+        uint64_t start_ns     = sim_clock_now();
+        uint32_t frames_count = m_apa102_decoder.frames_count;
+        uint32_t start_cycles = sim_cpu_clock_get();
+        uint32_t pixel_no;
+
+        for (pixel_no = 0; pixel_no < PIXELS_COUNT; pixel_no++)
+        {
+            drv_apa102_set_pixel(pixel_no, pixel_color(frame_no, pixel_no), DRV_APA102_BRIGHTNESS_MAX);
+        }
+        SIM_TEST_CHECK_EQUAL(drv_apa102_display(NULL, NULL), NRF_SUCCESS);
+        p_time->cycles += (uint32_t)(sim_cpu_clock_get() - start_cycles);
+
+        refresh_wait(drv_apa102_is_refreshing, start_ns);
+        p_time->busy_ns += sim_clock_now() - start_ns;
+
+        SIM_TEST_CHECK_EQUAL(m_apa102_decoder.frames_count, frames_count + 1U);
+        SIM_TEST_CHECK(apa102_frame_is(frame_no));
+        p_time->latched_ns += (m_apa102_decoder.frame_end_ps / 1000U) - start_ns;
+    }
+}
+
+static void frame_time_print(char const * p_name, frame_time_t const * p_time)
+{
+    double busy_us = (double)p_time->busy_ns / (FRAMES_COUNT * SIM_CLOCK_NS_PER_US);
+
+    printf("%8s %10.1f %12.1f %10.0f %12.0f\n",
+           p_name,
+           busy_us,
+           (double)p_time->latched_ns / (FRAMES_COUNT * SIM_CLOCK_NS_PER_US),
+           1000000.0 / busy_us,
+           (double)p_time->cycles / FRAMES_COUNT);
+}
+
+int main(void)
+{
+    frame_time_t ws2812_time = {0};
+    frame_time_t apa102_time = {0};
+
+    sim_clock_reset();
+    sim_gpio_reset();
+    sim_pwm_reset();
+    sim_spim_reset();
+    sim_ws2812_decoder_init(&m_ws2812_decoder, WS2812_DOUT_PIN);
+    sim_apa102_decoder_init(&m_apa102_decoder, DRV_APA102_SPIM_INSTANCE_NO);
+
+    SIM_TEST_CHECK_EQUAL(drv_ws2812_init(WS2812_DOUT_PIN), NRF_SUCCESS);
+    SIM_TEST_CHECK_EQUAL(drv_apa102_init(APA102_CLK_PIN, APA102_DATA_PIN), NRF_SUCCESS);
+
+    ws2812_measure(&ws2812_time);
+    apa102_measure(&apa102_time);
+
+    printf("%u pixels, virtual time per frame, host cycles of setting pixels and commit\n", (unsigned)PIXELS_COUNT);
+    printf("%8s %10s %12s %10s %12s\n", "driver", "busy us", "latched us", "max fps", "cycles");
+    frame_time_print("ws2812", &ws2812_time);
+    frame_time_print("apa102", &apa102_time);
+
+    SIM_TEST_CHECK_EQUAL(m_ws2812_decoder.errors_count, 0U);
+    SIM_TEST_CHECK_EQUAL(m_apa102_decoder.errors_count, 0U);
+    SIM_TEST_CHECK(apa102_time.busy_ns < ws2812_time.busy_ns);
+
+    return sim_test_result("led_frame_time");
+}
+
+/**
+ * @}
+ */
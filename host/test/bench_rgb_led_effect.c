@@ -0,0 +1,129 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @defgroup zigbee_examples_host_bench_rgb_led_effect bench_rgb_led_effect.c
+ * @{
+ * @ingroup zigbee_examples
+ *
+ * @brief Benchmark of rendering per-pixel effects of rgb_led.
+ *
+ * Reports host CPU cycles per frame and per pixel of every effect against the chain length. Cycles of the host are
+ * not cycles of the device, the numbers compare effects and show how the render time scales with the chain length.
+ */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "rgb_led.h"
+#include "rgb_led_effect.h"
+#include "sim_clock.h"
+#include "sim_test.h"
+
+#define PIXELS_COUNT_MAX        1000U
+#define FRAMES_COUNT            500U
+#define FRAME_PERIOD_MS         20U
+
+/* Not static, so that the compiler keeps the rendered frames */
+uint32_t bench_frame[PIXELS_COUNT_MAX];
+
+int main(void)
+{
+    static const struct
+    {
+        led_mode_t   mode;
+        char const * p_name;
+    } effects[] =
+    {
+        {LED_MODE_GRADIENT, "gradient"},
+        {LED_MODE_CHASE,    "chase"},
+        {LED_MODE_RAINBOW,  "rainbow"},
+        {LED_MODE_TWINKLE,  "twinkle"},
+    };
+    static const size_t chain_lengths[] = {40U, 300U, 1000U};
+    led_params_t        led_params;
+    size_t              i;
+    size_t              j;
+
+    printf("host cycles of rgb_led_effect_render\n");
+    printf("%10s %8s %12s %10s\n", "effect", "pixels", "per frame", "per pixel");
+
+    for (i = 0; i < (sizeof(effects) / sizeof(effects[0])); i++)
+    {
+        memset(&led_params, 0, sizeof(led_params));
+        led_params.mode   = effects[i].mode;
+        led_params.r      = 255;
+        led_params.g      = 96;
+        led_params.b      = 16;
+        led_params.r2     = 0;
+        led_params.g2     = 16;
+        led_params.b2     = 64;
+        led_params.period = 5000;
+        led_params.param  = 32;
+        SIM_TEST_CHECK(rgb_led_effect_is_frame_mode(led_params.mode));
+
+        for (j = 0; j < (sizeof(chain_lengths) / sizeof(chain_lengths[0])); j++)
+        {
+            uint64_t sum = 0U;
+            uint32_t frame_no;
+
+            for (frame_no = 0; frame_no < FRAMES_COUNT; frame_no++)
+            {
+                uint32_t start = sim_cpu_clock_get();
+
+                rgb_led_effect_render(&led_params, frame_no * FRAME_PERIOD_MS, bench_frame, chain_lengths[j]);
+                sum += (uint32_t)(sim_cpu_clock_get() - start);
+            }
+
+            printf("%10s %8u %12.0f %10.1f\n",
+                   effects[i].p_name,
+                   (unsigned)chain_lengths[j],
+                   (double)sum / FRAMES_COUNT,
+                   (double)sum / (FRAMES_COUNT * chain_lengths[j]));
+        }
+    }
+
+    return sim_test_result("rgb_led_effect");
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,206 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @defgroup zigbee_examples_host_bench_scenes bench_scenes.c
+ * @{
+ * @ingroup zigbee_examples
+ *
+ * @brief Benchmark of storing and recalling scenes of the color light.
+ *
+ * Reports flash words written and pages erased per Store Scene command, including compaction of the full log, and
+ * the time from a Recall Scene command to the end of the first WS2812 frame showing the scene, which has to be within
+ * one refresh period of rgb_led. Host cycles of the recall itself are taken from APP_PROFILER_STAGE_SCENE_RECALL.
+ */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "nordic_common.h"
+#include "nrf_gpio.h"
+#include "app_profiler.h"
+#include "zboss_api.h"
+#include "zigbee_color_light_scenes.h"
+#include "sim_clock.h"
+#include "sim_fstorage.h"
+#include "sim_test.h"
+#include "sim_ws2812.h"
+#include "light_fixture.h"
+
+#define DOUT_PIN                NRF_GPIO_PIN_MAP(1,7)
+#define GROUP_ID                1U
+#define SCENES_COUNT            ZB_COLOR_LIGHT_SCENES_COUNT_MAX
+#define STORES_COUNT            400U
+#define RECALLS_COUNT           200U
+#define STEP_NS                 (10ULL * SIM_CLOCK_NS_PER_US)
+#define SETTLE_NS               (200ULL * SIM_CLOCK_NS_PER_MS)
+#define RECALL_TIMEOUT_NS       (1000ULL * SIM_CLOCK_NS_PER_MS)
+#define REFRESH_PERIOD_NS       (40ULL * SIM_CLOCK_NS_PER_MS)   /**< RGB_LED_REFRESH_PERIOD_MS of rgb_led. */
+#define PIXEL_BYTES             3U
+
+static sim_ws2812_decoder_t m_decoder;
+static uint8_t              m_scene_pixels[SCENES_COUNT][PIXEL_BYTES];
+
+/**@brief Function for sending a command of the Scenes cluster with group ID and scene ID. */
+static void scene_cmd(zb_uint8_t cmd_id, zb_uint8_t scene_id)
+{
+    /* Recall Scene is sent with transition time 0 */
+    zb_uint8_t payload[5] = {(zb_uint8_t)GROUP_ID, (zb_uint8_t)(GROUP_ID >> 8), scene_id, 0U, 0U};
+
+    light_fixture_cmd(ZB_ZCL_CLUSTER_ID_SCENES,
+                      cmd_id,
+                      payload,
+                      (cmd_id == ZB_ZCL_CMD_SCENES_RECALL_SCENE) ? 5U : 3U);
+}
+
+/**@brief Function for running the clock for given time, decoding frames meanwhile. */
+static void run(uint64_t time_ns)
+{
+    uint64_t end_ns = sim_clock_now() + time_ns;
+
+    while (sim_clock_now() < end_ns)
+    {
+        sim_clock_advance(STEP_NS);
+        sim_ws2812_decoder_poll(&m_decoder, sim_clock_now() * 1000ULL);
+    }
+}
+
+/**@brief Function for running the clock until the first pixel shows given scene.
+ *
+ * @return Time from now to the end of the frame showing the scene, or RECALL_TIMEOUT_NS.
+ */
+static uint64_t run_until_scene(uint8_t scene_id)
+{
+    uint64_t start_ns     = sim_clock_now();
+    uint32_t frames_count = m_decoder.frames_count;
+
+    while ((sim_clock_now() - start_ns) < RECALL_TIMEOUT_NS)
+    {
+        sim_clock_advance(STEP_NS);
+        sim_ws2812_decoder_poll(&m_decoder, sim_clock_now() * 1000ULL);
+
+        if ((m_decoder.frames_count != frames_count) &&
+            (memcmp(m_decoder.frame, m_scene_pixels[scene_id], PIXEL_BYTES) == 0))
+        {
+            return (m_decoder.frame_end_ps / 1000ULL) - start_ns;
+        }
+        frames_count = m_decoder.frames_count;
+    }
+
+    return RECALL_TIMEOUT_NS;
+}
+
+int main(void)
+{
+    app_profiler_stats_t stats;
+    uint32_t             words_written;
+    uint32_t             pages_erased;
+    uint32_t             flash_ops;
+    uint64_t             latency_sum_ns = 0U;
+    uint64_t             latency_max_ns = 0U;
+    uint32_t             i;
+
+    light_fixture_init();
+    app_profiler_init();
+    sim_ws2812_decoder_init(&m_decoder, DOUT_PIN);
+    run(SETTLE_NS);
+
+    /* Every store changes the scene, so that it is written: level differs between rounds over the scenes */
+    words_written = sim_fstorage_words_written_get();
+    pages_erased  = sim_fstorage_pages_erased_get();
+    flash_ops     = zb_color_light_scenes_flash_ops_get();
+    for (i = 0; i < STORES_COUNT; i++)
+    {
+        uint8_t scene_id = (uint8_t)(i % SCENES_COUNT);
+        uint8_t round    = (uint8_t)((i / SCENES_COUNT) % 4U);
+
+        light_fixture_move_to_hue_sat((zb_uint8_t)(scene_id * 15U), 254U, 0U);
+        light_fixture_move_to_level((zb_uint8_t)(254U - (scene_id * 8U) - round), 0U);
+        scene_cmd(ZB_ZCL_CMD_SCENES_STORE_SCENE, scene_id);
+    }
+    SIM_TEST_CHECK_EQUAL(zb_color_light_scenes_count_get(LIGHT_FIXTURE_ENDPOINT), SCENES_COUNT);
+
+    words_written = sim_fstorage_words_written_get() - words_written;
+    pages_erased  = sim_fstorage_pages_erased_get() - pages_erased;
+    flash_ops     = zb_color_light_scenes_flash_ops_get() - flash_ops;
+    printf("%u stores: %.1f flash words and %.3f page erases per store, %.2f flash operations per store\n",
+           (unsigned)STORES_COUNT, (double)words_written / STORES_COUNT, (double)pages_erased / STORES_COUNT,
+           (double)flash_ops / STORES_COUNT);
+    SIM_TEST_CHECK(flash_ops >= STORES_COUNT);
+
+    /* Colors displayed by the scenes, once settled */
+    for (i = 0; i < SCENES_COUNT; i++)
+    {
+        scene_cmd(ZB_ZCL_CMD_SCENES_RECALL_SCENE, (uint8_t)i);
+        run(SETTLE_NS);
+        memcpy(m_scene_pixels[i], m_decoder.frame, PIXEL_BYTES);
+    }
+
+    /* Consecutive recalls always change the color */
+    app_profiler_reset();
+    for (i = 0; i < RECALLS_COUNT; i++)
+    {
+        uint8_t  scene_id = (uint8_t)((i * 7U) % SCENES_COUNT);
+        uint64_t latency_ns;
+
+        scene_cmd(ZB_ZCL_CMD_SCENES_RECALL_SCENE, scene_id);
+        latency_ns = run_until_scene(scene_id);
+        latency_sum_ns += latency_ns;
+        latency_max_ns  = MAX(latency_max_ns, latency_ns);
+        run(SETTLE_NS);
+    }
+
+    app_profiler_stats_get(APP_PROFILER_STAGE_SCENE_RECALL, &stats);
+    printf("%u recalls: %u host cycles per recall, frame latched after %llu us on average, %llu us at most\n",
+           (unsigned)RECALLS_COUNT,
+           (unsigned)(stats.sum / stats.count),
+           (unsigned long long)(latency_sum_ns / RECALLS_COUNT / SIM_CLOCK_NS_PER_US),
+           (unsigned long long)(latency_max_ns / SIM_CLOCK_NS_PER_US));
+    SIM_TEST_CHECK_EQUAL(stats.count, RECALLS_COUNT);
+    SIM_TEST_CHECK(latency_max_ns <= REFRESH_PERIOD_NS);
+    SIM_TEST_CHECK_EQUAL(m_decoder.errors_count, 0U);
+
+    return sim_test_result("scenes");
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,159 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @defgroup zigbee_examples_host_bench_ws2812_dither bench_ws2812_dither.c
+ * @{
+ * @ingroup zigbee_examples
+ *
+ * @brief Benchmark of the dithering tick of the WS2812 LED backend, for the chain length set at build time.
+ *
+ * Every pixel has its own color with intensities between 8-bit steps, so dithering does not stop. Events of the
+ * virtual clock are run one by one, and host CPU cycles are counted for the timer event which starts the refresh,
+ * that is the dithering tick which quantizes all pixels and commits the frame. Ticks which find the chain still busy
+ * return early and are not counted. Keepalive refresh is disabled, so every refresh is started by a tick.
+ */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "nordic_common.h"
+#include "nrf_error.h"
+#include "app_timer.h"
+#include "drv_ws2812.h"
+#include "rgb_led_backend.h"
+#include "sim_clock.h"
+#include "sim_gpio.h"
+#include "sim_pwm.h"
+#include "sim_test.h"
+
+#define TICKS_COUNT             100U
+#define EVENT_TIMEOUT_NS        (1000ULL * SIM_CLOCK_NS_PER_MS)
+
+static uint32_t m_frame[DRV_WS2812_PIXELS_COUNT_TOTAL];
+
+uint32_t m_tick_cycles_min;
+
+/**@brief Function for running the clock until the chain is idle. */
+static void refresh_wait(void)
+{
+    while (drv_ws2812_is_refreshing() && sim_clock_run_next(sim_clock_now() + EVENT_TIMEOUT_NS))
+    {
+    }
+    SIM_TEST_CHECK(!drv_ws2812_is_refreshing());
+}
+
+/**@brief Function for running clock events until one of them starts a refresh.
+ *
+ * @return Host cycles of the event which started the refresh.
+ */
+static uint32_t tick_run(void)
+{
+    uint32_t cycles = 0U;
+
+    while (!drv_ws2812_is_refreshing())
+    {
+        uint32_t start_cycles = sim_cpu_clock_get();
+
+        if (!sim_clock_run_next(sim_clock_now() + EVENT_TIMEOUT_NS))
+        {
+            SIM_TEST_CHECK(false);
+            break;
+        }
+        cycles = sim_cpu_clock_get() - start_cycles;
+    }
+
+    return cycles;
+}
+
+int main(void)
+{
+    uint64_t cycles = 0U;
+    uint64_t start_ns;
+    uint32_t pixel_no;
+    uint32_t tick;
+
+    sim_clock_reset();
+    sim_gpio_reset();
+    sim_pwm_reset();
+    SIM_TEST_CHECK_EQUAL(app_timer_init(), NRF_SUCCESS);
+
+    rgb_led_backend_init();
+    refresh_wait();
+
+    for (pixel_no = 0; pixel_no < DRV_WS2812_PIXELS_COUNT_TOTAL; pixel_no++)
+    {
+        m_frame[pixel_no] = (((pixel_no + 1U) * 2654435761U) & 0x003F3F3FU) | 0x00010101U;
+    }
+    rgb_led_backend_set_frame(m_frame, DRV_WS2812_PIXELS_COUNT_TOTAL);
+
+    /* First tick warms up the caches */
+    UNUSED_RETURN_VALUE(tick_run());
+    refresh_wait();
+
+    m_tick_cycles_min = UINT32_MAX;
+    start_ns          = sim_clock_now();
+    for (tick = 0U; tick < TICKS_COUNT; tick++)
+    {
+        uint32_t tick_cycles = tick_run();
+
+        cycles += tick_cycles;
+        if (tick_cycles < m_tick_cycles_min)
+        {
+            m_tick_cycles_min = tick_cycles;
+        }
+        refresh_wait();
+    }
+
+    printf("%u pixels, host cycles per dithering tick, virtual time between frames\n",
+           (unsigned)DRV_WS2812_PIXELS_COUNT_TOTAL);
+    printf("%12s %12s %12s %12s\n", "mean cycles", "min cycles", "per pixel", "period ms");
+    printf("%12.0f %12u %12.1f %12.2f\n",
+           (double)cycles / TICKS_COUNT,
+           (unsigned)m_tick_cycles_min,
+           (double)cycles / ((double)TICKS_COUNT * DRV_WS2812_PIXELS_COUNT_TOTAL),
+           (double)(sim_clock_now() - start_ns) / ((double)TICKS_COUNT * SIM_CLOCK_NS_PER_MS));
+
+    return sim_test_result("ws2812_dither");
+}
+
+/**
+ * @}
+ */
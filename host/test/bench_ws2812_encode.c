@@ -0,0 +1,191 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @defgroup zigbee_examples_host_bench_ws2812_encode bench_ws2812_encode.c
+ * @{
+ * @ingroup zigbee_examples
+ *
+ * @brief Benchmark of encoding pixels into the PWM sequence of the WS2812 driver.
+ *
+ * Compares host CPU cycles per pixel of the bit loop encoder, which the driver used before, with the lookup table
+ * encoder of the driver (APP_PROFILER_STAGE_WS2812_ENCODE). Built with DRV_WS2812_ENCODE_LUT_NIBBLE set to 0 and 1.
+ */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "nrf_error.h"
+#include "nrf_gpio.h"
+#include "nrfx_pwm.h"
+#include "app_profiler.h"
+#include "drv_ws2812.h"
+#include "sim_clock.h"
+#include "sim_gpio.h"
+#include "sim_pwm.h"
+#include "sim_test.h"
+
+#define DOUT_PIN                NRF_GPIO_PIN_MAP(1,7)
+#define PIXEL_BYTES             3U
+#define ITERATIONS              200U
+#define WS2812_T1H              (14U | 0x8000U)
+#define WS2812_T0H              (6U | 0x8000U)
+
+static uint8_t          m_pixels[DRV_WS2812_LED_CHAIN_PIXELS_COUNT_MAX * PIXEL_BYTES];
+/* Not static, so that the compiler keeps the stores of the encoder */
+nrf_pwm_values_common_t bench_sequence[DRV_WS2812_LED_CHAIN_PIXELS_COUNT_MAX * PIXEL_BYTES * 8U];
+
+/**@brief Bit loop encoder, as used by the driver before the lookup table. */
+static void __attribute__((noinline)) bit_loop_encode(size_t pixels_count)
+{
+    uint8_t const * ptr                = m_pixels;
+    size_t          pwm_duty_cycle_idx = 0;
+    size_t          byte_no;
+
+    for (byte_no = 0U; byte_no < (pixels_count * PIXEL_BYTES); ++byte_no)
+    {
+        uint_fast8_t bit;
+        uint_fast8_t b = *(ptr++);
+
+        /* Process bits in byte b, MSB first */
+        for (bit = 0U; bit < 8U; ++bit)
+        {
+            uint16_t pwm = WS2812_T0H;
+            if ((b & 0x80U) != 0U)
+            {
+                pwm = WS2812_T1H;
+            }
+            bench_sequence[pwm_duty_cycle_idx++] = pwm;
+            b <<= 1;
+        }
+    }
+}
+
+static uint32_t color_get(uint32_t iteration, uint32_t pixel_no)
+{
+    return ((pixel_no + 1U) * 2654435761U + (iteration * 40503U)) & 0x00FFFFFFU;
+}
+
+/**@brief Function for measuring the bit loop encoder, in cycles per pixel. */
+static double bit_loop_measure(size_t pixels_count)
+{
+    uint64_t sum = 0U;
+    uint32_t iteration;
+    size_t   i;
+
+    for (iteration = 0; iteration < ITERATIONS; iteration++)
+    {
+        uint32_t start;
+
+        for (i = 0; i < sizeof(m_pixels); i++)
+        {
+            m_pixels[i] = (uint8_t)color_get(iteration, (uint32_t)i);
+        }
+
+        start = sim_cpu_clock_get();
+        bit_loop_encode(pixels_count);
+        sum += (uint32_t)(sim_cpu_clock_get() - start);
+    }
+
+    return (double)sum / (ITERATIONS * pixels_count);
+}
+
+/**@brief Function for measuring encoding of frames by the driver, in cycles per pixel. */
+static double driver_measure(size_t pixels_count)
+{
+    app_profiler_stats_t stats;
+    drv_ws2812_stats_t   drv_stats;
+    uint32_t             encoded_pixels;
+    uint32_t             iteration;
+    uint32_t             pixel_no;
+
+    drv_ws2812_stats_get(&drv_stats);
+    encoded_pixels = drv_stats.encoded_pixels;
+    app_profiler_reset();
+
+    for (iteration = 0; iteration < ITERATIONS; iteration++)
+    {
+        for (pixel_no = 0; pixel_no < pixels_count; pixel_no++)
+        {
+            drv_ws2812_set_pixel(pixel_no, color_get(iteration, pixel_no));
+        }
+        SIM_TEST_CHECK_EQUAL(drv_ws2812_display(NULL, NULL), NRF_SUCCESS);
+        while (drv_ws2812_is_refreshing())
+        {
+            sim_clock_advance(SIM_CLOCK_NS_PER_MS);
+        }
+    }
+
+    drv_ws2812_stats_get(&drv_stats);
+    SIM_TEST_CHECK_EQUAL(drv_stats.encoded_pixels - encoded_pixels, ITERATIONS * pixels_count);
+
+    app_profiler_stats_get(APP_PROFILER_STAGE_WS2812_ENCODE, &stats);
+
+    return (double)stats.sum / (ITERATIONS * pixels_count);
+}
+
+int main(void)
+{
+    static const size_t chain_lengths[] = {40U, 300U, 1000U};
+    size_t              i;
+
+    sim_clock_reset();
+    sim_gpio_reset();
+    sim_pwm_reset();
+    app_profiler_init();
+
+    SIM_TEST_CHECK_EQUAL(drv_ws2812_init(DOUT_PIN), NRF_SUCCESS);
+
+    printf("host cycles per pixel, %s lookup table\n", DRV_WS2812_ENCODE_LUT_NIBBLE ? "nibble" : "byte");
+    printf("%8s %10s %10s\n", "pixels", "bit loop", "lookup");
+    for (i = 0; i < (sizeof(chain_lengths) / sizeof(chain_lengths[0])); i++)
+    {
+        double before = bit_loop_measure(chain_lengths[i]);
+        double after  = driver_measure(chain_lengths[i]);
+
+        printf("%8u %10.1f %10.1f\n", (unsigned)chain_lengths[i], before, after);
+    }
+
+    return sim_test_result(DRV_WS2812_ENCODE_LUT_NIBBLE ? "ws2812_encode_nibble" : "ws2812_encode");
+}
+
+/**
+ * @}
+ */
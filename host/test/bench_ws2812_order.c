@@ -0,0 +1,268 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @defgroup zigbee_examples_host_bench_ws2812_order bench_ws2812_order.c
+ * @{
+ * @ingroup zigbee_examples
+ *
+ * @brief Benchmark of the WS2812 encoder specialized for the color order against a generic encoder.
+ *
+ * The generic encoder takes the color order and the number of bytes per pixel at run time, as a driver supporting
+ * all LED types would. The driver is built for one DRV_WS2812_COLOR_ORDER and DRV_WS2812_RGBW_ENABLED, the color is
+ * reordered once by drv_ws2812_set_pixel and the encoder does not depend on the order. Host CPU cycles per pixel of
+ * both encoders and of drv_ws2812_set_pixel are reported, and the frame decoded from the pin is checked against
+ * the selected order.
+ */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "nrf_error.h"
+#include "nrf_gpio.h"
+#include "nrfx_pwm.h"
+#include "app_profiler.h"
+#include "drv_ws2812.h"
+#include "sim_clock.h"
+#include "sim_gpio.h"
+#include "sim_pwm.h"
+#include "sim_test.h"
+#include "sim_ws2812.h"
+
+#define DOUT_PIN                NRF_GPIO_PIN_MAP(1,7)
+#define PIXELS_COUNT            DRV_WS2812_LED_CHAIN_PIXELS_COUNT_MAX
+#define BYTES_PER_PIXEL         (DRV_WS2812_RGBW_ENABLED ? 4U : 3U)
+#define ITERATIONS              200U
+#define WS2812_T1H              (14U | 0x8000U)
+#define WS2812_T0H              (6U | 0x8000U)
+
+/* Shift of each transmitted byte within the color, white is always last */
+#if (DRV_WS2812_COLOR_ORDER == DRV_WS2812_COLOR_ORDER_GRB)
+#define ORDER_NAME              "GRB"
+#define ORDER_SHIFTS            {8U, 16U, 0U, 24U}
+#elif (DRV_WS2812_COLOR_ORDER == DRV_WS2812_COLOR_ORDER_RGB)
+#define ORDER_NAME              "RGB"
+#define ORDER_SHIFTS            {16U, 8U, 0U, 24U}
+#elif (DRV_WS2812_COLOR_ORDER == DRV_WS2812_COLOR_ORDER_BRG)
+#define ORDER_NAME              "BRG"
+#define ORDER_SHIFTS            {0U, 16U, 8U, 24U}
+#elif (DRV_WS2812_COLOR_ORDER == DRV_WS2812_COLOR_ORDER_RBG)
+#define ORDER_NAME              "RBG"
+#define ORDER_SHIFTS            {16U, 0U, 8U, 24U}
+#elif (DRV_WS2812_COLOR_ORDER == DRV_WS2812_COLOR_ORDER_GBR)
+#define ORDER_NAME              "GBR"
+#define ORDER_SHIFTS            {8U, 0U, 16U, 24U}
+#elif (DRV_WS2812_COLOR_ORDER == DRV_WS2812_COLOR_ORDER_BGR)
+#define ORDER_NAME              "BGR"
+#define ORDER_SHIFTS            {0U, 8U, 16U, 24U}
+#endif
+
+static sim_ws2812_decoder_t    m_decoder;
+static nrf_pwm_values_common_t m_lut[256][8];
+static uint32_t                m_colors[PIXELS_COUNT];
+/* Not const, so that the generic encoder does not get specialized for them */
+uint8_t                        bench_shifts[4] = ORDER_SHIFTS;
+size_t                         bench_bytes_per_pixel = BYTES_PER_PIXEL;
+/* Not static, so that the compiler keeps the stores of the encoder */
+nrf_pwm_values_common_t        bench_sequence[PIXELS_COUNT * 4U * 8U];
+
+/**@brief Generic encoder, color order and number of bytes per pixel are given at run time. */
+static void __attribute__((noinline)) generic_encode(uint32_t const * p_colors,
+                                                     size_t           pixels_count,
+                                                     uint8_t const  * p_shifts,
+                                                     size_t           bytes_per_pixel)
+{
+    nrf_pwm_values_common_t * p_dst = bench_sequence;
+    size_t                    pixel_no;
+
+    for (pixel_no = 0; pixel_no < pixels_count; pixel_no++)
+    {
+        uint32_t color = p_colors[pixel_no];
+        size_t   byte_no;
+
+        for (byte_no = 0; byte_no < bytes_per_pixel; byte_no++)
+        {
+            memcpy(p_dst, m_lut[(uint8_t)(color >> p_shifts[byte_no])], sizeof(m_lut[0]));
+            p_dst += 8U;
+        }
+    }
+}
+
+static uint32_t color_get(uint32_t iteration, uint32_t pixel_no)
+{
+    uint32_t color = ((pixel_no + 1U) * 2654435761U) + (iteration * 40503U);
+
+    return DRV_WS2812_RGBW_ENABLED ? color : (color & 0x00FFFFFFU);
+}
+
+/**@brief Function for measuring the generic encoder, in cycles per pixel. */
+static double generic_measure(void)
+{
+    uint64_t sum = 0U;
+    uint32_t iteration;
+    uint32_t pixel_no;
+
+    for (iteration = 0; iteration < ITERATIONS; iteration++)
+    {
+        uint32_t start;
+
+        for (pixel_no = 0; pixel_no < PIXELS_COUNT; pixel_no++)
+        {
+            m_colors[pixel_no] = color_get(iteration, pixel_no);
+        }
+
+        start = sim_cpu_clock_get();
+        generic_encode(m_colors, PIXELS_COUNT, bench_shifts, bench_bytes_per_pixel);
+        sum += (uint32_t)(sim_cpu_clock_get() - start);
+    }
+
+    return (double)sum / (ITERATIONS * PIXELS_COUNT);
+}
+
+/**@brief Function for measuring the driver, in cycles per pixel of drv_ws2812_set_pixel and of encoding. */
+static void driver_measure(double * p_set, double * p_encode)
+{
+    app_profiler_stats_t stats;
+    uint64_t             sum = 0U;
+    uint32_t             iteration;
+    uint32_t             pixel_no;
+
+    app_profiler_reset();
+
+    for (iteration = 0; iteration < ITERATIONS; iteration++)
+    {
+        uint32_t start;
+
+        for (pixel_no = 0; pixel_no < PIXELS_COUNT; pixel_no++)
+        {
+            m_colors[pixel_no] = color_get(iteration, pixel_no);
+        }
+
+        start = sim_cpu_clock_get();
+        for (pixel_no = 0; pixel_no < PIXELS_COUNT; pixel_no++)
+        {
+            drv_ws2812_set_pixel(pixel_no, m_colors[pixel_no]);
+        }
+        sum += (uint32_t)(sim_cpu_clock_get() - start);
+
+        SIM_TEST_CHECK_EQUAL(drv_ws2812_display(NULL, NULL), NRF_SUCCESS);
+        while (drv_ws2812_is_refreshing())
+        {
+            sim_clock_advance(SIM_CLOCK_NS_PER_MS);
+            sim_ws2812_decoder_poll(&m_decoder, sim_clock_now() * 1000ULL);
+        }
+    }
+    sim_clock_advance(SIM_CLOCK_NS_PER_MS);
+    sim_ws2812_decoder_poll(&m_decoder, sim_clock_now() * 1000ULL);
+
+    app_profiler_stats_get(APP_PROFILER_STAGE_WS2812_ENCODE, &stats);
+
+    *p_set    = (double)sum / (ITERATIONS * PIXELS_COUNT);
+    *p_encode = (double)stats.sum / (ITERATIONS * PIXELS_COUNT);
+}
+
+/**@brief Function for checking the last decoded frame against the colors of the last iteration. */
+static void frame_check(void)
+{
+    uint32_t pixel_no;
+    size_t   byte_no;
+
+    SIM_TEST_CHECK_EQUAL(m_decoder.frame_len, PIXELS_COUNT * BYTES_PER_PIXEL);
+    SIM_TEST_CHECK_EQUAL(m_decoder.errors_count, 0U);
+
+    for (pixel_no = 0; pixel_no < PIXELS_COUNT; pixel_no++)
+    {
+        for (byte_no = 0; byte_no < BYTES_PER_PIXEL; byte_no++)
+        {
+            uint8_t expected = (uint8_t)(m_colors[pixel_no] >> bench_shifts[byte_no]);
+
+            if (m_decoder.frame[(pixel_no * BYTES_PER_PIXEL) + byte_no] != expected)
+            {
+                printf("pixel %u byte %u: %02x, expected %02x\n", (unsigned)pixel_no, (unsigned)byte_no,
+                       m_decoder.frame[(pixel_no * BYTES_PER_PIXEL) + byte_no], expected);
+                SIM_TEST_CHECK(false);
+                return;
+            }
+        }
+    }
+}
+
+int main(void)
+{
+    double   generic;
+    double   set;
+    double   encode;
+    uint32_t b;
+    uint32_t bit;
+
+    for (b = 0; b < 256U; b++)
+    {
+        for (bit = 0; bit < 8U; bit++)
+        {
+            m_lut[b][bit] = ((b & (0x80U >> bit)) != 0U) ? WS2812_T1H : WS2812_T0H;
+        }
+    }
+
+    sim_clock_reset();
+    sim_gpio_reset();
+    sim_pwm_reset();
+    sim_ws2812_decoder_init(&m_decoder, DOUT_PIN);
+    app_profiler_init();
+
+    SIM_TEST_CHECK_EQUAL(drv_ws2812_init(DOUT_PIN), NRF_SUCCESS);
+
+    generic = generic_measure();
+    driver_measure(&set, &encode);
+    frame_check();
+
+    printf("%s%s, %u pixels, host cycles per pixel\n", ORDER_NAME, DRV_WS2812_RGBW_ENABLED ? "W" : "",
+           (unsigned)PIXELS_COUNT);
+    printf("%22s %10.1f\n", "generic encoder", generic);
+    printf("%22s %10.1f\n", "specialized encoder", encode);
+    /* Needed by both encoders, the generic one would store the color as given */
+    printf("%22s %10.1f\n", "drv_ws2812_set_pixel", set);
+
+    return sim_test_result("ws2812_order");
+}
+
+/**
+ * @}
+ */
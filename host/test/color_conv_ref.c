@@ -0,0 +1,213 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @defgroup zigbee_examples_host_color_conv_ref color_conv_ref.c
+ * @{
+ * @ingroup zigbee_examples
+ */
+#include <stdint.h>
+#include <stddef.h>
+#include <math.h>
+
+#include "color_conv_ref.h"
+
+/**@brief Function for converting a component from range 0 - 1 into 0 - 255 as the former code did, by truncation. */
+static uint8_t component_get(float value)
+{
+    value *= 255.0f;
+    if (value <= 0.0f)
+    {
+        return 0U;
+    }
+    if (value >= 255.0f)
+    {
+        return 255U;
+    }
+
+    return (uint8_t)value;
+}
+
+uint32_t color_conv_ref_hsb_to_rgb(uint8_t hue, uint8_t saturation, uint8_t brightness)
+{
+    /* C, X, m are auxiliary variables */
+    float   C = 0.0;
+    float   X = 0.0;
+    float   m = 0.0;
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+
+    /* Convertion HSB --> RGB */
+    C = (brightness / 255.0f) * (saturation / 254.0f);
+    X = (hue / 254.0f) * 6.0f;
+    /* Casting in var X is necessary due to implementation of floating-point modulo_2 */
+    X = (X - (2 * (((uint8_t) X) / 2)));
+    X -= 1.0f;
+    X = C * (1.0f - ((X > 0.0f) ? (X) : (-1.0f * X)));
+    m = (brightness / 255.0f) - C;
+
+    /* Hue value is stored in range (0 - 255) instead of (0 - 360) degree */
+    if (hue <= 42) /* hue < 60 degree */
+    {
+        r = component_get(C + m);
+        g = component_get(X + m);
+        b = component_get(0.0f + m);
+    }
+    else if (hue <= 84)  /* hue < 120 degree */
+    {
+        r = component_get(X + m);
+        g = component_get(C + m);
+        b = component_get(0.0f + m);
+    }
+    else if (hue <= 127) /* hue < 180 degree */
+    {
+        r = component_get(0.0f + m);
+        g = component_get(C + m);
+        b = component_get(X + m);
+    }
+    else if (hue < 170)  /* hue < 240 degree */
+    {
+        r = component_get(0.0f + m);
+        g = component_get(X + m);
+        b = component_get(C + m);
+    }
+    else if (hue <= 212) /* hue < 300 degree */
+    {
+        r = component_get(X + m);
+        g = component_get(0.0f + m);
+        b = component_get(C + m);
+    }
+    else                /* hue < 360 degree */
+    {
+        r = component_get(C + m);
+        g = component_get(0.0f + m);
+        b = component_get(X + m);
+    }
+
+    return ((uint32_t)r << 16) | ((uint32_t)g << 8) | b;
+}
+
+/**@brief Function for solving a 3 x 3 linear system with Cramer's rule.
+ *
+ * @param[in]  m        Matrix of the system.
+ * @param[in]  v        Right hand side.
+ * @param[out] p_res    Solution.
+ */
+static void solve3(const double m[3][3], const double v[3], double * p_res)
+{
+    double det = (m[0][0] * ((m[1][1] * m[2][2]) - (m[1][2] * m[2][1]))) -
+                 (m[0][1] * ((m[1][0] * m[2][2]) - (m[1][2] * m[2][0]))) +
+                 (m[0][2] * ((m[1][0] * m[2][1]) - (m[1][1] * m[2][0])));
+    size_t col;
+
+    for (col = 0; col < 3U; col++)
+    {
+        double mc[3][3];
+        size_t i;
+        size_t j;
+
+        for (i = 0; i < 3U; i++)
+        {
+            for (j = 0; j < 3U; j++)
+            {
+                mc[i][j] = (j == col) ? v[i] : m[i][j];
+            }
+        }
+        p_res[col] = ((mc[0][0] * ((mc[1][1] * mc[2][2]) - (mc[1][2] * mc[2][1]))) -
+                      (mc[0][1] * ((mc[1][0] * mc[2][2]) - (mc[1][2] * mc[2][0]))) +
+                      (mc[0][2] * ((mc[1][0] * mc[2][1]) - (mc[1][1] * mc[2][0])))) / det;
+    }
+}
+
+uint32_t color_conv_ref_xy_to_rgb(const color_conv_xy_t   p_primaries[3],
+                                  const color_conv_xy_t * p_white,
+                                  const color_conv_xy_t * p_xy)
+{
+    double   p[3][3];   /* XYZ of primaries with Y = 1, in columns */
+    double   white[3];
+    double   white_intensity[3];
+    double   xyz[3];
+    double   intensity[3];
+    double   intensity_max = 0.0;
+    uint32_t rgb           = 0U;
+    size_t   i;
+
+    for (i = 0; i < 3U; i++)
+    {
+        double x = p_primaries[i].x / 65536.0;
+        double y = p_primaries[i].y / 65536.0;
+
+        p[0][i] = x / y;
+        p[1][i] = 1.0;
+        p[2][i] = (1.0 - x - y) / y;
+    }
+
+    white[0] = p_white->x / 65536.0;
+    white[1] = p_white->y / 65536.0;
+    white[2] = 1.0 - white[0] - white[1];
+    solve3(p, white, white_intensity);
+
+    xyz[0] = p_xy->x / 65536.0;
+    xyz[1] = p_xy->y / 65536.0;
+    xyz[2] = fmax(1.0 - xyz[0] - xyz[1], 0.0);
+    solve3(p, xyz, intensity);
+
+    /* Intensities relative to the white point, out of gamut clipped, the brightest one at full intensity */
+    for (i = 0; i < 3U; i++)
+    {
+        intensity[i]  = fmax(intensity[i] / white_intensity[i], 0.0);
+        intensity_max = fmax(intensity[i], intensity_max);
+    }
+
+    for (i = 0; i < 3U; i++)
+    {
+        double luminance = (intensity_max > 0.0) ? (intensity[i] / intensity_max) : 0.0;
+        double lightness = (luminance <= 0.008856) ? (903.3 * luminance) : ((116.0 * cbrt(luminance)) - 16.0);
+
+        rgb = (rgb << 8) | (uint32_t)lround(lightness * 2.55);
+    }
+
+    return rgb;
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,91 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @defgroup zigbee_examples_host_color_conv_ref color_conv_ref.h
+ * @{
+ * @ingroup zigbee_examples
+ *
+ * @brief Floating point reference implementations of color conversions, used by tests and benchmarks of color_conv.
+ */
+
+#ifndef COLOR_CONV_REF_H__
+#define COLOR_CONV_REF_H__
+
+#include <stdint.h>
+
+#include "color_conv.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**@brief Function for converting Zigbee hue, saturation and brightness into RGB color with float arithmetic.
+ *
+ * Same as the conversion used by zigbee_color_light.c before color_conv, except that components out of range
+ * (saturation 255) are clamped instead of cast to uint8_t, which is undefined for floats out of range.
+ *
+ * @return RGB color, in the format of color_conv_hsb_to_rgb.
+ */
+uint32_t color_conv_ref_hsb_to_rgb(uint8_t hue, uint8_t saturation, uint8_t brightness);
+
+/**@brief Function for converting chromaticity coordinates into RGB color of full brightness with double arithmetic.
+ *
+ * The conversion matrix is computed for every call. Results are rounded to the nearest integer.
+ *
+ * @param[in] p_primaries   Chromaticity coordinates of red, green and blue primary.
+ * @param[in] p_white       Chromaticity coordinates of the white point.
+ * @param[in] p_xy          Chromaticity coordinates of the color.
+ *
+ * @return RGB color, in the format of color_conv_xy_to_rgb.
+ */
+uint32_t color_conv_ref_xy_to_rgb(const color_conv_xy_t   p_primaries[3],
+                                  const color_conv_xy_t * p_white,
+                                  const color_conv_xy_t * p_xy);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* COLOR_CONV_REF_H__ */
+
+/**
+ * @}
+ */
@@ -0,0 +1,274 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @defgroup zigbee_examples_host_light_fixture light_fixture.c
+ * @{
+ * @ingroup zigbee_examples
+ */
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "app_error.h"
+#include "app_timer.h"
+#include "rgb_led.h"
+#include "zboss_api.h"
+#include "zb_zcl_color_control.h"
+#include "zigbee_color_light.h"
+#include "sim_clock.h"
+#include "sim_fstorage.h"
+#include "sim_gpio.h"
+#include "sim_pwm.h"
+#include "sim_zboss.h"
+#include "light_fixture.h"
+
+zb_color_light_ctx_t light_fixture_ctx;
+
+/* Called by zigbee_color_light, as by main.c of the application */
+void update_endpoint_led(zb_uint8_t ep, led_params_t * p_led_params)
+{
+    rgb_led_segment_update(ep - LIGHT_FIXTURE_ENDPOINT, p_led_params);
+}
+
+/**@brief Function for registering attributes written by zigbee_color_light, as the device declaration does. */
+static void attrs_register(zb_color_light_ctx_t * p_ctx)
+{
+    zb_zcl_color_ctrl_attrs_set_color_inf_t * p_color_info = &p_ctx->color_control_attr.set_color_info;
+
+    sim_zboss_attr_register(LIGHT_FIXTURE_ENDPOINT, ZB_ZCL_CLUSTER_ID_ON_OFF, ZB_ZCL_ATTR_ON_OFF_ON_OFF_ID,
+                            &p_ctx->on_off_attr.on_off, sizeof(p_ctx->on_off_attr.on_off));
+    sim_zboss_attr_register(LIGHT_FIXTURE_ENDPOINT, ZB_ZCL_CLUSTER_ID_LEVEL_CONTROL, ZB_ZCL_ATTR_LEVEL_CONTROL_CURRENT_LEVEL_ID,
+                            &p_ctx->level_control_attr.current_level, sizeof(p_ctx->level_control_attr.current_level));
+    sim_zboss_attr_register(LIGHT_FIXTURE_ENDPOINT, ZB_ZCL_CLUSTER_ID_LEVEL_CONTROL, ZB_ZCL_ATTR_LEVEL_CONTROL_REMAINING_TIME_ID,
+                            &p_ctx->level_control_attr.remaining_time, sizeof(p_ctx->level_control_attr.remaining_time));
+    sim_zboss_attr_register(LIGHT_FIXTURE_ENDPOINT, ZB_ZCL_CLUSTER_ID_COLOR_CONTROL, ZB_ZCL_ATTR_COLOR_CONTROL_CURRENT_HUE_ID,
+                            &p_color_info->current_hue, sizeof(p_color_info->current_hue));
+    sim_zboss_attr_register(LIGHT_FIXTURE_ENDPOINT, ZB_ZCL_CLUSTER_ID_COLOR_CONTROL, ZB_ZCL_ATTR_COLOR_CONTROL_CURRENT_SATURATION_ID,
+                            &p_color_info->current_saturation, sizeof(p_color_info->current_saturation));
+    sim_zboss_attr_register(LIGHT_FIXTURE_ENDPOINT, ZB_ZCL_CLUSTER_ID_COLOR_CONTROL, ZB_ZCL_ATTR_COLOR_CONTROL_REMAINING_TIME_ID,
+                            &p_color_info->remaining_time, sizeof(p_color_info->remaining_time));
+    sim_zboss_attr_register(LIGHT_FIXTURE_ENDPOINT, ZB_ZCL_CLUSTER_ID_COLOR_CONTROL, ZB_ZCL_ATTR_COLOR_CONTROL_CURRENT_X_ID,
+                            &p_color_info->current_X, sizeof(p_color_info->current_X));
+    sim_zboss_attr_register(LIGHT_FIXTURE_ENDPOINT, ZB_ZCL_CLUSTER_ID_COLOR_CONTROL, ZB_ZCL_ATTR_COLOR_CONTROL_CURRENT_Y_ID,
+                            &p_color_info->current_Y, sizeof(p_color_info->current_Y));
+    sim_zboss_attr_register(LIGHT_FIXTURE_ENDPOINT, ZB_ZCL_CLUSTER_ID_COLOR_CONTROL, ZB_ZCL_ATTR_COLOR_CONTROL_COLOR_TEMPERATURE_ID,
+                            &p_color_info->color_temperature, sizeof(p_color_info->color_temperature));
+}
+
+void light_fixture_init(void)
+{
+    ret_code_t ret_code;
+
+    sim_clock_reset();
+    sim_gpio_reset();
+    sim_pwm_reset();
+    sim_zboss_reset();
+    sim_fstorage_reset();
+
+    ret_code = app_timer_init();
+    APP_ERROR_CHECK(ret_code);
+
+    /* Attributes are written already by the initialization of the context */
+    attrs_register(&light_fixture_ctx);
+
+    rgb_led_init();
+    zb_color_light_init();
+    zb_color_light_init_ctx(&light_fixture_ctx, LIGHT_FIXTURE_ENDPOINT, NULL, NULL);
+}
+
+/**@brief Function for writing an attribute and calling the device callback, as the stack does. */
+static void stack_attr_set(zb_uint16_t cluster_id, zb_uint16_t attr_id, zb_uint16_t value)
+{
+    zb_zcl_set_attr_value_param_t savp;
+    zb_ret_t                      ret;
+
+    memset(&savp, 0, sizeof(savp));
+    savp.cluster_id = cluster_id;
+    savp.attr_id    = attr_id;
+    if ((cluster_id == ZB_ZCL_CLUSTER_ID_ON_OFF) ||
+        (attr_id == ZB_ZCL_ATTR_COLOR_CONTROL_CURRENT_HUE_ID) ||
+        (attr_id == ZB_ZCL_ATTR_COLOR_CONTROL_CURRENT_SATURATION_ID))
+    {
+        savp.values.data8 = (zb_uint8_t)value;
+    }
+    else
+    {
+        savp.values.data16 = value;
+    }
+
+    UNUSED_RETURN_VALUE(zb_zcl_set_attr_val(light_fixture_ctx.ep_id,
+                                            cluster_id,
+                                            ZB_ZCL_CLUSTER_SERVER_ROLE,
+                                            attr_id,
+                                            (zb_uint8_t *)&savp.values,
+                                            ZB_FALSE));
+
+    ret = zb_color_light_set_attribute(&light_fixture_ctx, &savp);
+    APP_ERROR_CHECK_BOOL(ret == RET_OK);
+}
+
+/**@brief Function for processing a command by the stack, after the endpoint handler.
+ *
+ * Transitions of the stack are not run, the final value is set right away. zigbee_color_light ignores steps of
+ * transitions started by its command handler anyway.
+ */
+static void stack_cmd_process(zb_uint16_t cluster_id, zb_uint8_t cmd_id, zb_uint8_t const * p_payload, size_t length)
+{
+    zb_ret_t ret;
+
+    if (cluster_id == ZB_ZCL_CLUSTER_ID_ON_OFF)
+    {
+        zb_uint8_t on_off = light_fixture_ctx.on_off_attr.on_off;
+
+        switch (cmd_id)
+        {
+            case ZB_ZCL_CMD_ON_OFF_OFF_ID:
+                on_off = ZB_ZCL_ON_OFF_IS_OFF;
+                break;
+
+            case ZB_ZCL_CMD_ON_OFF_ON_ID:
+                on_off = ZB_ZCL_ON_OFF_IS_ON;
+                break;
+
+            case ZB_ZCL_CMD_ON_OFF_TOGGLE_ID:
+                on_off = !on_off;
+                break;
+
+            default:
+                break;
+        }
+        stack_attr_set(ZB_ZCL_CLUSTER_ID_ON_OFF, ZB_ZCL_ATTR_ON_OFF_ON_OFF_ID, on_off);
+    }
+    else if (cluster_id == ZB_ZCL_CLUSTER_ID_LEVEL_CONTROL)
+    {
+        if (((cmd_id == ZB_ZCL_CMD_LEVEL_CONTROL_MOVE_TO_LEVEL) ||
+             (cmd_id == ZB_ZCL_CMD_LEVEL_CONTROL_MOVE_TO_LEVEL_WITH_ON_OFF)) &&
+            (length >= 3))
+        {
+            ret = zb_color_light_set_level(&light_fixture_ctx, p_payload[0]);
+            APP_ERROR_CHECK_BOOL(ret == RET_OK);
+        }
+    }
+    else if (cluster_id == ZB_ZCL_CLUSTER_ID_COLOR_CONTROL)
+    {
+        switch (cmd_id)
+        {
+            case ZB_ZCL_CMD_COLOR_CONTROL_MOVE_TO_HUE:
+                if (length >= 4)
+                {
+                    stack_attr_set(cluster_id, ZB_ZCL_ATTR_COLOR_CONTROL_CURRENT_HUE_ID, p_payload[0]);
+                }
+                break;
+
+            case ZB_ZCL_CMD_COLOR_CONTROL_MOVE_TO_SATURATION:
+                if (length >= 3)
+                {
+                    stack_attr_set(cluster_id, ZB_ZCL_ATTR_COLOR_CONTROL_CURRENT_SATURATION_ID, p_payload[0]);
+                }
+                break;
+
+            case ZB_ZCL_CMD_COLOR_CONTROL_MOVE_TO_HUE_SATURATION:
+                if (length >= 4)
+                {
+                    stack_attr_set(cluster_id, ZB_ZCL_ATTR_COLOR_CONTROL_CURRENT_HUE_ID, p_payload[0]);
+                    stack_attr_set(cluster_id, ZB_ZCL_ATTR_COLOR_CONTROL_CURRENT_SATURATION_ID, p_payload[1]);
+                }
+                break;
+
+            default:
+                break;
+        }
+    }
+    else
+    {
+        /* Scenes are handled by zigbee_color_light */
+    }
+}
+
+void light_fixture_cmd(zb_uint16_t cluster_id, zb_uint8_t cmd_id, void const * p_payload, size_t length)
+{
+    zb_zcl_parsed_hdr_t cmd_info;
+    zb_bufid_t          bufid;
+    zb_uint8_t          consumed;
+
+    memset(&cmd_info, 0, sizeof(cmd_info));
+    cmd_info.cluster_id                           = cluster_id;
+    cmd_info.cmd_id                               = cmd_id;
+    cmd_info.cmd_direction                        = ZB_ZCL_FRAME_DIRECTION_TO_SRV;
+    cmd_info.addr_data.common_data.dst_endpoint   = light_fixture_ctx.ep_id;
+
+    bufid    = sim_zboss_buf_alloc(&cmd_info, p_payload, length);
+    consumed = zb_color_light_zcl_cmd_handler(&light_fixture_ctx, bufid);
+    if (!consumed)
+    {
+        stack_cmd_process(cluster_id, cmd_id, (zb_uint8_t const *)p_payload, length);
+    }
+    zb_buf_free(bufid);
+}
+
+void light_fixture_move_to_level(zb_uint8_t level, zb_uint16_t transition_time)
+{
+    zb_uint8_t payload[3] = {level, (zb_uint8_t)transition_time, (zb_uint8_t)(transition_time >> 8)};
+
+    light_fixture_cmd(ZB_ZCL_CLUSTER_ID_LEVEL_CONTROL,
+                      ZB_ZCL_CMD_LEVEL_CONTROL_MOVE_TO_LEVEL_WITH_ON_OFF,
+                      payload,
+                      sizeof(payload));
+}
+
+void light_fixture_move_to_hue_sat(zb_uint8_t hue, zb_uint8_t saturation, zb_uint16_t transition_time)
+{
+    zb_uint8_t payload[4] = {hue, saturation, (zb_uint8_t)transition_time, (zb_uint8_t)(transition_time >> 8)};
+
+    light_fixture_cmd(ZB_ZCL_CLUSTER_ID_COLOR_CONTROL,
+                      ZB_ZCL_CMD_COLOR_CONTROL_MOVE_TO_HUE_SATURATION,
+                      payload,
+                      sizeof(payload));
+}
+
+void light_fixture_on_off(bool on)
+{
+    light_fixture_cmd(ZB_ZCL_CLUSTER_ID_ON_OFF, on ? ZB_ZCL_CMD_ON_OFF_ON_ID : ZB_ZCL_CMD_ON_OFF_OFF_ID, NULL, 0);
+}
+
+/**
+ * @}
+ */
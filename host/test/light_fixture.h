@@ -0,0 +1,103 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @defgroup zigbee_examples_host_light_fixture light_fixture.h
+ * @{
+ * @ingroup zigbee_examples
+ *
+ * @brief Color light endpoint running on the host simulation.
+ *
+ * Initializes the simulated peripherals, rgb_led and a single color light endpoint, and delivers ZCL commands the way
+ * ZBOSS does: the endpoint handler sees the command first, then the stack updates attributes and calls the device
+ * callback of the application.
+ */
+
+#ifndef LIGHT_FIXTURE_H__
+#define LIGHT_FIXTURE_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "zboss_api.h"
+#include "zigbee_color_light.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LIGHT_FIXTURE_ENDPOINT      10U
+
+/**@brief Light context of the fixture endpoint. */
+extern zb_color_light_ctx_t light_fixture_ctx;
+
+/**@brief Function for resetting the simulation and initializing the light.
+ *
+ * Modules of the application keep their state in static variables, so it can be called once per test program.
+ */
+void light_fixture_init(void);
+
+/**@brief Function for delivering a ZCL command to the endpoint.
+ *
+ * @param[in] cluster_id  Cluster of the command.
+ * @param[in] cmd_id      Command ID.
+ * @param[in] p_payload   Payload of the command.
+ * @param[in] length      Length of @p p_payload.
+ */
+void light_fixture_cmd(zb_uint16_t cluster_id, zb_uint8_t cmd_id, void const * p_payload, size_t length);
+
+/**@brief Function for sending Move to Level with On/Off, as sent by most of the controllers. */
+void light_fixture_move_to_level(zb_uint8_t level, zb_uint16_t transition_time);
+
+/**@brief Function for sending Move to Hue and Saturation. */
+void light_fixture_move_to_hue_sat(zb_uint8_t hue, zb_uint8_t saturation, zb_uint16_t transition_time);
+
+/**@brief Function for sending On or Off. */
+void light_fixture_on_off(bool on);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIGHT_FIXTURE_H__ */
+
+/**
+ * @}
+ */
@@ -0,0 +1,188 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @defgroup zigbee_examples_host_test_apa102_backend test_apa102_backend.c
+ * @{
+ * @ingroup zigbee_examples
+ *
+ * @brief Test of the APA102 LED backend: light intensity decoded from the SPI stream against the color.
+ *
+ * Intensity of a channel is its 8-bit component scaled by the 5-bit global brightness. The backend must pick the
+ * lowest global brightness at which the brightest component fits in 8 bits, and refresh the chain while the color
+ * does not change.
+ */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "nordic_common.h"
+#include "app_util.h"
+#include "drv_apa102.h"
+#include "rgb_led_backend.h"
+#include "rgb_led_gamma.h"
+#include "sim_apa102.h"
+#include "sim_clock.h"
+#include "sim_gpio.h"
+#include "sim_spim.h"
+#include "sim_test.h"
+
+#define SETTLE_NS           (10ULL * SIM_CLOCK_NS_PER_MS)
+#define KEEPALIVE_NS        (1100ULL * SIM_CLOCK_NS_PER_MS)
+#define COMPONENT_SCALE     (RGB_LED_GAMMA_OUTPUT_MAX / UINT8_MAX)
+
+static sim_apa102_decoder_t m_decoder;
+
+/**@brief Function for getting light intensity of a channel of a decoded pixel, in the scale of the gamma table. */
+static double intensity_get(uint8_t const * p_pixel, uint32_t component_no)
+{
+    uint32_t brightness = p_pixel[0] & DRV_APA102_BRIGHTNESS_MAX;
+
+    return ((double)p_pixel[component_no] * brightness * COMPONENT_SCALE) / DRV_APA102_BRIGHTNESS_MAX;
+}
+
+/**@brief Function for checking a decoded pixel against a color.
+ *
+ * @return true if every channel is within half a step of the global brightness from the gamma corrected color.
+ */
+static bool pixel_check(uint8_t const * p_pixel, uint32_t color)
+{
+    /* BGR order after the header */
+    static const uint32_t channels[3] = {RGB_LED_GAMMA_CHANNEL_BLUE, RGB_LED_GAMMA_CHANNEL_GREEN,
+                                         RGB_LED_GAMMA_CHANNEL_RED};
+    uint16_t intensity[RGB_LED_GAMMA_CHANNELS_COUNT];
+    uint32_t brightness = p_pixel[0] & DRV_APA102_BRIGHTNESS_MAX;
+    uint32_t component_max;
+    double   tolerance;
+    bool     result = ((p_pixel[0] & 0xE0U) == 0xE0U) && (brightness > 0U);
+    size_t   i;
+
+    rgb_led_gamma_rgb_get(color, intensity);
+    tolerance     = ((double)brightness * COMPONENT_SCALE) / DRV_APA102_BRIGHTNESS_MAX;
+    component_max = MAX(p_pixel[1], MAX(p_pixel[2], p_pixel[3]));
+
+    for (i = 0; i < ARRAY_SIZE(channels); i++)
+    {
+        double error = intensity_get(p_pixel, i + 1U) - intensity[channels[i]];
+
+        if (ABS(error) > tolerance)
+        {
+            result = false;
+        }
+    }
+
+    /* One step lower global brightness would not fit the brightest component */
+    if ((brightness > 1U) && (((component_max * brightness) / (brightness - 1U)) <= UINT8_MAX))
+    {
+        result = false;
+    }
+
+    if (!result)
+    {
+        printf("color %06x: pixel %02x %02x %02x %02x\n",
+               (unsigned)color, p_pixel[0], p_pixel[1], p_pixel[2], p_pixel[3]);
+    }
+
+    return result;
+}
+
+int main(void)
+{
+    static const uint32_t colors[] = {0xFFFFFF, 0xFF0000, 0x00FF00, 0x0000FF, 0x404040, 0x102030, 0x030201, 0x010101};
+    static uint32_t       frame[DRV_APA102_LED_CHAIN_PIXELS_COUNT_MAX];
+    uint32_t              frames_count;
+    size_t                i;
+    size_t                pixel_no;
+
+    sim_clock_reset();
+    sim_gpio_reset();
+    sim_spim_reset();
+    sim_apa102_decoder_init(&m_decoder, DRV_APA102_SPIM_INSTANCE_NO);
+
+    rgb_led_backend_init();
+    SIM_TEST_CHECK_EQUAL(rgb_led_backend_pixels_count_get(), DRV_APA102_LED_CHAIN_PIXELS_COUNT_MAX);
+
+    for (i = 0; i < ARRAY_SIZE(colors); i++)
+    {
+        rgb_led_backend_set_color(colors[i]);
+        sim_clock_advance(SETTLE_NS);
+
+        SIM_TEST_CHECK_EQUAL(m_decoder.pixels_count, DRV_APA102_LED_CHAIN_PIXELS_COUNT_MAX);
+        for (pixel_no = 0; pixel_no < m_decoder.pixels_count; pixel_no++)
+        {
+            if (!pixel_check(&m_decoder.frame[pixel_no * SIM_APA102_PIXEL_BYTES], colors[i]))
+            {
+                SIM_TEST_CHECK(false);
+                break;
+            }
+        }
+    }
+
+    /* Chain is refreshed while the color does not change */
+    frames_count = m_decoder.frames_count;
+    sim_clock_advance(KEEPALIVE_NS);
+    SIM_TEST_CHECK_EQUAL(m_decoder.frames_count, frames_count + 1U);
+
+    /* Pixels of a frame, the rest of the chain is black */
+    for (pixel_no = 0; pixel_no < ARRAY_SIZE(frame); pixel_no++)
+    {
+        frame[pixel_no] = colors[pixel_no % ARRAY_SIZE(colors)];
+    }
+    rgb_led_backend_set_frame(frame, ARRAY_SIZE(frame) / 2U);
+    sim_clock_advance(SETTLE_NS);
+    for (pixel_no = 0; pixel_no < m_decoder.pixels_count; pixel_no++)
+    {
+        uint32_t color = (pixel_no < (ARRAY_SIZE(frame) / 2U)) ? frame[pixel_no] : 0U;
+
+        if (!pixel_check(&m_decoder.frame[pixel_no * SIM_APA102_PIXEL_BYTES], color))
+        {
+            SIM_TEST_CHECK(false);
+            break;
+        }
+    }
+
+    SIM_TEST_CHECK_EQUAL(m_decoder.errors_count, 0U);
+
+    return sim_test_result("apa102_backend");
+}
+
+/**
+ * @}
+ */
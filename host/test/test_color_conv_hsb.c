@@ -0,0 +1,116 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @defgroup zigbee_examples_host_test_color_conv_hsb test_color_conv_hsb.c
+ * @{
+ * @ingroup zigbee_examples
+ *
+ * @brief Exhaustive test of color_conv_hsb_to_rgb against the float conversion it replaced.
+ *
+ * Every hue, saturation and brightness value is converted, every component must be within 1 LSB of the float result.
+ */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "color_conv.h"
+#include "color_conv_ref.h"
+#include "sim_test.h"
+
+#define COMPONENT_TOLERANCE     1
+
+int main(void)
+{
+    uint32_t counts[COMPONENT_TOLERANCE + 2] = {0};
+    uint32_t hue;
+    uint32_t saturation;
+    uint32_t brightness;
+
+    for (hue = 0; hue <= UINT8_MAX; hue++)
+    {
+        for (saturation = 0; saturation <= UINT8_MAX; saturation++)
+        {
+            for (brightness = 0; brightness <= UINT8_MAX; brightness++)
+            {
+                uint32_t rgb      = color_conv_hsb_to_rgb(hue, saturation, brightness);
+                uint32_t expected = color_conv_ref_hsb_to_rgb(hue, saturation, brightness);
+                int32_t  diff_max = 0;
+                uint32_t shift;
+
+                for (shift = 0; shift < 24U; shift += 8U)
+                {
+                    int32_t diff = (int32_t)((rgb >> shift) & 0xFFU) - (int32_t)((expected >> shift) & 0xFFU);
+
+                    if (diff < 0)
+                    {
+                        diff = -diff;
+                    }
+                    if (diff > diff_max)
+                    {
+                        diff_max = diff;
+                    }
+                }
+
+                if (diff_max > COMPONENT_TOLERANCE)
+                {
+                    if (counts[COMPONENT_TOLERANCE + 1] == 0U)
+                    {
+                        printf("hsb %u %u %u: %06x, expected %06x\n",
+                               (unsigned)hue, (unsigned)saturation, (unsigned)brightness,
+                               (unsigned)rgb, (unsigned)expected);
+                    }
+                    diff_max = COMPONENT_TOLERANCE + 1;
+                }
+                counts[diff_max]++;
+            }
+        }
+    }
+
+    printf("exact %u, off by 1 LSB %u, off by more %u\n",
+           (unsigned)counts[0], (unsigned)counts[1], (unsigned)counts[COMPONENT_TOLERANCE + 1]);
+    SIM_TEST_CHECK_EQUAL(counts[COMPONENT_TOLERANCE + 1], 0U);
+
+    return sim_test_result("color_conv_hsb");
+}
+
+/**
+ * @}
+ */
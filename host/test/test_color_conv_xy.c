@@ -0,0 +1,164 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @defgroup zigbee_examples_host_test_color_conv_xy test_color_conv_xy.c
+ * @{
+ * @ingroup zigbee_examples
+ *
+ * @brief Test of the fixed-point conversion of CIE xy chromaticity into RGB against a double precision reference.
+ *
+ * Chromaticity coordinates are swept over the whole xy plane, including colors outside of the gamut of the LED, for
+ * the default primaries of the light and for sRGB primaries. Every channel must be within 1 LSB of the reference.
+ */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "nordic_common.h"
+#include "app_util.h"
+#include "color_conv.h"
+#include "color_conv_ref.h"
+#include "sim_test.h"
+
+#define XY_COORD_ONE            65536U
+#define XY_STEP                 64U
+#define COMPONENT_TOLERANCE     1
+
+typedef struct
+{
+    const char    * p_name;
+    color_conv_xy_t primaries[3];
+    color_conv_xy_t white;
+} gamut_t;
+
+static const gamut_t m_gamuts[] =
+{
+    /* LIGHT_PRIMARY_* and LIGHT_WHITE_POINT_* of zigbee_color_light.c */
+    {"WS2812B", {{45220, 19661}, {11141, 47841}, {8520, 4588}}, {20493, 21561}},
+    {"sRGB",    {{41943, 21627}, {19661, 39322}, {9830, 3932}}, {20493, 21561}},
+};
+
+/**@brief Function for getting the largest difference of channels of two colors. */
+static int32_t color_diff(uint32_t rgb, uint32_t expected)
+{
+    int32_t  diff_max = 0;
+    uint32_t shift;
+
+    for (shift = 0; shift < 24U; shift += 8U)
+    {
+        int32_t diff = (int32_t)((rgb >> shift) & 0xFFU) - (int32_t)((expected >> shift) & 0xFFU);
+
+        diff_max = MAX(diff_max, ABS(diff));
+    }
+
+    return diff_max;
+}
+
+/**@brief Function for checking conversion of all chromaticity coordinates of the grid for a gamut. */
+static void gamut_check(const gamut_t * p_gamut)
+{
+    color_conv_xy_matrix_t matrix;
+    uint32_t               counts[COMPONENT_TOLERANCE + 2] = {0};
+    uint32_t               x;
+    uint32_t               y;
+    size_t                 i;
+
+    SIM_TEST_CHECK(color_conv_xy_matrix_init(&matrix, p_gamut->primaries, &p_gamut->white));
+
+    /* Anchors: white point and the primaries themselves */
+    SIM_TEST_CHECK_EQUAL(color_conv_xy_to_rgb(&matrix, &p_gamut->white), 0xFFFFFFU);
+    for (i = 0; i < ARRAY_SIZE(p_gamut->primaries); i++)
+    {
+        SIM_TEST_CHECK(color_diff(color_conv_xy_to_rgb(&matrix, &p_gamut->primaries[i]),
+                                  0xFF0000U >> (8U * i)) <= COMPONENT_TOLERANCE);
+    }
+
+    for (x = 0; x < XY_COORD_ONE; x += XY_STEP)
+    {
+        for (y = 0; (x + y) < XY_COORD_ONE; y += XY_STEP)
+        {
+            color_conv_xy_t xy       = {(uint16_t)x, (uint16_t)y};
+            uint32_t        rgb      = color_conv_xy_to_rgb(&matrix, &xy);
+            uint32_t        expected = color_conv_ref_xy_to_rgb(p_gamut->primaries, &p_gamut->white, &xy);
+            int32_t         diff     = color_diff(rgb, expected);
+
+            if (diff > COMPONENT_TOLERANCE)
+            {
+                if (counts[COMPONENT_TOLERANCE + 1] == 0U)
+                {
+                    printf("%s xy %u %u: %06x, expected %06x\n",
+                           p_gamut->p_name, (unsigned)x, (unsigned)y, (unsigned)rgb, (unsigned)expected);
+                }
+                diff = COMPONENT_TOLERANCE + 1;
+            }
+            counts[diff]++;
+        }
+    }
+
+    printf("%s: exact %u, off by 1 LSB %u, off by more %u\n", p_gamut->p_name,
+           (unsigned)counts[0], (unsigned)counts[1], (unsigned)counts[COMPONENT_TOLERANCE + 1]);
+    SIM_TEST_CHECK_EQUAL(counts[COMPONENT_TOLERANCE + 1], 0U);
+}
+
+int main(void)
+{
+    static const color_conv_xy_t collinear[3] = {{45220, 19661}, {32768, 32768}, {20316, 45875}};
+    static const color_conv_xy_t no_y[3]      = {{45220, 0}, {11141, 47841}, {8520, 4588}};
+    static const color_conv_xy_t white_out    = {60000, 5000};
+    color_conv_xy_matrix_t       matrix;
+    size_t                       i;
+
+    for (i = 0; i < ARRAY_SIZE(m_gamuts); i++)
+    {
+        gamut_check(&m_gamuts[i]);
+    }
+
+    /* Primaries not spanning a gamut, white point outside of it */
+    SIM_TEST_CHECK(!color_conv_xy_matrix_init(&matrix, collinear, &m_gamuts[0].white));
+    SIM_TEST_CHECK(!color_conv_xy_matrix_init(&matrix, no_y, &m_gamuts[0].white));
+    SIM_TEST_CHECK(!color_conv_xy_matrix_init(&matrix, m_gamuts[0].primaries, &white_out));
+
+    return sim_test_result("color_conv_xy");
+}
+
+/**
+ * @}
+ */
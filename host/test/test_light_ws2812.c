@@ -0,0 +1,211 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @defgroup zigbee_examples_host_test_light_ws2812 test_light_ws2812.c
+ * @{
+ * @ingroup zigbee_examples
+ *
+ * @brief Smoke test of the whole light: ZCL commands in, WS2812 waveform on DOUT pin out.
+ *
+ * Measures in virtual time how long it takes from a command until the first changed frame is latched by the LEDs and
+ * until the chain displays the final color. Counts wakeups of the refresh timer, which must stay stopped while the color
+ * is constant and run once per refresh period while an effect is animated.
+ */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "nordic_common.h"
+#include "nrf_gpio.h"
+#include "rgb_led.h"
+#include "rgb_led_gamma.h"
+#include "sim_clock.h"
+#include "sim_test.h"
+#include "sim_ws2812.h"
+#include "light_fixture.h"
+
+#define DOUT_PIN                NRF_GPIO_PIN_MAP(1,7)
+#define STEP_NS                 (100ULL * SIM_CLOCK_NS_PER_US)
+#define SETTLE_TIMEOUT_NS       (2000ULL * SIM_CLOCK_NS_PER_MS)
+#define PIXEL_BYTES             3U
+#define COLOR_TOLERANCE         4       /**< Rounding of integer HSB conversion and of gamma correction. */
+#define REFRESH_PERIOD_MS       40U     /**< RGB_LED_REFRESH_PERIOD_MS of rgb_led. */
+#define IDLE_NS                 (10000ULL * SIM_CLOCK_NS_PER_MS)
+#define BREATHING_NS            (2000ULL * SIM_CLOCK_NS_PER_MS)
+#define WAKEUP_TOLERANCE        2
+
+static sim_ws2812_decoder_t m_decoder;
+
+/**@brief Function for checking if every pixel of the last frame is close to given color, after gamma correction. */
+static bool frame_is(uint32_t color)
+{
+    uint16_t intensity[RGB_LED_GAMMA_CHANNELS_COUNT];
+    size_t   i;
+
+    if ((m_decoder.frame_len == 0U) || ((m_decoder.frame_len % PIXEL_BYTES) != 0U))
+    {
+        return false;
+    }
+
+    rgb_led_gamma_rgb_get(color, intensity);
+
+    /* GRB order of WS2812 */
+    for (i = 0; i < m_decoder.frame_len; i += PIXEL_BYTES)
+    {
+        if ((ABS((int)m_decoder.frame[i]     - (intensity[RGB_LED_GAMMA_CHANNEL_GREEN] >> 8)) > COLOR_TOLERANCE) ||
+            (ABS((int)m_decoder.frame[i + 1] - (intensity[RGB_LED_GAMMA_CHANNEL_RED] >> 8))   > COLOR_TOLERANCE) ||
+            (ABS((int)m_decoder.frame[i + 2] - (intensity[RGB_LED_GAMMA_CHANNEL_BLUE] >> 8))  > COLOR_TOLERANCE))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**@brief Function for running the clock until the chain displays given color, in the format of rgb_led_backend.
+ *
+ * @param[out] p_first_ns   Time from now to the end of the first frame different from the current one.
+ * @param[out] p_settle_ns  Time from now to the end of the first frame of given color.
+ *
+ * @return true if the color has been displayed before the timeout.
+ */
+static bool run_until_frame(uint32_t color, uint64_t * p_first_ns, uint64_t * p_settle_ns)
+{
+    uint64_t start_ns     = sim_clock_now();
+    uint32_t frames_count = m_decoder.frames_count;
+    uint8_t  first[PIXEL_BYTES];
+    bool     changed      = false;
+
+    memcpy(first, m_decoder.frame, sizeof(first));
+
+    while ((sim_clock_now() - start_ns) < SETTLE_TIMEOUT_NS)
+    {
+        sim_clock_advance(STEP_NS);
+        sim_ws2812_decoder_poll(&m_decoder, sim_clock_now() * 1000ULL);
+
+        if (m_decoder.frames_count == frames_count)
+        {
+            continue;
+        }
+        frames_count = m_decoder.frames_count;
+
+        if (!changed && (memcmp(first, m_decoder.frame, sizeof(first)) != 0))
+        {
+            changed     = true;
+            *p_first_ns = (m_decoder.frame_end_ps / 1000ULL) - start_ns;
+        }
+        if (frame_is(color))
+        {
+            *p_settle_ns = (m_decoder.frame_end_ps / 1000ULL) - start_ns;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+int main(void)
+{
+    uint64_t     first_ns  = 0U;
+    uint64_t     settle_ns = 0U;
+    led_params_t led_params;
+    uint32_t     wakeup_count;
+    int          wakeups;
+
+    light_fixture_init();
+    sim_ws2812_decoder_init(&m_decoder, DOUT_PIN);
+
+    /* Initial red at full level */
+    SIM_TEST_CHECK(run_until_frame(0xFF0000, &first_ns, &settle_ns));
+    SIM_TEST_CHECK_EQUAL(m_decoder.frame_len, rgb_led_pixels_count_get() * PIXEL_BYTES);
+
+    light_fixture_move_to_hue_sat(85, 254, 0);
+    SIM_TEST_CHECK(run_until_frame(0x00FF00, &first_ns, &settle_ns));
+    printf("green: first frame %6llu us, settled %6llu us\n",
+           (unsigned long long)(first_ns / SIM_CLOCK_NS_PER_US),
+           (unsigned long long)(settle_ns / SIM_CLOCK_NS_PER_US));
+
+    light_fixture_move_to_level(0, 5);
+    SIM_TEST_CHECK(run_until_frame(0x000000, &first_ns, &settle_ns));
+    printf("off:   first frame %6llu us, settled %6llu us\n",
+           (unsigned long long)(first_ns / SIM_CLOCK_NS_PER_US),
+           (unsigned long long)(settle_ns / SIM_CLOCK_NS_PER_US));
+    /* Transition of 0.5 s is rendered, not jumped over */
+    SIM_TEST_CHECK(settle_ns >= (400ULL * SIM_CLOCK_NS_PER_MS));
+
+    light_fixture_on_off(true);
+    light_fixture_move_to_level(254, 0);
+    SIM_TEST_CHECK(run_until_frame(0x00FE00, &first_ns, &settle_ns));
+
+    /* Constant color is applied by a single wakeup, then the refresh timer stays stopped */
+    memset(&led_params, 0, sizeof(led_params));
+    led_params.mode = LED_MODE_CONSTANT;
+    led_params.r    = 0x20;
+    led_params.g    = 0x40;
+    led_params.b    = 0x60;
+    wakeup_count    = rgb_led_wakeup_count_get();
+    rgb_led_update(&led_params);
+    sim_clock_advance(IDLE_NS);
+    SIM_TEST_CHECK_EQUAL(rgb_led_wakeup_count_get(), wakeup_count + 1U);
+
+    /* Breathing is refreshed once per period */
+    memset(&led_params, 0, sizeof(led_params));
+    led_params.mode      = LED_MODE_BREATHING;
+    led_params.color     = LED_PARAMS_COLOR_MASK_RED | LED_PARAMS_COLOR_MASK_GREEN | LED_PARAMS_COLOR_MASK_BLUE;
+    led_params.intensity = 100;
+    led_params.delay     = 1000;
+    wakeup_count         = rgb_led_wakeup_count_get();
+    rgb_led_update(&led_params);
+    sim_clock_advance(BREATHING_NS);
+    wakeups = (int)(rgb_led_wakeup_count_get() - wakeup_count);
+    printf("breathing: %d wakeups in %llu ms\n", wakeups, (unsigned long long)(BREATHING_NS / SIM_CLOCK_NS_PER_MS));
+    SIM_TEST_CHECK(ABS(wakeups - (int)(BREATHING_NS / (REFRESH_PERIOD_MS * SIM_CLOCK_NS_PER_MS))) <= WAKEUP_TOLERANCE);
+
+    SIM_TEST_CHECK_EQUAL(m_decoder.errors_count, 0U);
+
+    return sim_test_result("light_ws2812");
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,190 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @defgroup zigbee_examples_host_test_pwm_backend test_pwm_backend.c
+ * @{
+ * @ingroup zigbee_examples
+ *
+ * @brief Test of the PWM LED backend: duty cycle measured on the pins against the intensity of the color.
+ *
+ * Built with RGB_LED_BACKEND_PWM_HIGH_RESOLUTION_ENABLED set to 0 and 1.
+ */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "nordic_common.h"
+#include "app_util.h"
+#include "nrf_gpio.h"
+#include "rgb_led_backend.h"
+#include "rgb_led_gamma.h"
+#include "sim_clock.h"
+#include "sim_gpio.h"
+#include "sim_pwm.h"
+#include "sim_test.h"
+
+#define R_PIN               NRF_GPIO_PIN_MAP(1,12)
+#define G_PIN               NRF_GPIO_PIN_MAP(1,13)
+#define B_PIN               NRF_GPIO_PIN_MAP(1,11)
+
+#if RGB_LED_BACKEND_PWM_HIGH_RESOLUTION_ENABLED
+#define PWM_TOTAL_MAX       (2048U * 32U)   /**< Counts of full intensity, per sequence of dithered periods. */
+#else
+#define PWM_TOTAL_MAX       16384U          /**< Counts of full intensity, per period. */
+#endif
+#define PWM_VALUE_MIN       560U
+
+#define SETTLE_NS           (20ULL * SIM_CLOCK_NS_PER_MS)
+#define WINDOW_NS           (65536ULL * SIM_CLOCK_NS_PER_US)  /**< Multiple of both periods and of the sequence. */
+#define DUTY_TOLERANCE      0.002
+
+typedef struct
+{
+    uint64_t rise_ps;
+    uint64_t high_ps;
+} duty_meter_t;
+
+static duty_meter_t m_meters[3];
+
+static void pin_listener(uint32_t pin, bool level, uint64_t time_ps, void * p_context)
+{
+    duty_meter_t * p_meter = (duty_meter_t *)p_context;
+
+    UNUSED_PARAMETER(pin);
+
+    if (level)
+    {
+        p_meter->rise_ps = time_ps;
+    }
+    else
+    {
+        p_meter->high_ps += time_ps - p_meter->rise_ps;
+    }
+}
+
+/**@brief Function for measuring duty cycle of the pins over a window. */
+static void duty_measure(double * p_duty)
+{
+    static const uint32_t pins[3] = {R_PIN, G_PIN, B_PIN};
+    uint64_t              start_ps;
+    uint64_t              end_ps;
+    size_t                i;
+
+    start_ps = sim_clock_now() * 1000ULL;
+    for (i = 0; i < ARRAY_SIZE(pins); i++)
+    {
+        m_meters[i].rise_ps = start_ps;
+        m_meters[i].high_ps = 0U;
+    }
+
+    sim_clock_advance(WINDOW_NS);
+
+    end_ps = sim_clock_now() * 1000ULL;
+    for (i = 0; i < ARRAY_SIZE(pins); i++)
+    {
+        if (sim_gpio_read(pins[i]))
+        {
+            m_meters[i].high_ps += end_ps - m_meters[i].rise_ps;
+        }
+        p_duty[i] = (double)m_meters[i].high_ps / (double)(end_ps - start_ps);
+    }
+}
+
+/**@brief Function for getting expected duty cycle of a channel, as documented by the backend. */
+static double duty_expected(uint16_t intensity)
+{
+    if (intensity == 0U)
+    {
+        return 0.0;
+    }
+
+    return (PWM_VALUE_MIN + ((uint32_t)intensity * (PWM_TOTAL_MAX - PWM_VALUE_MIN)) / RGB_LED_GAMMA_OUTPUT_MAX) /
+           (double)PWM_TOTAL_MAX;
+}
+
+int main(void)
+{
+    static const uint32_t colors[] = {0xFF0000, 0x00FF00, 0x0000FF, 0x404040, 0x102030, 0x010101, 0x000000, 0xFFFFFF};
+    size_t                i;
+    size_t                ch;
+
+    sim_clock_reset();
+    sim_gpio_reset();
+    sim_pwm_reset();
+
+    sim_gpio_listen(R_PIN, pin_listener, &m_meters[0]);
+    sim_gpio_listen(G_PIN, pin_listener, &m_meters[1]);
+    sim_gpio_listen(B_PIN, pin_listener, &m_meters[2]);
+
+    rgb_led_backend_init();
+    SIM_TEST_CHECK_EQUAL(rgb_led_backend_pixels_count_get(), 1U);
+
+    for (i = 0; i < ARRAY_SIZE(colors); i++)
+    {
+        uint16_t intensity[RGB_LED_GAMMA_CHANNELS_COUNT];
+        double   duty[3];
+
+        rgb_led_backend_set_color(colors[i]);
+        sim_clock_advance(SETTLE_NS);
+        duty_measure(duty);
+
+        rgb_led_gamma_rgb_get(colors[i], intensity);
+        for (ch = 0; ch < 3; ch++)
+        {
+            double expected = duty_expected(intensity[RGB_LED_GAMMA_CHANNEL_RED + ch]);
+
+            if (ABS(duty[ch] - expected) > DUTY_TOLERANCE)
+            {
+                printf("color %06x channel %u: duty %.5f, expected %.5f\n",
+                       (unsigned)colors[i], (unsigned)ch, duty[ch], expected);
+                SIM_TEST_CHECK(false);
+            }
+        }
+    }
+
+    SIM_TEST_CHECK(sim_pwm_is_playing(0));
+
+    return sim_test_result(RGB_LED_BACKEND_PWM_HIGH_RESOLUTION_ENABLED ? "pwm_backend_hires" : "pwm_backend");
+}
+
+/**
+ * @}
+ */
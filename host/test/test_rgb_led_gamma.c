@@ -0,0 +1,112 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @defgroup zigbee_examples_host_test_rgb_led_gamma test_rgb_led_gamma.c
+ * @{
+ * @ingroup zigbee_examples
+ *
+ * @brief Test of the brightness curve tables of rgb_led_gamma.
+ *
+ * Every channel table must not decrease, must be 0 only for brightness 0 and must reach the channel correction at
+ * brightness 255. The tables must be evaluated by the compiler: they are const objects, placed by the linker in
+ * read-only data between the end of the code and the start of writable data, so no code computes them at run time.
+ */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "nordic_common.h"
+#include "app_util.h"
+#include "rgb_led_gamma.h"
+#include "sim_test.h"
+
+/* Table entries are read-only */
+STATIC_ASSERT(__builtin_types_compatible_p(__typeof__(c_rgb_led_gamma[0][0]), const uint16_t));
+
+/* Defined by the GNU linker: end of the code, followed by read-only data, and start of writable data */
+extern const char etext[];
+extern char       __data_start[];
+
+int main(void)
+{
+    static const uint32_t cal[RGB_LED_GAMMA_CHANNELS_COUNT] =
+    {
+        [RGB_LED_GAMMA_CHANNEL_RED]   = RGB_LED_GAMMA_CAL_RED,
+        [RGB_LED_GAMMA_CHANNEL_GREEN] = RGB_LED_GAMMA_CAL_GREEN,
+        [RGB_LED_GAMMA_CHANNEL_BLUE]  = RGB_LED_GAMMA_CAL_BLUE,
+        [RGB_LED_GAMMA_CHANNEL_WHITE] = RGB_LED_GAMMA_CAL_WHITE,
+    };
+    uintptr_t table_start = (uintptr_t)c_rgb_led_gamma;
+    uintptr_t table_end   = table_start + sizeof(c_rgb_led_gamma);
+    uint8_t   channel;
+    uint32_t  i;
+
+    for (channel = 0U; channel < RGB_LED_GAMMA_CHANNELS_COUNT; channel++)
+    {
+        uint16_t full_scale = (uint16_t)((cal[channel] * RGB_LED_GAMMA_OUTPUT_MAX) / 100.0 + 0.5);
+
+        SIM_TEST_CHECK_EQUAL(rgb_led_gamma_get(channel, 0U), 0U);
+        SIM_TEST_CHECK_EQUAL(rgb_led_gamma_get(channel, 255U), full_scale);
+
+        for (i = 1U; i < 256U; i++)
+        {
+            if ((rgb_led_gamma_get(channel, (uint8_t)i) == 0U) ||
+                (rgb_led_gamma_get(channel, (uint8_t)i) < rgb_led_gamma_get(channel, (uint8_t)(i - 1U))))
+            {
+                printf("channel %u: entry %u is %u after %u\n", (unsigned)channel, (unsigned)i,
+                       (unsigned)rgb_led_gamma_get(channel, (uint8_t)i),
+                       (unsigned)rgb_led_gamma_get(channel, (uint8_t)(i - 1U)));
+                SIM_TEST_CHECK(false);
+                break;
+            }
+        }
+    }
+
+    /* Tables are in read-only data, not initialized at run time */
+    SIM_TEST_CHECK(table_start >= (uintptr_t)etext);
+    SIM_TEST_CHECK(table_end <= (uintptr_t)__data_start);
+
+    return sim_test_result("rgb_led_gamma");
+}
+
+/**
+ * @}
+ */
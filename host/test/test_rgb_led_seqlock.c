@@ -0,0 +1,236 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @defgroup zigbee_examples_host_test_rgb_led_seqlock test_rgb_led_seqlock.c
+ * @{
+ * @ingroup zigbee_examples
+ *
+ * @brief Stress test of the sequence lock passing parameters from rgb_led_segment_update to the refresh timer.
+ *
+ * A writer thread updates the parameters in a loop, alternating between a hue and a color temperature, which lie in
+ * the first and the last bytes of led_params_t. The refresh timer interrupt is modelled by a signal delivered to
+ * the writer thread every few microseconds, so the refresh preempts the writer at arbitrary instructions, as the
+ * RTC interrupt preempts the main loop of the device. A refresh which loaded a torn copy of the parameters would
+ * display a color of neither update.
+ *
+ * The test links its own app_timer, which runs the refresh from the signal, and its own backend, which checks every
+ * displayed color.
+ */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include <signal.h>
+#include <sys/time.h>
+
+#include "nordic_common.h"
+#include "nrf_error.h"
+#include "app_timer.h"
+#include "rgb_led.h"
+#include "rgb_led_backend.h"
+#include "sim_test.h"
+
+#define FRAMES_COUNT            100000U
+#define SIGNAL_PERIOD_US        20
+#define UPDATES_COUNT_MAX       2000000000U
+
+static led_params_t                  m_updates[2];
+static uint32_t                      m_colors[2];
+static app_timer_timeout_handler_t   m_timer_handler;
+static volatile bool                 m_timer_pending;
+static volatile uint32_t             m_frames_count;
+static volatile uint32_t             m_torn_count;
+static volatile uint32_t             m_torn_color;
+static volatile uint32_t             m_last_color;
+static uint32_t                      m_updates_count;
+
+ret_code_t app_timer_create(app_timer_id_t const *      p_timer_id,
+                            app_timer_mode_t            mode,
+                            app_timer_timeout_handler_t timeout_handler)
+{
+    UNUSED_PARAMETER(p_timer_id);
+    UNUSED_PARAMETER(mode);
+
+    m_timer_handler = timeout_handler;
+
+    return NRF_SUCCESS;
+}
+
+ret_code_t app_timer_start(app_timer_id_t timer_id, uint32_t timeout_ticks, void * p_context)
+{
+    UNUSED_PARAMETER(timer_id);
+    UNUSED_PARAMETER(timeout_ticks);
+    UNUSED_PARAMETER(p_context);
+
+    __atomic_store_n(&m_timer_pending, true, __ATOMIC_SEQ_CST);
+
+    return NRF_SUCCESS;
+}
+
+void rgb_led_backend_init(void)
+{
+}
+
+size_t rgb_led_backend_pixels_count_get(void)
+{
+    return 1U;
+}
+
+void rgb_led_backend_set_color(uint32_t color)
+{
+    if ((color != m_colors[0]) && (color != m_colors[1]) && (m_colors[1] != 0U))
+    {
+        m_torn_color = color;
+        m_torn_count++;
+    }
+    m_last_color = color;
+    m_frames_count++;
+}
+
+void rgb_led_backend_set_frame(const uint32_t * p_frame, size_t pixels_count)
+{
+    /* Parameters of this test never select a per-pixel mode */
+    m_torn_count++;
+}
+
+/**@brief Function for refreshing the led chain, if refresh has been requested. Models the RTC interrupt. */
+static void refresh_run(void)
+{
+    if (__atomic_exchange_n(&m_timer_pending, false, __ATOMIC_SEQ_CST))
+    {
+        m_timer_handler(NULL);
+    }
+}
+
+static void refresh_signal_handler(int signal_no)
+{
+    UNUSED_PARAMETER(signal_no);
+
+    refresh_run();
+}
+
+static void * writer_thread(void * p_arg)
+{
+    struct sigaction  action;
+    struct itimerval  timer;
+    uint32_t          update_no = 0U;
+
+    UNUSED_PARAMETER(p_arg);
+
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = refresh_signal_handler;
+    SIM_TEST_CHECK_EQUAL(sigaction(SIGALRM, &action, NULL), 0);
+
+    memset(&timer, 0, sizeof(timer));
+    timer.it_interval.tv_usec = SIGNAL_PERIOD_US;
+    timer.it_value.tv_usec    = SIGNAL_PERIOD_US;
+    SIM_TEST_CHECK_EQUAL(setitimer(ITIMER_REAL, &timer, NULL), 0);
+
+    while ((m_frames_count < FRAMES_COUNT) && (update_no < UPDATES_COUNT_MAX))
+    {
+        rgb_led_segment_update(0U, &m_updates[update_no & 1U]);
+        update_no++;
+    }
+
+    memset(&timer, 0, sizeof(timer));
+    SIM_TEST_CHECK_EQUAL(setitimer(ITIMER_REAL, &timer, NULL), 0);
+    m_updates_count = update_no;
+
+    return NULL;
+}
+
+int main(void)
+{
+    pthread_t writer;
+    sigset_t  signals;
+    size_t    i;
+
+    rgb_led_init();
+
+    /* Hue with saturation, then white of a color temperature, updated instantly */
+    for (i = 0; i < ARRAY_SIZE(m_updates); i++)
+    {
+        memset(&m_updates[i], 0, sizeof(m_updates[i]));
+        m_updates[i].mode       = LED_MODE_HSB;
+        m_updates[i].saturation = 254U;
+        m_updates[i].level      = 255U;
+    }
+    m_updates[0].hue               = 85U;
+    m_updates[1].hue               = 170U;
+    m_updates[1].color_temperature = 250U;
+
+    /* Colors of consistent updates, applied with no writer running */
+    for (i = 0; i < ARRAY_SIZE(m_updates); i++)
+    {
+        rgb_led_segment_update(0U, &m_updates[i]);
+        refresh_run();
+        m_colors[i] = m_last_color;
+    }
+    SIM_TEST_CHECK(m_colors[0] != m_colors[1]);
+    printf("colors %06x %06x\n", (unsigned)m_colors[0], (unsigned)m_colors[1]);
+
+    /* Only the writer thread is interrupted by the refresh */
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGALRM);
+    SIM_TEST_CHECK_EQUAL(pthread_create(&writer, NULL, writer_thread, NULL), 0);
+    SIM_TEST_CHECK_EQUAL(pthread_sigmask(SIG_BLOCK, &signals, NULL), 0);
+    SIM_TEST_CHECK_EQUAL(pthread_join(writer, NULL), 0);
+
+    /* The last update is applied on the refresh it has requested */
+    refresh_run();
+
+    printf("%u updates, %u frames, %u torn\n",
+           (unsigned)m_updates_count, (unsigned)m_frames_count, (unsigned)m_torn_count);
+    if (m_torn_count != 0U)
+    {
+        printf("torn color %06x\n", (unsigned)m_torn_color);
+    }
+    SIM_TEST_CHECK_EQUAL(m_torn_count, 0U);
+    SIM_TEST_CHECK(m_frames_count >= FRAMES_COUNT);
+    SIM_TEST_CHECK_EQUAL(m_last_color, m_colors[(m_updates_count - 1U) & 1U]);
+
+    return sim_test_result("rgb_led_seqlock");
+}
+
+/**
+ * @}
+ */
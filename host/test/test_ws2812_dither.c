@@ -0,0 +1,207 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @defgroup zigbee_examples_host_test_ws2812_dither test_ws2812_dither.c
+ * @{
+ * @ingroup zigbee_examples
+ *
+ * @brief Test of the temporal dithering of the WS2812 LED backend, against frames decoded from the DOUT pin.
+ *
+ * The quantization error carried between frames is below one 8-bit step, so over 256 frames the sum of the 8-bit
+ * outputs of a channel must equal its 16-bit light intensity, that is the mean output times 256 is the intensity.
+ * Intensities above 0xFF00 cannot be reached with 8 bits and are capped there. Keepalive refresh is disabled, so
+ * every frame comes from a dithering tick.
+ */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "nordic_common.h"
+#include "app_util.h"
+#include "nrf_error.h"
+#include "app_timer.h"
+#include "nrf_gpio.h"
+#include "rgb_led_backend.h"
+#include "rgb_led_gamma.h"
+#include "sim_clock.h"
+#include "sim_gpio.h"
+#include "sim_pwm.h"
+#include "sim_test.h"
+#include "sim_ws2812.h"
+
+#define DOUT_PIN                NRF_GPIO_PIN_MAP(1,7)
+#define STEP_NS                 (1ULL * SIM_CLOCK_NS_PER_MS)
+#define DITHERING_PERIOD_MS     10U         /**< RGB_LED_BACKEND_WS2812_DITHERING_PERIOD_MS of the backend. */
+#define TICK_TIMEOUT_NS         (2ULL * DITHERING_PERIOD_MS * SIM_CLOCK_NS_PER_MS)
+#define TICKS_COUNT             256U
+#define PIXEL_BYTES             3U
+#define DITHER_OUTPUT_MAX       0xFF00U     /**< Highest mean intensity of 8-bit outputs, times 256. */
+
+/* Channels in GRB order of WS2812 */
+static const uint32_t m_channels[PIXEL_BYTES] = {RGB_LED_GAMMA_CHANNEL_GREEN, RGB_LED_GAMMA_CHANNEL_RED,
+                                                 RGB_LED_GAMMA_CHANNEL_BLUE};
+
+static sim_ws2812_decoder_t m_decoder;
+
+/**@brief Function for running the clock until the next frame is latched.
+ *
+ * @return false if no frame has been latched for two dithering periods, so the chain keeps displaying the last one.
+ */
+static bool frame_wait(void)
+{
+    uint64_t start_ns     = sim_clock_now();
+    uint32_t frames_count = m_decoder.frames_count;
+
+    while ((sim_clock_now() - start_ns) < TICK_TIMEOUT_NS)
+    {
+        sim_clock_advance(STEP_NS);
+        sim_ws2812_decoder_poll(&m_decoder, sim_clock_now() * 1000ULL);
+
+        if (m_decoder.frames_count != frames_count)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**@brief Function for summing the outputs of the first pixel over @ref TICKS_COUNT dithering periods.
+ *
+ * @param[out] p_sum        Sum for each byte of the pixel, in GRB order.
+ * @param[out] p_frames     Number of frames latched.
+ */
+static void outputs_sum(uint32_t * p_sum, uint32_t * p_frames)
+{
+    uint32_t tick;
+    size_t   i;
+
+    memset(p_sum, 0, PIXEL_BYTES * sizeof(p_sum[0]));
+    *p_frames = 0U;
+
+    for (tick = 0U; tick < TICKS_COUNT; tick++)
+    {
+        if (frame_wait())
+        {
+            (*p_frames)++;
+        }
+        SIM_TEST_CHECK_EQUAL(m_decoder.frame_len, rgb_led_backend_pixels_count_get() * PIXEL_BYTES);
+
+        /* Without a new frame the chain displays the last one */
+        for (i = 0; i < PIXEL_BYTES; i++)
+        {
+            p_sum[i] += m_decoder.frame[i];
+        }
+    }
+}
+
+/**@brief Function for checking the mean outputs against the light intensities of a color.
+ *
+ * @return true if the sum of outputs of each channel equals its intensity, capped at @ref DITHER_OUTPUT_MAX.
+ */
+static bool color_check(uint32_t color)
+{
+    uint16_t intensity[RGB_LED_GAMMA_CHANNELS_COUNT];
+    uint32_t sum[PIXEL_BYTES];
+    uint32_t frames;
+    bool     result = true;
+    size_t   i;
+
+    rgb_led_gamma_rgb_get(color, intensity);
+    rgb_led_backend_set_color(color);
+    outputs_sum(sum, &frames);
+
+    for (i = 0; i < PIXEL_BYTES; i++)
+    {
+        if (sum[i] != MIN(intensity[m_channels[i]], DITHER_OUTPUT_MAX))
+        {
+            printf("color %06x: channel %u intensity %u, mean output * 256 is %u\n", (unsigned)color,
+                   (unsigned)m_channels[i], (unsigned)intensity[m_channels[i]], (unsigned)sum[i]);
+            result = false;
+        }
+    }
+
+    return result;
+}
+
+int main(void)
+{
+    uint32_t sum[PIXEL_BYTES];
+    uint32_t frames;
+    uint32_t level;
+
+    sim_clock_reset();
+    sim_gpio_reset();
+    sim_pwm_reset();
+    sim_ws2812_decoder_init(&m_decoder, DOUT_PIN);
+    SIM_TEST_CHECK_EQUAL(app_timer_init(), NRF_SUCCESS);
+
+    rgb_led_backend_init();
+    SIM_TEST_CHECK(frame_wait());
+
+    /* Every gray level, the error left by the previous level is carried over */
+    for (level = 0U; level <= UINT8_MAX; level++)
+    {
+        SIM_TEST_CHECK(color_check(level * 0x010101U));
+    }
+
+    /* Red above the cap is displayed at full 8-bit intensity. Nothing changes, so dithering stops after a frame */
+    rgb_led_backend_set_color(0xFF0000U);
+    outputs_sum(sum, &frames);
+    SIM_TEST_CHECK_EQUAL(rgb_led_gamma_get(RGB_LED_GAMMA_CHANNEL_RED, UINT8_MAX) > DITHER_OUTPUT_MAX, true);
+    SIM_TEST_CHECK_EQUAL(sum[1], DITHER_OUTPUT_MAX);
+    SIM_TEST_CHECK_EQUAL(sum[0], 0U);
+    SIM_TEST_CHECK_EQUAL(sum[2], 0U);
+    SIM_TEST_CHECK_EQUAL(frames, 1U);
+
+    /* Capped channel, while the others are dithered. Error of the capped channel does not grow */
+    SIM_TEST_CHECK(color_check(0xFF0101U));
+    SIM_TEST_CHECK(color_check(0x010101U));
+
+    SIM_TEST_CHECK_EQUAL(m_decoder.errors_count, 0U);
+
+    return sim_test_result("ws2812_dither");
+}
+
+/**
+ * @}
+ */
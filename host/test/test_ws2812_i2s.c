@@ -0,0 +1,234 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @defgroup zigbee_examples_host_test_ws2812_i2s test_ws2812_i2s.c
+ * @{
+ * @ingroup zigbee_examples
+ *
+ * @brief Test of the I2S backend of the WS2812 driver: the SDOUT bitstream decoded back to pixels.
+ *
+ * Every WS2812 bit is sent as a 4-bit pattern, so a byte takes one I2S word of 10 us. The test checks the decoded
+ * frames, their duration, encoding of changed pixels only, frames committed while the chain is busy, and the
+ * interrupt latency which the RET code leading the buffer allows before the frame is sent again.
+ */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "nrf_error.h"
+#include "nrf_gpio.h"
+#include "drv_ws2812.h"
+#include "sim_clock.h"
+#include "sim_gpio.h"
+#include "sim_i2s.h"
+#include "sim_test.h"
+#include "sim_ws2812.h"
+
+#define DOUT_PIN                NRF_GPIO_PIN_MAP(1,7)
+#define PIXELS_COUNT            DRV_WS2812_LED_CHAIN_PIXELS_COUNT_MAX
+#define PIXEL_BYTES             3U
+#define BYTE_PS                 10000000ULL     /**< One I2S word of 16-bit stereo samples at LRCK of 100 kHz. */
+#define RET_CODE_NS             (130ULL * SIM_CLOCK_NS_PER_US)
+#define FRAME_TIMEOUT_NS        (100ULL * SIM_CLOCK_NS_PER_MS)
+
+static sim_ws2812_decoder_t m_decoder;
+static uint32_t             m_callbacks_count;
+
+/**@brief Function for getting color of a pixel of given frame, different for every pixel and frame. */
+static uint32_t pixel_color(uint32_t frame_no, uint32_t pixel_no)
+{
+    return ((pixel_no + 1U) * 2654435761U + (frame_no * 40503U)) & 0x00FFFFFFU;
+}
+
+static void refresh_callback(void * p_param)
+{
+    (*(uint32_t *)p_param)++;
+}
+
+/**@brief Function for running the clock until the LED chain is idle and the last frame is latched. */
+static void refresh_wait(void)
+{
+    uint64_t start_ns = sim_clock_now();
+
+    while (drv_ws2812_is_refreshing() && ((sim_clock_now() - start_ns) < FRAME_TIMEOUT_NS))
+    {
+        sim_clock_advance(10ULL * SIM_CLOCK_NS_PER_US);
+    }
+    SIM_TEST_CHECK(!drv_ws2812_is_refreshing());
+
+    sim_clock_advance(RET_CODE_NS);
+    sim_ws2812_decoder_poll(&m_decoder, sim_clock_now() * 1000ULL);
+}
+
+/**@brief Function for checking whether the last latched frame carries pixels of given frame, in GRB order. */
+static bool frame_is(uint32_t const * p_frame_nos)
+{
+    uint32_t pixel_no;
+
+    if (m_decoder.frame_len != (PIXELS_COUNT * PIXEL_BYTES))
+    {
+        return false;
+    }
+
+    for (pixel_no = 0; pixel_no < PIXELS_COUNT; pixel_no++)
+    {
+        uint32_t        color = pixel_color(p_frame_nos[pixel_no], pixel_no);
+        uint8_t const * p_grb = &m_decoder.frame[pixel_no * PIXEL_BYTES];
+
+        if ((p_grb[0] != (uint8_t)(color >> 8)) || (p_grb[1] != (uint8_t)(color >> 16)) || (p_grb[2] != (uint8_t)color))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**@brief Function for writing pixels of given frame to the back buffer. */
+static void frame_set(uint32_t * p_frame_nos, uint32_t frame_no)
+{
+    uint32_t pixel_no;
+
+    for (pixel_no = 0; pixel_no < PIXELS_COUNT; pixel_no++)
+    {
+        drv_ws2812_set_pixel(pixel_no, pixel_color(frame_no, pixel_no));
+        p_frame_nos[pixel_no] = frame_no;
+    }
+}
+
+int main(void)
+{
+    static uint32_t    frame_nos[PIXELS_COUNT];
+    drv_ws2812_stats_t stats;
+    uint32_t           frames_count;
+    uint32_t           frame_no;
+    uint64_t           duration_ps;
+
+    sim_clock_reset();
+    sim_gpio_reset();
+    sim_i2s_reset();
+    sim_ws2812_decoder_init(&m_decoder, DOUT_PIN);
+
+    SIM_TEST_CHECK_EQUAL(drv_ws2812_init(DOUT_PIN), NRF_SUCCESS);
+
+    /* Whole frames */
+    for (frame_no = 0; frame_no < 4U; frame_no++)
+    {
+        frames_count = m_decoder.frames_count;
+        frame_set(frame_nos, frame_no);
+        SIM_TEST_CHECK_EQUAL(drv_ws2812_display(refresh_callback, &m_callbacks_count), NRF_SUCCESS);
+        refresh_wait();
+
+        SIM_TEST_CHECK_EQUAL(m_decoder.frames_count, frames_count + 1U);
+        SIM_TEST_CHECK(frame_is(frame_nos));
+    }
+    SIM_TEST_CHECK_EQUAL(m_callbacks_count, frame_no);
+    SIM_TEST_CHECK(!sim_i2s_is_running());
+
+    /* Every byte is one word */
+    duration_ps = m_decoder.frame_end_ps - m_decoder.frame_start_ps;
+    printf("%u pixels, frame of %llu us\n", (unsigned)PIXELS_COUNT, (unsigned long long)(duration_ps / 1000000ULL));
+    SIM_TEST_CHECK(duration_ps <= (PIXELS_COUNT * PIXEL_BYTES * BYTE_PS));
+    SIM_TEST_CHECK(duration_ps >  ((PIXELS_COUNT * PIXEL_BYTES) - 1U) * BYTE_PS);
+
+    /* Only the changed pixel is encoded, the rest of the buffer is sent as before */
+    drv_ws2812_set_pixel(PIXELS_COUNT / 2U, pixel_color(frame_no, PIXELS_COUNT / 2U));
+    frame_nos[PIXELS_COUNT / 2U] = frame_no++;
+    SIM_TEST_CHECK_EQUAL(drv_ws2812_display(NULL, NULL), NRF_SUCCESS);
+    refresh_wait();
+    drv_ws2812_stats_get(&stats);
+    SIM_TEST_CHECK_EQUAL(stats.last_frame_encoded_pixels, 1U);
+    SIM_TEST_CHECK(frame_is(frame_nos));
+
+    /* Refresh sends the same frame again */
+    frames_count = m_decoder.frames_count;
+    SIM_TEST_CHECK_EQUAL(drv_ws2812_refresh(NULL, NULL), NRF_SUCCESS);
+    SIM_TEST_CHECK_EQUAL(drv_ws2812_refresh(NULL, NULL), NRF_ERROR_BUSY);
+    refresh_wait();
+    SIM_TEST_CHECK_EQUAL(m_decoder.frames_count, frames_count + 1U);
+    SIM_TEST_CHECK(frame_is(frame_nos));
+
+    /* Frames committed while the chain is busy: the latest one is sent when the refresh finishes */
+    frames_count = m_decoder.frames_count;
+    drv_ws2812_stats_get(&stats);
+    frame_set(frame_nos, frame_no++);
+    SIM_TEST_CHECK_EQUAL(drv_ws2812_display(NULL, NULL), NRF_SUCCESS);
+    frame_set(frame_nos, frame_no++);
+    SIM_TEST_CHECK_EQUAL(drv_ws2812_display(NULL, NULL), NRF_SUCCESS);
+    frame_set(frame_nos, frame_no++);
+    SIM_TEST_CHECK_EQUAL(drv_ws2812_display(NULL, NULL), NRF_SUCCESS);
+    {
+        drv_ws2812_stats_t stats_after;
+
+        refresh_wait();
+        drv_ws2812_stats_get(&stats_after);
+        SIM_TEST_CHECK_EQUAL(stats_after.dropped_frames - stats.dropped_frames, 1U);
+    }
+    SIM_TEST_CHECK_EQUAL(m_decoder.frames_count, frames_count + 2U);
+    SIM_TEST_CHECK_EQUAL(m_decoder.errors_count, 0U);
+    SIM_TEST_CHECK(frame_is(frame_nos));
+
+    /* Interrupt handled within the RET code stops I2S before the frame is sent again */
+    sim_irq_latency_ns = 100ULL * SIM_CLOCK_NS_PER_US;
+    frames_count       = m_decoder.frames_count;
+    frame_set(frame_nos, frame_no++);
+    SIM_TEST_CHECK_EQUAL(drv_ws2812_display(NULL, NULL), NRF_SUCCESS);
+    refresh_wait();
+    SIM_TEST_CHECK_EQUAL(m_decoder.frames_count, frames_count + 1U);
+    SIM_TEST_CHECK(frame_is(frame_nos));
+
+    /* Later interrupt lets the beginning of the frame out again, as a second, partial frame */
+    sim_irq_latency_ns = 200ULL * SIM_CLOCK_NS_PER_US;
+    frames_count       = m_decoder.frames_count;
+    frame_set(frame_nos, frame_no++);
+    SIM_TEST_CHECK_EQUAL(drv_ws2812_display(NULL, NULL), NRF_SUCCESS);
+    refresh_wait();
+    SIM_TEST_CHECK_EQUAL(m_decoder.frames_count, frames_count + 2U);
+    SIM_TEST_CHECK(m_decoder.frame_len < (PIXELS_COUNT * PIXEL_BYTES));
+
+    SIM_TEST_CHECK_EQUAL(m_decoder.errors_count, 0U);
+
+    return sim_test_result("ws2812_i2s");
+}
+
+/**
+ * @}
+ */
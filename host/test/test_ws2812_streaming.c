@@ -0,0 +1,165 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @defgroup zigbee_examples_host_test_ws2812_streaming test_ws2812_streaming.c
+ * @{
+ * @ingroup zigbee_examples
+ *
+ * @brief Test of the streaming mode of the WS2812 driver on a long chain.
+ *
+ * Buffers are refilled from the PWM interrupt while the other one is played, so the waveform is correct only if
+ * the interrupt is handled within a chunk, 30 us per pixel. The test decodes frames sent with increasing interrupt
+ * latency, frames sent within the deadline must arrive intact and a latency above it must corrupt them.
+ */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "nrf_error.h"
+#include "nrf_gpio.h"
+#include "drv_ws2812.h"
+#include "sim_clock.h"
+#include "sim_gpio.h"
+#include "sim_pwm.h"
+#include "sim_test.h"
+#include "sim_ws2812.h"
+
+#define DOUT_PIN                NRF_GPIO_PIN_MAP(1,7)
+#define PIXELS_COUNT            DRV_WS2812_LED_CHAIN_PIXELS_COUNT_MAX
+#define PIXEL_BYTES             3U
+#define CHUNK_NS                (DRV_WS2812_STREAM_CHUNK_PIXELS * 30ULL * SIM_CLOCK_NS_PER_US)
+#define FRAME_TIMEOUT_NS        (100ULL * SIM_CLOCK_NS_PER_MS)
+
+static sim_ws2812_decoder_t m_decoder;
+
+/**@brief Function for getting color of a pixel of given frame, different for every pixel and frame. */
+static uint32_t pixel_color(uint32_t frame_no, uint32_t pixel_no)
+{
+    return ((pixel_no + 1U) * 2654435761U + (frame_no * 40503U)) & 0x00FFFFFFU;
+}
+
+/**@brief Function for sending a frame and checking whether it is decoded intact.
+ *
+ * @return true if the LEDs have latched the frame without timing errors.
+ */
+static bool frame_send(uint32_t frame_no)
+{
+    uint32_t frames_count = m_decoder.frames_count;
+    uint32_t errors_count = m_decoder.errors_count;
+    uint64_t start_ns     = sim_clock_now();
+    uint32_t pixel_no;
+
+    for (pixel_no = 0; pixel_no < PIXELS_COUNT; pixel_no++)
+    {
+        drv_ws2812_set_pixel(pixel_no, pixel_color(frame_no, pixel_no));
+    }
+    SIM_TEST_CHECK_EQUAL(drv_ws2812_display(NULL, NULL), NRF_SUCCESS);
+
+    while (drv_ws2812_is_refreshing() && ((sim_clock_now() - start_ns) < FRAME_TIMEOUT_NS))
+    {
+        sim_clock_advance(CHUNK_NS);
+    }
+    sim_clock_advance(CHUNK_NS);
+    sim_ws2812_decoder_poll(&m_decoder, sim_clock_now() * 1000ULL);
+
+    if ((m_decoder.errors_count != errors_count) ||
+        (m_decoder.frames_count != (frames_count + 1U)) ||
+        (m_decoder.frame_len != (PIXELS_COUNT * PIXEL_BYTES)))
+    {
+        return false;
+    }
+
+    /* GRB order */
+    for (pixel_no = 0; pixel_no < PIXELS_COUNT; pixel_no++)
+    {
+        uint32_t       color   = pixel_color(frame_no, pixel_no);
+        uint8_t const * p_grb  = &m_decoder.frame[pixel_no * PIXEL_BYTES];
+
+        if ((p_grb[0] != (uint8_t)(color >> 8)) || (p_grb[1] != (uint8_t)(color >> 16)) || (p_grb[2] != (uint8_t)color))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int main(void)
+{
+    static const uint64_t latencies_us[] = {0U, 50U, 200U};
+    drv_ws2812_stats_t    stats;
+    uint32_t              frame_no = 0;
+    size_t                i;
+
+    sim_clock_reset();
+    sim_gpio_reset();
+    sim_pwm_reset();
+    sim_ws2812_decoder_init(&m_decoder, DOUT_PIN);
+
+    SIM_TEST_CHECK_EQUAL(drv_ws2812_init(DOUT_PIN), NRF_SUCCESS);
+
+    /* Refill within the chunk deadline */
+    for (i = 0; i < (sizeof(latencies_us) / sizeof(latencies_us[0])); i++)
+    {
+        sim_irq_latency_ns = latencies_us[i] * SIM_CLOCK_NS_PER_US;
+        if (!frame_send(frame_no++))
+        {
+            printf("frame corrupted with interrupt latency of %llu us\n", (unsigned long long)latencies_us[i]);
+            SIM_TEST_CHECK(false);
+        }
+    }
+
+    drv_ws2812_stats_get(&stats);
+    printf("%u pixels, %u interrupts per frame\n", (unsigned)PIXELS_COUNT, (unsigned)(stats.interrupts / frame_no));
+    /* Every buffer is refilled from a single interrupt */
+    SIM_TEST_CHECK(stats.interrupts <= (frame_no * ((PIXELS_COUNT / DRV_WS2812_STREAM_CHUNK_PIXELS) + 4U)));
+
+    /* Missing the deadline plays a buffer which has not been refilled */
+    sim_irq_latency_ns = CHUNK_NS + (60ULL * SIM_CLOCK_NS_PER_US);
+    SIM_TEST_CHECK(!frame_send(frame_no++));
+
+    return sim_test_result("ws2812_streaming");
+}
+
+/**
+ * @}
+ */
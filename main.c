@@ -64,6 +64,7 @@
 #include "nrf_log_default_backends.h"
 
 #include "drv_ws2812.h"
+#include "app_profiler.h"
 
 #define MAX_CHILDREN                      10                                    /**< The maximum amount of connected devices. Setting this value to 0 disables association to this device.  */
 #define IEEE_CHANNEL_MASK                 (1l << ZIGBEE_CHANNEL)                /**< Scan only one, predefined channel to find the coordinator. */
@@ -87,12 +88,19 @@
 #define HA_COLOR_LIGHT_ENDPOINT_1_ID      10                        /**< Device first endpoint, used to receive light controlling commands. */
 #define HA_COLOR_LIGHT_ENDPOINT_2_ID      11                        /**< Device second endpoint, used to receive light controlling commands. */
 #define HA_COLOR_LIGHT_ENDPOINT_3_ID      12                        /**< Device third endpoint, used to receive light controlling commands. */
+#define LIGHT_ENDPOINTS_COUNT             3                         /**< Number of color light endpoints, each controlling its own segment of the LED chain. */
+#ifndef LIGHT_ENDPOINT_PIXELS_COUNT
+#define LIGHT_ENDPOINT_PIXELS_COUNT       0                         /**< Number of LED chain pixels controlled by each endpoint, starting from the first endpoint. 0 splits the chain evenly. */
+#endif
+
+STATIC_ASSERT(LIGHT_ENDPOINTS_COUNT <= RGB_LED_SEGMENTS_COUNT_MAX);
 
 #ifdef  BOARD_PCA10059                                                          /**< If it is Dongle */
 #define IDENTIFY_MODE_BSP_EVT             BSP_EVENT_KEY_0                       /**< Button event used to enter the Bulb into the Identify mode. */
 #define ZIGBEE_NETWORK_STATE_LED          BSP_BOARD_LED_0                       /**< LED indicating that light switch successfully joind Zigbee network. */
 #else
 #define IDENTIFY_MODE_BSP_EVT             BSP_EVENT_KEY_3                       /**< Button event used to enter the Bulb into the Identify mode. */
+#define PROFILER_REPORT_BSP_EVT           BSP_EVENT_KEY_0                       /**< Button event used to log the profiler statistics. */
 #define ZIGBEE_NETWORK_STATE_LED          BSP_BOARD_LED_2                       /**< LED indicating that light switch successfully joind Zigbee network. */
 #endif
 #define BULB_LED                          BSP_BOARD_LED_3                       /**< LED immitaing dimmable light bulb. */
@@ -119,18 +127,32 @@ typedef struct
 
 
 static zb_color_light_ctx_t m_color_light_ctx_1;
+static zb_color_light_ctx_t m_color_light_ctx_2;
+static zb_color_light_ctx_t m_color_light_ctx_3;
 
 ZB_DECLARE_COLOR_CONTROL_CLUSTER_ATTR_LIST(m_color_light_ctx_1,
                                            m_color_light_clusters_1);
+ZB_DECLARE_COLOR_CONTROL_CLUSTER_ATTR_LIST(m_color_light_ctx_2,
+                                           m_color_light_clusters_2);
+ZB_DECLARE_COLOR_CONTROL_CLUSTER_ATTR_LIST(m_color_light_ctx_3,
+                                           m_color_light_clusters_3);
 
-/* Declare two endpoints for color controllable and dimmable light bulbs */
+/* Declare three endpoints for color controllable and dimmable light bulbs */
 ZB_ZCL_DECLARE_COLOR_DIMMABLE_LIGHT_EP(m_color_light_ep_1,
                                        HA_COLOR_LIGHT_ENDPOINT_1_ID,
                                        m_color_light_clusters_1);
+ZB_ZCL_DECLARE_COLOR_DIMMABLE_LIGHT_EP(m_color_light_ep_2,
+                                       HA_COLOR_LIGHT_ENDPOINT_2_ID,
+                                       m_color_light_clusters_2);
+ZB_ZCL_DECLARE_COLOR_DIMMABLE_LIGHT_EP(m_color_light_ep_3,
+                                       HA_COLOR_LIGHT_ENDPOINT_3_ID,
+                                       m_color_light_clusters_3);
 
 /* Declare context for endpoints */
-ZBOSS_DECLARE_DEVICE_CTX_1_EP(m_color_light_ctx,
-                              m_color_light_ep_1);
+ZBOSS_DECLARE_DEVICE_CTX_3_EP(m_color_light_ctx,
+                              m_color_light_ep_1,
+                              m_color_light_ep_2,
+                              m_color_light_ep_3);
 
 
 /**@brief Function for initializing the application timer.
@@ -151,6 +173,38 @@ static void log_init(void)
     NRF_LOG_DEFAULT_BACKENDS_INIT();
 }
 
+/**@brief Function for assigning segments of the LED chain to the endpoints.
+ *
+ * Endpoint HA_COLOR_LIGHT_ENDPOINT_1_ID + n controls LED segment n. If the chain is too short to be shared,
+ * it is controlled by the first endpoint only.
+ */
+static void led_segments_init(void)
+{
+    ret_code_t err_code;
+    size_t     pixels_count  = rgb_led_pixels_count_get();
+    size_t     segment_size  = LIGHT_ENDPOINT_PIXELS_COUNT;
+    size_t     first_pixel   = 0;
+    size_t     i;
+
+    if (segment_size == 0)
+    {
+        segment_size = pixels_count / LIGHT_ENDPOINTS_COUNT;
+    }
+    if (segment_size == 0)
+    {
+        segment_size = pixels_count;
+    }
+
+    for (i = 0; i < LIGHT_ENDPOINTS_COUNT; i++)
+    {
+        size_t count = MIN(segment_size, pixels_count - first_pixel);
+
+        err_code = rgb_led_segment_config(i, first_pixel, count);
+        APP_ERROR_CHECK(err_code);
+        first_pixel += count;
+    }
+}
+
 /**@brief Function to update LED state on device using given parameters.
  *
  * @param[IN]  ep            Endpoint ID for which LED state should be updated.
@@ -158,9 +212,11 @@ static void log_init(void)
  */
 void update_endpoint_led(zb_uint8_t ep, led_params_t * p_led_params)
 {
-
-	rgb_led_update(p_led_params);
-	NRF_LOG_INFO("LED value update ");
+    if ((ep >= HA_COLOR_LIGHT_ENDPOINT_1_ID) && (ep < HA_COLOR_LIGHT_ENDPOINT_1_ID + LIGHT_ENDPOINTS_COUNT))
+    {
+        rgb_led_segment_update(ep - HA_COLOR_LIGHT_ENDPOINT_1_ID, p_led_params);
+        NRF_LOG_INFO("LED value update on endpoint %hu", ep);
+    }
 }
 
 /**@brief Function to handle identify notification events on endpoint.
@@ -170,16 +226,22 @@ void update_endpoint_led(zb_uint8_t ep, led_params_t * p_led_params)
  */
 static zb_void_t zb_identify_ep_handler(zb_uint8_t param, zb_uint16_t ep)
 {
-    zb_ret_t             ret   = RET_OK;
+    zb_ret_t               ret         = RET_OK;
+    zb_color_light_ctx_t * p_light_ctx = zb_color_light_ctx_get((zb_uint8_t)ep);
 
     NRF_LOG_INFO("Endpoint %d, param value: %hd", ep, param);
 
+    if (p_light_ctx == NULL)
+    {
+        return;
+    }
+
     if (param)
     {
     	/* Turn on led indicating ongoing find and bind procedure and set Thingy
     	 * LED to breathing green to indicate ongoing procedure. */
     	bsp_board_led_on(ZB_ONGOING_FIND_N_BIND_LED);
-    	ret = zb_color_light_do_identify_effect(&m_color_light_ctx_1,
+    	ret = zb_color_light_do_identify_effect(p_light_ctx,
     			ZB_ZCL_IDENTIFY_EFFECT_ID_BREATHE);
     }
     else
@@ -187,7 +249,7 @@ static zb_void_t zb_identify_ep_handler(zb_uint8_t param, zb_uint16_t ep)
     	/* Turn off led indicating ongoing find and bind procedure and
     	 * restore Thingy LED color. */
     	bsp_board_led_off(ZB_ONGOING_FIND_N_BIND_LED);
-    	ret = zb_color_light_do_identify_effect(&m_color_light_ctx_1,
+    	ret = zb_color_light_do_identify_effect(p_light_ctx,
     			ZB_ZCL_IDENTIFY_EFFECT_ID_STOP);
     }
 
@@ -205,6 +267,55 @@ static zb_void_t zb_identify_ep_1_handler(zb_uint8_t param)
 }
 
 
+/**@brief Function to handle identify notification events on the second endpoint.
+ *
+ * @param[IN]   param   Parameter handler is called with.
+ */
+static zb_void_t zb_identify_ep_2_handler(zb_uint8_t param)
+{
+    zb_identify_ep_handler(param, HA_COLOR_LIGHT_ENDPOINT_2_ID);
+}
+
+
+/**@brief Function to handle identify notification events on the third endpoint.
+ *
+ * @param[IN]   param   Parameter handler is called with.
+ */
+static zb_void_t zb_identify_ep_3_handler(zb_uint8_t param)
+{
+    zb_identify_ep_handler(param, HA_COLOR_LIGHT_ENDPOINT_3_ID);
+}
+
+
+/**@brief Function to handle ZCL commands received on the first endpoint, before they are processed by the stack.
+ *
+ * @param[IN]   bufid   Reference to Zigbee stack buffer with received command.
+ */
+static zb_uint8_t zb_ep_1_handler(zb_bufid_t bufid)
+{
+    return zb_color_light_zcl_cmd_handler(&m_color_light_ctx_1, bufid);
+}
+
+
+/**@brief Function to handle ZCL commands received on the second endpoint, before they are processed by the stack.
+ *
+ * @param[IN]   bufid   Reference to Zigbee stack buffer with received command.
+ */
+static zb_uint8_t zb_ep_2_handler(zb_bufid_t bufid)
+{
+    return zb_color_light_zcl_cmd_handler(&m_color_light_ctx_2, bufid);
+}
+
+
+/**@brief Function to handle ZCL commands received on the third endpoint, before they are processed by the stack.
+ *
+ * @param[IN]   bufid   Reference to Zigbee stack buffer with received command.
+ */
+static zb_uint8_t zb_ep_3_handler(zb_bufid_t bufid)
+{
+    return zb_color_light_zcl_cmd_handler(&m_color_light_ctx_3, bufid);
+}
+
 
 /**@brief Callback function for handling ZCL commands.
  *
@@ -213,28 +324,35 @@ static zb_void_t zb_identify_ep_1_handler(zb_uint8_t param)
 static zb_void_t zb_zcl_device_cb(zb_bufid_t bufid)
 {
     zb_zcl_device_callback_param_t * p_device_cb_param = ZB_BUF_GET_PARAM(bufid, zb_zcl_device_callback_param_t);
+    zb_color_light_ctx_t           * p_light_ctx       = zb_color_light_ctx_get(p_device_cb_param->endpoint);
     zb_ret_t                         ret = RET_OK;
+    APP_PROFILER_STAGE_BEGIN(APP_PROFILER_STAGE_ZCL_DEVICE_CB);
 
     NRF_LOG_INFO("Received ZCL callback %hd on endpoint %hu",
                  p_device_cb_param->device_cb_id, p_device_cb_param->endpoint);
 
+    if (p_light_ctx == NULL)
+    {
+        NRF_LOG_INFO("Unknown endpoint, returned error");
+        ret = RET_ERROR;
+    }
     /* Prevent led update if related Endpoint is in identify mode. */
-    if (!m_color_light_ctx_1.identify_attr.identify_time)
+    else if (!p_light_ctx->identify_attr.identify_time)
     {
         switch (p_device_cb_param->device_cb_id)
         {
             case ZB_ZCL_LEVEL_CONTROL_SET_VALUE_CB_ID:
-                ret = zb_color_light_set_level(&m_color_light_ctx_1,
+                ret = zb_color_light_set_level(p_light_ctx,
                                                p_device_cb_param->cb_param.level_control_set_value_param.new_value);
                 break;
 
             case ZB_ZCL_SET_ATTR_VALUE_CB_ID:
-                ret = zb_color_light_set_attribute(&m_color_light_ctx_1,
+                ret = zb_color_light_set_attribute(p_light_ctx,
                                                    &p_device_cb_param->cb_param.set_attr_value_param);
                 break;
 
             case ZB_ZCL_IDENTIFY_EFFECT_CB_ID:
-                ret = zb_color_light_do_identify_effect(&m_color_light_ctx_1,
+                ret = zb_color_light_do_identify_effect(p_light_ctx,
                                                         p_device_cb_param->cb_param.identify_effect_value_param.effect_id);
                 break;
 
@@ -252,6 +370,8 @@ static zb_void_t zb_zcl_device_cb(zb_bufid_t bufid)
 
     /* Set default response value. */
     p_device_cb_param->status = ret;
+    APP_PROFILER_STAGE_END(APP_PROFILER_STAGE_ZCL_DEVICE_CB);
+
     NRF_LOG_INFO("zb_zcl_device_cb status: %hd", p_device_cb_param->status);
 }
 
@@ -280,6 +400,13 @@ static void buttons_handler(bsp_event_t evt)
             }
             break;
 
+#if (APP_PROFILER_ENABLED && defined(PROFILER_REPORT_BSP_EVT))
+        case PROFILER_REPORT_BSP_EVT:
+            app_profiler_report();
+            app_profiler_reset();
+            break;
+#endif
+
         default:
             NRF_LOG_INFO("Unhandled BSP Event received: %d", evt);
             break;
@@ -336,7 +463,10 @@ int main(void)
     /* Initialize timer, logging system and GPIOs. */
     timer_init();
     log_init();
+    app_profiler_init();
     leds_buttons_init();
+    rgb_led_init();
+    led_segments_init();
 
     /* Set Zigbee stack logging level and traffic dump subsystem. */
     ZB_SET_TRACE_LEVEL(ZIGBEE_TRACE_LEVEL);
@@ -358,6 +488,8 @@ int main(void)
 
     /* Initialize application context structure. */
     UNUSED_RETURN_VALUE(ZB_MEMSET(&m_color_light_ctx_1, 0, sizeof(m_color_light_ctx_1)));
+    UNUSED_RETURN_VALUE(ZB_MEMSET(&m_color_light_ctx_2, 0, sizeof(m_color_light_ctx_2)));
+    UNUSED_RETURN_VALUE(ZB_MEMSET(&m_color_light_ctx_3, 0, sizeof(m_color_light_ctx_3)));
 
     // Register device context with ZBOSS prior to using zb_color_light
     // functions as the module uses ZBOSS APIs which operate on the device object.
@@ -368,7 +500,16 @@ int main(void)
 
     zb_color_light_init_ctx(&m_color_light_ctx_1,
                             HA_COLOR_LIGHT_ENDPOINT_1_ID,
-                            zb_identify_ep_1_handler);
+                            zb_identify_ep_1_handler,
+                            zb_ep_1_handler);
+    zb_color_light_init_ctx(&m_color_light_ctx_2,
+                            HA_COLOR_LIGHT_ENDPOINT_2_ID,
+                            zb_identify_ep_2_handler,
+                            zb_ep_2_handler);
+    zb_color_light_init_ctx(&m_color_light_ctx_3,
+                            HA_COLOR_LIGHT_ENDPOINT_3_ID,
+                            zb_identify_ep_3_handler,
+                            zb_ep_3_handler);
 
     /** Start Zigbee Stack. */
     zb_err_code = zboss_start_no_autostart();
@@ -57,6 +57,24 @@
 #define RGB_LED_BACKEND_PWM_INSTANCE NRF_DRV_PWM_INSTANCE(0)
 #endif
 
+// <q> RGB_LED_BACKEND_PWM_HIGH_RESOLUTION_ENABLED  - Drives the RGB LED tape with 7.8 kHz PWM dithered to 16-bit resolution.
+// <i> Otherwise PWM of 976 Hz with 14-bit resolution is used, which may be visible on camera.
+#ifndef RGB_LED_BACKEND_PWM_HIGH_RESOLUTION_ENABLED
+#define RGB_LED_BACKEND_PWM_HIGH_RESOLUTION_ENABLED 1
+#endif
+
+// <q> APP_PROFILER_ENABLED  - Enables measurement of execution time of the application hot paths.
+// <i> Statistics are collected with the DWT cycle counter and logged on demand.
+#ifndef APP_PROFILER_ENABLED
+#define APP_PROFILER_ENABLED 0
+#endif
+
+// <o> ZB_COLOR_LIGHT_SCENES_COUNT_MAX - Maximum number of scenes stored for all endpoints together. 
+// <i> Scenes are persisted in one flash page, reserved as region SCENES by the linker script.
+#ifndef ZB_COLOR_LIGHT_SCENES_COUNT_MAX
+#define ZB_COLOR_LIGHT_SCENES_COUNT_MAX 16
+#endif
+
 // </h> 
 //==========================================================
 
@@ -80,6 +98,170 @@
 #define DRV_WS2812_PWM_INSTANCE_NO 0
 #endif
 
+// <o> DRV_WS2812_PWM_INSTANCES_COUNT - Number of the nrfx PWM instances used by the WS2812 driver (1-4). 
+// <i> Instances DRV_WS2812_PWM_INSTANCE_NO_1..3 follow DRV_WS2812_PWM_INSTANCE_NO. Enable the corresponding NRFX_PWMn_ENABLED.
+
+#ifndef DRV_WS2812_PWM_INSTANCES_COUNT
+#define DRV_WS2812_PWM_INSTANCES_COUNT 1
+#endif
+
+// <o> DRV_WS2812_CHANNELS_PER_INSTANCE - Number of LED strips driven in parallel by every PWM instance (1-4). 
+// <i> More than one channel uses the individual load mode, with 4 times bigger PWM sequence.
+
+#ifndef DRV_WS2812_CHANNELS_PER_INSTANCE
+#define DRV_WS2812_CHANNELS_PER_INSTANCE 1
+#endif
+
+// <q> DRV_WS2812_STREAMING_ENABLED  - Stream PWM sequence through two small buffers refilled from the PWM interrupt
+// <i> RAM used by the driver no longer depends on the LED chain length (except 3 bytes, or 4 with RGBW, per pixel of the LED state buffer).
+
+#ifndef DRV_WS2812_STREAMING_ENABLED
+#define DRV_WS2812_STREAMING_ENABLED 0
+#endif
+
+// <o> DRV_WS2812_STREAM_CHUNK_PIXELS - Number of pixels encoded in a single streaming buffer. 
+// <i> Playing one buffer takes 30 us per pixel, which is the deadline for refilling the other one. Minimum value is 5.
+
+#ifndef DRV_WS2812_STREAM_CHUNK_PIXELS
+#define DRV_WS2812_STREAM_CHUNK_PIXELS 8
+#endif
+
+// <q> DRV_WS2812_ENCODE_LUT_NIBBLE  - Use a 128 byte nibble lookup table instead of a 4 kB byte lookup table for encoding
+ 
+
+#ifndef DRV_WS2812_ENCODE_LUT_NIBBLE
+#define DRV_WS2812_ENCODE_LUT_NIBBLE 0
+#endif
+
+// <q> DRV_WS2812_RGBW_ENABLED  - Drive SK6812 RGBW LEDs, with 32 bits per pixel
+// <i> White part of colors is displayed by the white LED.
+
+#ifndef DRV_WS2812_RGBW_ENABLED
+#define DRV_WS2812_RGBW_ENABLED 0
+#endif
+
+// <o> DRV_WS2812_COLOR_ORDER  - Order of color components sent to the LEDs
+// <i> White component of RGBW LEDs is always sent last.
+// <0=> GRB
+// <1=> RGB
+// <2=> BRG
+// <3=> RBG
+// <4=> GBR
+// <5=> BGR
+
+#ifndef DRV_WS2812_COLOR_ORDER
+#define DRV_WS2812_COLOR_ORDER 0
+#endif
+
+// <e> DRV_WS2812_HW_KEEPALIVE_ENABLED - Refresh LEDs periodically by hardware (RTC and PPI), without waking up the CPU
+// <i> Not supported together with streaming.
+//==========================================================
+#ifndef DRV_WS2812_HW_KEEPALIVE_ENABLED
+#define DRV_WS2812_HW_KEEPALIVE_ENABLED 0
+#endif
+// <o> DRV_WS2812_HW_KEEPALIVE_RTC_INSTANCE_NO  - RTC instance used exclusively by the driver
+// <i> RTC1 is used by app_timer and RTC2 by the 802.15.4 radio driver.
+// <0=> RTC0
+// <1=> RTC1
+// <2=> RTC2
+
+#ifndef DRV_WS2812_HW_KEEPALIVE_RTC_INSTANCE_NO
+#define DRV_WS2812_HW_KEEPALIVE_RTC_INSTANCE_NO 0
+#endif
+
+// </e>
+
+// <e> DRV_WS2812_I2S_ENABLED - Generate DOUT waveform with I2S instead of PWM (12 bytes per pixel)
+// <i> Drives a single strip. Not supported together with streaming and hardware keepalive. NRFX_I2S_ENABLED must be 0.
+//==========================================================
+#ifndef DRV_WS2812_I2S_ENABLED
+#define DRV_WS2812_I2S_ENABLED 0
+#endif
+// <o> DRV_WS2812_I2S_SCK_PIN - SCK pin, required by I2S but must be left unconnected  <0-47>
+
+
+#ifndef DRV_WS2812_I2S_SCK_PIN
+#define DRV_WS2812_I2S_SCK_PIN 42
+#endif
+
+// <o> DRV_WS2812_I2S_LRCK_PIN - LRCK pin, required by I2S but must be left unconnected  <0-47>
+
+
+#ifndef DRV_WS2812_I2S_LRCK_PIN
+#define DRV_WS2812_I2S_LRCK_PIN 43
+#endif
+
+// <o> DRV_WS2812_I2S_IRQ_PRIORITY  - Interrupt priority
+ 
+
+// <i> Priorities 0,2 (nRF51) and 0,1,4,5 (nRF52) are reserved for SoftDevice
+// <0=> 0 (highest) 
+// <1=> 1 
+// <2=> 2 
+// <3=> 3 
+// <4=> 4 
+// <5=> 5 
+// <6=> 6 
+// <7=> 7 
+
+#ifndef DRV_WS2812_I2S_IRQ_PRIORITY
+#define DRV_WS2812_I2S_IRQ_PRIORITY 6
+#endif
+
+// </e>
+
+// </h> 
+//==========================================================
+
+// <h> apa102 - APA102/SK9822 led chain driver
+
+//==========================================================
+// <o> DRV_APA102_LED_CHAIN_PIXELS_COUNT_MAX - Maximum number of the APA102 LEDs in chain supported by the APA102 driver. 
+#ifndef DRV_APA102_LED_CHAIN_PIXELS_COUNT_MAX
+#define DRV_APA102_LED_CHAIN_PIXELS_COUNT_MAX 40
+#endif
+
+// <o> DRV_APA102_SPIM_INSTANCE_NO - Number of the nrfx SPIM instance used by the APA102 driver. 
+// <i> When DRV_APA102_SPIM_INSTANCE_NO == 0 define NRFX_SPIM0_ENABLED to 1
+// <i> etc.
+
+#ifndef DRV_APA102_SPIM_INSTANCE_NO
+#define DRV_APA102_SPIM_INSTANCE_NO 0
+#endif
+
+// <o> DRV_APA102_SPIM_FREQUENCY  - SPI clock frequency
+// <i> Frequencies above 8 MHz are supported only by SPIM3.
+// <0x02000000=> 125k 
+// <0x04000000=> 250k 
+// <0x08000000=> 500k 
+// <0x10000000=> 1M 
+// <0x20000000=> 2M 
+// <0x40000000=> 4M 
+// <0x80000000=> 8M 
+// <0x0A000000=> 16M 
+// <0x14000000=> 32M 
+
+#ifndef DRV_APA102_SPIM_FREQUENCY
+#define DRV_APA102_SPIM_FREQUENCY 0x80000000
+#endif
+
+// <o> DRV_APA102_SPIM_IRQ_PRIORITY  - Interrupt priority
+ 
+
+// <i> Priorities 0,2 (nRF51) and 0,1,4,5 (nRF52) are reserved for SoftDevice
+// <0=> 0 (highest) 
+// <1=> 1 
+// <2=> 2 
+// <3=> 3 
+// <4=> 4 
+// <5=> 5 
+// <6=> 6 
+// <7=> 7 
+
+#ifndef DRV_APA102_SPIM_IRQ_PRIORITY
+#define DRV_APA102_SPIM_IRQ_PRIORITY 6
+#endif
+
 // </h> 
 //==========================================================
 
@@ -785,6 +967,125 @@
 
 // </e>
 
+// <e> NRFX_SPIM_ENABLED - nrfx_spim - SPIM peripheral driver
+// <i> Used by the APA102 LED backend, enabled together with the instance by the board Makefile with LED_BACKEND=apa102.
+//==========================================================
+#ifndef NRFX_SPIM_ENABLED
+#define NRFX_SPIM_ENABLED 0
+#endif
+// <q> NRFX_SPIM0_ENABLED  - Enable SPIM0 instance
+ 
+
+#ifndef NRFX_SPIM0_ENABLED
+#define NRFX_SPIM0_ENABLED 0
+#endif
+
+// <q> NRFX_SPIM1_ENABLED  - Enable SPIM1 instance
+ 
+
+#ifndef NRFX_SPIM1_ENABLED
+#define NRFX_SPIM1_ENABLED 0
+#endif
+
+// <q> NRFX_SPIM2_ENABLED  - Enable SPIM2 instance
+ 
+
+#ifndef NRFX_SPIM2_ENABLED
+#define NRFX_SPIM2_ENABLED 0
+#endif
+
+// <q> NRFX_SPIM3_ENABLED  - Enable SPIM3 instance
+ 
+
+#ifndef NRFX_SPIM3_ENABLED
+#define NRFX_SPIM3_ENABLED 0
+#endif
+
+// <q> NRFX_SPIM_EXTENDED_ENABLED  - Enable extended SPIM features
+ 
+
+#ifndef NRFX_SPIM_EXTENDED_ENABLED
+#define NRFX_SPIM_EXTENDED_ENABLED 0
+#endif
+
+// <o> NRFX_SPIM_MISO_PULL_CFG  - MISO pin pull configuration.
+ 
+// <0=> NRF_GPIO_PIN_NOPULL 
+// <1=> NRF_GPIO_PIN_PULLDOWN 
+// <3=> NRF_GPIO_PIN_PULLUP 
+
+#ifndef NRFX_SPIM_MISO_PULL_CFG
+#define NRFX_SPIM_MISO_PULL_CFG 1
+#endif
+
+// <o> NRFX_SPIM_DEFAULT_CONFIG_IRQ_PRIORITY  - Interrupt priority
+ 
+// <0=> 0 (highest) 
+// <1=> 1 
+// <2=> 2 
+// <3=> 3 
+// <4=> 4 
+// <5=> 5 
+// <6=> 6 
+// <7=> 7 
+
+#ifndef NRFX_SPIM_DEFAULT_CONFIG_IRQ_PRIORITY
+#define NRFX_SPIM_DEFAULT_CONFIG_IRQ_PRIORITY 6
+#endif
+
+// <e> NRFX_SPIM_CONFIG_LOG_ENABLED - Enables logging in the module.
+//==========================================================
+#ifndef NRFX_SPIM_CONFIG_LOG_ENABLED
+#define NRFX_SPIM_CONFIG_LOG_ENABLED 0
+#endif
+// <o> NRFX_SPIM_CONFIG_LOG_LEVEL  - Default Severity level
+ 
+// <0=> Off 
+// <1=> Error 
+// <2=> Warning 
+// <3=> Info 
+// <4=> Debug 
+
+#ifndef NRFX_SPIM_CONFIG_LOG_LEVEL
+#define NRFX_SPIM_CONFIG_LOG_LEVEL 3
+#endif
+
+// <o> NRFX_SPIM_CONFIG_INFO_COLOR  - ANSI escape code prefix.
+ 
+// <0=> Default 
+// <1=> Black 
+// <2=> Red 
+// <3=> Green 
+// <4=> Yellow 
+// <5=> Blue 
+// <6=> Magenta 
+// <7=> Cyan 
+// <8=> White 
+
+#ifndef NRFX_SPIM_CONFIG_INFO_COLOR
+#define NRFX_SPIM_CONFIG_INFO_COLOR 0
+#endif
+
+// <o> NRFX_SPIM_CONFIG_DEBUG_COLOR  - ANSI escape code prefix.
+ 
+// <0=> Default 
+// <1=> Black 
+// <2=> Red 
+// <3=> Green 
+// <4=> Yellow 
+// <5=> Blue 
+// <6=> Magenta 
+// <7=> Cyan 
+// <8=> White 
+
+#ifndef NRFX_SPIM_CONFIG_DEBUG_COLOR
+#define NRFX_SPIM_CONFIG_DEBUG_COLOR 0
+#endif
+
+// </e>
+
+// </e>
+
 // <q> NRFX_SYSTICK_ENABLED  - nrfx_systick - ARM(R) SysTick driver
  
 
@@ -46,249 +46,260 @@
 #include <stdint.h>
 #include <stddef.h>
 #include <stdbool.h>
+#include <string.h>
 
+#include "app_profiler.h"
 #include "app_util_platform.h"
 #include "app_timer.h"
+#include "nrf_atomic.h"
 #include "rgb_led.h"
 #include "rgb_led_backend.h"
+#include "rgb_led_effect.h"
+#include "rgb_led_state.h"
 
 /**@def RGB_LED_REFRESH_PERIOD_MS
- * @brief Period of timer performing refresh of RGB led chain
+ * @brief Period of timer performing refresh of RGB led chain, while an animation or a transition is running
  */
 #ifndef RGB_LED_REFRESH_PERIOD_MS
 #define RGB_LED_REFRESH_PERIOD_MS   (40U)
 #endif
 
-static led_params_t  m_curr_led_params;
-static volatile led_params_t  m_next_led_params;
-static volatile bool m_next_led_params_set;
-static uint32_t m_timer_ms;
-static uint32_t m_breathe_delay_start_timestamp;
-static bool m_breathe_delay_state;
-/* Index to c_led_breathe_brightness_sequence */
-static size_t  m_led_breathe_sequence_curr_idx;
-/* LED brightness sequence, played to imitate 'breathe' effect. */
-static const uint8_t  c_led_breathe_brightness_sequence[] =
+/**@def RGB_LED_PIXELS_COUNT_MAX
+ * @brief Maximum number of pixels rendered by per-pixel effects and covered by segments
+ */
+#ifndef RGB_LED_PIXELS_COUNT_MAX
+#define RGB_LED_PIXELS_COUNT_MAX    (40U)
+#endif
+
+/* State of independently controlled part of the led chain */
+typedef struct
 {
-        0, 10, 20, 40, 80, 120, 160, 200, 240, 255, 240, 200, 160, 120, 80, 40, 20, 10, 0
-};
+    rgb_led_state_t         state;                  /**< Displayed state, advanced on each refresh. */
+    led_params_t            next_led_params;        /**< Parameters requested by @ref rgb_led_segment_update. */
+    volatile uint32_t       next_led_params_seq;    /**< Incremented before and after writing @c next_led_params, odd while writing. */
+    uint32_t                loaded_seq;             /**< Value of @c next_led_params_seq when parameters have been loaded. */
+    size_t                  first_pixel;            /**< Index of the first pixel of the segment. */
+    size_t                  pixels_count;           /**< Number of pixels of the segment, 0 if segment is not used. */
+} rgb_led_segment_t;
+
+/* True when m_led_refresh_timer has been started and has not expired yet */
+static nrf_atomic_flag_t m_refresh_scheduled;
+static volatile uint32_t m_wakeup_count;
+static uint32_t m_timer_ms;
+static rgb_led_segment_t m_segments[RGB_LED_SEGMENTS_COUNT_MAX];
+/* Frame composed of all segments, sent to the backend with a single refresh */
+static uint32_t m_frame[RGB_LED_PIXELS_COUNT_MAX];
+static size_t   m_frame_pixels_count;
 
 APP_TIMER_DEF(m_led_refresh_timer);
 
-/**@brief Function for applying intensity to given brightness.
+/**@brief Function for loading parameters requested for a segment, if there are any.
  *
- * @param[in] brightness    Value from range [0, 255] being brightness of color (255 means the brightest)
- * @param[in] intensity     Value from range [0, 100] being intensity of color
+ * Reading side of the sequence lock protecting @c next_led_params. Interrupts are not disabled by the writer, so
+ * the copy is discarded if the writer has been interrupted in the middle of writing. The writer requests a refresh
+ * once it is done, so new parameters are loaded on that refresh.
  *
- * @return Color brightness multiplied by color intensity
- */
-static uint8_t brightness_apply_intensity(uint8_t brightness, uint8_t intensity)
-{
-    if (intensity > 100U)
-    {
-        /* Limit intensity value, defensive code */
-        intensity = 100U;
-    }
-
-    return (uint8_t)((uint32_t)intensity * brightness / 100U);
-}
-
-/**@brief Function for making RGB color value out of mask selecting individual channels and channel brightness
- * @param[in] brightness    Value from range [0, 255] being brightness of selected channels
- * @param[in] color_mask    Mask selecting RGB channels, combination of @ref LED_PARAMS_COLOR_MASK_RED,
- *                          @ref LED_PARAMS_COLOR_MASK_GREEN, @ref LED_PARAMS_COLOR_MASK_BLUE flags.
+ * @param[in] p_segment     Segment to be loaded.
  *
- * @return RGB color value suitable for RGB LED backend module.
+ * @return true if new parameters have been loaded.
  */
-static uint32_t make_rgb_color_from_brightness_and_mask(uint8_t brightness, uint8_t color_mask)
+static bool segment_params_load(rgb_led_segment_t * p_segment)
 {
-    uint32_t result = 0U;
+    led_params_t led_params;
+    uint32_t     seq = p_segment->next_led_params_seq;
 
-    /* Here component takes value from range [0, 255] */
-    if ((color_mask & LED_PARAMS_COLOR_MASK_RED) != 0U)
+    __DMB();
+    if ((seq == p_segment->loaded_seq) || ((seq & 1U) != 0U))
     {
-        result |= brightness;
+        /* Nothing new or writing in progress */
+        return false;
     }
-    result <<= 8;
 
-    if ((color_mask & LED_PARAMS_COLOR_MASK_GREEN) != 0U)
+    led_params = p_segment->next_led_params;
+    __DMB();
+    if (p_segment->next_led_params_seq != seq)
     {
-        result |= brightness;
+        /* Torn copy, parameters changed while being read */
+        return false;
     }
-    result <<= 8;
+    p_segment->loaded_seq = seq;
 
-    if ((color_mask & LED_PARAMS_COLOR_MASK_BLUE) != 0U)
-    {
-        result |= brightness;
-    }
+    rgb_led_state_load(&p_segment->state, &led_params, m_timer_ms);
 
-    return result;
+    return true;
 }
 
-/**@brief Function for converting led_params_t (r, g, b components) into RGB LED backend color.
+/**@brief Function for starting refresh timer.
  *
- * @param[in] p_led_params  Input color structure with filled @c r, @c g, @c fields
- *
- * @return RGB color compatible with RGB LED backend module.
+ * @param[in] timeout_ticks     Time to the next refresh, in app_timer ticks.
  */
-static uint32_t make_rgb_color_from_led_params_rgb(const led_params_t * p_led_params)
+static void refresh_schedule(uint32_t timeout_ticks)
 {
-    uint32_t result;
-
-    result = p_led_params->r;
-    result <<= 8;
-    result |= p_led_params->g;
-    result <<= 8;
-    result |= p_led_params->b;
-
-    return result;
-}
-
-/**@brief Function for generating RGB color compatible with RGB LED backend module from led_params_t and given index of breathe sequence
- *
- * @param[in] p_led_params          Input led parameters with filled @c intensity and @c color fields.
- * @param[in] breathe_sequence_idx  Index to @ref c_led_breathe_brightness_sequence
- *
- * @return RGB color compatible with RGB LED backend module corresponding to given step of breathe sequence.
- */
-static uint32_t make_rgb_color_from_breathe_sequence(const led_params_t * p_led_params, size_t breathe_sequence_idx)
-{
-    uint8_t brightness;
-
-    brightness = c_led_breathe_brightness_sequence[breathe_sequence_idx];
-    brightness = brightness_apply_intensity(brightness, p_led_params->intensity);
+    ret_code_t ret_code;
 
-    return make_rgb_color_from_brightness_and_mask(brightness, p_led_params->color);
+    ret_code = app_timer_start(m_led_refresh_timer, timeout_ticks, NULL);
+    APP_ERROR_CHECK(ret_code);
 }
 
-/**@brief Function for generating RGB color compatible with RGB LED backend module form current LED controlling variables
+/**@brief Function for requesting refresh of the led chain as soon as possible.
  *
- * @return RGB color compatible with RGB LED backend module.
+ * Does nothing if the refresh timer is running, since the request is handled on its expiration anyway.
  */
-static uint32_t get_current_state_color(void)
+static void refresh_request(void)
 {
-    uint32_t color;
-
-    switch (m_curr_led_params.mode)
+    if (nrf_atomic_flag_set_fetch(&m_refresh_scheduled) == 0U)
     {
-        case LED_MODE_CONSTANT:
-            color = make_rgb_color_from_led_params_rgb(&m_curr_led_params);
-            break;
-
-        case LED_MODE_BREATHING:
-            /* no break, fall-through */
-        case LED_MODE_ONE_SHOT:
-            color = make_rgb_color_from_breathe_sequence(&m_curr_led_params, m_led_breathe_sequence_curr_idx);
-            break;
-
-        case LED_MODE_OFF:
-            /* no break, fall-through */
-        default:
-            color = 0U;
-            break;
+        refresh_schedule(APP_TIMER_MIN_TIMEOUT_TICKS);
     }
-
-    return color;
-}
-
-/**@brief Function for transition to next breathe sequence
- * @param[in] idx   Previous index to @ref c_led_breathe_brightness_sequence
- * @return Next value of index to @ref c_led_breathe_brightness_sequence to have nice breathe effect */
-static size_t breathe_sequence_idx_next(size_t idx)
-{
-    idx++;
-    if (idx >= ARRAY_SIZE(c_led_breathe_brightness_sequence))
-    {
-        idx = 0U;
-    }
-    return idx;
 }
 
 static void led_refresh_timer_callback(void * p_context)
 {
+    rgb_led_segment_t * p_whole_chain = &m_segments[0];
+    bool                animating     = false;
+    size_t              i;
+    APP_PROFILER_STAGE_BEGIN(APP_PROFILER_STAGE_LED_REFRESH);
+
     UNUSED_PARAMETER(p_context);
 
+    /* Any update requested from now on needs another refresh */
+    UNUSED_RETURN_VALUE(nrf_atomic_flag_clear(&m_refresh_scheduled));
+    m_wakeup_count++;
+
     m_timer_ms += RGB_LED_REFRESH_PERIOD_MS;    /* Possible wrap around is okay */
 
-    if (m_next_led_params_set)
+    for (i = 0; i < RGB_LED_SEGMENTS_COUNT_MAX; i++)
     {
-        /* We need to load a new requested pattern, set current state as requested */
-        m_next_led_params_set = false;
-        m_curr_led_params = m_next_led_params;
-        m_led_breathe_sequence_curr_idx = 0U;
-        m_breathe_delay_state = false;
+        rgb_led_segment_t * p_segment = &m_segments[i];
+
+        if (!segment_params_load(p_segment))
+        {
+            rgb_led_state_step(&p_segment->state, m_timer_ms, RGB_LED_REFRESH_PERIOD_MS);
+        }
+
+        if (p_segment->pixels_count != 0U)
+        {
+            animating |= rgb_led_state_is_animating(&p_segment->state);
+            if (i != 0U)
+            {
+                p_whole_chain = NULL;
+            }
+        }
+    }
+
+    if ((p_whole_chain != NULL) &&
+        (p_whole_chain->first_pixel == 0U) &&
+        (p_whole_chain->pixels_count == m_frame_pixels_count) &&
+        (!rgb_led_effect_is_frame_mode(p_whole_chain->state.curr_led_params.mode)))
+    {
+        /* Single color of the whole chain, let the backend apply it in the most efficient way */
+        rgb_led_backend_set_color(rgb_led_state_color_get(&p_whole_chain->state));
     }
     else
     {
-        /* State transitions */
-        switch (m_curr_led_params.mode)
+        /* All segments are composed into one frame, refreshed at once */
+        memset(m_frame, 0, sizeof(m_frame));
+        for (i = 0; i < RGB_LED_SEGMENTS_COUNT_MAX; i++)
         {
-            case LED_MODE_BREATHING:
-                if (!m_breathe_delay_state)
-                {
-                    /* Generating breathe sequence */
-                    m_led_breathe_sequence_curr_idx = breathe_sequence_idx_next(m_led_breathe_sequence_curr_idx);
-                    if ((m_led_breathe_sequence_curr_idx == 0U) && (m_curr_led_params.delay >= RGB_LED_REFRESH_PERIOD_MS))
-                    {
-                        /* Just about to start a new breathe sequence, but need to wait a delay given by m_curr_led_params.delay */
-                        m_breathe_delay_state = true;
-                        m_breathe_delay_start_timestamp = m_timer_ms;
-                    }
-                }
-                else if ( (uint32_t)(m_timer_ms - m_breathe_delay_start_timestamp) >= m_curr_led_params.delay)
-                {
-                    /* Delay after previous breathe sequence has just finished */
-                    m_breathe_delay_state = false;
-                    m_led_breathe_sequence_curr_idx = breathe_sequence_idx_next(m_led_breathe_sequence_curr_idx);
-                }
-                else
-                {
-                    /* Still in delay between breathes */
-                }
-                break;
-
-            case LED_MODE_ONE_SHOT:
-                m_led_breathe_sequence_curr_idx = breathe_sequence_idx_next(m_led_breathe_sequence_curr_idx);
-                if (m_led_breathe_sequence_curr_idx == 0U)
-                {
-                    /* Breathe sequence has just finished */
-                    m_curr_led_params.mode = LED_MODE_OFF;
-                }
-                break;
-
-            default:
-                /* No transitions required */
-                break;
+            rgb_led_state_render(&m_segments[i].state,
+                                 m_timer_ms,
+                                 &m_frame[m_segments[i].first_pixel],
+                                 m_segments[i].pixels_count);
         }
+        rgb_led_backend_set_frame(m_frame, m_frame_pixels_count);
     }
 
-    rgb_led_backend_set_color(get_current_state_color());
+    /* Nothing changes until next rgb_led_segment_update if there is no animation, timer stays stopped then */
+    if (animating)
+    {
+        UNUSED_RETURN_VALUE(nrf_atomic_flag_set(&m_refresh_scheduled));
+        refresh_schedule(APP_TIMER_TICKS(RGB_LED_REFRESH_PERIOD_MS));
+    }
+
+    APP_PROFILER_STAGE_END(APP_PROFILER_STAGE_LED_REFRESH);
 }
 
 void rgb_led_update(const led_params_t * p_led_params)
+{
+    rgb_led_segment_update(0U, p_led_params);
+}
+
+void rgb_led_segment_update(size_t segment_no, const led_params_t * p_led_params)
+{
+    rgb_led_segment_t * p_segment;
+    uint32_t            seq;
+
+    if (segment_no >= RGB_LED_SEGMENTS_COUNT_MAX)
+    {
+        APP_ERROR_CHECK(NRF_ERROR_INVALID_PARAM);
+        return;
+    }
+    p_segment = &m_segments[segment_no];
+
+    /* Writing side of the sequence lock, see segment_params_load. Radio interrupts are never blocked here. */
+    seq = p_segment->next_led_params_seq;
+    p_segment->next_led_params_seq = seq + 1U;
+    __DMB();
+    p_segment->next_led_params = *p_led_params;
+    __DMB();
+    p_segment->next_led_params_seq = seq + 2U;
+
+    /* If timer is stopped, new parameters are applied as soon as possible. Otherwise they are applied on next refresh. */
+    refresh_request();
+}
+
+ret_code_t rgb_led_segment_config(size_t segment_no, size_t first_pixel, size_t pixels_count)
 {
     uint8_t cr_nested;
 
+    if ((segment_no >= RGB_LED_SEGMENTS_COUNT_MAX) ||
+        (first_pixel > m_frame_pixels_count) ||
+        (pixels_count > (m_frame_pixels_count - first_pixel)))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
     app_util_critical_region_enter(&cr_nested);
-    m_next_led_params = *p_led_params;
-    m_next_led_params_set = true;
+    m_segments[segment_no].first_pixel  = first_pixel;
+    m_segments[segment_no].pixels_count = pixels_count;
     app_util_critical_region_exit(cr_nested);
+
+    /* Pixels not covered by the segment anymore have to be switched off */
+    refresh_request();
+
+    return NRF_SUCCESS;
+}
+
+size_t rgb_led_pixels_count_get(void)
+{
+    return m_frame_pixels_count;
+}
+
+uint32_t rgb_led_wakeup_count_get(void)
+{
+    return m_wakeup_count;
 }
 
 void rgb_led_init(void)
 {
     ret_code_t ret_code;
+    size_t     i;
 
     rgb_led_backend_init();
 
-    m_next_led_params.mode = LED_MODE_OFF;
-    m_curr_led_params = m_next_led_params;
-    m_next_led_params_set = false;
+    m_frame_pixels_count = MIN(rgb_led_backend_pixels_count_get(), RGB_LED_PIXELS_COUNT_MAX);
 
-    ret_code = app_timer_create(&m_led_refresh_timer, APP_TIMER_MODE_REPEATED, led_refresh_timer_callback);
-    APP_ERROR_CHECK(ret_code);
+    memset(m_segments, 0, sizeof(m_segments));
+    for (i = 0; i < RGB_LED_SEGMENTS_COUNT_MAX; i++)
+    {
+        rgb_led_state_init(&m_segments[i].state);
+    }
+    /* Until configured otherwise, the first segment covers the whole chain */
+    m_segments[0].pixels_count = m_frame_pixels_count;
+    UNUSED_RETURN_VALUE(nrf_atomic_flag_clear(&m_refresh_scheduled));
 
-    ret_code = app_timer_start(m_led_refresh_timer, APP_TIMER_TICKS(RGB_LED_REFRESH_PERIOD_MS), NULL);
+    /* Timer is started only when there is something to be refreshed */
+    ret_code = app_timer_create(&m_led_refresh_timer, APP_TIMER_MODE_SINGLE_SHOT, led_refresh_timer_callback);
     APP_ERROR_CHECK(ret_code);
 }
 
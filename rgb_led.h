@@ -48,8 +48,10 @@
 #define RGB_LED_H__
 
 #include <stdint.h>
+#include <stddef.h>
 
 #include "app_util_platform.h"
+#include "sdk_errors.h"
 
 #ifdef __CC_ARM
 #pragma anon_unions
@@ -61,13 +63,33 @@ typedef enum led_mode_e
     LED_MODE_OFF       = 0,
     LED_MODE_CONSTANT  = 1,
     LED_MODE_BREATHING = 2,
-    LED_MODE_ONE_SHOT  = 3
+    LED_MODE_ONE_SHOT  = 3,
+    LED_MODE_GRADIENT  = 4,
+    LED_MODE_CHASE     = 5,
+    LED_MODE_RAINBOW   = 6,
+    LED_MODE_TWINKLE   = 7,
+    LED_MODE_HSB       = 8
 } led_mode_t;
 
+/**@def RGB_LED_SEGMENTS_COUNT_MAX
+ * @brief Maximum number of independently controlled segments of the led chain
+ */
+#ifndef RGB_LED_SEGMENTS_COUNT_MAX
+#define RGB_LED_SEGMENTS_COUNT_MAX      3U
+#endif
+
 #define LED_PARAMS_COLOR_MASK_RED       0x01U
 #define LED_PARAMS_COLOR_MASK_GREEN     0x02U
 #define LED_PARAMS_COLOR_MASK_BLUE      0x04U
 
+#define LED_PARAMS_HUE_DIRECTION_SHORTEST   0x00U   /**< Hue transition along the shortest distance. */
+#define LED_PARAMS_HUE_DIRECTION_LONGEST    0x01U   /**< Hue transition along the longest distance. */
+#define LED_PARAMS_HUE_DIRECTION_UP         0x02U   /**< Hue transition with increasing hue. */
+#define LED_PARAMS_HUE_DIRECTION_DOWN       0x03U   /**< Hue transition with decreasing hue. */
+
+#define LED_PARAMS_COLOR_LOOP_DIRECTION_DOWN    0x00U   /**< Color loop with decreasing hue. */
+#define LED_PARAMS_COLOR_LOOP_DIRECTION_UP      0x01U   /**< Color loop with increasing hue. */
+
 /** @brief Structure for storing LED configuration */
 typedef PACKED_STRUCT led_params_s
 {
@@ -78,6 +100,24 @@ typedef PACKED_STRUCT led_params_s
      * When this field is set to @ref LED_MODE_ONE_SHOT, behavior and required fields are identical to those used with @c mode set to
      * @ref LED_MODE_BREATHING, but only one cycle of breathing effect will be executed, and then the led will switch to mode
      * @ref LED_MODE_OFF automatically.
+     * When this field is set to one of per-pixel effect modes, fields @c r, @c g, @c b, @c r2, @c g2, @c b2, @c period
+     * and @c param specify the effect:
+     * - @ref LED_MODE_GRADIENT: gradient from (@c r, @c g, @c b) to (@c r2, @c g2, @c b2) along the chain, scrolled
+     *   once per @c period (static if @c period is 0).
+     * - @ref LED_MODE_CHASE: pixel of (@c r, @c g, @c b) with a tail of @c param pixels running over
+     *   (@c r2, @c g2, @c b2) background, once around the chain per @c period.
+     * - @ref LED_MODE_RAINBOW: color wheel spread along the chain, rotated once per @c period,
+     *   with brightness given by @c param.
+     * - @ref LED_MODE_TWINKLE: pixels flashing (@c r, @c g, @c b) over (@c r2, @c g2, @c b2) background roughly once
+     *   per @c period, each pixel lit for @c param / 256 of the time.
+     * When this field is set to @ref LED_MODE_HSB, fields @c hue, @c saturation, @c level specify the color. Each of them
+     * changes smoothly from the currently displayed value over its transition time. A channel keeps its ongoing
+     * transition as long as its target value does not change. When @c color_loop_time is not 0, hue goes around
+     * the color wheel continuously instead, starting from @c hue at the moment the color loop is activated. Once it is
+     * deactivated, hue changes from the last value of the loop to @c hue over its transition time. When
+     * @c color_temperature is not 0, white of that temperature is displayed instead of @c hue and @c saturation, and
+     * the color loop is paused. Color temperature changes smoothly as well, but switching between color temperature
+     * and hue with saturation is immediate.
      */
     led_mode_t mode;
 
@@ -88,6 +128,11 @@ typedef PACKED_STRUCT led_params_s
             uint8_t  r;         /**< Red color value. */
             uint8_t  g;         /**< Green color value. */
             uint8_t  b;         /**< Blue color value. */
+            uint8_t  r2;        /**< Red color value of the second color used by per-pixel effects. */
+            uint8_t  g2;        /**< Green color value of the second color used by per-pixel effects. */
+            uint8_t  b2;        /**< Blue color value of the second color used by per-pixel effects. */
+            uint16_t period;    /**< Period of per-pixel effect in milliseconds. */
+            uint8_t  param;     /**< Effect specific parameter, see @ref led_params_s::mode. */
         };
         PACKED_STRUCT
         {
@@ -108,6 +153,20 @@ typedef PACKED_STRUCT led_params_s
              * Value of the time is in milliseconds and specifies time between breathe blinks. */
             uint16_t delay;
         };
+        PACKED_STRUCT
+        {
+            uint8_t  hue;                           /**< Hue, from range [0, 254] covering the whole color wheel. */
+            uint8_t  saturation;                    /**< Saturation, from range [0, 254]. */
+            uint8_t  level;                         /**< Brightness, from range [0, 255]. */
+            uint8_t  hue_direction;                 /**< Direction of hue transition, one of LED_PARAMS_HUE_DIRECTION_*. */
+            uint16_t hue_transition_time;           /**< Time of hue transition, in tenths of a second. */
+            uint16_t saturation_transition_time;    /**< Time of saturation transition, in tenths of a second. */
+            uint16_t level_transition_time;         /**< Time of level transition, in tenths of a second. */
+            uint16_t color_loop_time;               /**< Time of one color loop, in seconds, 0 if the loop is not active. */
+            uint8_t  color_loop_direction;          /**< Direction of color loop, one of LED_PARAMS_COLOR_LOOP_DIRECTION_*. */
+            uint16_t color_temperature;             /**< Color temperature in mireds, 0 if color is given by hue and saturation. */
+            uint16_t color_temperature_transition_time; /**< Time of color temperature transition, in tenths of a second. */
+        };
     };
 } led_params_t;
 
@@ -119,11 +178,53 @@ void rgb_led_init(void);
 
 /**@brief Function for updating LED state/behavior.
  * This function just sets requested led state/behavior. Update of visible led state is performed internally and may be delayed.
+ * Equivalent to @ref rgb_led_segment_update called for segment 0, which covers the whole chain unless configured otherwise.
  *
  * @param[in] p_led_params  A pointer to LED parameters. Must not be NULL.
  */
 void rgb_led_update(const led_params_t * p_led_params);
 
+/**@brief Function for updating state/behavior of one segment of the led chain.
+ * Per-pixel effects are rendered within the segment, as if it was a separate chain. All segments are refreshed
+ * together.
+ *
+ * @note Interrupts are not disabled. The function may be interrupted by the refresh, but it must not be called for
+ *       the same segment from contexts preempting each other.
+ *
+ * @param[in] segment_no    Index of the segment, lower than @ref RGB_LED_SEGMENTS_COUNT_MAX.
+ * @param[in] p_led_params  A pointer to LED parameters. Must not be NULL.
+ */
+void rgb_led_segment_update(size_t segment_no, const led_params_t * p_led_params);
+
+/**@brief Function for assigning a range of pixels to a segment.
+ *
+ * After @ref rgb_led_init, segment 0 covers the whole chain and other segments are empty. Pixels not covered by any
+ * segment are switched off. If segments overlap, the one with the higher index is displayed.
+ *
+ * @param[in] segment_no    Index of the segment, lower than @ref RGB_LED_SEGMENTS_COUNT_MAX.
+ * @param[in] first_pixel   Index of the first pixel of the segment.
+ * @param[in] pixels_count  Number of pixels of the segment, 0 to leave the segment unused.
+ *
+ * @retval NRF_SUCCESS              Segment configured.
+ * @retval NRF_ERROR_INVALID_PARAM  Invalid segment number or the range exceeds @ref rgb_led_pixels_count_get.
+ */
+ret_code_t rgb_led_segment_config(size_t segment_no, size_t first_pixel, size_t pixels_count);
+
+/**@brief Function for getting number of pixels which can be assigned to segments.
+ *
+ * @return Number of pixels of the led chain.
+ */
+size_t rgb_led_pixels_count_get(void);
+
+/**@brief Function for getting number of refresh timer wakeups.
+ *
+ * The refresh timer runs only while an animation or a transition is in progress, so the counter does not
+ * increase while the LED shows a constant color.
+ *
+ * @return Number of refresh timer expirations since initialization.
+ */
+uint32_t rgb_led_wakeup_count_get(void);
+
 #endif
 
 /**
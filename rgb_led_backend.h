@@ -48,6 +48,7 @@
 #define RGB_LED_BACKEND_H__
 
 #include <stdint.h>
+#include <stddef.h>
 
 
 /**@brief Function for initialization of the selected LED driver module.
@@ -61,6 +62,19 @@ void rgb_led_backend_init(void);
  */
 void rgb_led_backend_set_color(uint32_t color);
 
+/**@brief Function for getting number of individually controlled pixels.
+ *
+ * @return Number of pixels driven by the backend.
+ */
+size_t rgb_led_backend_pixels_count_get(void);
+
+/**@brief Function for setting color of each pixel.
+ *
+ * @param[in] p_frame       Colors of consecutive pixels, in the format described for @ref rgb_led_backend_set_color.
+ * @param[in] pixels_count  Number of colors in @p p_frame. Pixels beyond this number are switched off.
+ */
+void rgb_led_backend_set_frame(const uint32_t * p_frame, size_t pixels_count);
+
 #endif /* RGB_LED_BACKEND_H__ */
 
 /**
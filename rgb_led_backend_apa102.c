@@ -0,0 +1,234 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @defgroup zigbee_examples_ble_zigbee_color_light_bulb_thingy rgb_led_backend_apa102.c
+ * @{
+ * @ingroup zigbee_examples
+ */
+#include "sdk_config.h"
+#include "rgb_led_backend.h"
+#include "app_util_platform.h"
+#include "boards.h"
+#include "drv_apa102.h"
+#include "rgb_led_gamma.h"
+#include "app_timer.h"
+
+/**@def LED_CHAIN_CLK_PIN
+ * @brief GPIO pin used as clock (to be connected to CI pin of the first apa102 led in chain) */
+/**@def LED_CHAIN_DATA_PIN
+ * @brief GPIO pin used as data (to be connected to DI pin of the first apa102 led in chain) */
+#ifndef LED_CHAIN_CLK_PIN
+#if defined(BOARD_PCA10056)
+#define LED_CHAIN_CLK_PIN               NRF_GPIO_PIN_MAP(1,8)
+#define LED_CHAIN_DATA_PIN              NRF_GPIO_PIN_MAP(1,7)
+#elif defined(BOARD_PCA10059)
+#define LED_CHAIN_CLK_PIN               NRF_GPIO_PIN_MAP(0,31)
+#define LED_CHAIN_DATA_PIN              NRF_GPIO_PIN_MAP(0,29)
+#elif defined(BOARD_PCA10100)
+#define LED_CHAIN_CLK_PIN               NRF_GPIO_PIN_MAP(1,8)
+#define LED_CHAIN_DATA_PIN              NRF_GPIO_PIN_MAP(1,7)
+#else
+#error Unsupported board type
+#endif
+#endif
+
+/**@def RGB_LED_BACKEND_APA102_GLOBAL_BRIGHTNESS_ENABLED
+ * @brief Enables use of the 5-bit global brightness of every pixel, which gives up to 5 more bits
+ *        of resolution of dim colors. SK9822 scales the LED current, APA102 adds a slow PWM to it */
+#ifndef RGB_LED_BACKEND_APA102_GLOBAL_BRIGHTNESS_ENABLED
+#define RGB_LED_BACKEND_APA102_GLOBAL_BRIGHTNESS_ENABLED    1
+#endif
+
+/**@def RGB_LED_BACKEND_APA102_KEEPALIVE_PERIOD_MS
+ * @brief Period of refreshing led chain while colors do not change, so device is robust to hot plug of led chain.
+ *        0 disables the keepalive refresh */
+#ifndef RGB_LED_BACKEND_APA102_KEEPALIVE_PERIOD_MS
+#define RGB_LED_BACKEND_APA102_KEEPALIVE_PERIOD_MS          1000
+#endif
+
+/* Light intensity of a step of 8-bit color component at full global brightness */
+#define APA102_COMPONENT_SCALE      (RGB_LED_GAMMA_OUTPUT_MAX / UINT8_MAX)
+
+APP_TIMER_DEF(m_keepalive_timer);
+
+/**@brief Function for restarting keepalive timer, so the led chain is refreshed a period after the last frame. */
+static void keepalive_schedule(void)
+{
+#if (RGB_LED_BACKEND_APA102_KEEPALIVE_PERIOD_MS != 0)
+    ret_code_t ret_code;
+
+    ret_code = app_timer_stop(m_keepalive_timer);
+    APP_ERROR_CHECK(ret_code);
+
+    ret_code = app_timer_start(m_keepalive_timer, APP_TIMER_TICKS(RGB_LED_BACKEND_APA102_KEEPALIVE_PERIOD_MS), NULL);
+    APP_ERROR_CHECK(ret_code);
+#endif
+}
+
+/**@brief Function for displaying pixels set in driver.
+ *
+ * If led chain is busy, the driver sends the frame as soon as the current transfer finishes.
+ */
+static void chain_display(void)
+{
+    UNUSED_RETURN_VALUE(drv_apa102_display(NULL, NULL));
+    keepalive_schedule();
+}
+
+static void keepalive_timer_callback(void * p_context)
+{
+    UNUSED_PARAMETER(p_context);
+
+    /* LED state buffer is sent as it is, so the keepalive refresh costs no CPU time */
+    chain_display();
+}
+
+/**@brief Function for scaling 16-bit light intensity to 8 bits at given global brightness.
+ *
+ * @param[in] intensity     Light intensity, from range [0, @ref RGB_LED_GAMMA_OUTPUT_MAX].
+ * @param[in] brightness    Global brightness, from range [1, @ref DRV_APA102_BRIGHTNESS_MAX].
+ *
+ * @return Light intensity from range [0, 255].
+ */
+static uint32_t intensity_scale(uint16_t intensity, uint32_t brightness)
+{
+    uint32_t divisor = brightness * APA102_COMPONENT_SCALE;
+    uint32_t value   = (((uint32_t)intensity * DRV_APA102_BRIGHTNESS_MAX) + (divisor / 2U)) / divisor;
+
+    return (value > UINT8_MAX) ? UINT8_MAX : value;
+}
+
+/**@brief Function for applying brightness curve to RGB color.
+ *
+ * @param[in]  color        Color in the format described for @ref rgb_led_backend_set_color.
+ * @param[out] p_brightness Global brightness to be displayed with the returned color.
+ *
+ * @return Color with 8-bit light intensity of each channel, as expected by apa102 leds.
+ */
+static uint32_t color_correct(uint32_t color, uint8_t * p_brightness)
+{
+    uint16_t intensity[RGB_LED_GAMMA_CHANNELS_COUNT];
+    uint32_t brightness = DRV_APA102_BRIGHTNESS_MAX;
+    uint32_t r;
+    uint32_t g;
+    uint32_t b;
+
+    rgb_led_gamma_rgb_get(color, intensity);
+
+#if RGB_LED_BACKEND_APA102_GLOBAL_BRIGHTNESS_ENABLED
+    uint32_t intensity_max = MAX(intensity[RGB_LED_GAMMA_CHANNEL_RED],
+                                 MAX(intensity[RGB_LED_GAMMA_CHANNEL_GREEN], intensity[RGB_LED_GAMMA_CHANNEL_BLUE]));
+
+    /* The lowest global brightness, at which the brightest component still fits in 8 bits */
+    brightness = ((intensity_max * DRV_APA102_BRIGHTNESS_MAX) + RGB_LED_GAMMA_OUTPUT_MAX - 1U) / RGB_LED_GAMMA_OUTPUT_MAX;
+    if (brightness == 0U)
+    {
+        brightness = 1U;
+    }
+#endif
+
+    r = intensity_scale(intensity[RGB_LED_GAMMA_CHANNEL_RED],   brightness);
+    g = intensity_scale(intensity[RGB_LED_GAMMA_CHANNEL_GREEN], brightness);
+    b = intensity_scale(intensity[RGB_LED_GAMMA_CHANNEL_BLUE],  brightness);
+
+    *p_brightness = (uint8_t)brightness;
+
+    return (r << 16) | (g << 8) | b;
+}
+
+static uint32_t m_current_color;
+/* False when pixels have been set individually, so the chain does not show m_current_color */
+static bool     m_current_color_valid;
+
+void rgb_led_backend_set_color(uint32_t color)
+{
+    if ((!m_current_color_valid) || (color != m_current_color))
+    {
+        uint8_t  brightness;
+        uint32_t corrected = color_correct(color, &brightness);
+
+        drv_apa102_set_pixel_all(corrected, brightness);
+        chain_display();
+        m_current_color       = color;
+        m_current_color_valid = true;
+    }
+}
+
+size_t rgb_led_backend_pixels_count_get(void)
+{
+    return DRV_APA102_LED_CHAIN_PIXELS_COUNT_MAX;
+}
+
+void rgb_led_backend_set_frame(const uint32_t * p_frame, size_t pixels_count)
+{
+    uint32_t pixel_no;
+
+    for (pixel_no = 0U; pixel_no < DRV_APA102_LED_CHAIN_PIXELS_COUNT_MAX; pixel_no++)
+    {
+        uint8_t  brightness;
+        uint32_t corrected = color_correct((pixel_no < pixels_count) ? p_frame[pixel_no] : 0U, &brightness);
+
+        drv_apa102_set_pixel(pixel_no, corrected, brightness);
+    }
+    m_current_color_valid = false;
+
+    /* If the chain is still busy, the frame is sent when it finishes */
+    chain_display();
+}
+
+void rgb_led_backend_init(void)
+{
+    ret_code_t ret_code;
+
+    ret_code = drv_apa102_init(LED_CHAIN_CLK_PIN, LED_CHAIN_DATA_PIN);
+    APP_ERROR_CHECK(ret_code);
+
+    ret_code = app_timer_create(&m_keepalive_timer, APP_TIMER_MODE_SINGLE_SHOT, keepalive_timer_callback);
+    APP_ERROR_CHECK(ret_code);
+
+    m_current_color       = 0U;
+    m_current_color_valid = false;
+    rgb_led_backend_set_color(0U);
+}
+
+/**
+ * @}
+ */
@@ -44,9 +44,12 @@
  * @ingroup zigbee_examples
  */
 #include <stdint.h>
+#include <string.h>
 
 #include "sdk_config.h"
 #include "rgb_led_backend.h"
+#include "app_util_platform.h"
+#include "rgb_led_gamma.h"
 #include "nrf_gpio.h"
 #include "nrf_drv_pwm.h"
 
@@ -54,8 +57,22 @@
 #error Unsupported board type
 #endif
 
-#define RGB_LED_PWM_VALUE_MAX      1024                     /**< PWM counter maximum value. */
-#define RGB_LED_PWM_VALUE_MIN      35                       /**< Minimal PWM counter value, which lights up the LED. */
+/**@def RGB_LED_BACKEND_PWM_HIGH_RESOLUTION_ENABLED
+ * @brief Enables PWM of 7.8 kHz, which is not visible on camera. Duty cycle is dithered over a sequence
+ *        of periods, which gives 16-bit resolution and dimming below the minimal pulse width. */
+#ifndef RGB_LED_BACKEND_PWM_HIGH_RESOLUTION_ENABLED
+#define RGB_LED_BACKEND_PWM_HIGH_RESOLUTION_ENABLED 0
+#endif
+
+#if RGB_LED_BACKEND_PWM_HIGH_RESOLUTION_ENABLED
+#define RGB_LED_PWM_VALUE_MAX      2048                     /**< PWM counter maximum value, 11-bit resolution at 16 MHz (7.8 kHz). */
+#define RGB_LED_PWM_DITHER_STEPS   32U                      /**< Number of PWM periods of a sequence, over which duty cycle is dithered. */
+#define RGB_LED_PWM_TOTAL_MAX      (RGB_LED_PWM_VALUE_MAX * RGB_LED_PWM_DITHER_STEPS) /**< Light output of full intensity, in PWM counts per sequence. */
+#else
+#define RGB_LED_PWM_VALUE_MAX      16384                    /**< PWM counter maximum value, 14-bit resolution at 16 MHz (976 Hz). */
+#endif
+#define RGB_LED_PWM_VALUE_MIN      560                      /**< Minimal PWM counter value, which lights up the LED (35 us). */
+#define RGB_LED_PWM_CHANNELS_COUNT 4U                       /**< Number of PWM channels, ordered as in rgb_led_backend_init. */
 
 #ifndef RGB_LED_BACKEND_PWM_R_PIN
 #define RGB_LED_BACKEND_PWM_R_PIN  NRF_GPIO_PIN_MAP(1,12)   /**< Pin number of red LED of the RGB tape. */
@@ -70,20 +87,182 @@
 #endif
 
 #ifndef RGB_LED_BACKEND_PWM_W_PIN
-#define RGB_LED_BACKEND_PWM_W_PIN  NRF_DRV_PWM_PIN_NOT_USED /**< Pin number of white LED of the RGBW tape (unused). */
+#define RGB_LED_BACKEND_PWM_W_PIN  NRF_DRV_PWM_PIN_NOT_USED /**< Pin number of white LED of the RGBW tape, unused for RGB tape. */
 #endif
 
-
-/**@brief Union that allows to access color representation as byte array. */
-typedef union
-{
-    uint32_t   combined;  /**< RGB LED color stored as a concatenated (w|r|g|b) color bytes. */
-    uint8_t    color[4];  /**< RGB LED color stored as a separate channels. */
-} rgb_bulb_color_t;
+/* White part of colors is displayed by the white LED only if it is connected */
+#define RGB_LED_PWM_WHITE_ENABLED  (RGB_LED_BACKEND_PWM_W_PIN != NRF_DRV_PWM_PIN_NOT_USED)
 
 
 /* Declare app PWM instance for controlling LED tape. */
 static nrf_drv_pwm_t               m_led_pwm = RGB_LED_BACKEND_PWM_INSTANCE;
+
+#if RGB_LED_BACKEND_PWM_HIGH_RESOLUTION_ENABLED
+
+/* Any total between RGB_LED_PWM_VALUE_MIN and RGB_LED_PWM_TOTAL_MAX must be split into pulses of allowed width */
+STATIC_ASSERT((2 * RGB_LED_PWM_VALUE_MIN) <= RGB_LED_PWM_VALUE_MAX);
+
+/* Sequences are played alternately in a loop. Buffer of a sequence is refilled when the sequence ends,
+ * so new colors are applied at a period boundary and a sequence is never changed while being played.
+ */
+static nrf_pwm_values_individual_t m_led_values[2][RGB_LED_PWM_DITHER_STEPS];
+
+static const nrf_pwm_sequence_t m_led_seq[2] =
+{
+    {
+        .values.p_individual = m_led_values[0],
+        .length              = RGB_LED_PWM_DITHER_STEPS * RGB_LED_PWM_CHANNELS_COUNT,
+        .repeats             = 0,
+        .end_delay           = 0
+    },
+    {
+        .values.p_individual = m_led_values[1],
+        .length              = RGB_LED_PWM_DITHER_STEPS * RGB_LED_PWM_CHANNELS_COUNT,
+        .repeats             = 0,
+        .end_delay           = 0
+    }
+};
+
+/* Light output of every channel, in PWM counts per sequence */
+static uint32_t m_led_totals[RGB_LED_PWM_CHANNELS_COUNT];
+/* Incremented on every change of m_led_totals, buffers filled for an older generation are refilled */
+static uint32_t m_led_generation;
+static uint32_t m_led_buffer_generation[2];
+/* True while SEQEND interrupts are enabled */
+static volatile bool m_led_refill_active;
+
+/**@brief Function for converting light intensity to PWM counts per sequence.
+ *
+ * @param[in]  intensity   Corrected light intensity, as returned by @ref rgb_led_gamma_get.
+ *
+ * @returns  Sum of PWM counter values of all periods of a sequence.
+ **/
+static uint32_t intensity_to_total(uint32_t intensity)
+{
+    if (intensity == 0)
+    {
+        return 0;
+    }
+
+    /* Lowest intensity gives one pulse of minimal width per sequence */
+    return RGB_LED_PWM_VALUE_MIN +
+           (intensity * (RGB_LED_PWM_TOTAL_MAX - RGB_LED_PWM_VALUE_MIN)) / RGB_LED_GAMMA_OUTPUT_MAX;
+}
+
+/**@brief Function for filling PWM values of one channel of a sequence.
+ *
+ * The total is split into as many pulses as possible, each at least @ref RGB_LED_PWM_VALUE_MIN wide.
+ * Pulses and their widths are spread evenly over the sequence, as by a first-order sigma-delta modulator,
+ * so the sum of the sequence is exact and the dithering noise is kept at high frequencies.
+ *
+ * @param[out] p_dst    Value of the channel in the first period, next periods follow every
+ *                      @ref RGB_LED_PWM_CHANNELS_COUNT values.
+ * @param[in]  total    Light output, from range [@ref RGB_LED_PWM_VALUE_MIN, @ref RGB_LED_PWM_TOTAL_MAX], or 0.
+ */
+static void channel_dither(uint16_t * p_dst, uint32_t total)
+{
+    uint32_t pulses = MIN(total / RGB_LED_PWM_VALUE_MIN, RGB_LED_PWM_DITHER_STEPS);
+    uint32_t pulse  = 0;
+    uint32_t step;
+
+    for (step = 0; step < RGB_LED_PWM_DITHER_STEPS; step++)
+    {
+        uint32_t width = 0;
+
+        if ((((step + 1) * pulses) / RGB_LED_PWM_DITHER_STEPS) > ((step * pulses) / RGB_LED_PWM_DITHER_STEPS))
+        {
+            width = (((pulse + 1) * total) / pulses) - ((pulse * total) / pulses);
+            pulse++;
+        }
+
+        p_dst[step * RGB_LED_PWM_CHANNELS_COUNT] = (uint16_t)(RGB_LED_PWM_VALUE_MAX - width);
+    }
+}
+
+/**@brief Function for filling the buffer of a sequence with the current light output.
+ *
+ * @param[in]  buffer_no   Number of the sequence, which must not be played.
+ */
+static void led_buffer_fill(uint32_t buffer_no)
+{
+    uint16_t * p_values = (uint16_t *)m_led_values[buffer_no];
+    uint32_t   channel;
+
+    for (channel = 0; channel < RGB_LED_PWM_CHANNELS_COUNT; channel++)
+    {
+        channel_dither(&p_values[channel], m_led_totals[channel]);
+    }
+    m_led_buffer_generation[buffer_no] = m_led_generation;
+}
+
+static void led_pwm_handler(nrf_drv_pwm_evt_type_t event_type)
+{
+    uint32_t buffer_no;
+
+    if (event_type == NRF_DRV_PWM_EVT_END_SEQ0)
+    {
+        buffer_no = 0;
+    }
+    else if (event_type == NRF_DRV_PWM_EVT_END_SEQ1)
+    {
+        buffer_no = 1;
+    }
+    else
+    {
+        return;
+    }
+
+    /* Sequence has just ended, its buffer is not read until the other sequence ends */
+    if (m_led_buffer_generation[buffer_no] != m_led_generation)
+    {
+        led_buffer_fill(buffer_no);
+    }
+
+    if ((m_led_buffer_generation[0] == m_led_generation) && (m_led_buffer_generation[1] == m_led_generation))
+    {
+        /* Both sequences play current colors, CPU does not need to be woken up anymore */
+        nrf_pwm_int_disable(m_led_pwm.p_registers, NRF_PWM_INT_SEQEND0_MASK | NRF_PWM_INT_SEQEND1_MASK);
+        m_led_refill_active = false;
+    }
+}
+
+void rgb_led_backend_set_color(uint32_t color)
+{
+    uint32_t totals[RGB_LED_PWM_CHANNELS_COUNT];
+    uint16_t intensity[RGB_LED_GAMMA_CHANNELS_COUNT];
+
+#if RGB_LED_PWM_WHITE_ENABLED
+    rgb_led_gamma_rgbw_get(color, intensity);
+#else
+    rgb_led_gamma_rgb_get(color, intensity);
+#endif
+
+    /* Channels are ordered as in rgb_led_backend_init */
+    totals[0] = intensity_to_total(intensity[RGB_LED_GAMMA_CHANNEL_BLUE]);
+    totals[1] = intensity_to_total(intensity[RGB_LED_GAMMA_CHANNEL_GREEN]);
+    totals[2] = intensity_to_total(intensity[RGB_LED_GAMMA_CHANNEL_RED]);
+    totals[3] = intensity_to_total(intensity[RGB_LED_GAMMA_CHANNEL_WHITE]);
+
+    CRITICAL_REGION_ENTER();
+    if (memcmp(m_led_totals, totals, sizeof(m_led_totals)) != 0)
+    {
+        memcpy(m_led_totals, totals, sizeof(m_led_totals));
+        m_led_generation++;
+
+        if (!m_led_refill_active)
+        {
+            /* Events set while the interrupts were disabled are stale, the next one tells which sequence has ended */
+            nrf_pwm_event_clear(m_led_pwm.p_registers, NRF_PWM_EVENT_SEQEND0);
+            nrf_pwm_event_clear(m_led_pwm.p_registers, NRF_PWM_EVENT_SEQEND1);
+            nrf_pwm_int_enable(m_led_pwm.p_registers, NRF_PWM_INT_SEQEND0_MASK | NRF_PWM_INT_SEQEND1_MASK);
+            m_led_refill_active = true;
+        }
+    }
+    CRITICAL_REGION_EXIT();
+}
+
+#else
+
 static nrf_pwm_values_individual_t m_led_values;
 
 static const nrf_pwm_sequence_t m_led_seq =
@@ -94,54 +273,58 @@ static const nrf_pwm_sequence_t m_led_seq =
     .end_delay           = 0
 };
 
-/* LED correction values, in percent, relative to the current brightness level. */
-const uint8_t c_led_color_cal[] = {66, 73, 100, 0};
-
-/* Brightness level to PWM counter matrix. */
-const uint16_t c_led_brightness[32] = {
-    0, 1, 3, 6, 10, 16, 23, 32, 43, 56, 71, 88, 107,
-    129, 154, 181, 210, 242, 277, 315, 356, 400, 447,
-    498, 551, 608, 668, 732, 799, 869, 944, 1023};
-
-
-/**@brief Function for converting single-byte brightness level to PWM counter value.
+/**@brief Function for converting light intensity to PWM counter value.
  *
- * @param[in]  brightness  Brightness level in 0-255 range.
- * @param[in]  correction  Brightness correction value, in percent.
+ * @param[in]  intensity   Corrected light intensity, as returned by @ref rgb_led_gamma_get.
  *
  * @returns  PWM counter value.
  **/
-static uint16_t brightness_to_pwm(uint8_t brightness, uint8_t correction)
+static uint16_t intensity_to_pwm(uint32_t intensity)
 {
-    uint16_t pwm_signal;
-
-    // Scale available brightness level from (0 - 255) range down to (0 - 31) range.
-    brightness = brightness / 8;
+    uint32_t pwm_signal;
 
-    pwm_signal = RGB_LED_PWM_VALUE_MIN + (c_led_brightness[brightness] * (uint16_t)correction) / 100;
-
-    if (c_led_brightness[brightness] == 0)
+    if (intensity == 0)
     {
         pwm_signal = 0;
     }
-    else if (pwm_signal > RGB_LED_PWM_VALUE_MAX)
+    else
     {
-        pwm_signal = RGB_LED_PWM_VALUE_MAX;
+        pwm_signal = RGB_LED_PWM_VALUE_MIN +
+                     (intensity * (RGB_LED_PWM_VALUE_MAX - RGB_LED_PWM_VALUE_MIN)) / RGB_LED_GAMMA_OUTPUT_MAX;
     }
 
-    return RGB_LED_PWM_VALUE_MAX - pwm_signal;
+    return (uint16_t)(RGB_LED_PWM_VALUE_MAX - pwm_signal);
 }
 
 void rgb_led_backend_set_color(uint32_t color)
 {
-    uint16_t         * p_channels = (uint16_t *)&m_led_values;
-    rgb_bulb_color_t   displayed_color;
+    uint16_t * p_channels = (uint16_t *)&m_led_values;
+    uint16_t   intensity[RGB_LED_GAMMA_CHANNELS_COUNT];
 
-    displayed_color.combined = color;
-    for (uint_fast8_t i = 0; i < 4; i++)
-    {
-        p_channels[i] = brightness_to_pwm(displayed_color.color[i], c_led_color_cal[i]);
-    }
+#if RGB_LED_PWM_WHITE_ENABLED
+    rgb_led_gamma_rgbw_get(color, intensity);
+#else
+    rgb_led_gamma_rgb_get(color, intensity);
+#endif
+
+    /* Channels are ordered as in rgb_led_backend_init */
+    p_channels[0] = intensity_to_pwm(intensity[RGB_LED_GAMMA_CHANNEL_BLUE]);
+    p_channels[1] = intensity_to_pwm(intensity[RGB_LED_GAMMA_CHANNEL_GREEN]);
+    p_channels[2] = intensity_to_pwm(intensity[RGB_LED_GAMMA_CHANNEL_RED]);
+    p_channels[3] = intensity_to_pwm(intensity[RGB_LED_GAMMA_CHANNEL_WHITE]);
+}
+
+#endif /* RGB_LED_BACKEND_PWM_HIGH_RESOLUTION_ENABLED */
+
+size_t rgb_led_backend_pixels_count_get(void)
+{
+    /* Whole LED tape is driven by single set of PWM channels */
+    return 1U;
+}
+
+void rgb_led_backend_set_frame(const uint32_t * p_frame, size_t pixels_count)
+{
+    rgb_led_backend_set_color((pixels_count > 0U) ? p_frame[0] : 0U);
 }
 
 void rgb_led_backend_init(void)
@@ -158,17 +341,37 @@ void rgb_led_backend_init(void)
             RGB_LED_BACKEND_PWM_W_PIN, // channel 3
         },
         .irq_priority = APP_IRQ_PRIORITY_LOWEST,
-        .base_clock   = NRF_PWM_CLK_1MHz,
+        .base_clock   = NRF_PWM_CLK_16MHz,
         .count_mode   = NRF_PWM_MODE_UP,
         .top_value    = RGB_LED_PWM_VALUE_MAX,
         .load_mode    = NRF_PWM_LOAD_INDIVIDUAL,
         .step_mode    = NRF_PWM_STEP_AUTO
     };
 
+#if RGB_LED_BACKEND_PWM_HIGH_RESOLUTION_ENABLED
+    memset(m_led_totals, 0, sizeof(m_led_totals));
+    m_led_generation    = 0;
+    led_buffer_fill(0);
+    led_buffer_fill(1);
+    m_led_refill_active = true;
+
+    /* Initialize PWM in order to control dimmable RGB LED tape. */
+    err_code = nrf_drv_pwm_init(&m_led_pwm, &led_pwm_config, led_pwm_handler);
+    APP_ERROR_CHECK(err_code);
+
+    /* SEQEND interrupts are disabled by the handler, once both sequences play current colors */
+    err_code = nrf_drv_pwm_complex_playback(&m_led_pwm, &m_led_seq[0], &m_led_seq[1], 1,
+                                            NRF_DRV_PWM_FLAG_LOOP             |
+                                            NRF_DRV_PWM_FLAG_SIGNAL_END_SEQ0  |
+                                            NRF_DRV_PWM_FLAG_SIGNAL_END_SEQ1  |
+                                            NRF_DRV_PWM_FLAG_NO_EVT_FINISHED);
+    APP_ERROR_CHECK(err_code);
+#else
     /* Initialize PWM in order to control dimmable RGB LED tape. */
     err_code = nrf_drv_pwm_init(&m_led_pwm, &led_pwm_config, NULL);
     APP_ERROR_CHECK(err_code);
 
     err_code = nrf_drv_pwm_simple_playback(&m_led_pwm, &m_led_seq, 1, NRF_DRV_PWM_FLAG_LOOP);
     APP_ERROR_CHECK(err_code);
+#endif
 }
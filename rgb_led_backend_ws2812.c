@@ -43,11 +43,15 @@
  * @{
  * @ingroup zigbee_examples
  */
+#include <string.h>
+
 #include "sdk_config.h"
 #include "rgb_led_backend.h"
 #include "app_util_platform.h"
 #include "boards.h"
 #include "drv_ws2812.h"
+#include "rgb_led_gamma.h"
+#include "app_timer.h"
 
 /**@def LED_CHAIN_DOUT_PIN
  * @brief GPIO pin used as DOUT (to be connected to DIN pin of the first ws2812 led in chain) */
@@ -63,43 +67,350 @@
 #endif
 #endif
 
-static uint32_t m_current_color;
+/**@def RGB_LED_BACKEND_WS2812_DITHERING_ENABLED
+ * @brief Enables temporal dithering, which gives more than 8-bit resolution of dim colors */
+#ifndef RGB_LED_BACKEND_WS2812_DITHERING_ENABLED
+#define RGB_LED_BACKEND_WS2812_DITHERING_ENABLED    0
+#endif
 
-void rgb_led_backend_set_color(uint32_t color)
+/**@def RGB_LED_BACKEND_WS2812_DITHERING_PERIOD_MS
+ * @brief Refresh period of the led chain when dithering is enabled. Shorter period reduces visible flicker */
+#ifndef RGB_LED_BACKEND_WS2812_DITHERING_PERIOD_MS
+#define RGB_LED_BACKEND_WS2812_DITHERING_PERIOD_MS  10
+#endif
+
+/**@def RGB_LED_BACKEND_WS2812_KEEPALIVE_PERIOD_MS
+ * @brief Period of refreshing led chain while colors do not change, so device is robust to hot plug of led chain.
+ *        0 disables the keepalive refresh */
+#ifndef RGB_LED_BACKEND_WS2812_KEEPALIVE_PERIOD_MS
+#define RGB_LED_BACKEND_WS2812_KEEPALIVE_PERIOD_MS  1000
+#endif
+
+/* Number of channels of a pixel, indexed by RGB_LED_GAMMA_CHANNEL_* */
+#if DRV_WS2812_RGBW_ENABLED
+#define WS2812_CHANNELS_COUNT                       4U
+#else
+#define WS2812_CHANNELS_COUNT                       3U
+#endif
+
+/* With DRV_WS2812_HW_KEEPALIVE_ENABLED the keepalive refresh is done by hardware, keepalive timer is not used */
+#if DRV_WS2812_HW_KEEPALIVE_ENABLED
+#define WS2812_KEEPALIVE_TIMER_PERIOD_MS            0
+#else
+#define WS2812_KEEPALIVE_TIMER_PERIOD_MS            RGB_LED_BACKEND_WS2812_KEEPALIVE_PERIOD_MS
+#endif
+
+APP_TIMER_DEF(m_keepalive_timer);
+
+/**@brief Function for restarting keepalive timer, so the led chain is refreshed a period after the last frame. */
+static void keepalive_schedule(void)
+{
+#if (WS2812_KEEPALIVE_TIMER_PERIOD_MS != 0)
+    ret_code_t ret_code;
+
+    ret_code = app_timer_stop(m_keepalive_timer);
+    APP_ERROR_CHECK(ret_code);
+
+    ret_code = app_timer_start(m_keepalive_timer, APP_TIMER_TICKS(WS2812_KEEPALIVE_TIMER_PERIOD_MS), NULL);
+    APP_ERROR_CHECK(ret_code);
+#endif
+}
+
+/**@brief Function for displaying pixels set in driver.
+ *
+ * If led chain is busy, the driver sends the frame as soon as the current refresh finishes.
+ */
+static void chain_display(void)
+{
+    UNUSED_RETURN_VALUE(drv_ws2812_display(NULL, NULL));
+    keepalive_schedule();
+}
+
+static void keepalive_timer_callback(void * p_context)
+{
+    UNUSED_PARAMETER(p_context);
+
+    /* Skipped if led chain is busy, it is being refreshed anyway */
+    UNUSED_RETURN_VALUE(drv_ws2812_refresh(NULL, NULL));
+    keepalive_schedule();
+}
+
+/**@brief Function for getting light intensities of the channels of a pixel displaying given color.
+ *
+ * @param[in]  color        Color in the format described for @ref rgb_led_backend_set_color.
+ * @param[out] p_intensity  Light intensities, @ref RGB_LED_GAMMA_CHANNELS_COUNT entries.
+ */
+static void color_intensity_get(uint32_t color, uint16_t * p_intensity)
+{
+#if DRV_WS2812_RGBW_ENABLED
+    /* White part of the color is displayed by the white LED of SK6812 */
+    rgb_led_gamma_rgbw_get(color, p_intensity);
+#else
+    rgb_led_gamma_rgb_get(color, p_intensity);
+#endif
+}
+
+/**@brief Function for initializing led chain and keepalive timer. */
+static void chain_init(void)
 {
-    if (color != m_current_color)
+    ret_code_t ret_code;
+    ret_code = drv_ws2812_init(LED_CHAIN_DOUT_PIN);
+    APP_ERROR_CHECK(ret_code);
+
+    ret_code = app_timer_create(&m_keepalive_timer, APP_TIMER_MODE_SINGLE_SHOT, keepalive_timer_callback);
+    APP_ERROR_CHECK(ret_code);
+
+    drv_ws2812_set_pixel_all(0x00000000U);
+    chain_display();
+
+#if DRV_WS2812_HW_KEEPALIVE_ENABLED && (RGB_LED_BACKEND_WS2812_KEEPALIVE_PERIOD_MS != 0)
+    ret_code = drv_ws2812_keepalive_start(RGB_LED_BACKEND_WS2812_KEEPALIVE_PERIOD_MS);
+    APP_ERROR_CHECK(ret_code);
+#endif
+}
+
+#if RGB_LED_BACKEND_WS2812_DITHERING_ENABLED
+/* Light intensity requested for each channel of each pixel, 16-bit */
+static uint16_t m_dither_target[DRV_WS2812_PIXELS_COUNT_TOTAL][WS2812_CHANNELS_COUNT];
+/* Part of the requested intensity not displayed yet, below 8-bit resolution */
+static uint8_t  m_dither_error[DRV_WS2812_PIXELS_COUNT_TOTAL][WS2812_CHANNELS_COUNT];
+/* True while m_dither_timer is running */
+static bool     m_dither_active;
+
+APP_TIMER_DEF(m_dither_timer);
+
+/**@brief Function for setting requested light intensity of a pixel.
+ *
+ * @param[in] pixel_no  Pixel index.
+ * @param[in] color     Color in the format described for @ref rgb_led_backend_set_color.
+ */
+static void dither_target_set(uint32_t pixel_no, uint32_t color)
+{
+    uint16_t intensity[RGB_LED_GAMMA_CHANNELS_COUNT];
+
+    color_intensity_get(color, intensity);
+    memcpy(m_dither_target[pixel_no], intensity, sizeof(m_dither_target[pixel_no]));
+}
+
+/**@brief Function for quantizing one channel to 8 bits, carrying the quantization error over to the next frame.
+ *
+ * @param[in]    target     Requested 16-bit intensity.
+ * @param[inout] p_error    Error left from previous frames.
+ *
+ * @return 8-bit intensity to be displayed in this frame.
+ */
+static uint32_t dither_channel(uint16_t target, uint8_t * p_error)
+{
+    uint32_t value  = (uint32_t)target + *p_error;
+    uint32_t output = value >> 8;
+
+    if (output > UINT8_MAX)
     {
-        drv_ws2812_set_pixel_all(color);
-        if (drv_ws2812_display(NULL, NULL) == NRF_SUCCESS)
-        {
-            m_current_color = color;
-        }
-        else
+        output = UINT8_MAX;
+    }
+    value -= output << 8;
+    *p_error = (uint8_t)((value > UINT8_MAX) ? UINT8_MAX : value);
+
+    return output;
+}
+
+/**@brief Function for checking if every requested intensity is displayed exactly, without dithering.
+ *
+ * @return true if frames following the last displayed one would be all the same.
+ */
+static bool dither_is_stable(void)
+{
+    uint32_t pixel_no;
+    uint32_t channel;
+
+    for (pixel_no = 0U; pixel_no < DRV_WS2812_PIXELS_COUNT_TOTAL; pixel_no++)
+    {
+        for (channel = 0U; channel < WS2812_CHANNELS_COUNT; channel++)
         {
-            /* If previous drv_ws2812_display has not finished yet (very long LED chain and low value of RGB_LED_REFRESH_PERIOD_MS),
-             * we simply loose one refresh frame, but without negative effect to overall light effect, because
-             * update will happen on next timer tick.
-             */
+            uint16_t target = m_dither_target[pixel_no][channel];
+
+            /* Error carried over is below 8-bit resolution, so output is constant for such targets */
+            if (((target & 0xFFU) != 0U) && (target < 0xFF00U))
+            {
+                return false;
+            }
         }
     }
-    else
+
+    return true;
+}
+
+/**@brief Function for starting dithering after requested intensities have changed. */
+static void dither_start(void)
+{
+    ret_code_t ret_code;
+
+    if (!m_dither_active)
+    {
+        m_dither_active = true;
+        ret_code = app_timer_start(m_dither_timer, APP_TIMER_TICKS(RGB_LED_BACKEND_WS2812_DITHERING_PERIOD_MS), NULL);
+        APP_ERROR_CHECK(ret_code);
+    }
+}
+
+static void dither_timer_callback(void * p_context)
+{
+    uint32_t pixel_no;
+
+    UNUSED_PARAMETER(p_context);
+
+    if (drv_ws2812_is_refreshing())
+    {
+        /* Chain too long for the dithering period, error is carried over to the next tick */
+        return;
+    }
+
+    for (pixel_no = 0U; pixel_no < DRV_WS2812_PIXELS_COUNT_TOTAL; pixel_no++)
+    {
+        uint16_t * p_target = m_dither_target[pixel_no];
+        uint8_t  * p_error  = m_dither_error[pixel_no];
+        uint32_t   r        = dither_channel(p_target[RGB_LED_GAMMA_CHANNEL_RED],   &p_error[RGB_LED_GAMMA_CHANNEL_RED]);
+        uint32_t   g        = dither_channel(p_target[RGB_LED_GAMMA_CHANNEL_GREEN], &p_error[RGB_LED_GAMMA_CHANNEL_GREEN]);
+        uint32_t   b        = dither_channel(p_target[RGB_LED_GAMMA_CHANNEL_BLUE],  &p_error[RGB_LED_GAMMA_CHANNEL_BLUE]);
+#if DRV_WS2812_RGBW_ENABLED
+        uint32_t   w        = dither_channel(p_target[RGB_LED_GAMMA_CHANNEL_WHITE], &p_error[RGB_LED_GAMMA_CHANNEL_WHITE]);
+#else
+        uint32_t   w        = 0U;
+#endif
+
+        drv_ws2812_set_pixel(pixel_no, (w << 24) | (r << 16) | (g << 8) | b);
+    }
+
+    UNUSED_RETURN_VALUE(drv_ws2812_display(NULL, NULL));
+
+    if (dither_is_stable())
+    {
+        /* Displayed frame does not change anymore, leave refreshing to keepalive timer */
+        ret_code_t ret_code = app_timer_stop(m_dither_timer);
+        APP_ERROR_CHECK(ret_code);
+
+        m_dither_active = false;
+        keepalive_schedule();
+    }
+}
+
+void rgb_led_backend_set_color(uint32_t color)
+{
+    uint32_t pixel_no;
+
+    for (pixel_no = 0U; pixel_no < DRV_WS2812_PIXELS_COUNT_TOTAL; pixel_no++)
+    {
+        dither_target_set(pixel_no, color);
+    }
+    dither_start();
+}
+
+size_t rgb_led_backend_pixels_count_get(void)
+{
+    return DRV_WS2812_PIXELS_COUNT_TOTAL;
+}
+
+void rgb_led_backend_set_frame(const uint32_t * p_frame, size_t pixels_count)
+{
+    uint32_t pixel_no;
+
+    for (pixel_no = 0U; pixel_no < DRV_WS2812_PIXELS_COUNT_TOTAL; pixel_no++)
     {
-        /* No change in color, just refresh led chain to make device robust to hot plug of led chain */
-        UNUSED_RETURN_VALUE(drv_ws2812_refresh(NULL, NULL));
+        dither_target_set(pixel_no, (pixel_no < pixels_count) ? p_frame[pixel_no] : 0U);
     }
+    dither_start();
 }
 
 void rgb_led_backend_init(void)
 {
     ret_code_t ret_code;
-    ret_code = drv_ws2812_init(LED_CHAIN_DOUT_PIN);
+
+    chain_init();
+
+    m_dither_active = false;
+    ret_code = app_timer_create(&m_dither_timer, APP_TIMER_MODE_REPEATED, dither_timer_callback);
     APP_ERROR_CHECK(ret_code);
+}
 
-    drv_ws2812_set_pixel_all(0x00000000U);
-    UNUSED_RETURN_VALUE(drv_ws2812_display(NULL, NULL));
+#else
+
+/**@brief Function for rounding 16-bit light intensity to 8 bits.
+ *
+ * @param[in] intensity     Light intensity, from range [0, @ref RGB_LED_GAMMA_OUTPUT_MAX].
+ *
+ * @return Light intensity from range [0, 255].
+ */
+static uint32_t intensity_round(uint16_t intensity)
+{
+    /* Scaled rather than shifted, so full intensity does not overflow to 256 */
+    return (((uint32_t)intensity * UINT8_MAX) + 0x8000U) >> 16;
+}
+
+/**@brief Function for applying brightness curve to RGB color.
+ *
+ * @param[in] color     Color in the format described for @ref rgb_led_backend_set_color.
+ *
+ * @return Color with 8-bit light intensity of each channel, as expected by ws2812 leds.
+ */
+static uint32_t color_correct(uint32_t color)
+{
+    uint16_t intensity[RGB_LED_GAMMA_CHANNELS_COUNT];
+
+    color_intensity_get(color, intensity);
+
+    return (intensity_round(intensity[RGB_LED_GAMMA_CHANNEL_WHITE]) << 24) |
+           (intensity_round(intensity[RGB_LED_GAMMA_CHANNEL_RED])   << 16) |
+           (intensity_round(intensity[RGB_LED_GAMMA_CHANNEL_GREEN]) << 8)  |
+           intensity_round(intensity[RGB_LED_GAMMA_CHANNEL_BLUE]);
+}
+
+static uint32_t m_current_color;
+/* False when pixels have been set individually, so the chain does not show m_current_color */
+static bool     m_current_color_valid;
+
+void rgb_led_backend_set_color(uint32_t color)
+{
+    if ((!m_current_color_valid) || (color != m_current_color))
+    {
+        drv_ws2812_set_pixel_all(color_correct(color));
+        /* If previous drv_ws2812_display has not finished yet (very long LED chain and low value of RGB_LED_REFRESH_PERIOD_MS),
+         * the frame is queued by the driver.
+         */
+        chain_display();
+        m_current_color       = color;
+        m_current_color_valid = true;
+    }
+}
+
+size_t rgb_led_backend_pixels_count_get(void)
+{
+    return DRV_WS2812_PIXELS_COUNT_TOTAL;
+}
+
+void rgb_led_backend_set_frame(const uint32_t * p_frame, size_t pixels_count)
+{
+    uint32_t pixel_no;
+
+    for (pixel_no = 0U; pixel_no < DRV_WS2812_PIXELS_COUNT_TOTAL; pixel_no++)
+    {
+        drv_ws2812_set_pixel(pixel_no, (pixel_no < pixels_count) ? color_correct(p_frame[pixel_no]) : 0U);
+    }
+    m_current_color_valid = false;
+
+    /* Only changed pixels are encoded. If the chain is still busy, the frame is sent when it finishes,
+     * unless the next frame replaces it before.
+     */
+    chain_display();
+}
+
+void rgb_led_backend_init(void)
+{
+    chain_init();
 
-    m_current_color = 0U;
+    m_current_color       = 0U;
+    m_current_color_valid = true;
 }
+#endif /* RGB_LED_BACKEND_WS2812_DITHERING_ENABLED */
 
 /**
  * @}
@@ -0,0 +1,310 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @defgroup zigbee_examples_ble_zigbee_color_light_bulb_thingy rgb_led_effect.c
+ * @{
+ * @ingroup zigbee_examples
+ */
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "rgb_led_effect.h"
+
+/**@brief Function for making RGB color value out of individual components. */
+static uint32_t make_rgb_color(uint8_t r, uint8_t g, uint8_t b)
+{
+    return ((uint32_t)r << 16) | ((uint32_t)g << 8) | (uint32_t)b;
+}
+
+/**@brief Function for blending two RGB colors.
+ *
+ * @param[in] color_a   Color returned when @p weight is 0.
+ * @param[in] color_b   Color returned when @p weight is 255.
+ * @param[in] weight    Weight of @p color_b, from range [0, 255].
+ *
+ * @return Blended RGB color.
+ */
+static uint32_t color_blend(uint32_t color_a, uint32_t color_b, uint8_t weight)
+{
+    uint32_t result = 0U;
+    uint32_t shift;
+
+    for (shift = 0U; shift <= 16U; shift += 8U)
+    {
+        uint32_t a = (color_a >> shift) & 0xFFU;
+        uint32_t b = (color_b >> shift) & 0xFFU;
+
+        result |= ((a * (255U - weight) + b * weight + 127U) / 255U) << shift;
+    }
+
+    return result;
+}
+
+/**@brief Function for getting fully saturated color of the color wheel.
+ *
+ * @param[in] position      Position on the color wheel, from range [0, 255].
+ * @param[in] brightness    Brightness of the color, from range [0, 255].
+ *
+ * @return RGB color.
+ */
+static uint32_t color_wheel(uint8_t position, uint8_t brightness)
+{
+    uint32_t r;
+    uint32_t g;
+    uint32_t b;
+
+    if (position < 85U)
+    {
+        r = 255U - position * 3U;
+        g = position * 3U;
+        b = 0U;
+    }
+    else if (position < 170U)
+    {
+        position -= 85U;
+        r = 0U;
+        g = 255U - position * 3U;
+        b = position * 3U;
+    }
+    else
+    {
+        position -= 170U;
+        r = position * 3U;
+        g = 0U;
+        b = 255U - position * 3U;
+    }
+
+    return make_rgb_color((uint8_t)(r * brightness / 255U),
+                          (uint8_t)(g * brightness / 255U),
+                          (uint8_t)(b * brightness / 255U));
+}
+
+/**@brief Function for calculating phase of a periodic effect.
+ *
+ * @param[in] time_ms       Time in milliseconds.
+ * @param[in] period_ms     Period of the effect in milliseconds. 0 means static effect.
+ *
+ * @return Phase of the effect, from range [0, 65535] corresponding to one period.
+ */
+static uint32_t effect_phase(uint32_t time_ms, uint32_t period_ms)
+{
+    if (period_ms == 0U)
+    {
+        return 0U;
+    }
+
+    /* Twinkle stretches periods beyond 16 bits, so the shifted remainder may not fit in 32 bits */
+    return (uint32_t)(((uint64_t)(time_ms % period_ms) << 16) / period_ms);
+}
+
+/**@brief Function for calculating pseudo-random, but constant value assigned to a pixel. */
+static uint32_t pixel_hash(uint32_t pixel_no)
+{
+    uint32_t x = pixel_no * 0x9E3779B1U + 0x7F4A7C15U;
+
+    x ^= x >> 15;
+    x *= 0x2C1B3C6DU;
+    x ^= x >> 12;
+    x *= 0x297A2D39U;
+    x ^= x >> 15;
+
+    return x;
+}
+
+/**@brief Function for rendering a two-color gradient, scrolled along the chain if period is set. */
+static void render_gradient(uint32_t color_a, uint32_t color_b, uint32_t phase, bool scroll,
+                            uint32_t * p_frame, size_t pixels_count)
+{
+    size_t i;
+
+    for (i = 0; i < pixels_count; i++)
+    {
+        uint32_t weight;
+
+        if (scroll)
+        {
+            /* Triangle wave along the chain, so that the scrolled gradient has no visible seam */
+            uint32_t position = ((i << 16) / pixels_count + phase) & 0xFFFFU;
+
+            weight = (position < 0x8000U) ? (position >> 7) : ((0xFFFFU - position) >> 7);
+        }
+        else
+        {
+            weight = (pixels_count > 1U) ? (i * 255U / (pixels_count - 1U)) : 0U;
+        }
+
+        p_frame[i] = color_blend(color_a, color_b, (uint8_t)weight);
+    }
+}
+
+/**@brief Function for rendering a head of @p color_head with a fading tail running over @p color_bg. */
+static void render_chase(uint32_t color_head, uint32_t color_bg, uint32_t phase, uint8_t tail_length,
+                         uint32_t * p_frame, size_t pixels_count)
+{
+    size_t   head = (size_t)((phase * pixels_count) >> 16);
+    uint32_t tail = (tail_length != 0U) ? tail_length : 1U;
+    size_t   i;
+
+    for (i = 0; i < pixels_count; i++)
+    {
+        uint32_t distance = (uint32_t)((head + pixels_count - i) % pixels_count);
+
+        if (distance < tail)
+        {
+            p_frame[i] = color_blend(color_bg, color_head, (uint8_t)(255U - distance * 255U / tail));
+        }
+        else
+        {
+            p_frame[i] = color_bg;
+        }
+    }
+}
+
+/**@brief Function for rendering the whole color wheel spread along the chain. */
+static void render_rainbow(uint32_t phase, uint8_t brightness, uint32_t * p_frame, size_t pixels_count)
+{
+    size_t i;
+
+    for (i = 0; i < pixels_count; i++)
+    {
+        uint32_t position = ((i << 16) / pixels_count + phase) & 0xFFFFU;
+
+        p_frame[i] = color_wheel((uint8_t)(position >> 8), brightness);
+    }
+}
+
+/**@brief Function for rendering pixels of @p color_spark randomly flashing over @p color_bg.
+ *
+ * Every pixel has its own, pseudo-random offset and period, so the effect does not need any state.
+ */
+static void render_twinkle(uint32_t color_spark, uint32_t color_bg, uint32_t time_ms, uint16_t period_ms,
+                           uint8_t density, uint32_t * p_frame, size_t pixels_count)
+{
+    uint32_t window = (uint32_t)density << 8;
+    size_t   i;
+
+    for (i = 0; i < pixels_count; i++)
+    {
+        uint32_t hash = pixel_hash((uint32_t)i);
+        uint32_t weight;
+
+        if (period_ms == 0U)
+        {
+            weight = ((hash & 0xFFU) < density) ? 255U : 0U;
+        }
+        else
+        {
+            /* Up to +50% of the period, so that pixels drift apart */
+            uint32_t pixel_period = period_ms + (((hash & 0xFFU) * period_ms) >> 9);
+            uint32_t position     = effect_phase(time_ms + (hash >> 8), pixel_period);
+
+            if (position < window)
+            {
+                position = (position << 9) / window;
+                weight   = (position < 256U) ? position : (511U - position);
+            }
+            else
+            {
+                weight = 0U;
+            }
+        }
+
+        p_frame[i] = color_blend(color_bg, color_spark, (uint8_t)weight);
+    }
+}
+
+bool rgb_led_effect_is_frame_mode(led_mode_t mode)
+{
+    switch (mode)
+    {
+        case LED_MODE_GRADIENT:
+        case LED_MODE_CHASE:
+        case LED_MODE_RAINBOW:
+        case LED_MODE_TWINKLE:
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+void rgb_led_effect_render(const led_params_t * p_led_params,
+                           uint32_t             elapsed_ms,
+                           uint32_t           * p_frame,
+                           size_t               pixels_count)
+{
+    uint32_t color_1 = make_rgb_color(p_led_params->r, p_led_params->g, p_led_params->b);
+    uint32_t color_2 = make_rgb_color(p_led_params->r2, p_led_params->g2, p_led_params->b2);
+    uint32_t phase   = effect_phase(elapsed_ms, p_led_params->period);
+
+    if (pixels_count == 0U)
+    {
+        return;
+    }
+
+    switch (p_led_params->mode)
+    {
+        case LED_MODE_GRADIENT:
+            render_gradient(color_1, color_2, phase, (p_led_params->period != 0U), p_frame, pixels_count);
+            break;
+
+        case LED_MODE_CHASE:
+            render_chase(color_1, color_2, phase, p_led_params->param, p_frame, pixels_count);
+            break;
+
+        case LED_MODE_RAINBOW:
+            render_rainbow(phase, p_led_params->param, p_frame, pixels_count);
+            break;
+
+        case LED_MODE_TWINKLE:
+            render_twinkle(color_1, color_2, elapsed_ms, p_led_params->period, p_led_params->param,
+                           p_frame, pixels_count);
+            break;
+
+        default:
+            break;
+    }
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,81 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @defgroup zigbee_examples_ble_zigbee_color_light_bulb_thingy rgb_led_effect.h
+ * @{
+ * @ingroup zigbee_examples
+ */
+
+#ifndef RGB_LED_EFFECT_H__
+#define RGB_LED_EFFECT_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "rgb_led.h"
+
+/**@brief Function for checking if given LED mode is rendered per pixel by the effect engine.
+ *
+ * @param[in] mode  LED mode.
+ *
+ * @return true if frame for the mode must be rendered by @ref rgb_led_effect_render, false if the mode
+ *         produces single color for the whole LED chain.
+ */
+bool rgb_led_effect_is_frame_mode(led_mode_t mode);
+
+/**@brief Function for rendering one frame of a per-pixel effect.
+ *
+ * @param[in]  p_led_params     LED parameters with mode being one of per-pixel effect modes. Must not be NULL.
+ * @param[in]  elapsed_ms       Time elapsed since the effect has been started, in milliseconds.
+ * @param[out] p_frame          Frame buffer, one RGB color per pixel (format as in @ref rgb_led_backend_set_color).
+ * @param[in]  pixels_count     Number of pixels in @p p_frame.
+ */
+void rgb_led_effect_render(const led_params_t * p_led_params,
+                           uint32_t             elapsed_ms,
+                           uint32_t           * p_frame,
+                           size_t               pixels_count);
+
+#endif /* RGB_LED_EFFECT_H__ */
+
+/**
+ * @}
+ */
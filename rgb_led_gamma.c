@@ -0,0 +1,83 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @defgroup zigbee_examples_ble_zigbee_color_light_bulb_thingy rgb_led_gamma.c
+ * @{
+ * @ingroup zigbee_examples
+ */
+#include <stdint.h>
+
+#include "sdk_config.h"
+#include "rgb_led_gamma.h"
+
+/* CIE lightness L* from range [0, 100] for given brightness */
+#define CIE_L(i)            ((double)(i) * 100.0 / 255.0)
+
+/* Relative luminance Y from range [0, 1] for given lightness, inverse of CIE 1976 L* formula */
+#define CIE_Y_OF_L(l)       (((l) <= 8.0) ? ((l) / 903.3) : (((l) + 16.0) / 116.0) * (((l) + 16.0) / 116.0) * (((l) + 16.0) / 116.0))
+
+/* Table entries are arithmetic constant expressions, evaluated by the compiler */
+#define GAMMA_ENTRY(i, cal) ((uint16_t)(CIE_Y_OF_L(CIE_L(i)) * (cal) * RGB_LED_GAMMA_OUTPUT_MAX / 100.0 + 0.5))
+#define GAMMA_4(i, cal)     GAMMA_ENTRY((i), cal),      GAMMA_ENTRY((i) + 1, cal),  \
+                            GAMMA_ENTRY((i) + 2, cal),  GAMMA_ENTRY((i) + 3, cal)
+#define GAMMA_16(i, cal)    GAMMA_4((i), cal),          GAMMA_4((i) + 4, cal),      \
+                            GAMMA_4((i) + 8, cal),      GAMMA_4((i) + 12, cal)
+#define GAMMA_64(i, cal)    GAMMA_16((i), cal),         GAMMA_16((i) + 16, cal),    \
+                            GAMMA_16((i) + 32, cal),    GAMMA_16((i) + 48, cal)
+#define GAMMA_256(cal)      GAMMA_64(0, cal),           GAMMA_64(64, cal),          \
+                            GAMMA_64(128, cal),         GAMMA_64(192, cal)
+
+#if (RGB_LED_GAMMA_CAL_RED > 100) || (RGB_LED_GAMMA_CAL_GREEN > 100) || (RGB_LED_GAMMA_CAL_BLUE > 100) || \
+    (RGB_LED_GAMMA_CAL_WHITE > 100)
+#error Channel correction must not exceed 100 percent
+#endif
+
+const uint16_t c_rgb_led_gamma[RGB_LED_GAMMA_CHANNELS_COUNT][256] =
+{
+    [RGB_LED_GAMMA_CHANNEL_RED]   = { GAMMA_256(RGB_LED_GAMMA_CAL_RED) },
+    [RGB_LED_GAMMA_CHANNEL_GREEN] = { GAMMA_256(RGB_LED_GAMMA_CAL_GREEN) },
+    [RGB_LED_GAMMA_CHANNEL_BLUE]  = { GAMMA_256(RGB_LED_GAMMA_CAL_BLUE) },
+    [RGB_LED_GAMMA_CHANNEL_WHITE] = { GAMMA_256(RGB_LED_GAMMA_CAL_WHITE) },
+};
+
+/**
+ * @}
+ */
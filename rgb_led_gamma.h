@@ -0,0 +1,147 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @defgroup zigbee_examples_ble_zigbee_color_light_bulb_thingy rgb_led_gamma.h
+ * @{
+ * @ingroup zigbee_examples
+ */
+
+#ifndef RGB_LED_GAMMA_H__
+#define RGB_LED_GAMMA_H__
+
+#include <stdint.h>
+
+/**@def RGB_LED_GAMMA_CAL_RED
+ * @brief Correction of red channel intensity, in percent */
+#ifndef RGB_LED_GAMMA_CAL_RED
+#define RGB_LED_GAMMA_CAL_RED       100
+#endif
+
+/**@def RGB_LED_GAMMA_CAL_GREEN
+ * @brief Correction of green channel intensity, in percent */
+#ifndef RGB_LED_GAMMA_CAL_GREEN
+#define RGB_LED_GAMMA_CAL_GREEN     73
+#endif
+
+/**@def RGB_LED_GAMMA_CAL_BLUE
+ * @brief Correction of blue channel intensity, in percent */
+#ifndef RGB_LED_GAMMA_CAL_BLUE
+#define RGB_LED_GAMMA_CAL_BLUE      66
+#endif
+
+/**@def RGB_LED_GAMMA_CAL_WHITE
+ * @brief Correction of white channel intensity, in percent. With 100 the white LED at full intensity matches
+ *        red, green and blue LEDs at full corrected intensity together */
+#ifndef RGB_LED_GAMMA_CAL_WHITE
+#define RGB_LED_GAMMA_CAL_WHITE     100
+#endif
+
+#define RGB_LED_GAMMA_CHANNEL_RED       0U      /**< Index of red channel in @ref c_rgb_led_gamma. */
+#define RGB_LED_GAMMA_CHANNEL_GREEN     1U      /**< Index of green channel in @ref c_rgb_led_gamma. */
+#define RGB_LED_GAMMA_CHANNEL_BLUE      2U      /**< Index of blue channel in @ref c_rgb_led_gamma. */
+#define RGB_LED_GAMMA_CHANNEL_WHITE     3U      /**< Index of white channel in @ref c_rgb_led_gamma. */
+#define RGB_LED_GAMMA_CHANNELS_COUNT    4U      /**< Number of channels in @ref c_rgb_led_gamma. */
+
+#define RGB_LED_GAMMA_OUTPUT_MAX        0xFFFFU /**< Output value of full intensity, before channel correction. */
+
+/**@brief Perceptually uniform (CIE 1976 lightness) brightness curve with channel correction applied.
+ *
+ * Maps 8-bit brightness of each channel to 16-bit light intensity. The table is generated by the compiler.
+ */
+extern const uint16_t c_rgb_led_gamma[RGB_LED_GAMMA_CHANNELS_COUNT][256];
+
+/**@brief Function for getting corrected light intensity of a channel.
+ *
+ * @param[in] channel       Channel index, one of RGB_LED_GAMMA_CHANNEL_*.
+ * @param[in] brightness    Brightness of the channel, from range [0, 255].
+ *
+ * @return Light intensity, from range [0, @ref RGB_LED_GAMMA_OUTPUT_MAX].
+ */
+static inline uint16_t rgb_led_gamma_get(uint8_t channel, uint8_t brightness)
+{
+    return c_rgb_led_gamma[channel][brightness];
+}
+
+/**@brief Function for getting corrected light intensities of an RGBW LED displaying given color.
+ *
+ * White part of the color is moved from red, green and blue channels to the white channel. All channels share
+ * the brightness curve, so the lowest brightness of red, green and blue is the white part also in terms of light
+ * intensity, and subtracting its intensity leaves the rest of the color exactly.
+ *
+ * @param[in]  color        Color in the format described for @ref rgb_led_backend_set_color.
+ * @param[out] p_intensity  Light intensities of channels, indexed by RGB_LED_GAMMA_CHANNEL_*.
+ */
+static inline void rgb_led_gamma_rgbw_get(uint32_t color, uint16_t * p_intensity)
+{
+    uint8_t r     = (uint8_t)(color >> 16);
+    uint8_t g     = (uint8_t)(color >> 8);
+    uint8_t b     = (uint8_t)(color);
+    uint8_t white = (r < g) ? r : g;
+
+    white = (b < white) ? b : white;
+
+    p_intensity[RGB_LED_GAMMA_CHANNEL_RED]   = c_rgb_led_gamma[RGB_LED_GAMMA_CHANNEL_RED][r] -
+                                               c_rgb_led_gamma[RGB_LED_GAMMA_CHANNEL_RED][white];
+    p_intensity[RGB_LED_GAMMA_CHANNEL_GREEN] = c_rgb_led_gamma[RGB_LED_GAMMA_CHANNEL_GREEN][g] -
+                                               c_rgb_led_gamma[RGB_LED_GAMMA_CHANNEL_GREEN][white];
+    p_intensity[RGB_LED_GAMMA_CHANNEL_BLUE]  = c_rgb_led_gamma[RGB_LED_GAMMA_CHANNEL_BLUE][b] -
+                                               c_rgb_led_gamma[RGB_LED_GAMMA_CHANNEL_BLUE][white];
+    p_intensity[RGB_LED_GAMMA_CHANNEL_WHITE] = c_rgb_led_gamma[RGB_LED_GAMMA_CHANNEL_WHITE][white];
+}
+
+/**@brief Function for getting corrected light intensities of an RGB LED displaying given color.
+ *
+ * @param[in]  color        Color in the format described for @ref rgb_led_backend_set_color.
+ * @param[out] p_intensity  Light intensities of channels, indexed by RGB_LED_GAMMA_CHANNEL_*. White is always 0.
+ */
+static inline void rgb_led_gamma_rgb_get(uint32_t color, uint16_t * p_intensity)
+{
+    p_intensity[RGB_LED_GAMMA_CHANNEL_RED]   = c_rgb_led_gamma[RGB_LED_GAMMA_CHANNEL_RED][(uint8_t)(color >> 16)];
+    p_intensity[RGB_LED_GAMMA_CHANNEL_GREEN] = c_rgb_led_gamma[RGB_LED_GAMMA_CHANNEL_GREEN][(uint8_t)(color >> 8)];
+    p_intensity[RGB_LED_GAMMA_CHANNEL_BLUE]  = c_rgb_led_gamma[RGB_LED_GAMMA_CHANNEL_BLUE][(uint8_t)(color)];
+    p_intensity[RGB_LED_GAMMA_CHANNEL_WHITE] = 0U;
+}
+
+#endif /* RGB_LED_GAMMA_H__ */
+
+/**
+ * @}
+ */
@@ -0,0 +1,586 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @defgroup zigbee_examples_ble_zigbee_color_light_bulb_thingy rgb_led_state.c
+ * @{
+ * @ingroup zigbee_examples
+ */
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "nordic_common.h"
+#include "rgb_led_state.h"
+#include "rgb_led_effect.h"
+#include "color_conv.h"
+
+/* Indexes of color channels in LED_MODE_HSB */
+#define HSB_CHANNEL_HUE         0U
+#define HSB_CHANNEL_SATURATION  1U
+#define HSB_CHANNEL_LEVEL       2U
+#define HSB_CHANNEL_COLOR_TEMP  3U
+
+/* Length of the hue circle (hue 254 is equal to hue 0) in Q8.8 format */
+#define HSB_HUE_CIRCLE_Q8       (254 << 8)
+
+/* LED brightness sequence, played to imitate 'breathe' effect. */
+static const uint8_t  c_led_breathe_brightness_sequence[] =
+{
+        0, 10, 20, 40, 80, 120, 160, 200, 240, 255, 240, 200, 160, 120, 80, 40, 20, 10, 0
+};
+
+/**@brief Function for applying intensity to given brightness.
+ *
+ * @param[in] brightness    Value from range [0, 255] being brightness of color (255 means the brightest)
+ * @param[in] intensity     Value from range [0, 100] being intensity of color
+ *
+ * @return Color brightness multiplied by color intensity
+ */
+static uint8_t brightness_apply_intensity(uint8_t brightness, uint8_t intensity)
+{
+    if (intensity > 100U)
+    {
+        /* Limit intensity value, defensive code */
+        intensity = 100U;
+    }
+
+    return (uint8_t)((uint32_t)intensity * brightness / 100U);
+}
+
+/**@brief Function for making RGB color value out of mask selecting individual channels and channel brightness
+ * @param[in] brightness    Value from range [0, 255] being brightness of selected channels
+ * @param[in] color_mask    Mask selecting RGB channels, combination of @ref LED_PARAMS_COLOR_MASK_RED,
+ *                          @ref LED_PARAMS_COLOR_MASK_GREEN, @ref LED_PARAMS_COLOR_MASK_BLUE flags.
+ *
+ * @return RGB color value suitable for RGB LED backend module.
+ */
+static uint32_t make_rgb_color_from_brightness_and_mask(uint8_t brightness, uint8_t color_mask)
+{
+    uint32_t result = 0U;
+
+    /* Here component takes value from range [0, 255] */
+    if ((color_mask & LED_PARAMS_COLOR_MASK_RED) != 0U)
+    {
+        result |= brightness;
+    }
+    result <<= 8;
+
+    if ((color_mask & LED_PARAMS_COLOR_MASK_GREEN) != 0U)
+    {
+        result |= brightness;
+    }
+    result <<= 8;
+
+    if ((color_mask & LED_PARAMS_COLOR_MASK_BLUE) != 0U)
+    {
+        result |= brightness;
+    }
+
+    return result;
+}
+
+/**@brief Function for converting led_params_t (r, g, b components) into RGB LED backend color.
+ *
+ * @param[in] p_led_params  Input color structure with filled @c r, @c g, @c fields
+ *
+ * @return RGB color compatible with RGB LED backend module.
+ */
+static uint32_t make_rgb_color_from_led_params_rgb(const led_params_t * p_led_params)
+{
+    uint32_t result;
+
+    result = p_led_params->r;
+    result <<= 8;
+    result |= p_led_params->g;
+    result <<= 8;
+    result |= p_led_params->b;
+
+    return result;
+}
+
+/**@brief Function for generating RGB color compatible with RGB LED backend module from led_params_t and given index of breathe sequence
+ *
+ * @param[in] p_led_params          Input led parameters with filled @c intensity and @c color fields.
+ * @param[in] breathe_sequence_idx  Index to @ref c_led_breathe_brightness_sequence
+ *
+ * @return RGB color compatible with RGB LED backend module corresponding to given step of breathe sequence.
+ */
+static uint32_t make_rgb_color_from_breathe_sequence(const led_params_t * p_led_params, size_t breathe_sequence_idx)
+{
+    uint8_t brightness;
+
+    brightness = c_led_breathe_brightness_sequence[breathe_sequence_idx];
+    brightness = brightness_apply_intensity(brightness, p_led_params->intensity);
+
+    return make_rgb_color_from_brightness_and_mask(brightness, p_led_params->color);
+}
+
+/**@brief Function for starting transition of single color channel.
+ *
+ * @param[in] p_transition      Transition to be started.
+ * @param[in] target            Value at the end of the transition.
+ * @param[in] transition_time   Time of the transition, in tenths of a second.
+ * @param[in] hue_direction     Direction of the transition, one of LED_PARAMS_HUE_DIRECTION_*, used for hue only,
+ *                              for other channels must be @c UINT8_MAX.
+ */
+static void hsb_transition_start(rgb_led_hsb_transition_t * p_transition,
+                                 uint16_t           target,
+                                 uint16_t           transition_time,
+                                 uint8_t            hue_direction)
+{
+    int32_t delta = ((int32_t)target << 8) - p_transition->value;
+
+    switch (hue_direction)
+    {
+        case LED_PARAMS_HUE_DIRECTION_SHORTEST:
+            if (delta > (HSB_HUE_CIRCLE_Q8 / 2))
+            {
+                delta -= HSB_HUE_CIRCLE_Q8;
+            }
+            else if (delta < -(HSB_HUE_CIRCLE_Q8 / 2))
+            {
+                delta += HSB_HUE_CIRCLE_Q8;
+            }
+            break;
+
+        case LED_PARAMS_HUE_DIRECTION_LONGEST:
+            if ((delta > 0) && (delta < (HSB_HUE_CIRCLE_Q8 / 2)))
+            {
+                delta -= HSB_HUE_CIRCLE_Q8;
+            }
+            else if ((delta < 0) && (delta > -(HSB_HUE_CIRCLE_Q8 / 2)))
+            {
+                delta += HSB_HUE_CIRCLE_Q8;
+            }
+            break;
+
+        case LED_PARAMS_HUE_DIRECTION_UP:
+            if (delta < 0)
+            {
+                delta += HSB_HUE_CIRCLE_Q8;
+            }
+            break;
+
+        case LED_PARAMS_HUE_DIRECTION_DOWN:
+            if (delta > 0)
+            {
+                delta -= HSB_HUE_CIRCLE_Q8;
+            }
+            break;
+
+        default:
+            /* Not a hue channel, go straight to the target */
+            break;
+    }
+
+    p_transition->target      = target;
+    p_transition->start       = p_transition->value;
+    p_transition->delta       = delta;
+    p_transition->elapsed_ms  = 0U;
+    p_transition->duration_ms = (uint32_t)transition_time * 100U;
+
+    if (p_transition->duration_ms == 0U)
+    {
+        p_transition->value = (int32_t)target << 8;
+    }
+}
+
+/**@brief Function for advancing transition of single color channel by one refresh period.
+ *
+ * @param[in] p_transition  Transition to be advanced.
+ * @param[in] is_hue        true if the channel wraps around the hue circle.
+ * @param[in] step_ms       Length of the refresh period.
+ */
+static void hsb_transition_step(rgb_led_hsb_transition_t * p_transition, bool is_hue, uint32_t step_ms)
+{
+    int32_t value;
+
+    if (p_transition->elapsed_ms >= p_transition->duration_ms)
+    {
+        return;
+    }
+
+    p_transition->elapsed_ms += step_ms;
+    if (p_transition->elapsed_ms >= p_transition->duration_ms)
+    {
+        value = (int32_t)p_transition->target << 8;
+    }
+    else
+    {
+        value = p_transition->start +
+                (int32_t)(((int64_t)p_transition->delta * p_transition->elapsed_ms) / p_transition->duration_ms);
+        if (is_hue)
+        {
+            if (value < 0)
+            {
+                value += HSB_HUE_CIRCLE_Q8;
+            }
+            else if (value >= HSB_HUE_CIRCLE_Q8)
+            {
+                value -= HSB_HUE_CIRCLE_Q8;
+            }
+        }
+    }
+
+    p_transition->value = value;
+}
+
+/**@brief Function for (re)starting transitions of color channels whose target value has changed.
+ *
+ * @param[in] p_state       State with current parameters in @ref LED_MODE_HSB mode.
+ * @param[in] from_current  true if transitions start from the currently displayed color, false if the requested
+ *                          color has to be displayed immediately.
+ */
+static void hsb_transitions_update(rgb_led_state_t * p_state, bool from_current)
+{
+    const led_params_t * p_led_params = &p_state->curr_led_params;
+    const uint16_t targets[RGB_LED_STATE_HSB_CHANNELS_COUNT] =
+    {
+        p_led_params->hue, p_led_params->saturation, p_led_params->level, p_led_params->color_temperature
+    };
+    const uint16_t times[RGB_LED_STATE_HSB_CHANNELS_COUNT] =
+    {
+        p_led_params->hue_transition_time,
+        p_led_params->saturation_transition_time,
+        p_led_params->level_transition_time,
+        p_led_params->color_temperature_transition_time
+    };
+    size_t i;
+
+    for (i = 0; i < RGB_LED_STATE_HSB_CHANNELS_COUNT; i++)
+    {
+        rgb_led_hsb_transition_t * p_transition = &p_state->hsb_transitions[i];
+
+        if ((!from_current) ||
+            ((i == HSB_CHANNEL_COLOR_TEMP) && ((targets[i] == 0U) || (p_transition->target == 0U))))
+        {
+            /* Also when switching between color temperature and hue with saturation, there is nothing in between */
+            p_transition->value = (int32_t)targets[i] << 8;
+            hsb_transition_start(p_transition, targets[i], 0U, UINT8_MAX);
+        }
+        else if (targets[i] != p_transition->target)
+        {
+            hsb_transition_start(p_transition,
+                                 targets[i],
+                                 times[i],
+                                 (i == HSB_CHANNEL_HUE) ? p_led_params->hue_direction : UINT8_MAX);
+        }
+        else
+        {
+            /* Target not changed, ongoing transition continues */
+        }
+    }
+}
+
+/**@brief Function for checking if color loop is active in @ref LED_MODE_HSB mode. */
+static bool color_loop_is_active(const led_params_t * p_led_params)
+{
+    return (p_led_params->color_loop_time != 0U);
+}
+
+/**@brief Function for getting currently displayed hue of color loop, in Q8.8 format. */
+static int32_t color_loop_hue_get(const rgb_led_state_t * p_state)
+{
+    return (int32_t)(((uint64_t)p_state->color_loop_phase * HSB_HUE_CIRCLE_Q8) >> 32);
+}
+
+/**@brief Function for starting or stopping color loop, after new parameters have been loaded.
+ *
+ * @param[in] p_state       State with current parameters in @ref LED_MODE_HSB mode.
+ * @param[in] was_active    true if color loop was active with the previous parameters.
+ */
+static void color_loop_update(rgb_led_state_t * p_state, bool was_active)
+{
+    const led_params_t *       p_led_params = &p_state->curr_led_params;
+    rgb_led_hsb_transition_t * p_hue        = &p_state->hsb_transitions[HSB_CHANNEL_HUE];
+
+    if (color_loop_is_active(p_led_params) && !was_active)
+    {
+        /* Loop starts from the requested hue */
+        p_state->color_loop_phase = (uint32_t)(((uint64_t)p_led_params->hue << 32) / 254U);
+    }
+    else if (!color_loop_is_active(p_led_params) && was_active)
+    {
+        /* Hue goes from where the loop has stopped to the requested one, even if it is the one before the loop */
+        p_hue->value = color_loop_hue_get(p_state);
+        hsb_transition_start(p_hue, p_led_params->hue, p_led_params->hue_transition_time, p_led_params->hue_direction);
+    }
+    else
+    {
+        /* Ongoing loop continues with possibly new time and direction */
+    }
+}
+
+/**@brief Function for advancing color loop by one refresh period.
+ *
+ * @param[in] p_state   State with active color loop.
+ * @param[in] step_ms   Length of the refresh period.
+ */
+static void color_loop_step(rgb_led_state_t * p_state, uint32_t step_ms)
+{
+    const led_params_t * p_led_params = &p_state->curr_led_params;
+    uint32_t             increment;
+
+    /* Fraction of the full circle passed during the step, the phase wraps around naturally */
+    increment = (uint32_t)(((uint64_t)step_ms << 32) / ((uint32_t)p_led_params->color_loop_time * 1000U));
+
+    if (p_led_params->color_loop_direction == LED_PARAMS_COLOR_LOOP_DIRECTION_UP)
+    {
+        p_state->color_loop_phase += increment;
+    }
+    else
+    {
+        p_state->color_loop_phase -= increment;
+    }
+}
+
+/**@brief Function for generating RGB color compatible with RGB LED backend module from currently displayed
+ * values of color channels in @ref LED_MODE_HSB mode.
+ *
+ * @param[in] p_state   State with current parameters in @ref LED_MODE_HSB mode.
+ */
+static uint32_t make_rgb_color_from_hsb_transitions(const rgb_led_state_t * p_state)
+{
+    const rgb_led_hsb_transition_t * p_transitions = p_state->hsb_transitions;
+    int32_t                          hue           = p_transitions[HSB_CHANNEL_HUE].value;
+
+    if (p_state->curr_led_params.color_temperature != 0U)
+    {
+        return color_conv_ct_to_rgb((uint16_t)((p_transitions[HSB_CHANNEL_COLOR_TEMP].value + 0x80) >> 8),
+                                    (uint8_t)((p_transitions[HSB_CHANNEL_LEVEL].value + 0x80) >> 8));
+    }
+
+    if (color_loop_is_active(&p_state->curr_led_params))
+    {
+        hue = color_loop_hue_get(p_state);
+    }
+
+    /* Values are rounded to the nearest integer */
+    return color_conv_hsb_to_rgb((uint8_t)((hue + 0x80) >> 8),
+                                 (uint8_t)((p_transitions[HSB_CHANNEL_SATURATION].value + 0x80) >> 8),
+                                 (uint8_t)((p_transitions[HSB_CHANNEL_LEVEL].value + 0x80) >> 8));
+}
+
+/**@brief Function for transition to next breathe sequence
+ * @param[in] idx   Previous index to @ref c_led_breathe_brightness_sequence
+ * @return Next value of index to @ref c_led_breathe_brightness_sequence to have nice breathe effect */
+static size_t breathe_sequence_idx_next(size_t idx)
+{
+    idx++;
+    if (idx >= ARRAY_SIZE(c_led_breathe_brightness_sequence))
+    {
+        idx = 0U;
+    }
+    return idx;
+}
+
+void rgb_led_state_init(rgb_led_state_t * p_state)
+{
+    memset(p_state, 0, sizeof(rgb_led_state_t));
+    p_state->curr_led_params.mode = LED_MODE_OFF;
+}
+
+void rgb_led_state_load(rgb_led_state_t * p_state, const led_params_t * p_led_params, uint32_t now_ms)
+{
+    /* Colors can be smoothly changed only between two HSB states */
+    bool hsb_from_current      = (p_state->curr_led_params.mode == LED_MODE_HSB);
+    bool color_loop_was_active = hsb_from_current && color_loop_is_active(&p_state->curr_led_params);
+
+    p_state->curr_led_params = *p_led_params;
+    if (p_state->curr_led_params.mode == LED_MODE_HSB)
+    {
+        hsb_transitions_update(p_state, hsb_from_current);
+        color_loop_update(p_state, color_loop_was_active);
+    }
+    p_state->breathe_sequence_curr_idx = 0U;
+    p_state->breathe_delay_state       = false;
+    p_state->effect_start_timestamp    = now_ms;
+}
+
+void rgb_led_state_step(rgb_led_state_t * p_state, uint32_t now_ms, uint32_t step_ms)
+{
+    switch (p_state->curr_led_params.mode)
+    {
+        case LED_MODE_BREATHING:
+            if (!p_state->breathe_delay_state)
+            {
+                /* Generating breathe sequence */
+                p_state->breathe_sequence_curr_idx = breathe_sequence_idx_next(p_state->breathe_sequence_curr_idx);
+                if ((p_state->breathe_sequence_curr_idx == 0U) && (p_state->curr_led_params.delay >= step_ms))
+                {
+                    /* Just about to start a new breathe sequence, but need to wait a delay given by curr_led_params.delay */
+                    p_state->breathe_delay_state           = true;
+                    p_state->breathe_delay_start_timestamp = now_ms;
+                }
+            }
+            else if ( (uint32_t)(now_ms - p_state->breathe_delay_start_timestamp) >= p_state->curr_led_params.delay)
+            {
+                /* Delay after previous breathe sequence has just finished */
+                p_state->breathe_delay_state       = false;
+                p_state->breathe_sequence_curr_idx = breathe_sequence_idx_next(p_state->breathe_sequence_curr_idx);
+            }
+            else
+            {
+                /* Still in delay between breathes */
+            }
+            break;
+
+        case LED_MODE_ONE_SHOT:
+            p_state->breathe_sequence_curr_idx = breathe_sequence_idx_next(p_state->breathe_sequence_curr_idx);
+            if (p_state->breathe_sequence_curr_idx == 0U)
+            {
+                /* Breathe sequence has just finished */
+                p_state->curr_led_params.mode = LED_MODE_OFF;
+            }
+            break;
+
+        case LED_MODE_HSB:
+            hsb_transition_step(&p_state->hsb_transitions[HSB_CHANNEL_HUE], true, step_ms);
+            hsb_transition_step(&p_state->hsb_transitions[HSB_CHANNEL_SATURATION], false, step_ms);
+            hsb_transition_step(&p_state->hsb_transitions[HSB_CHANNEL_LEVEL], false, step_ms);
+            hsb_transition_step(&p_state->hsb_transitions[HSB_CHANNEL_COLOR_TEMP], false, step_ms);
+            if (color_loop_is_active(&p_state->curr_led_params) && (p_state->curr_led_params.color_temperature == 0U))
+            {
+                color_loop_step(p_state, step_ms);
+            }
+            break;
+
+        default:
+            /* No transitions required */
+            break;
+    }
+}
+
+bool rgb_led_state_is_animating(const rgb_led_state_t * p_state)
+{
+    size_t i;
+
+    switch (p_state->curr_led_params.mode)
+    {
+        case LED_MODE_BREATHING:
+        case LED_MODE_ONE_SHOT:
+            return true;
+
+        case LED_MODE_GRADIENT:
+        case LED_MODE_CHASE:
+        case LED_MODE_RAINBOW:
+        case LED_MODE_TWINKLE:
+            return (p_state->curr_led_params.period != 0U);
+
+        case LED_MODE_HSB:
+            /* Color loop of a light switched off or displaying color temperature is not visible, it is paused */
+            if (color_loop_is_active(&p_state->curr_led_params) &&
+                (p_state->curr_led_params.color_temperature == 0U) &&
+                (p_state->hsb_transitions[HSB_CHANNEL_LEVEL].value != 0))
+            {
+                return true;
+            }
+            for (i = 0; i < RGB_LED_STATE_HSB_CHANNELS_COUNT; i++)
+            {
+                if (p_state->hsb_transitions[i].elapsed_ms < p_state->hsb_transitions[i].duration_ms)
+                {
+                    return true;
+                }
+            }
+            return false;
+
+        default:
+            return false;
+    }
+}
+
+uint32_t rgb_led_state_color_get(const rgb_led_state_t * p_state)
+{
+    uint32_t color;
+
+    switch (p_state->curr_led_params.mode)
+    {
+        case LED_MODE_CONSTANT:
+            color = make_rgb_color_from_led_params_rgb(&p_state->curr_led_params);
+            break;
+
+        case LED_MODE_BREATHING:
+            /* no break, fall-through */
+        case LED_MODE_ONE_SHOT:
+            color = make_rgb_color_from_breathe_sequence(&p_state->curr_led_params,
+                                                         p_state->breathe_sequence_curr_idx);
+            break;
+
+        case LED_MODE_HSB:
+            color = make_rgb_color_from_hsb_transitions(p_state);
+            break;
+
+        case LED_MODE_OFF:
+            /* no break, fall-through */
+        default:
+            color = 0U;
+            break;
+    }
+
+    return color;
+}
+
+void rgb_led_state_render(const rgb_led_state_t * p_state, uint32_t now_ms, uint32_t * p_pixels, size_t pixels_count)
+{
+    uint32_t color;
+    size_t   i;
+
+    if (rgb_led_effect_is_frame_mode(p_state->curr_led_params.mode))
+    {
+        rgb_led_effect_render(&p_state->curr_led_params,
+                              (uint32_t)(now_ms - p_state->effect_start_timestamp),
+                              p_pixels,
+                              pixels_count);
+    }
+    else
+    {
+        color = rgb_led_state_color_get(p_state);
+        for (i = 0; i < pixels_count; i++)
+        {
+            p_pixels[i] = color;
+        }
+    }
+}
+
+/**
+ * @}
+ */
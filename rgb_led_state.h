@@ -0,0 +1,138 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @defgroup zigbee_examples_ble_zigbee_color_light_bulb_thingy rgb_led_state.h
+ * @{
+ * @ingroup zigbee_examples
+ *
+ * @brief State machine of a single LED segment, independent of timers and LED hardware.
+ *
+ * Time is passed explicitly by the caller, so the module can be driven by any clock.
+ */
+
+#ifndef RGB_LED_STATE_H__
+#define RGB_LED_STATE_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "rgb_led.h"
+
+/* Number of color channels in LED_MODE_HSB */
+#define RGB_LED_STATE_HSB_CHANNELS_COUNT    4U
+
+/* Transition of single color channel in LED_MODE_HSB. Values are stored in Q8.8 format. */
+typedef struct
+{
+    int32_t  value;         /**< Currently displayed value. */
+    int32_t  start;         /**< Value at the beginning of the transition. */
+    int32_t  delta;         /**< Change of value during the whole transition. */
+    uint32_t elapsed_ms;    /**< Time elapsed since the beginning of the transition. */
+    uint32_t duration_ms;   /**< Time of the whole transition. */
+    uint16_t target;        /**< Value at the end of the transition. */
+} rgb_led_hsb_transition_t;
+
+/* State of LED segment displaying given LED parameters */
+typedef struct
+{
+    led_params_t             curr_led_params;       /**< Parameters being displayed. */
+    uint32_t                 breathe_delay_start_timestamp;
+    bool                     breathe_delay_state;
+    size_t                   breathe_sequence_curr_idx;
+    uint32_t                 effect_start_timestamp;
+    rgb_led_hsb_transition_t hsb_transitions[RGB_LED_STATE_HSB_CHANNELS_COUNT];
+    uint32_t                 color_loop_phase;      /**< Hue in color loop, full circle is 2^32. The upper 16 bits are
+                                                         the enhanced hue, the lower ones accumulate fractional steps. */
+} rgb_led_state_t;
+
+/**@brief Function for initializing the state, with LED switched off.
+ *
+ * @param[out] p_state  State to be initialized.
+ */
+void rgb_led_state_init(rgb_led_state_t * p_state);
+
+/**@brief Function for starting display of new LED parameters.
+ *
+ * @param[inout] p_state        State to be updated.
+ * @param[in]    p_led_params   New LED parameters.
+ * @param[in]    now_ms         Current time, in milliseconds.
+ */
+void rgb_led_state_load(rgb_led_state_t * p_state, const led_params_t * p_led_params, uint32_t now_ms);
+
+/**@brief Function for advancing the state by one refresh period.
+ *
+ * @param[inout] p_state    State to be advanced.
+ * @param[in]    now_ms     Current time, in milliseconds.
+ * @param[in]    step_ms    Time elapsed since previous step, in milliseconds.
+ */
+void rgb_led_state_step(rgb_led_state_t * p_state, uint32_t now_ms, uint32_t step_ms);
+
+/**@brief Function for checking if displayed colors change in time without new parameters being loaded.
+ *
+ * @param[in] p_state   State to be checked.
+ *
+ * @return true if the state has to be advanced periodically.
+ */
+bool rgb_led_state_is_animating(const rgb_led_state_t * p_state);
+
+/**@brief Function for getting color of the state, if it is not rendered per pixel.
+ *
+ * @param[in] p_state   State to be displayed.
+ *
+ * @return Color in the format described for @ref rgb_led_backend_set_color.
+ */
+uint32_t rgb_led_state_color_get(const rgb_led_state_t * p_state);
+
+/**@brief Function for rendering colors of all pixels of the segment.
+ *
+ * @param[in]  p_state      State to be displayed.
+ * @param[in]  now_ms       Current time, in milliseconds.
+ * @param[out] p_pixels     Colors of consecutive pixels of the segment.
+ * @param[in]  pixels_count Number of pixels of the segment.
+ */
+void rgb_led_state_render(const rgb_led_state_t * p_state, uint32_t now_ms, uint32_t * p_pixels, size_t pixels_count);
+
+#endif /* RGB_LED_STATE_H__ */
+
+/**
+ * @}
+ */
@@ -45,15 +45,18 @@
  */
 #include <stdbool.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "nrf_log.h"
 #include "nrf_log_ctrl.h"
-#include "app_timer.h"
 #include "app_util_platform.h"
 #include "zboss_api.h"
 #include "zb_zcl_color_control.h"
 #include "zb_error_handler.h"
 #include "zigbee_color_light.h"
+#include "zigbee_color_light_scenes.h"
+#include "color_conv.h"
+#include "app_profiler.h"
 
 #define LIGHT_LOCATION_KITCHEN              0x1D
 #define LIGHT_LOCATION_OFFICE               0x24
@@ -69,97 +72,54 @@
 #define BULB_INIT_BASIC_LOCATION_DESC       "Office desk"                       /**< Describes the physical location of the device (16 bytes). May be modified during commisioning process. */
 #define BULB_INIT_BASIC_PH_ENV              LIGHT_LOCATION_OFFICE               /**< Describes the type of physical environment. For possible values see section 3.2.2.2.10 of ZCL specification. */
 #define BULB_LED_VISIBLE_TRESHOLD           90                                  /**< Threshold for Blink effect. */
-#define CHECK_VALUE_CHANGE_PERIOD           120                                 /**< Period of time [ms] to check if value of cluster is changing. */
+#define LIGHT_CTX_COUNT_MAX                 3                                   /**< Maximum number of light contexts (endpoints) handled by the module. */
+#define LIGHT_TRANSITION_TICK_TIME          1                                   /**< Period of remaining time countdown [1/10 s], equal to the ZCL RemainingTime attribute unit. */
+#define LIGHT_STEP_TRANSITION_TIME          1                                   /**< Transition time [1/10 s] smoothing out value changes not requested with transition time, e.g. steps of Move commands. */
+#define LIGHT_TRANSITION_TIME_DEFAULT       0xFFFF                              /**< Transition time value requesting usage of OnOffTransitionTime attribute. */
+#define LIGHT_COLOR_LOOP_UPDATE_ACTION      0x01                                /**< Color Loop Set update flag of action field. */
+#define LIGHT_COLOR_LOOP_UPDATE_DIRECTION   0x02                                /**< Color Loop Set update flag of direction field. */
+#define LIGHT_COLOR_LOOP_UPDATE_TIME        0x04                                /**< Color Loop Set update flag of time field. */
+#define LIGHT_COLOR_LOOP_UPDATE_START_HUE   0x08                                /**< Color Loop Set update flag of start hue field. */
+#define LIGHT_COLOR_LOOP_ACTION_DEACTIVATE  0x00                                /**< Color Loop Set action deactivating the loop. */
+#define LIGHT_COLOR_LOOP_ACTION_FROM_START  0x01                                /**< Color Loop Set action activating the loop from ColorLoopStartEnhancedHue. */
+#define LIGHT_COLOR_LOOP_ACTION_FROM_HUE    0x02                                /**< Color Loop Set action activating the loop from EnhancedCurrentHue. */
+
+/* Chromaticity coordinates of LED primaries (coordinate * 65536), defaults are typical for WS2812B */
+#ifndef LIGHT_PRIMARY_RED_X
+#define LIGHT_PRIMARY_RED_X                 45220                               /**< Red primary x = 0.690. */
+#define LIGHT_PRIMARY_RED_Y                 19661                               /**< Red primary y = 0.300. */
+#define LIGHT_PRIMARY_GREEN_X               11141                               /**< Green primary x = 0.170. */
+#define LIGHT_PRIMARY_GREEN_Y               47841                               /**< Green primary y = 0.730. */
+#define LIGHT_PRIMARY_BLUE_X                8520                                /**< Blue primary x = 0.130. */
+#define LIGHT_PRIMARY_BLUE_Y                4588                                /**< Blue primary y = 0.070. */
+#endif
+#ifndef LIGHT_WHITE_POINT_X
+#define LIGHT_WHITE_POINT_X                 20493                               /**< White of all primaries at full intensity, D65 x = 0.3127. */
+#define LIGHT_WHITE_POINT_Y                 21561                               /**< White of all primaries at full intensity, D65 y = 0.3290. */
+#endif
 
 extern void update_endpoint_led(zb_uint8_t ep, led_params_t * p_led_params);
 
-/* Define nrf app timer to handle too quick cluster attribute value changes in zboss stack */
-APP_TIMER_DEF(m_level_timer);
-APP_TIMER_DEF(m_effect_timer);
-static volatile bool                   m_effect_timer_active;
-static zb_color_light_ctx_t * volatile m_p_effect_timer_light_ctx;
+static bool                            m_effect_timer_active;
+static zb_color_light_ctx_t *          m_p_effect_timer_light_ctx;
+static zb_color_light_ctx_t *          m_p_light_ctxs[LIGHT_CTX_COUNT_MAX];
+static color_conv_xy_matrix_t          m_xy_matrix;
 
-/**@brief Function to convert hue_stauration to RGB color space.
- *
- * @param[IN]  hue          Hue value of color.
- * @param[IN]  saturation   Saturation value of color.
- * @param[IN]  brightness   Brightness value of color.
- * @param[OUT] p_led_params Pointer to structure containing parameters to write to LED characteristic
- */
-static void convert_hsb_to_rgb(uint8_t hue, uint8_t saturation, uint8_t brightness, led_params_t * p_rgb)
+static const color_conv_xy_t c_primaries[3] =
 {
-    /* Check if p_leds_params is not NULL pointer */
-    if (p_rgb == NULL)
-    {
-        NRF_LOG_INFO("Incorrect pointer to led params");
-        return;
-    }
-
-    /* C, X, m are auxiliary variables */
-    float C     = 0.0;
-    float X     = 0.0;
-    float m     = 0.0;
-    /* Convertion HSB --> RGB */
-    C = (brightness / 255.0f) * (saturation / 254.0f);
-    X = (hue / 254.0f) * 6.0f;
-    /* Casting in var X is necessary due to implementation of floating-point modulo_2 */
-    /*lint -e653 */
-    X = (X - (2 * (((uint8_t) X) / 2)));
-    /*lint -restore */
-    X -= 1.0f;
-    X = C * (1.0f - ((X > 0.0f) ? (X) : (-1.0f * X)));
-    m = (brightness / 255.0f) - C;
-
-    /* Hue value is stored in range (0 - 255) instead of (0 - 360) degree */
-    if (hue <= 42) /* hue < 60 degree */
-    {
-        p_rgb->r = (uint8_t)((C + m) * 255.0f);
-        p_rgb->g = (uint8_t)((X + m) * 255.0f);
-        p_rgb->b = (uint8_t)((0.0f + m) * 255.0f);
-    }
-    else if (hue <= 84)  /* hue < 120 degree */
-    {
-        p_rgb->r = (uint8_t)((X + m) * 255.0f);
-        p_rgb->g = (uint8_t)((C + m) * 255.0f);
-        p_rgb->b = (uint8_t)((0.0f + m) * 255.0f);
-    }
-    else if (hue <= 127) /* hue < 180 degree */
-    {
-        p_rgb->r = (uint8_t)((0.0f + m) * 255.0f);
-        p_rgb->g = (uint8_t)((C + m) * 255.0f);
-        p_rgb->b = (uint8_t)((X + m) * 255.0f);
-    }
-    else if (hue < 170)  /* hue < 240 degree */
-    {
-        p_rgb->r = (uint8_t)((0.0f + m) * 255.0f);
-        p_rgb->g = (uint8_t)((X + m) * 255.0f);
-        p_rgb->b = (uint8_t)((C + m) * 255.0f);
-    }
-    else if (hue <= 212) /* hue < 300 degree */
-    {
-        p_rgb->r = (uint8_t)((X + m) * 255.0f);
-        p_rgb->g = (uint8_t)((0.0f + m) * 255.0f);
-        p_rgb->b = (uint8_t)((C + m) * 255.0f);
-    }
-    else                /* hue < 360 degree */
-    {
-        p_rgb->r = (uint8_t)((C + m) * 255.0f);
-        p_rgb->g = (uint8_t)((0.0f + m) * 255.0f);
-        p_rgb->b = (uint8_t)((X + m) * 255.0f);
-    }
-}
+    {LIGHT_PRIMARY_RED_X,   LIGHT_PRIMARY_RED_Y},
+    {LIGHT_PRIMARY_GREEN_X, LIGHT_PRIMARY_GREEN_Y},
+    {LIGHT_PRIMARY_BLUE_X,  LIGHT_PRIMARY_BLUE_Y},
+};
+static const color_conv_xy_t c_white_point = {LIGHT_WHITE_POINT_X, LIGHT_WHITE_POINT_Y};
 
-/**@brief Function for updating RGB color value.
+/**@brief Function for updating LED with color stored in light context.
  *
  * @param[IN] p_ep_dev_ctx pointer to endpoint device ctx.
  */
 static void led_update_state(zb_color_light_ctx_t * p_light_ctx)
 {
-    convert_hsb_to_rgb(p_light_ctx->color_control_attr.set_color_info.current_hue,
-                       p_light_ctx->color_control_attr.set_color_info.current_saturation,
-                       p_light_ctx->level_control_attr.current_level,
-                       &p_light_ctx->led_params);
-
+    p_light_ctx->led_params.mode = LED_MODE_HSB;
     update_endpoint_led(p_light_ctx->ep_id, &p_light_ctx->led_params);
 }
 
@@ -169,10 +129,9 @@ static void led_update_state(zb_color_light_ctx_t * p_light_ctx)
  */
 static void led_off(zb_color_light_ctx_t * p_light_ctx)
 {
-    p_light_ctx->led_params.r = 0;
-    p_light_ctx->led_params.g = 0;
-    p_light_ctx->led_params.b = 0;
-    update_endpoint_led(p_light_ctx->ep_id, &p_light_ctx->led_params);
+    p_light_ctx->led_params.level                 = 0;
+    p_light_ctx->led_params.level_transition_time = 0;
+    led_update_state(p_light_ctx);
 }
 
 /**@brief Function for changing the hue of the light bulb.
@@ -191,7 +150,15 @@ static void light_set_hue(zb_color_light_ctx_t * p_light_ctx, zb_uint8_t hue)
                          &hue,
                          ZB_FALSE);                                  
 
-    led_update_state(p_light_ctx);
+    if (p_light_ctx->color_remaining_time == 0)
+    {
+        /* Not a step of transition already handled by zb_color_light_zcl_cmd_handler */
+        p_light_ctx->led_params.hue                 = hue;
+        p_light_ctx->led_params.hue_direction       = LED_PARAMS_HUE_DIRECTION_SHORTEST;
+        p_light_ctx->led_params.hue_transition_time = LIGHT_STEP_TRANSITION_TIME;
+        p_light_ctx->led_params.color_temperature   = 0;
+        led_update_state(p_light_ctx);
+    }
 }
 
 /**@brief Function for changing the saturation of the light bulb.
@@ -210,7 +177,100 @@ static void light_set_saturation(zb_color_light_ctx_t * p_light_ctx, zb_uint8_t
                          &saturation,                                       
                          ZB_FALSE);                                  
 
-    led_update_state(p_light_ctx);
+    if (p_light_ctx->color_remaining_time == 0)
+    {
+        p_light_ctx->led_params.saturation                 = saturation;
+        p_light_ctx->led_params.saturation_transition_time = LIGHT_STEP_TRANSITION_TIME;
+        p_light_ctx->led_params.color_temperature          = 0;
+        led_update_state(p_light_ctx);
+    }
+}
+
+/**@brief Function for converting chromaticity coordinates into hue and saturation displayed by the LED.
+ *
+ * @param[IN]  x             CurrentX value.
+ * @param[IN]  y             CurrentY value.
+ * @param[OUT] p_hue         Hue of the color.
+ * @param[OUT] p_saturation  Saturation of the color.
+ */
+static void light_xy_to_hs(zb_uint16_t x, zb_uint16_t y, zb_uint8_t * p_hue, zb_uint8_t * p_saturation)
+{
+    color_conv_xy_t xy =
+    {
+        .x = x,
+        .y = y,
+    };
+
+    color_conv_rgb_to_hs(color_conv_xy_to_rgb(&m_xy_matrix, &xy), p_hue, p_saturation);
+}
+
+/**@brief Function for changing the color of the light bulb given by chromaticity coordinates.
+ *
+ * @param[IN] p_light_ctx  Pointer to endpoint device ctx.
+ * @param[IN] x            New value for CurrentX.
+ * @param[IN] y            New value for CurrentY.
+ */
+static void light_set_xy(zb_color_light_ctx_t * p_light_ctx, zb_uint16_t x, zb_uint16_t y)
+{
+    zb_uint8_t hue;
+    zb_uint8_t saturation;
+
+    NRF_LOG_INFO("Set color x: %u y: %u on endpoint: %hu", x, y, p_light_ctx->ep_id);
+
+    ZB_ZCL_SET_ATTRIBUTE(p_light_ctx->ep_id,
+                         ZB_ZCL_CLUSTER_ID_COLOR_CONTROL,
+                         ZB_ZCL_CLUSTER_SERVER_ROLE,
+                         ZB_ZCL_ATTR_COLOR_CONTROL_CURRENT_X_ID,
+                         (zb_uint8_t *)&x,
+                         ZB_FALSE);
+    ZB_ZCL_SET_ATTRIBUTE(p_light_ctx->ep_id,
+                         ZB_ZCL_CLUSTER_ID_COLOR_CONTROL,
+                         ZB_ZCL_CLUSTER_SERVER_ROLE,
+                         ZB_ZCL_ATTR_COLOR_CONTROL_CURRENT_Y_ID,
+                         (zb_uint8_t *)&y,
+                         ZB_FALSE);
+
+    if (p_light_ctx->color_remaining_time == 0)
+    {
+        light_xy_to_hs(x, y, &hue, &saturation);
+        p_light_ctx->led_params.hue                        = hue;
+        p_light_ctx->led_params.hue_direction              = LED_PARAMS_HUE_DIRECTION_SHORTEST;
+        p_light_ctx->led_params.hue_transition_time        = LIGHT_STEP_TRANSITION_TIME;
+        p_light_ctx->led_params.saturation                 = saturation;
+        p_light_ctx->led_params.saturation_transition_time = LIGHT_STEP_TRANSITION_TIME;
+        p_light_ctx->led_params.color_temperature          = 0;
+        led_update_state(p_light_ctx);
+    }
+}
+
+/**@brief Function for limiting color temperature to the range supported by the LED. */
+static zb_uint16_t light_color_temperature_clamp(zb_uint16_t mireds)
+{
+    return MAX(MIN(mireds, COLOR_CONV_CT_MIREDS_MAX), COLOR_CONV_CT_MIREDS_MIN);
+}
+
+/**@brief Function for changing the color temperature of the light bulb.
+ *
+ * @param[IN] p_light_ctx  Pointer to endpoint device ctx.
+ * @param[IN] mireds       New value for color temperature.
+ */
+static void light_set_color_temperature(zb_color_light_ctx_t * p_light_ctx, zb_uint16_t mireds)
+{
+    NRF_LOG_INFO("Set color temperature value: %u on endpoint: %hu", mireds, p_light_ctx->ep_id);
+
+    ZB_ZCL_SET_ATTRIBUTE(p_light_ctx->ep_id,
+                         ZB_ZCL_CLUSTER_ID_COLOR_CONTROL,
+                         ZB_ZCL_CLUSTER_SERVER_ROLE,
+                         ZB_ZCL_ATTR_COLOR_CONTROL_COLOR_TEMPERATURE_ID,
+                         (zb_uint8_t *)&mireds,
+                         ZB_FALSE);
+
+    if (p_light_ctx->color_remaining_time == 0)
+    {
+        p_light_ctx->led_params.color_temperature                 = light_color_temperature_clamp(mireds);
+        p_light_ctx->led_params.color_temperature_transition_time = LIGHT_STEP_TRANSITION_TIME;
+        led_update_state(p_light_ctx);
+    }
 }
 
 /**@brief Function for setting the light bulb brightness.
@@ -250,7 +310,12 @@ static void light_set_brightness(zb_color_light_ctx_t * p_light_ctx, zb_uint16_t
                              ZB_FALSE);
     }
 
-    led_update_state(p_light_ctx);
+    if (p_light_ctx->level_remaining_time == 0)
+    {
+        p_light_ctx->led_params.level                 = (uint8_t)level;
+        p_light_ctx->led_params.level_transition_time = LIGHT_STEP_TRANSITION_TIME;
+        led_update_state(p_light_ctx);
+    }
 }
 
 /**@brief Function for turning ON/OFF the light bulb.
@@ -280,34 +345,541 @@ static void light_set_state(zb_color_light_ctx_t * p_light_ctx, zb_bool_t on)
     }
 }
 
-/**@brief Set level control value if stable.
+zb_color_light_ctx_t * zb_color_light_ctx_get(zb_uint8_t ep_id)
+{
+    for (uint_fast8_t i = 0; i < LIGHT_CTX_COUNT_MAX; i++)
+    {
+        if ((m_p_light_ctxs[i] != NULL) && (m_p_light_ctxs[i]->ep_id == ep_id))
+        {
+            return m_p_light_ctxs[i];
+        }
+    }
+
+    return NULL;
+}
+
+/**@brief Function for counting down remaining time of ongoing transitions.
+ *
+ * Updates RemainingTime attributes of Level Control and Color Control clusters. Once a transition is finished,
+ * values reported by the stack are displayed directly again.
+ *
+ * @param[IN] ep_id  Endpoint ID of light context.
+ */
+static zb_void_t transition_countdown_handler(zb_uint8_t ep_id)
+{
+    zb_color_light_ctx_t * p_light_ctx = zb_color_light_ctx_get(ep_id);
+    zb_bool_t              pending     = ZB_FALSE;
+    zb_ret_t               zb_err_code;
+
+    if (p_light_ctx == NULL)
+    {
+        return;
+    }
+
+    if (p_light_ctx->level_remaining_time > 0)
+    {
+        p_light_ctx->level_remaining_time = (p_light_ctx->level_remaining_time > LIGHT_TRANSITION_TICK_TIME) ?
+                                            (p_light_ctx->level_remaining_time - LIGHT_TRANSITION_TICK_TIME) : 0;
+        ZB_ZCL_SET_ATTRIBUTE(p_light_ctx->ep_id,
+                             ZB_ZCL_CLUSTER_ID_LEVEL_CONTROL,
+                             ZB_ZCL_CLUSTER_SERVER_ROLE,
+                             ZB_ZCL_ATTR_LEVEL_CONTROL_REMAINING_TIME_ID,
+                             (zb_uint8_t *)&p_light_ctx->level_remaining_time,
+                             ZB_FALSE);
+        pending |= (p_light_ctx->level_remaining_time > 0);
+    }
+
+    if (p_light_ctx->color_remaining_time > 0)
+    {
+        p_light_ctx->color_remaining_time = (p_light_ctx->color_remaining_time > LIGHT_TRANSITION_TICK_TIME) ?
+                                            (p_light_ctx->color_remaining_time - LIGHT_TRANSITION_TICK_TIME) : 0;
+        ZB_ZCL_SET_ATTRIBUTE(p_light_ctx->ep_id,
+                             ZB_ZCL_CLUSTER_ID_COLOR_CONTROL,
+                             ZB_ZCL_CLUSTER_SERVER_ROLE,
+                             ZB_ZCL_ATTR_COLOR_CONTROL_REMAINING_TIME_ID,
+                             (zb_uint8_t *)&p_light_ctx->color_remaining_time,
+                             ZB_FALSE);
+        pending |= (p_light_ctx->color_remaining_time > 0);
+    }
+
+    if (pending)
+    {
+        zb_err_code = ZB_SCHEDULE_APP_ALARM(transition_countdown_handler,
+                                            ep_id,
+                                            ZB_MILLISECONDS_TO_BEACON_INTERVAL(100 * LIGHT_TRANSITION_TICK_TIME));
+        ZB_ERROR_CHECK(zb_err_code);
+    }
+}
+
+/**@brief Function for (re)starting countdown of remaining time of transitions.
  *
- * This function checks if level control attribute is stable. If so then
- * the LED value is updated. If not another check is scheduled.
+ * @param[IN] p_light_ctx  Pointer to light context.
+ */
+static void transition_countdown_start(zb_color_light_ctx_t * p_light_ctx)
+{
+    zb_ret_t zb_err_code;
+
+    UNUSED_RETURN_VALUE(ZB_SCHEDULE_APP_ALARM_CANCEL(transition_countdown_handler, p_light_ctx->ep_id));
+
+    ZB_ZCL_SET_ATTRIBUTE(p_light_ctx->ep_id,
+                         ZB_ZCL_CLUSTER_ID_LEVEL_CONTROL,
+                         ZB_ZCL_CLUSTER_SERVER_ROLE,
+                         ZB_ZCL_ATTR_LEVEL_CONTROL_REMAINING_TIME_ID,
+                         (zb_uint8_t *)&p_light_ctx->level_remaining_time,
+                         ZB_FALSE);
+
+    ZB_ZCL_SET_ATTRIBUTE(p_light_ctx->ep_id,
+                         ZB_ZCL_CLUSTER_ID_COLOR_CONTROL,
+                         ZB_ZCL_CLUSTER_SERVER_ROLE,
+                         ZB_ZCL_ATTR_COLOR_CONTROL_REMAINING_TIME_ID,
+                         (zb_uint8_t *)&p_light_ctx->color_remaining_time,
+                         ZB_FALSE);
+
+    if ((p_light_ctx->level_remaining_time > 0) || (p_light_ctx->color_remaining_time > 0))
+    {
+        zb_err_code = ZB_SCHEDULE_APP_ALARM(transition_countdown_handler,
+                                            p_light_ctx->ep_id,
+                                            ZB_MILLISECONDS_TO_BEACON_INTERVAL(100 * LIGHT_TRANSITION_TICK_TIME));
+        ZB_ERROR_CHECK(zb_err_code);
+    }
+}
+
+/**@brief Function for starting level transition requested by a command.
  *
- * @param[IN]   context   Void pointer to context function is called with.
+ * @param[IN] p_light_ctx      Pointer to light context.
+ * @param[IN] level            Target level.
+ * @param[IN] transition_time  Transition time [1/10 s].
+ */
+static void level_transition_start(zb_color_light_ctx_t * p_light_ctx, zb_uint8_t level, zb_uint16_t transition_time)
+{
+    if (transition_time == LIGHT_TRANSITION_TIME_DEFAULT)
+    {
+        /* OnOffTransitionTime attribute is not supported, move as fast as possible */
+        transition_time = 0;
+    }
+
+    NRF_LOG_INFO("Level transition to %hu in %hu on endpoint: %hu", level, transition_time, p_light_ctx->ep_id);
+
+    p_light_ctx->led_params.level                 = level;
+    p_light_ctx->led_params.level_transition_time = transition_time;
+    p_light_ctx->level_remaining_time             = transition_time;
+    led_update_state(p_light_ctx);
+    transition_countdown_start(p_light_ctx);
+}
+
+/**@brief Function for starting hue and saturation transition requested by a command.
  *
- * @details Function is called with pointer to zb_color_light_ctx_t as argument.
+ * @param[IN] p_light_ctx      Pointer to light context.
+ * @param[IN] hue              Target hue.
+ * @param[IN] saturation       Target saturation.
+ * @param[IN] direction        Direction of hue change, one of LED_PARAMS_HUE_DIRECTION_*.
+ * @param[IN] transition_time  Transition time [1/10 s].
  */
-static void level_timer_handler(void * context)
+static void color_transition_start(zb_color_light_ctx_t * p_light_ctx,
+                                   zb_uint8_t             hue,
+                                   zb_uint8_t             saturation,
+                                   zb_uint8_t             direction,
+                                   zb_uint16_t            transition_time)
 {
-    zb_color_light_ctx_t  * p_device         = (zb_color_light_ctx_t *)context;
-    zb_uint8_t            * p_lvl_ctrl_value = &p_device->level_control_attr.current_level;
+    NRF_LOG_INFO("Color transition to %hu/%hu in %hu on endpoint: %hu", hue, saturation, transition_time, p_light_ctx->ep_id);
+
+    p_light_ctx->led_params.hue                        = hue;
+    p_light_ctx->led_params.hue_direction              = direction;
+    p_light_ctx->led_params.hue_transition_time        = transition_time;
+    p_light_ctx->led_params.saturation                 = saturation;
+    p_light_ctx->led_params.saturation_transition_time = transition_time;
+    p_light_ctx->led_params.color_temperature          = 0;
+    p_light_ctx->color_remaining_time                  = transition_time;
+    led_update_state(p_light_ctx);
+    transition_countdown_start(p_light_ctx);
+}
+
+/**@brief Function for starting color temperature transition rendered by rgb_led module.
+ *
+ * @param[IN] p_light_ctx      Pointer to light context.
+ * @param[IN] mireds           Target color temperature.
+ * @param[IN] transition_time  Transition time [1/10 s].
+ */
+static void color_temperature_transition_start(zb_color_light_ctx_t * p_light_ctx,
+                                               zb_uint16_t            mireds,
+                                               zb_uint16_t            transition_time)
+{
+    NRF_LOG_INFO("Color temperature transition to %u in %hu on endpoint: %hu", mireds, transition_time, p_light_ctx->ep_id);
+
+    p_light_ctx->led_params.color_temperature                 = light_color_temperature_clamp(mireds);
+    p_light_ctx->led_params.color_temperature_transition_time = transition_time;
+    p_light_ctx->color_remaining_time                         = transition_time;
+    led_update_state(p_light_ctx);
+    transition_countdown_start(p_light_ctx);
+}
+
+/**@brief Function for reading little endian 16-bit value from command payload. */
+static zb_uint16_t payload_uint16_get(const zb_uint8_t * p_data)
+{
+    return (zb_uint16_t)(p_data[0] | ((zb_uint16_t)p_data[1] << 8));
+}
+
+/**@brief Function for handling Color Loop Set command.
+ *
+ * The loop runs in rgb_led module, so hue attributes are not updated while it is active. Once it is deactivated,
+ * hue stored at its activation is restored.
+ *
+ * @param[IN] p_light_ctx  Pointer to light context.
+ * @param[IN] p_payload    Command payload: update flags (1 byte), action (1 byte), direction (1 byte),
+ *                         time (2 bytes), start hue (2 bytes).
+ */
+static void color_loop_set(zb_color_light_ctx_t * p_light_ctx, const zb_uint8_t * p_payload)
+{
+    zb_zcl_color_ctrl_attrs_set_color_inf_t * p_color_info = &p_light_ctx->color_control_attr.set_color_info;
+    zb_uint8_t                                flags        = p_payload[0];
+    zb_uint8_t                                hue;
+
+    if (flags & LIGHT_COLOR_LOOP_UPDATE_DIRECTION)
+    {
+        p_color_info->color_loop_direction = p_payload[2];
+    }
+    if (flags & LIGHT_COLOR_LOOP_UPDATE_TIME)
+    {
+        p_color_info->color_loop_time = payload_uint16_get(&p_payload[3]);
+    }
+    if (flags & LIGHT_COLOR_LOOP_UPDATE_START_HUE)
+    {
+        p_color_info->color_loop_start_enhanced_hue = payload_uint16_get(&p_payload[5]);
+    }
 
-    if (p_device->prev_lvl_ctrl_value == *p_lvl_ctrl_value)
+    if (flags & LIGHT_COLOR_LOOP_UPDATE_ACTION)
     {
-        p_device->value_unstable = ZB_FALSE;
-        light_set_brightness(p_device, *p_lvl_ctrl_value);
+        switch (p_payload[1])
+        {
+            case LIGHT_COLOR_LOOP_ACTION_DEACTIVATE:
+                if (p_color_info->color_loop_active)
+                {
+                    p_color_info->color_loop_active    = ZB_FALSE;
+                    p_color_info->enhanced_current_hue = p_color_info->color_loop_stored_enhanced_hue;
+                    hue                                = (zb_uint8_t)(p_color_info->enhanced_current_hue >> 8);
+                    ZB_ZCL_SET_ATTRIBUTE(p_light_ctx->ep_id,
+                                         ZB_ZCL_CLUSTER_ID_COLOR_CONTROL,
+                                         ZB_ZCL_CLUSTER_SERVER_ROLE,
+                                         ZB_ZCL_ATTR_COLOR_CONTROL_CURRENT_HUE_ID,
+                                         &hue,
+                                         ZB_FALSE);
+                    p_light_ctx->led_params.hue                 = hue;
+                    p_light_ctx->led_params.hue_direction       = LED_PARAMS_HUE_DIRECTION_SHORTEST;
+                    p_light_ctx->led_params.hue_transition_time = LIGHT_STEP_TRANSITION_TIME;
+                }
+                break;
+
+            case LIGHT_COLOR_LOOP_ACTION_FROM_START:
+            case LIGHT_COLOR_LOOP_ACTION_FROM_HUE:
+                /* CurrentHue is the one kept up to date by this module. A loop which is already active
+                 * continues, only its time and direction are updated. */
+                p_color_info->enhanced_current_hue           = (zb_uint16_t)p_color_info->current_hue << 8;
+                p_color_info->color_loop_stored_enhanced_hue = p_color_info->enhanced_current_hue;
+                p_color_info->color_loop_active              = ZB_TRUE;
+                p_light_ctx->led_params.color_temperature    = 0;
+                p_light_ctx->led_params.hue = (zb_uint8_t)(((p_payload[1] == LIGHT_COLOR_LOOP_ACTION_FROM_START) ?
+                                                            p_color_info->color_loop_start_enhanced_hue :
+                                                            p_color_info->enhanced_current_hue) >> 8);
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    NRF_LOG_INFO("Color loop %hu, time %hu s, direction %hu on endpoint: %hu",
+                 p_color_info->color_loop_active, p_color_info->color_loop_time,
+                 p_color_info->color_loop_direction, p_light_ctx->ep_id);
+
+    if (p_color_info->color_loop_active)
+    {
+        /* Time 0 would stop the loop, run it as fast as possible instead */
+        p_light_ctx->led_params.color_loop_time      = MAX(p_color_info->color_loop_time, 1);
+        p_light_ctx->led_params.color_loop_direction = p_color_info->color_loop_direction;
     }
     else
     {
-        ret_code_t err_code;
-        err_code = app_timer_start(m_level_timer,
-                                   APP_TIMER_TICKS(CHECK_VALUE_CHANGE_PERIOD),
-                                   context);
-        APP_ERROR_CHECK(err_code);
+        p_light_ctx->led_params.color_loop_time = 0;
+    }
+    led_update_state(p_light_ctx);
+}
+
+/**@brief Function for updating Scenes cluster attributes after the scene table has changed.
+ *
+ * @param[IN] p_light_ctx  Pointer to light context.
+ */
+static void scenes_attr_update(zb_color_light_ctx_t * p_light_ctx)
+{
+    zb_zcl_scenes_attrs_t * p_scenes_attr = &p_light_ctx->scenes_attr;
 
-        p_device->prev_lvl_ctrl_value = *p_lvl_ctrl_value;
+    p_scenes_attr->scene_count = zb_color_light_scenes_count_get(p_light_ctx->ep_id);
+    if (zb_color_light_scene_find(p_light_ctx->ep_id,
+                                  p_scenes_attr->current_group,
+                                  p_scenes_attr->current_scene) == NULL)
+    {
+        p_scenes_attr->scene_valid = ZB_FALSE;
+    }
+}
+
+/**@brief Function for filling a scene with the current state of the light.
+ *
+ * @param[IN]  p_light_ctx  Pointer to light context.
+ * @param[OUT] p_scene      Scene to be filled, except group ID, scene ID and transition time.
+ */
+static void scene_current_get(zb_color_light_ctx_t * p_light_ctx, zb_color_light_scene_t * p_scene)
+{
+    memset(p_scene, 0, sizeof(*p_scene));
+    p_scene->ep_id      = p_light_ctx->ep_id;
+    p_scene->on_off     = p_light_ctx->on_off_attr.on_off;
+    p_scene->level      = p_light_ctx->level_control_attr.current_level;
+    p_scene->hue        = p_light_ctx->color_control_attr.set_color_info.current_hue;
+    p_scene->saturation = p_light_ctx->color_control_attr.set_color_info.current_saturation;
+}
+
+/**@brief Function for storing a scene in the scene table.
+ *
+ * @param[IN] p_light_ctx  Pointer to light context.
+ * @param[IN] p_scene      Scene to be stored.
+ */
+static void scene_save(zb_color_light_ctx_t * p_light_ctx, const zb_color_light_scene_t * p_scene)
+{
+    ret_code_t err_code = zb_color_light_scene_store(p_scene);
+
+    if (err_code == NRF_SUCCESS)
+    {
+        NRF_LOG_INFO("Scene %hu/%hu stored on endpoint: %hu, flash operations: %u",
+                     p_scene->group_id, p_scene->scene_id, p_light_ctx->ep_id, zb_color_light_scenes_flash_ops_get());
+    }
+    else
+    {
+        NRF_LOG_WARNING("Scene %hu/%hu not stored on endpoint: %hu, error: %d",
+                        p_scene->group_id, p_scene->scene_id, p_light_ctx->ep_id, err_code);
+    }
+    scenes_attr_update(p_light_ctx);
+}
+
+/**@brief Function for handling Add Scene command.
+ *
+ * Values of attributes not included in extension field sets are taken from the current state of the light.
+ *
+ * @param[IN] p_light_ctx  Pointer to light context.
+ * @param[IN] p_payload    Command payload.
+ * @param[IN] length       Length of the payload.
+ */
+static void scene_add(zb_color_light_ctx_t * p_light_ctx, const zb_uint8_t * p_payload, zb_uint_t length)
+{
+    zb_color_light_scene_t scene;
+    zb_uint_t              pos;
+
+    /* Payload: group ID (2 bytes), scene ID (1 byte), transition time (2 bytes), scene name (string),
+     * extension field sets, each: cluster ID (2 bytes), length (1 byte), attribute values */
+    if ((length < 6) || (length < (6U + p_payload[5])))
+    {
+        return;
+    }
+
+    scene_current_get(p_light_ctx, &scene);
+    scene.group_id        = payload_uint16_get(&p_payload[0]);
+    scene.scene_id        = p_payload[2];
+    scene.transition_time = payload_uint16_get(&p_payload[3]);
+
+    for (pos = 6U + p_payload[5]; (pos + 3U) <= length; pos += 3U + p_payload[pos + 2U])
+    {
+        zb_uint16_t        cluster_id = payload_uint16_get(&p_payload[pos]);
+        zb_uint8_t         set_length = p_payload[pos + 2U];
+        const zb_uint8_t * p_set      = &p_payload[pos + 3U];
+
+        if ((pos + 3U + set_length) > length)
+        {
+            break;
+        }
+
+        if ((cluster_id == ZB_ZCL_CLUSTER_ID_ON_OFF) && (set_length >= 1))
+        {
+            scene.on_off = p_set[0];
+        }
+        else if ((cluster_id == ZB_ZCL_CLUSTER_ID_LEVEL_CONTROL) && (set_length >= 1))
+        {
+            scene.level = p_set[0];
+        }
+        else if ((cluster_id == ZB_ZCL_CLUSTER_ID_COLOR_CONTROL) && (set_length >= 7))
+        {
+            /* CurrentX (2 bytes), CurrentY (2 bytes), EnhancedCurrentHue (2 bytes), CurrentSaturation (1 byte), ... */
+            scene.hue        = (zb_uint8_t)(payload_uint16_get(&p_set[4]) >> 8);
+            scene.saturation = p_set[6];
+        }
+        else
+        {
+            /* Attributes of other clusters are not part of the scene */
+        }
+    }
+
+    scene_save(p_light_ctx, &scene);
+}
+
+/**@brief Function for handling Store Scene command.
+ *
+ * @param[IN] p_light_ctx  Pointer to light context.
+ * @param[IN] group_id     Group ID of the scene.
+ * @param[IN] scene_id     Scene ID.
+ */
+static void scene_store_current(zb_color_light_ctx_t * p_light_ctx, zb_uint16_t group_id, zb_uint8_t scene_id)
+{
+    const zb_color_light_scene_t * p_stored = zb_color_light_scene_find(p_light_ctx->ep_id, group_id, scene_id);
+    zb_color_light_scene_t         scene;
+
+    scene_current_get(p_light_ctx, &scene);
+    scene.group_id        = group_id;
+    scene.scene_id        = scene_id;
+    /* Transition time of an existing scene is kept */
+    scene.transition_time = (p_stored != NULL) ? p_stored->transition_time : 0;
+
+    scene_save(p_light_ctx, &scene);
+
+    p_light_ctx->scenes_attr.current_group = group_id;
+    p_light_ctx->scenes_attr.current_scene = scene_id;
+    p_light_ctx->scenes_attr.scene_valid   = (zb_color_light_scene_find(p_light_ctx->ep_id, group_id, scene_id) != NULL);
+}
+
+/**@brief Function for handling Recall Scene command.
+ *
+ * Stored values are written to the clusters attributes and displayed directly, within one refresh of the LED.
+ *
+ * @param[IN] p_light_ctx      Pointer to light context.
+ * @param[IN] group_id         Group ID of the scene.
+ * @param[IN] scene_id         Scene ID.
+ * @param[IN] transition_time  Transition time [1/10 s], LIGHT_TRANSITION_TIME_DEFAULT to use the one of the scene.
+ */
+static void scene_recall(zb_color_light_ctx_t * p_light_ctx,
+                         zb_uint16_t            group_id,
+                         zb_uint8_t             scene_id,
+                         zb_uint16_t            transition_time)
+{
+    const zb_color_light_scene_t * p_scene;
+    zb_uint8_t                     value;
+    APP_PROFILER_STAGE_BEGIN(APP_PROFILER_STAGE_SCENE_RECALL);
+
+    p_scene = zb_color_light_scene_find(p_light_ctx->ep_id, group_id, scene_id);
+    if (p_scene != NULL)
+    {
+        if (transition_time == LIGHT_TRANSITION_TIME_DEFAULT)
+        {
+            transition_time = p_scene->transition_time;
+        }
+
+        NRF_LOG_INFO("Recall scene %hu/%hu on endpoint: %hu", group_id, scene_id, p_light_ctx->ep_id);
+
+        value = p_scene->on_off;
+        ZB_ZCL_SET_ATTRIBUTE(p_light_ctx->ep_id,
+                             ZB_ZCL_CLUSTER_ID_ON_OFF,
+                             ZB_ZCL_CLUSTER_SERVER_ROLE,
+                             ZB_ZCL_ATTR_ON_OFF_ON_OFF_ID,
+                             &value,
+                             ZB_FALSE);
+        value = p_scene->level;
+        ZB_ZCL_SET_ATTRIBUTE(p_light_ctx->ep_id,
+                             ZB_ZCL_CLUSTER_ID_LEVEL_CONTROL,
+                             ZB_ZCL_CLUSTER_SERVER_ROLE,
+                             ZB_ZCL_ATTR_LEVEL_CONTROL_CURRENT_LEVEL_ID,
+                             &value,
+                             ZB_FALSE);
+        value = p_scene->hue;
+        ZB_ZCL_SET_ATTRIBUTE(p_light_ctx->ep_id,
+                             ZB_ZCL_CLUSTER_ID_COLOR_CONTROL,
+                             ZB_ZCL_CLUSTER_SERVER_ROLE,
+                             ZB_ZCL_ATTR_COLOR_CONTROL_CURRENT_HUE_ID,
+                             &value,
+                             ZB_FALSE);
+        value = p_scene->saturation;
+        ZB_ZCL_SET_ATTRIBUTE(p_light_ctx->ep_id,
+                             ZB_ZCL_CLUSTER_ID_COLOR_CONTROL,
+                             ZB_ZCL_CLUSTER_SERVER_ROLE,
+                             ZB_ZCL_ATTR_COLOR_CONTROL_CURRENT_SATURATION_ID,
+                             &value,
+                             ZB_FALSE);
+
+        color_transition_start(p_light_ctx,
+                               p_scene->hue,
+                               p_scene->saturation,
+                               LED_PARAMS_HUE_DIRECTION_SHORTEST,
+                               transition_time);
+        if (p_scene->on_off)
+        {
+            level_transition_start(p_light_ctx, p_scene->level, transition_time);
+        }
+        else
+        {
+            led_off(p_light_ctx);
+        }
+
+        p_light_ctx->scenes_attr.current_group = group_id;
+        p_light_ctx->scenes_attr.current_scene = scene_id;
+        p_light_ctx->scenes_attr.scene_valid   = ZB_TRUE;
+    }
+
+    APP_PROFILER_STAGE_END(APP_PROFILER_STAGE_SCENE_RECALL);
+}
+
+/**@brief Function for keeping the scene table up to date with Scenes cluster commands.
+ *
+ * @param[IN] p_light_ctx  Pointer to light context.
+ * @param[IN] cmd_id       Command ID.
+ * @param[IN] p_payload    Command payload.
+ * @param[IN] length       Length of the payload.
+ */
+static void scenes_cmd_handle(zb_color_light_ctx_t * p_light_ctx,
+                              zb_uint8_t             cmd_id,
+                              const zb_uint8_t     * p_payload,
+                              zb_uint_t              length)
+{
+    switch (cmd_id)
+    {
+        case ZB_ZCL_CMD_SCENES_ADD_SCENE:
+            scene_add(p_light_ctx, p_payload, length);
+            break;
+
+        case ZB_ZCL_CMD_SCENES_STORE_SCENE:
+            /* Payload: group ID (2 bytes), scene ID (1 byte) */
+            if (length >= 3)
+            {
+                scene_store_current(p_light_ctx, payload_uint16_get(&p_payload[0]), p_payload[2]);
+            }
+            break;
+
+        case ZB_ZCL_CMD_SCENES_RECALL_SCENE:
+            /* Payload: group ID (2 bytes), scene ID (1 byte), optional transition time (2 bytes) */
+            if (length >= 3)
+            {
+                scene_recall(p_light_ctx,
+                             payload_uint16_get(&p_payload[0]),
+                             p_payload[2],
+                             (length >= 5) ? payload_uint16_get(&p_payload[3]) : LIGHT_TRANSITION_TIME_DEFAULT);
+            }
+            break;
+
+        case ZB_ZCL_CMD_SCENES_REMOVE_SCENE:
+            /* Payload: group ID (2 bytes), scene ID (1 byte) */
+            if (length >= 3)
+            {
+                UNUSED_RETURN_VALUE(zb_color_light_scene_remove(p_light_ctx->ep_id,
+                                                                payload_uint16_get(&p_payload[0]),
+                                                                p_payload[2]));
+                scenes_attr_update(p_light_ctx);
+            }
+            break;
+
+        case ZB_ZCL_CMD_SCENES_REMOVE_ALL_SCENES:
+            /* Payload: group ID (2 bytes) */
+            if (length >= 2)
+            {
+                UNUSED_RETURN_VALUE(zb_color_light_scenes_remove_all(p_light_ctx->ep_id,
+                                                                     payload_uint16_get(&p_payload[0])));
+                scenes_attr_update(p_light_ctx);
+            }
+            break;
+
+        default:
+            break;
     }
 }
 
@@ -386,46 +958,53 @@ static void clusters_attr_init(zb_color_light_ctx_t * p_light_ctx)
     p_color_info->color_mode          = ZB_ZCL_COLOR_CONTROL_COLOR_MODE_HUE_SATURATION;
     p_color_info->color_temperature   = ZB_ZCL_COLOR_CONTROL_COLOR_TEMPERATURE_DEF_VALUE;
     p_color_info->remaining_time      = ZB_ZCL_COLOR_CONTROL_REMAINING_TIME_MIN_VALUE;
-    p_color_info->color_capabilities  = ZB_ZCL_COLOR_CONTROL_CAPABILITIES_HUE_SATURATION;
+    p_color_info->color_capabilities  = ZB_ZCL_COLOR_CONTROL_CAPABILITIES_HUE_SATURATION |
+                                        ZB_ZCL_COLOR_CONTROL_CAPABILITIES_X_Y |
+                                        ZB_ZCL_COLOR_CONTROL_CAPABILITIES_COLOR_TEMP;
+    /* Range of color temperatures covered by color_conv_ct_to_rgb */
+    p_color_info->color_temp_physical_min_mireds        = COLOR_CONV_CT_MIREDS_MIN;
+    p_color_info->color_temp_physical_max_mireds        = COLOR_CONV_CT_MIREDS_MAX;
+    p_color_info->couple_color_temp_to_level_min_mireds = COLOR_CONV_CT_MIREDS_MIN;
+    p_color_info->start_up_color_temp_mireds            = ZB_ZCL_COLOR_CONTROL_COLOR_TEMPERATURE_DEF_VALUE;
     /* According to ZCL spec 5.2.2.2.1.12 0x00 shall be set when CurrentHue and CurrentSaturation are used. */
     p_color_info->enhanced_color_mode = 0x00;
     /* According to 5.2.2.2.1.10 execute commands when device is off. */
     p_color_info->options             = ZB_ZCL_COLOR_CONTROL_OPTIONS_EXECUTE_IF_OFF;
-    /* According to ZCL spec 5.2.2.2.2 0xFF shall be set when specific value is unknown. */
-    p_light_ctx->color_control_attr.set_defined_primaries_info.number_primaries = 0xff;
+    /* Primaries used for conversion of CurrentX and CurrentY */
+    p_light_ctx->color_control_attr.set_defined_primaries_info.number_primaries = ARRAY_SIZE(c_primaries);
+    p_light_ctx->color_control_attr.set_defined_primaries_info.primary_1_X      = c_primaries[0].x;
+    p_light_ctx->color_control_attr.set_defined_primaries_info.primary_1_Y      = c_primaries[0].y;
+    p_light_ctx->color_control_attr.set_defined_primaries_info.primary_2_X      = c_primaries[1].x;
+    p_light_ctx->color_control_attr.set_defined_primaries_info.primary_2_Y      = c_primaries[1].y;
+    p_light_ctx->color_control_attr.set_defined_primaries_info.primary_3_X      = c_primaries[2].x;
+    p_light_ctx->color_control_attr.set_defined_primaries_info.primary_3_Y      = c_primaries[2].y;
+
+    /* Scenes cluster attributes data, scene names are not stored */
+    p_light_ctx->scenes_attr.scene_count  = zb_color_light_scenes_count_get(p_light_ctx->ep_id);
+    p_light_ctx->scenes_attr.scene_valid  = ZB_FALSE;
+    p_light_ctx->scenes_attr.name_support = 0;
 }
 
-/**@brief Clears bool variable in ISR-safe manner (atomically), returns value as it was just before the operation.
- * @param p_variable    Pointer to variable to be read and cleared atomically
- * @return Value of the variable just before the operation
+/**@brief Function for stopping an identify effect once its time has elapsed.
+ *
+ * Runs from the ZBOSS scheduler like every other writer of the LED parameters, so it never preempts
+ * an update of the same segment, see @ref rgb_led_segment_update.
+ *
+ * @param[IN] ep_id  Endpoint ID of light context.
  */
-static bool prv_atomic_bool_test_and_clear(volatile bool * p_variable)
+static zb_void_t effect_timer_handler(zb_uint8_t ep_id)
 {
-    bool    result;
-
-    CRITICAL_REGION_ENTER();
-
-    result      = *p_variable;
-    *p_variable = false;
-
-    CRITICAL_REGION_EXIT();
+    zb_color_light_ctx_t * p_light_ctx = zb_color_light_ctx_get(ep_id);
+    zb_ret_t               ret;
 
-    return result;
-}
+    m_effect_timer_active = false;
 
-static void effect_timer_handler(void * context)
-{
-    if (!prv_atomic_bool_test_and_clear(&m_effect_timer_active))
+    if (p_light_ctx != NULL)
     {
-        return;
+        ret = zb_color_light_do_identify_effect(p_light_ctx,
+                                                ZB_ZCL_IDENTIFY_EFFECT_ID_STOP);
+        UNUSED_RETURN_VALUE(ret);
     }
-
-    zb_color_light_ctx_t * p_light_ctx = (zb_color_light_ctx_t *)context;
-    zb_ret_t               ret;
-
-    ret = zb_color_light_do_identify_effect(p_light_ctx,
-                                            ZB_ZCL_IDENTIFY_EFFECT_ID_STOP);
-    UNUSED_RETURN_VALUE(ret);
 }
 
 
@@ -434,21 +1013,28 @@ zb_ret_t zb_color_light_do_identify_effect(zb_color_light_ctx_t * p_light_ctx,
 {
     uint8_t      effect_time = 0; // in seconds, 0 for indefinite effect
     led_params_t led_params;
-    ret_code_t   err_code = NRF_SUCCESS;
+    zb_ret_t     zb_err_code = RET_OK;
 
     NRF_LOG_INFO("Identify effect %d on ep %d", effect_id, p_light_ctx->ep_id);
 
     switch (effect_id)
     {
         case ZB_ZCL_IDENTIFY_EFFECT_ID_BLINK:
-            if (p_light_ctx->led_params.mode == LED_MODE_CONSTANT)
+            if (p_light_ctx->led_params.mode == LED_MODE_HSB)
             {
+                uint32_t color = (p_light_ctx->led_params.color_temperature != 0) ?
+                                 color_conv_ct_to_rgb(p_light_ctx->led_params.color_temperature,
+                                                      p_light_ctx->led_params.level) :
+                                 color_conv_hsb_to_rgb(p_light_ctx->led_params.hue,
+                                                       p_light_ctx->led_params.saturation,
+                                                       p_light_ctx->led_params.level);
+
                 // Current brightness may be set to a low level (below
                 // BULB_LED_VISIBLE_TRESHOLD), so switching it off would not
                 // produce a blink effect. If, so then switch on fully.
-                if (p_light_ctx->led_params.r +
-                    p_light_ctx->led_params.g +
-                    p_light_ctx->led_params.b > BULB_LED_VISIBLE_TRESHOLD)
+                if (((color >> 16) & 0xFFU) +
+                    ((color >> 8) & 0xFFU) +
+                    (color & 0xFFU) > BULB_LED_VISIBLE_TRESHOLD)
                 {
                     led_params.r = 0x00;
                     led_params.g = 0x00;
@@ -513,42 +1099,184 @@ zb_ret_t zb_color_light_do_identify_effect(zb_color_light_ctx_t * p_light_ctx,
             return RET_INVALID_PARAMETER;
     }
 
-    if (prv_atomic_bool_test_and_clear(&m_effect_timer_active))
+    if (m_effect_timer_active)
     {
-        /* Here even if m_effect_timer's callback (effect_timer_handler) is called, nothing will happen,
-         * see effect_timer_handler guard with m_effect_timer_active.
-         * We will never get here when called from effect_timer_handler due to the m_effect_timer_active guard
-         */
-        UNUSED_RETURN_VALUE(app_timer_stop(m_effect_timer));
+        /* Effect timer runs from the same scheduler, so it cannot expire while it is cancelled here */
+        m_effect_timer_active = false;
+        UNUSED_RETURN_VALUE(ZB_SCHEDULE_APP_ALARM_CANCEL(effect_timer_handler, ZB_ALARM_ANY_PARAM));
 
-        zb_color_light_ctx_t * p_effect_timer_light_ctx = m_p_effect_timer_light_ctx;
-        if (p_effect_timer_light_ctx != NULL)
-        {
-            /* Restore led state */
-            update_endpoint_led(p_effect_timer_light_ctx->ep_id,
-                                &p_effect_timer_light_ctx->led_params);
-        }
+        /* Restore led state */
+        update_endpoint_led(m_p_effect_timer_light_ctx->ep_id,
+                            &m_p_effect_timer_light_ctx->led_params);
     }
 
     update_endpoint_led(p_light_ctx->ep_id, &led_params);
 
     if (effect_time > 0)
     {
-        m_p_effect_timer_light_ctx = p_light_ctx;
-        m_effect_timer_active      = true;
+        zb_err_code = ZB_SCHEDULE_APP_ALARM(effect_timer_handler,
+                                            p_light_ctx->ep_id,
+                                            ZB_MILLISECONDS_TO_BEACON_INTERVAL(1000 * effect_time));
+
+        if (zb_err_code == RET_OK)
+        {
+            m_p_effect_timer_light_ctx = p_light_ctx;
+            m_effect_timer_active      = true;
+        }
+    }
+
+    return (zb_err_code == RET_OK ? RET_OK : RET_ERROR);
+}
 
-        err_code = app_timer_start(m_effect_timer,
-                                   APP_TIMER_TICKS(1000*effect_time),
-                                   p_light_ctx);
+zb_uint8_t zb_color_light_zcl_cmd_handler(zb_color_light_ctx_t * p_light_ctx, zb_bufid_t bufid)
+{
+    zb_zcl_parsed_hdr_t                     * p_cmd_info   = ZB_BUF_GET_PARAM(bufid, zb_zcl_parsed_hdr_t);
+    const zb_uint8_t                        * p_payload    = (const zb_uint8_t *)zb_buf_begin(bufid);
+    zb_uint_t                                 length       = zb_buf_len(bufid);
+    zb_zcl_color_ctrl_attrs_set_color_inf_t * p_color_info = &p_light_ctx->color_control_attr.set_color_info;
+    zb_uint8_t                                hue;
+    zb_uint8_t                                saturation;
 
-        if (err_code != NRF_SUCCESS)
+    if ((p_cmd_info->is_common_command) ||
+        (p_cmd_info->cmd_direction != ZB_ZCL_FRAME_DIRECTION_TO_SRV) ||
+        (p_light_ctx->identify_attr.identify_time != 0))
+    {
+        return ZB_FALSE;
+    }
+
+    if (p_cmd_info->cluster_id == ZB_ZCL_CLUSTER_ID_LEVEL_CONTROL)
+    {
+        switch (p_cmd_info->cmd_id)
         {
-            m_effect_timer_active = false;
+            case ZB_ZCL_CMD_LEVEL_CONTROL_MOVE_TO_LEVEL:
+            case ZB_ZCL_CMD_LEVEL_CONTROL_MOVE_TO_LEVEL_WITH_ON_OFF:
+                /* Payload: level (1 byte), transition time (2 bytes) */
+                if (length >= 3)
+                {
+                    level_transition_start(p_light_ctx, p_payload[0], payload_uint16_get(&p_payload[1]));
+                }
+                break;
+
+            case ZB_ZCL_CMD_LEVEL_CONTROL_STOP:
+            case ZB_ZCL_CMD_LEVEL_CONTROL_STOP_WITH_ON_OFF:
+                /* Stay at the level the stack has reached */
+                p_light_ctx->led_params.level                 = p_light_ctx->level_control_attr.current_level;
+                p_light_ctx->led_params.level_transition_time = LIGHT_STEP_TRANSITION_TIME;
+                p_light_ctx->level_remaining_time             = 0;
+                led_update_state(p_light_ctx);
+                transition_countdown_start(p_light_ctx);
+                break;
+
+            default:
+                break;
         }
     }
+    else if (p_cmd_info->cluster_id == ZB_ZCL_CLUSTER_ID_COLOR_CONTROL)
+    {
+        switch (p_cmd_info->cmd_id)
+        {
+            case ZB_ZCL_CMD_COLOR_CONTROL_MOVE_TO_HUE:
+                /* Payload: hue (1 byte), direction (1 byte), transition time (2 bytes) */
+                if (length >= 4)
+                {
+                    color_transition_start(p_light_ctx,
+                                           p_payload[0],
+                                           p_light_ctx->led_params.saturation,
+                                           p_payload[1],
+                                           payload_uint16_get(&p_payload[2]));
+                }
+                break;
 
+            case ZB_ZCL_CMD_COLOR_CONTROL_MOVE_TO_SATURATION:
+                /* Payload: saturation (1 byte), transition time (2 bytes) */
+                if (length >= 3)
+                {
+                    color_transition_start(p_light_ctx,
+                                           p_light_ctx->led_params.hue,
+                                           p_payload[0],
+                                           LED_PARAMS_HUE_DIRECTION_SHORTEST,
+                                           payload_uint16_get(&p_payload[1]));
+                }
+                break;
 
-    return (err_code == NRF_SUCCESS ? RET_OK : RET_ERROR);
+            case ZB_ZCL_CMD_COLOR_CONTROL_MOVE_TO_HUE_SATURATION:
+                /* Payload: hue (1 byte), saturation (1 byte), transition time (2 bytes) */
+                if (length >= 4)
+                {
+                    color_transition_start(p_light_ctx,
+                                           p_payload[0],
+                                           p_payload[1],
+                                           LED_PARAMS_HUE_DIRECTION_SHORTEST,
+                                           payload_uint16_get(&p_payload[2]));
+                }
+                break;
+
+            case ZB_ZCL_CMD_COLOR_CONTROL_MOVE_TO_COLOR:
+                /* Payload: color X (2 bytes), color Y (2 bytes), transition time (2 bytes) */
+                if (length >= 6)
+                {
+                    light_xy_to_hs(payload_uint16_get(&p_payload[0]), payload_uint16_get(&p_payload[2]), &hue, &saturation);
+                    color_transition_start(p_light_ctx,
+                                           hue,
+                                           saturation,
+                                           LED_PARAMS_HUE_DIRECTION_SHORTEST,
+                                           payload_uint16_get(&p_payload[4]));
+                }
+                break;
+
+            case ZB_ZCL_CMD_COLOR_CONTROL_MOVE_TO_COLOR_TEMPERATURE:
+                /* Payload: color temperature (2 bytes), transition time (2 bytes) */
+                if (length >= 4)
+                {
+                    color_temperature_transition_start(p_light_ctx,
+                                                       payload_uint16_get(&p_payload[0]),
+                                                       payload_uint16_get(&p_payload[2]));
+                }
+                break;
+
+            case ZB_ZCL_CMD_COLOR_CONTROL_COLOR_LOOP_SET:
+                if (length >= 7)
+                {
+                    color_loop_set(p_light_ctx, p_payload);
+                }
+                break;
+
+            case ZB_ZCL_CMD_COLOR_CONTROL_STOP_MOVE_STEP:
+                /* Stay at the color the stack has reached */
+                if (p_light_ctx->led_params.color_temperature != 0)
+                {
+                    p_light_ctx->led_params.color_temperature =
+                        light_color_temperature_clamp(p_color_info->color_temperature);
+                    p_light_ctx->led_params.color_temperature_transition_time = LIGHT_STEP_TRANSITION_TIME;
+                }
+                else
+                {
+                    p_light_ctx->led_params.hue                        = p_color_info->current_hue;
+                    p_light_ctx->led_params.hue_direction              = LED_PARAMS_HUE_DIRECTION_SHORTEST;
+                    p_light_ctx->led_params.hue_transition_time        = LIGHT_STEP_TRANSITION_TIME;
+                    p_light_ctx->led_params.saturation                 = p_color_info->current_saturation;
+                    p_light_ctx->led_params.saturation_transition_time = LIGHT_STEP_TRANSITION_TIME;
+                }
+                p_light_ctx->color_remaining_time = 0;
+                led_update_state(p_light_ctx);
+                transition_countdown_start(p_light_ctx);
+                break;
+
+            default:
+                break;
+        }
+    }
+    else if (p_cmd_info->cluster_id == ZB_ZCL_CLUSTER_ID_SCENES)
+    {
+        scenes_cmd_handle(p_light_ctx, p_cmd_info->cmd_id, p_payload, length);
+    }
+    else
+    {
+        /* Other clusters are handled by the stack only */
+    }
+
+    /* The command is processed by the stack as well, which updates attributes and sends the response */
+    return ZB_FALSE;
 }
 
 zb_ret_t zb_color_light_set_attribute(zb_color_light_ctx_t          * p_light_ctx,
@@ -578,26 +1306,38 @@ zb_ret_t zb_color_light_set_attribute(zb_color_light_ctx_t          * p_light_ct
     }
     else if (p_savp->cluster_id == ZB_ZCL_CLUSTER_ID_COLOR_CONTROL)
     {
-        if (p_light_ctx->color_control_attr.set_color_info.remaining_time <= 1)
-        {
-            uint16_t value = p_savp->values.data16;
+        uint16_t value = p_savp->values.data16;
 
-            switch (p_savp->attr_id)
-            {
-                case ZB_ZCL_ATTR_COLOR_CONTROL_CURRENT_HUE_ID:
-                    light_set_hue(p_light_ctx, value);
-                    ret = RET_OK;
-                    break;
-
-                case ZB_ZCL_ATTR_COLOR_CONTROL_CURRENT_SATURATION_ID:
-                    light_set_saturation(p_light_ctx, value);
-                    ret = RET_OK;
-                    break;
-
-                default:
-                    NRF_LOG_INFO("Unused attribute");
-                    break;
-            }
+        switch (p_savp->attr_id)
+        {
+            case ZB_ZCL_ATTR_COLOR_CONTROL_CURRENT_HUE_ID:
+                light_set_hue(p_light_ctx, value);
+                ret = RET_OK;
+                break;
+
+            case ZB_ZCL_ATTR_COLOR_CONTROL_CURRENT_SATURATION_ID:
+                light_set_saturation(p_light_ctx, value);
+                ret = RET_OK;
+                break;
+
+            case ZB_ZCL_ATTR_COLOR_CONTROL_CURRENT_X_ID:
+                light_set_xy(p_light_ctx, value, p_light_ctx->color_control_attr.set_color_info.current_Y);
+                ret = RET_OK;
+                break;
+
+            case ZB_ZCL_ATTR_COLOR_CONTROL_CURRENT_Y_ID:
+                light_set_xy(p_light_ctx, p_light_ctx->color_control_attr.set_color_info.current_X, value);
+                ret = RET_OK;
+                break;
+
+            case ZB_ZCL_ATTR_COLOR_CONTROL_COLOR_TEMPERATURE_ID:
+                light_set_color_temperature(p_light_ctx, value);
+                ret = RET_OK;
+                break;
+
+            default:
+                NRF_LOG_INFO("Unused attribute");
+                break;
         }
     }
     else
@@ -611,67 +1351,64 @@ zb_ret_t zb_color_light_set_attribute(zb_color_light_ctx_t          * p_light_ct
 
 zb_ret_t zb_color_light_set_level(zb_color_light_ctx_t * p_light_ctx, zb_uint8_t value)
 {
-    ret_code_t err_code = NRF_SUCCESS;
-
     NRF_LOG_INFO("Level control setting to %d", value);
-    ZB_ZCL_SET_ATTRIBUTE(p_light_ctx->ep_id,                                       
-                         ZB_ZCL_CLUSTER_ID_LEVEL_CONTROL,            
-                         ZB_ZCL_CLUSTER_SERVER_ROLE,                 
-                         ZB_ZCL_ATTR_LEVEL_CONTROL_CURRENT_LEVEL_ID, 
-                         (zb_uint8_t *)&value,                                       
-                         ZB_FALSE);                                  
 
-    if (p_light_ctx->value_debounce_time > 0)
-    {
-        if (p_light_ctx->value_unstable == ZB_FALSE)
-        {
-            err_code = app_timer_start(m_level_timer,
-                                       APP_TIMER_TICKS(p_light_ctx->value_debounce_time),
-                                       p_light_ctx);
-            p_light_ctx->prev_lvl_ctrl_value = p_light_ctx->level_control_attr.current_level;
-            p_light_ctx->value_unstable = ZB_TRUE;
-        }
-    }
-    else
-    {
-        light_set_brightness(p_light_ctx, value);
-    }
+    /* Steps of transitions started by zb_color_light_zcl_cmd_handler are not displayed,
+     * the transition is rendered smoothly by rgb_led module. */
+    light_set_brightness(p_light_ctx, value);
 
-    return (err_code == NRF_SUCCESS ? RET_OK : RET_ERROR);
+    return RET_OK;
 }
 
 void zb_color_light_init_ctx(zb_color_light_ctx_t * p_light_ctx,
                              uint8_t                ep_id,
-                             zb_callback_t          identify_cb)
+                             zb_callback_t          identify_cb,
+                             zb_device_handler_t    ep_handler)
 {
+    uint_fast8_t i;
+
     memset(p_light_ctx, 0, sizeof(zb_color_light_ctx_t));
 
-    p_light_ctx->ep_id               = ep_id;
-    p_light_ctx->value_unstable      = ZB_FALSE;
-    p_light_ctx->value_debounce_time = CHECK_VALUE_CHANGE_PERIOD;
-    p_light_ctx->led_params.mode     = LED_MODE_CONSTANT;
+    p_light_ctx->ep_id           = ep_id;
+    p_light_ctx->led_params.mode = LED_MODE_HSB;
+
+    for (i = 0; i < LIGHT_CTX_COUNT_MAX; i++)
+    {
+        if (m_p_light_ctxs[i] == NULL)
+        {
+            m_p_light_ctxs[i] = p_light_ctx;
+            break;
+        }
+    }
+    if (i == LIGHT_CTX_COUNT_MAX)
+    {
+        APP_ERROR_CHECK(NRF_ERROR_NO_MEM);
+    }
 
     clusters_attr_init(p_light_ctx);
+    p_light_ctx->led_params.hue        = p_light_ctx->color_control_attr.set_color_info.current_hue;
+    p_light_ctx->led_params.saturation = p_light_ctx->color_control_attr.set_color_info.current_saturation;
     light_set_brightness(p_light_ctx, ZB_ZCL_LEVEL_CONTROL_LEVEL_MAX_VALUE);
 
     /* Register handlers to identify notifications */
     ZB_AF_SET_IDENTIFY_NOTIFICATION_HANDLER(p_light_ctx->ep_id, identify_cb);
+
+    /* Register handler peeking at commands with transition time */
+    ZB_AF_SET_ENDPOINT_HANDLER(p_light_ctx->ep_id, ep_handler);
 }
 
 void zb_color_light_init(void)
 {
-    // Create app timer for handling fast changing cluster attribute values
     uint32_t err_code;
 
-    err_code = app_timer_create(&m_level_timer,
-                                APP_TIMER_MODE_SINGLE_SHOT,
-                                level_timer_handler);
+    err_code = zb_color_light_scenes_init();
     APP_ERROR_CHECK(err_code);
 
-    err_code = app_timer_create(&m_effect_timer,
-                                APP_TIMER_MODE_SINGLE_SHOT,
-                                effect_timer_handler);
-    APP_ERROR_CHECK(err_code);
+    if (!color_conv_xy_matrix_init(&m_xy_matrix, c_primaries, &c_white_point))
+    {
+        /* LIGHT_PRIMARY_* do not span a gamut containing LIGHT_WHITE_POINT_* */
+        APP_ERROR_CHECK(NRF_ERROR_INVALID_PARAM);
+    }
 }
 
 /**
@@ -161,9 +161,8 @@ typedef struct
 {
     led_params_t                led_params;             /**< Table to store RGB color values to control the LED on Thingy. */
     uint8_t                     ep_id;                  /**< Endpoint ID. */
-    uint8_t                     value_unstable: 1;      /**< Variable used as flag when detecting changing value in Level Control attribute. */
-    uint8_t                     value_debounce_time: 7; /**< Value in ms for debounce level change. */
-    uint8_t                     prev_lvl_ctrl_value;    /**< Variable used to store the previous attribute value when detecting changing value in Level Control attribute. */
+    uint16_t                    level_remaining_time;   /**< Time [1/10 s] until the end of level transition requested with transition time. */
+    uint16_t                    color_remaining_time;   /**< Time [1/10 s] until the end of color transition requested with transition time. */
 
     zb_zcl_basic_attrs_ext_t    basic_attr;
     zb_zcl_identify_attrs_t     identify_attr;
@@ -175,6 +174,8 @@ typedef struct
 } zb_color_light_ctx_t;
 
 /**@brief Initialize module.
+ *
+ * Loads the scene table from flash, must be called before @ref zb_color_light_init_ctx.
  */
 void zb_color_light_init(void);
 
@@ -184,10 +185,20 @@ void zb_color_light_init(void);
  * @param[in] p_light_ctx A pointer to light context object.
  * @param[in] ep_id       Endpoint ID
  * @param[in] identify_cb A callback which should be called upon Identify Request.
+ * @param[in] ep_handler  Endpoint handler, which should call @ref zb_color_light_zcl_cmd_handler.
  */
 void zb_color_light_init_ctx(zb_color_light_ctx_t * p_light_ctx,
                              uint8_t                ep_id,
-                             zb_callback_t          identify_cb);
+                             zb_callback_t          identify_cb,
+                             zb_device_handler_t    ep_handler);
+
+/**@brief Finds light context of given endpoint.
+ *
+ * @param[in] ep_id  Endpoint ID.
+ *
+ * @return Pointer to light context or NULL if the endpoint has not been initialized with @ref zb_color_light_init_ctx.
+ */
+zb_color_light_ctx_t * zb_color_light_ctx_get(zb_uint8_t ep_id);
 
 /**@brief Does Identify effect on color light object.
  *
@@ -195,10 +206,25 @@ void zb_color_light_init_ctx(zb_color_light_ctx_t * p_light_ctx,
  * @param[in] effect       Identify effect to play.
  *
  * @return RET_OK on success or error code on failure.
+ *
+ * @note Must be called from the ZBOSS scheduler, as timed effects are stopped from there.
  */
 zb_ret_t zb_color_light_do_identify_effect(zb_color_light_ctx_t * p_light_ctx,
                                            zb_uint8_t             effect);
 
+/**@brief Starts smooth transitions requested by ZCL commands.
+ *
+ * Handles Move to Level and Move to Hue/Saturation commands, so that the light changes smoothly over the requested
+ * transition time, instead of following steps of the stack. Keeps the scene table up to date with Scenes cluster
+ * commands and displays recalled scenes. The command is not consumed, it is processed by the stack afterwards.
+ *
+ * @param[in] p_light_ctx  Pointer to light context object.
+ * @param[in] bufid        Reference to Zigbee stack buffer with received command.
+ *
+ * @return ZB_FALSE, so that the stack processes the command.
+ */
+zb_uint8_t zb_color_light_zcl_cmd_handler(zb_color_light_ctx_t * p_light_ctx, zb_bufid_t bufid);
+
 /**@brief Sets color light attribute.
  *
  * This function sets physical property of the light according to the provided
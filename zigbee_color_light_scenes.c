@@ -0,0 +1,484 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @defgroup zigbee_examples_ble_zigbee_color_light_bulb_thingy zigbee_color_light_scenes.c
+ * @{
+ * @ingroup zigbee_examples
+ */
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "app_util.h"
+#include "nordic_common.h"
+#include "compiler_abstraction.h"
+#include "nrf_fstorage.h"
+#include "nrf_fstorage_nvmc.h"
+#include "nrf_log.h"
+#include "zigbee_color_light_scenes.h"
+
+#define SCENES_FLASH_PAGE_SIZE      4096U                                       /**< Size of nRF52 flash page. */
+#define SCENES_INDEX_BITS           5U                                          /**< Number of bits of hash index. */
+#define SCENES_INDEX_SIZE           (1UL << SCENES_INDEX_BITS)                  /**< Number of hash index slots. */
+#define SCENES_INDEX_EMPTY          0U                                          /**< Hash index slot without scene. */
+
+#define RECORD_MARKER_HEADER        0x314E4353UL                                /**< First record of the page, "SCN1". */
+#define RECORD_MARKER_STORE         0x524F5453UL                                /**< Scene stored, "STOR". */
+#define RECORD_MARKER_REMOVE        0x534D4552UL                                /**< Scene removed, "REMS". */
+#define RECORD_MARKER_REMOVE_GROUP  0x474D4552UL                                /**< All scenes of group removed, "REMG". */
+#define RECORD_MARKER_FREE          0xFFFFFFFFUL                                /**< Erased record. */
+
+/* Record of the log kept in flash. The marker is written last, so a record interrupted by reset is not valid. */
+typedef struct
+{
+    zb_color_light_scene_t scene;   /**< Scene affected by the record. */
+    uint32_t               marker;  /**< Type of the record, one of RECORD_MARKER_*. */
+} scene_record_t;
+
+#define SCENES_RECORDS_COUNT        (SCENES_FLASH_PAGE_SIZE / sizeof(scene_record_t))
+
+/* Load factor of the hash index is kept at most 1/2, so that probe sequences stay short */
+STATIC_ASSERT(SCENES_INDEX_SIZE >= (2U * ZB_COLOR_LIGHT_SCENES_COUNT_MAX));
+STATIC_ASSERT(ZB_COLOR_LIGHT_SCENES_COUNT_MAX < UINT8_MAX);
+STATIC_ASSERT((sizeof(zb_color_light_scene_t) % sizeof(uint32_t)) == 0);
+STATIC_ASSERT(ZB_COLOR_LIGHT_SCENES_COUNT_MAX < SCENES_RECORDS_COUNT);
+
+static void fstorage_evt_handler(nrf_fstorage_evt_t * p_evt);
+
+/* Flash page reserved for the scenes log by the linker script, outside of the application image */
+extern const uint32_t __start_zb_color_light_scenes[];
+extern const uint32_t __stop_zb_color_light_scenes[];
+
+NRF_FSTORAGE_DEF(nrf_fstorage_t m_fstorage) =
+{
+    .evt_handler = fstorage_evt_handler,
+};
+
+static zb_color_light_scene_t m_scenes[ZB_COLOR_LIGHT_SCENES_COUNT_MAX];
+static uint8_t                m_scenes_count;
+static uint8_t                m_index[SCENES_INDEX_SIZE];                       /**< Index of scene in m_scenes + 1, or SCENES_INDEX_EMPTY. */
+static uint32_t               m_next_record;                                    /**< Index of the first free record in flash page. */
+static uint32_t               m_flash_ops;
+
+/* Buffer of data being written to flash, fits the whole table and the header for compaction */
+static scene_record_t         m_write_buffer[ZB_COLOR_LIGHT_SCENES_COUNT_MAX + 1U];
+
+/**@brief Function for handling flash storage events. */
+static void fstorage_evt_handler(nrf_fstorage_evt_t * p_evt)
+{
+    if (p_evt->result != NRF_SUCCESS)
+    {
+        NRF_LOG_ERROR("Scenes flash operation failed: %d", p_evt->result);
+    }
+}
+
+/**@brief Function for computing hash index slot of a scene.
+ *
+ * @return First slot of probe sequence of the scene.
+ */
+static uint32_t scene_hash(uint8_t ep_id, uint16_t group_id, uint8_t scene_id)
+{
+    uint32_t key = ((uint32_t)group_id << 16) | ((uint32_t)ep_id << 8) | scene_id;
+
+    /* Multiplicative hashing, the upper bits are mixed best */
+    return (uint32_t)(key * 2654435769UL) >> (32U - SCENES_INDEX_BITS);
+}
+
+/**@brief Function for checking if a scene has given endpoint, group and scene ID. */
+static bool scene_matches(const zb_color_light_scene_t * p_scene, uint8_t ep_id, uint16_t group_id, uint8_t scene_id)
+{
+    return (p_scene->ep_id == ep_id) && (p_scene->group_id == group_id) && (p_scene->scene_id == scene_id);
+}
+
+/**@brief Function for finding index of a scene in m_scenes.
+ *
+ * @return Index of the scene or ZB_COLOR_LIGHT_SCENES_COUNT_MAX if the scene is not stored.
+ */
+static uint32_t scene_idx_find(uint8_t ep_id, uint16_t group_id, uint8_t scene_id)
+{
+    uint32_t slot = scene_hash(ep_id, group_id, scene_id);
+
+    /* Index is never full, so an empty slot ends every probe sequence */
+    while (m_index[slot] != SCENES_INDEX_EMPTY)
+    {
+        uint32_t idx = m_index[slot] - 1U;
+
+        if (scene_matches(&m_scenes[idx], ep_id, group_id, scene_id))
+        {
+            return idx;
+        }
+        slot = (slot + 1U) & (SCENES_INDEX_SIZE - 1U);
+    }
+
+    return ZB_COLOR_LIGHT_SCENES_COUNT_MAX;
+}
+
+/**@brief Function for adding a scene from m_scenes to the hash index. */
+static void index_insert(uint32_t idx)
+{
+    uint32_t slot = scene_hash(m_scenes[idx].ep_id, m_scenes[idx].group_id, m_scenes[idx].scene_id);
+
+    while (m_index[slot] != SCENES_INDEX_EMPTY)
+    {
+        slot = (slot + 1U) & (SCENES_INDEX_SIZE - 1U);
+    }
+    m_index[slot] = (uint8_t)(idx + 1U);
+}
+
+/**@brief Function for rebuilding the hash index after scenes have been removed from m_scenes. */
+static void index_rebuild(void)
+{
+    uint32_t idx;
+
+    memset(m_index, SCENES_INDEX_EMPTY, sizeof(m_index));
+    for (idx = 0; idx < m_scenes_count; idx++)
+    {
+        index_insert(idx);
+    }
+}
+
+/**@brief Function for storing a scene in RAM table.
+ *
+ * @return true if the table has been changed, false if the same scene was already stored or the table is full.
+ */
+static bool table_store(const zb_color_light_scene_t * p_scene)
+{
+    uint32_t idx = scene_idx_find(p_scene->ep_id, p_scene->group_id, p_scene->scene_id);
+
+    if (idx < ZB_COLOR_LIGHT_SCENES_COUNT_MAX)
+    {
+        if (memcmp(&m_scenes[idx], p_scene, sizeof(*p_scene)) == 0)
+        {
+            return false;
+        }
+        m_scenes[idx] = *p_scene;
+    }
+    else if (m_scenes_count < ZB_COLOR_LIGHT_SCENES_COUNT_MAX)
+    {
+        idx           = m_scenes_count++;
+        m_scenes[idx] = *p_scene;
+        index_insert(idx);
+    }
+    else
+    {
+        return false;
+    }
+
+    return true;
+}
+
+/**@brief Function for removing matching scenes from RAM table.
+ *
+ * @param[in] p_scene       Scene with endpoint, group and scene ID to be matched.
+ * @param[in] whole_group   true if scene ID is ignored.
+ *
+ * @return Number of removed scenes.
+ */
+static uint32_t table_remove(const zb_color_light_scene_t * p_scene, bool whole_group)
+{
+    uint32_t removed = 0U;
+    uint32_t idx     = 0U;
+
+    while (idx < m_scenes_count)
+    {
+        if ((m_scenes[idx].ep_id == p_scene->ep_id) &&
+            (m_scenes[idx].group_id == p_scene->group_id) &&
+            (whole_group || (m_scenes[idx].scene_id == p_scene->scene_id)))
+        {
+            /* Order of scenes does not matter, fill the gap with the last one */
+            m_scenes[idx] = m_scenes[--m_scenes_count];
+            removed++;
+        }
+        else
+        {
+            idx++;
+        }
+    }
+
+    if (removed > 0U)
+    {
+        index_rebuild();
+    }
+
+    return removed;
+}
+
+/**@brief Function for getting flash address of a record of the log. */
+static uint32_t record_addr(uint32_t record_no)
+{
+    return m_fstorage.start_addr + (record_no * sizeof(scene_record_t));
+}
+
+/**@brief Function for writing records to flash.
+ *
+ * @note The NVMC backend of fstorage is synchronous, @ref m_write_buffer can be reused once this function returns.
+ */
+static ret_code_t records_write(uint32_t first_record_no, uint32_t records_count)
+{
+    m_flash_ops++;
+    return nrf_fstorage_write(&m_fstorage,
+                              record_addr(first_record_no),
+                              m_write_buffer,
+                              records_count * sizeof(scene_record_t),
+                              NULL);
+}
+
+/**@brief Function for erasing the flash page and writing the whole RAM table to it. */
+static ret_code_t log_compact(void)
+{
+    ret_code_t err_code;
+    uint32_t   idx;
+
+    m_flash_ops++;
+    err_code = nrf_fstorage_erase(&m_fstorage, m_fstorage.start_addr, 1U, NULL);
+    if (err_code != NRF_SUCCESS)
+    {
+        return err_code;
+    }
+
+    memset(&m_write_buffer[0], 0xFF, sizeof(m_write_buffer[0]));
+    m_write_buffer[0].marker = RECORD_MARKER_HEADER;
+    for (idx = 0; idx < m_scenes_count; idx++)
+    {
+        m_write_buffer[idx + 1U].scene  = m_scenes[idx];
+        m_write_buffer[idx + 1U].marker = RECORD_MARKER_STORE;
+    }
+
+    m_next_record = m_scenes_count + 1U;
+
+    return records_write(0U, m_next_record);
+}
+
+/**@brief Function for appending a change of the RAM table to the log, compacting the log if it is full. */
+static ret_code_t log_append(const zb_color_light_scene_t * p_scene, uint32_t marker)
+{
+    if (m_next_record >= SCENES_RECORDS_COUNT)
+    {
+        /* RAM table already contains the change */
+        return log_compact();
+    }
+
+    m_write_buffer[0].scene  = *p_scene;
+    m_write_buffer[0].marker = marker;
+
+    return records_write(m_next_record++, 1U);
+}
+
+/**@brief Function for checking if a record of the log has not been written at all. */
+static bool record_is_erased(const scene_record_t * p_record)
+{
+    const uint8_t * p_byte = (const uint8_t *)p_record;
+    size_t          i;
+
+    for (i = 0; i < sizeof(*p_record); i++)
+    {
+        if (p_byte[i] != 0xFFU)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**@brief Function for rebuilding RAM table by replaying the log.
+ *
+ * @return true if the log is valid and new records can be appended to it.
+ */
+static bool log_replay(void)
+{
+    scene_record_t record;
+    ret_code_t     err_code;
+
+    err_code = nrf_fstorage_read(&m_fstorage, record_addr(0U), &record, sizeof(record));
+    if ((err_code != NRF_SUCCESS) || (record.marker != RECORD_MARKER_HEADER))
+    {
+        return false;
+    }
+
+    for (m_next_record = 1U; m_next_record < SCENES_RECORDS_COUNT; m_next_record++)
+    {
+        err_code = nrf_fstorage_read(&m_fstorage, record_addr(m_next_record), &record, sizeof(record));
+        if (err_code != NRF_SUCCESS)
+        {
+            return false;
+        }
+
+        switch (record.marker)
+        {
+            case RECORD_MARKER_STORE:
+                UNUSED_RETURN_VALUE(table_store(&record.scene));
+                break;
+
+            case RECORD_MARKER_REMOVE:
+                UNUSED_RETURN_VALUE(table_remove(&record.scene, false));
+                break;
+
+            case RECORD_MARKER_REMOVE_GROUP:
+                UNUSED_RETURN_VALUE(table_remove(&record.scene, true));
+                break;
+
+            case RECORD_MARKER_FREE:
+                /* End of the log, unless a write has been interrupted */
+                return record_is_erased(&record);
+
+            default:
+                return false;
+        }
+    }
+
+    return true;
+}
+
+ret_code_t zb_color_light_scenes_init(void)
+{
+    ret_code_t err_code;
+
+    m_fstorage.start_addr = (uint32_t)__start_zb_color_light_scenes;
+    m_fstorage.end_addr   = (uint32_t)__stop_zb_color_light_scenes;
+    if ((m_fstorage.end_addr - m_fstorage.start_addr) != SCENES_FLASH_PAGE_SIZE)
+    {
+        NRF_LOG_ERROR("Scenes flash region must be a single page");
+        return NRF_ERROR_INVALID_LENGTH;
+    }
+
+    err_code = nrf_fstorage_init(&m_fstorage, &nrf_fstorage_nvmc, NULL);
+    if (err_code != NRF_SUCCESS)
+    {
+        return err_code;
+    }
+
+    m_scenes_count = 0U;
+    m_flash_ops    = 0U;
+    index_rebuild();
+
+    if (!log_replay())
+    {
+        /* Keep scenes recovered so far, start a fresh log with them */
+        NRF_LOG_INFO("Scenes log not valid, rewriting");
+        err_code = log_compact();
+    }
+
+    NRF_LOG_INFO("Loaded %u scenes, %u log records used", m_scenes_count, m_next_record);
+
+    return err_code;
+}
+
+const zb_color_light_scene_t * zb_color_light_scene_find(uint8_t ep_id, uint16_t group_id, uint8_t scene_id)
+{
+    uint32_t idx = scene_idx_find(ep_id, group_id, scene_id);
+
+    return (idx < ZB_COLOR_LIGHT_SCENES_COUNT_MAX) ? &m_scenes[idx] : NULL;
+}
+
+ret_code_t zb_color_light_scene_store(const zb_color_light_scene_t * p_scene)
+{
+    zb_color_light_scene_t scene = *p_scene;
+
+    memset(scene.reserved, 0xFF, sizeof(scene.reserved));
+
+    if (!table_store(&scene))
+    {
+        /* Storing the same scene again needs no flash write */
+        return (zb_color_light_scene_find(scene.ep_id, scene.group_id, scene.scene_id) != NULL) ?
+               NRF_SUCCESS : NRF_ERROR_NO_MEM;
+    }
+
+    return log_append(&scene, RECORD_MARKER_STORE);
+}
+
+ret_code_t zb_color_light_scene_remove(uint8_t ep_id, uint16_t group_id, uint8_t scene_id)
+{
+    zb_color_light_scene_t scene;
+
+    memset(&scene, 0xFF, sizeof(scene));
+    scene.ep_id    = ep_id;
+    scene.group_id = group_id;
+    scene.scene_id = scene_id;
+
+    if (table_remove(&scene, false) == 0U)
+    {
+        return NRF_ERROR_NOT_FOUND;
+    }
+
+    return log_append(&scene, RECORD_MARKER_REMOVE);
+}
+
+ret_code_t zb_color_light_scenes_remove_all(uint8_t ep_id, uint16_t group_id)
+{
+    zb_color_light_scene_t scene;
+
+    memset(&scene, 0xFF, sizeof(scene));
+    scene.ep_id    = ep_id;
+    scene.group_id = group_id;
+
+    if (table_remove(&scene, true) == 0U)
+    {
+        return NRF_SUCCESS;
+    }
+
+    return log_append(&scene, RECORD_MARKER_REMOVE_GROUP);
+}
+
+uint8_t zb_color_light_scenes_count_get(uint8_t ep_id)
+{
+    uint8_t  count = 0U;
+    uint32_t idx;
+
+    for (idx = 0; idx < m_scenes_count; idx++)
+    {
+        if (m_scenes[idx].ep_id == ep_id)
+        {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+uint32_t zb_color_light_scenes_flash_ops_get(void)
+{
+    return m_flash_ops;
+}
+
+/**
+ * @}
+ */
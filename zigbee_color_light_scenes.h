@@ -0,0 +1,156 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @defgroup zigbee_examples_ble_zigbee_color_light_bulb_thingy zigbee_color_light_scenes.h
+ * @{
+ * @ingroup zigbee_examples
+ *
+ * @brief Scene table of the color light, persisted in flash.
+ *
+ * Scenes are kept in RAM and found with a hashed lookup, so that Recall Scene needs no flash access. Every change of
+ * the table is appended as a single record to a log in a reserved flash page, which is replayed at boot. The page is
+ * compacted (erased and rewritten with the current table) only when it is full.
+ *
+ * The page is given by symbols __start_zb_color_light_scenes and __stop_zb_color_light_scenes, which the linker script
+ * provides for a memory region outside of the application image, so that flashing a new image keeps the scenes.
+ */
+
+#ifndef ZIGBEE_COLOR_LIGHT_SCENES_H__
+#define ZIGBEE_COLOR_LIGHT_SCENES_H__
+
+#include <stdint.h>
+
+#include "sdk_config.h"
+#include "sdk_errors.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**@def ZB_COLOR_LIGHT_SCENES_COUNT_MAX
+ * @brief Maximum number of scenes stored for all endpoints together */
+#ifndef ZB_COLOR_LIGHT_SCENES_COUNT_MAX
+#define ZB_COLOR_LIGHT_SCENES_COUNT_MAX     16U
+#endif
+
+/* Scene of the color light, values ready to be applied to the clusters attributes and the LED */
+typedef struct
+{
+    uint16_t group_id;          /**< Group ID of the scene. */
+    uint8_t  ep_id;             /**< Endpoint the scene belongs to. */
+    uint8_t  scene_id;          /**< Scene ID. */
+    uint16_t transition_time;   /**< Transition time [1/10 s]. */
+    uint8_t  on_off;            /**< Value of OnOff attribute. */
+    uint8_t  level;             /**< Value of CurrentLevel attribute. */
+    uint8_t  hue;               /**< Value of CurrentHue attribute. */
+    uint8_t  saturation;        /**< Value of CurrentSaturation attribute. */
+    uint8_t  reserved[2];       /**< Padding, keeps the size a multiple of flash word. */
+} zb_color_light_scene_t;
+
+/**@brief Function for initializing the scene table and loading it from flash.
+ *
+ * @retval NRF_SUCCESS  Table loaded, or initialized empty if the flash page held no valid table.
+ * @return Error code of flash storage otherwise.
+ */
+ret_code_t zb_color_light_scenes_init(void);
+
+/**@brief Function for finding a scene.
+ *
+ * @param[in] ep_id     Endpoint ID.
+ * @param[in] group_id  Group ID.
+ * @param[in] scene_id  Scene ID.
+ *
+ * @return Pointer to the scene, valid until the next change of the table, or NULL if the scene is not stored.
+ */
+const zb_color_light_scene_t * zb_color_light_scene_find(uint8_t ep_id, uint16_t group_id, uint8_t scene_id);
+
+/**@brief Function for adding a scene or replacing a scene with the same endpoint, group and scene ID.
+ *
+ * @param[in] p_scene   Scene to be stored.
+ *
+ * @retval NRF_SUCCESS          Scene stored.
+ * @retval NRF_ERROR_NO_MEM     Scene table is full.
+ * @return Error code of flash storage otherwise.
+ */
+ret_code_t zb_color_light_scene_store(const zb_color_light_scene_t * p_scene);
+
+/**@brief Function for removing a scene.
+ *
+ * @param[in] ep_id     Endpoint ID.
+ * @param[in] group_id  Group ID.
+ * @param[in] scene_id  Scene ID.
+ *
+ * @retval NRF_SUCCESS          Scene removed.
+ * @retval NRF_ERROR_NOT_FOUND  Scene is not stored.
+ * @return Error code of flash storage otherwise.
+ */
+ret_code_t zb_color_light_scene_remove(uint8_t ep_id, uint16_t group_id, uint8_t scene_id);
+
+/**@brief Function for removing all scenes of a group.
+ *
+ * @param[in] ep_id     Endpoint ID.
+ * @param[in] group_id  Group ID.
+ *
+ * @retval NRF_SUCCESS  Scenes removed, also if there were none.
+ * @return Error code of flash storage otherwise.
+ */
+ret_code_t zb_color_light_scenes_remove_all(uint8_t ep_id, uint16_t group_id);
+
+/**@brief Function for getting number of scenes stored for an endpoint.
+ *
+ * @param[in] ep_id     Endpoint ID.
+ *
+ * @return Number of scenes, suitable for SceneCount attribute.
+ */
+uint8_t zb_color_light_scenes_count_get(uint8_t ep_id);
+
+/**@brief Function for getting number of flash operations (writes and page erases) done since initialization. */
+uint32_t zb_color_light_scenes_flash_ops_get(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZIGBEE_COLOR_LIGHT_SCENES_H__ */
+
+/**
+ * @}
+ */